@@ -113,6 +113,8 @@ const IPAddress kSubnetMask = IPAddress(255, 255, 255, 0);
                                     // Note: OTA & GPIO updates are always
                                     //       passworded.
 // If you do not set a password, Firmware OTA & GPIO updates will be blocked.
+// Max. nr. of commands accepted in a single "/batch" request.
+const uint8_t kBatchMaxCommands = 32;
 
 // ----------------------- MQTT Related Settings -------------------------------
 #if MQTT_ENABLE
@@ -169,6 +171,23 @@ const uint32_t kMqttReconnectTime = 5000;  // Delay(ms) between reconnect tries.
 // In theory, you shouldn't need this as you can always clean up by hand, hence
 // it is disabled by default. Note: `false` saves ~1.2k.
 #define MQTT_CLEAR_ENABLE false
+
+// Enable(true)/Disable(false) sharing climate units between several
+// IRMQTTServers that can all reach them. e.g. A big room with an IR bridge at
+// each end. Each server advertises the units it can reach, & they agree on
+// which one of them drives each unit. If that server goes offline, another
+// takes over its units. Units shared this way use the command & stat topics
+// under `MQTT_FLEET/units/<unit name>/` instead of the channel's usual ones.
+// Each server must have a unique hostname. Note: `false` saves ~2k.
+#define MQTT_FLEET_ENABLE false
+#if MQTT_FLEET_ENABLE
+#define MQTT_FLEET "ir_server_fleet"  // Base topic shared by all the servers.
+// The fleet-wide name of the unit each TX GPIO (channel) reaches, or "" if
+// the channel isn't shared. All servers must use the same name for a unit.
+const char* kFleetUnitNames[kNrOfIrTxGpios] = {"ac_1"};  // <=- CHANGE_ME
+// Max. nr. of other servers we keep track of.
+const uint16_t kFleetMaxPeers = 8;
+#endif  // MQTT_FLEET_ENABLE
 #endif  // MQTT_ENABLE
 
 // ------------------------ IR Capture Settings --------------------------------
@@ -272,7 +291,6 @@ const uint8_t kPasswordLength = 20;
 // -------------------------- Json Settings ------------------------------------
 
 const uint16_t kJsonConfigMaxSize = 512;    // Bytes
-const uint16_t kJsonAcStateMaxSize = 1024;  // Bytes
 
 // -------------------------- Debug Settings -----------------------------------
 // Debug output is disabled if any of the IR pins are on the TX (D1) pin.
@@ -325,15 +343,32 @@ const char* kCommandDelimiter = ",";
 const char* kUrlRoot = "/";
 const char* kUrlAdmin = "/admin";
 const char* kUrlAircon = "/aircon";
+const char* kUrlBatch = "/batch";
 const char* kUrlSendDiscovery = "/send_discovery";
 const char* kUrlExamples = "/examples";
 const char* kUrlGpio = "/gpio";
 const char* kUrlGpioSet = "/gpio/set";
 const char* kUrlInfo = "/info";
+const char* kUrlMetrics = "/metrics";
+const char* kUrlMetricsJson = "/metrics.json";
 const char* kUrlReboot = "/quitquitquit";
 const char* kUrlWipe = "/reset";
 const char* kUrlClearMqtt = "/clear_retained";
 
+// A checked command from a "/batch" request.
+struct BatchCommand {
+  bool is_climate;  // An A/C update, rather than an IR code.
+  uint8_t channel;  // The IR TX channel to use.
+  bool resend;  // Send the A/C state, even if it hasn't changed.
+  decode_type_t type;  // IR code only.
+  uint64_t code;  // IR code only.
+  uint16_t code_start;  // Where the unparsed IR code is in the request body.
+  uint16_t code_end;
+  uint16_t bits;  // IR code only.
+  uint16_t repeat;  // IR code only.
+  stdAc::update_t update;  // A/C update only.
+};
+
 #if MQTT_ENABLE
 const uint32_t kBroadcastPeriodMs = MQTTbroadcastInterval * 1000;  // mSeconds.
 // How long should we listen to recover for previous states?
@@ -379,6 +414,13 @@ void sendMQTTDiscovery(const char *topic);
 void doBroadcast(TimerMs *timer, const uint32_t interval,
                  IRac *climates[], const bool retain,
                  const bool force);
+String climateTopic(const uint16_t channel);
+bool ownsChannel(const uint16_t channel);
+#if MQTT_FLEET_ENABLE
+bool fleetPublish(const char *topic, const char *payload, const bool retain,
+                  void *arg);
+void fleetOwnership(const int16_t unit, const bool owned, void *arg);
+#endif  // MQTT_FLEET_ENABLE
 #if MQTT_CLIMATE_JSON
 stdAc::state_t jsonToState(const stdAc::state_t current, const char *str);
 void sendJsonState(const stdAc::state_t state, const String topic,
@@ -428,6 +470,7 @@ void handleAirCon(void);
 void handleAirConSet(void);
 void handleAdmin(void);
 void handleInfo(void);
+void handleMetrics(void);
 void handleReset(void);
 void handleReboot(void);
 bool parseStringAndSendAirCon(IRsend *irsend, const decode_type_t irType,
@@ -445,6 +488,12 @@ bool parseStringAndSendPronto(IRsend *irsend, const String str,
 bool parseStringAndSendRaw(IRsend *irsend, const String str);
 #endif  // SEND_RAW
 void handleIr(void);
+uint32_t climateKeyToFields(const String key);
+String parseBatchLine(const String &body, const uint16_t start,
+                      const uint16_t end, BatchCommand *cmd,
+                      decode_type_t protocols[]);
+bool sendBatchCommand(const String &body, const BatchCommand *cmd);
+void handleBatch(void);
 void handleNotFound(void);
 void setup_wifi(void);
 void init_vars(void);
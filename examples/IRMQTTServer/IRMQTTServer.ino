@@ -73,6 +73,31 @@
  *   http://<your_esp's_ip_address>/ir?channel=0&type=7&code=E0E09966
  *   http://<your_esp's_ip_address>/ir?channel=1&type=7&code=E0E09966
  *
+ * To send lots of commands at once (e.g. a "scene"), POST them to
+ * http://<your_esp's_ip_address>/batch as plain text, one per line, using the
+ * same arguments as the "/ir" & "/aircon/set" URLs. Lines with a "code" are IR
+ * codes, the rest are A/C updates. Blank lines & lines starting with '#' are
+ * ignored. Every line is checked before anything is sent, then the result of
+ * each line is streamed back as it is sent. The commands are sent in order,
+ * from within the request, so nothing else (e.g. MQTT) is handled until the
+ * whole batch has been sent. There is no send queue. e.g.
+ *   curl -H 'Content-Type: text/plain' --data-binary @- \
+ *     http://<your_esp's_ip_address>/batch <<EOF
+ *   type=7&code=E0E09966
+ *   channel=0&protocol=PANASONIC_AC&power=on&mode=cool&temp=23
+ *   EOF
+ * gives:
+ *   1 ok
+ *   2 ok
+ *   done 2/2 in 214ms, checked in 1130us
+ * The totals of the commands & the time spent checking them are in the
+ * "irmqtt_batch_*" metrics.
+ *
+ * The library's & the server's counters (IR messages received, decode misses,
+ * send airtime, MQTT messages published etc) are available from
+ * http://<your_esp's_ip_address>/metrics in the Prometheus text format, or
+ * from http://<your_esp's_ip_address>/metrics.json as JSON.
+ *
  * or
  *
  * Send a MQTT message to the topic 'ir_server/send'
@@ -210,6 +235,18 @@
  * accordingly. This will typically result in A/C IR message being sent as and
  * saved state will probably be different from the defaults.
  *
+ * ### Sharing A/Cs between several IRMQTTServers. (aka. a "fleet")
+ * If more than one IRMQTTServer can reach the same A/C, set
+ * `MQTT_FLEET_ENABLE` & name the unit each TX GPIO reaches in
+ * `kFleetUnitNames` (see IRMQTTServer.h) on each of them. The servers
+ * advertise which units they can reach on "MQTT_FLEET/nodes/<hostname>" and
+ * agree, without any central coordinator, on exactly one of them to drive
+ * each unit. Control the unit via the "MQTT_FLEET/units/<unit>/cmnd/*"
+ * topics, & its state is reported on "MQTT_FLEET/units/<unit>/stat/*".
+ * If a server stops advertising for ~2 minutes, its units are taken over by
+ * the other servers that can reach them, which have been following their
+ * state in the meantime. Adding a server only moves the units it will drive.
+ *
  * NOTE: Command attributes are processed sequentially.
  *       e.g. Going from "25C, cool, fan low" to "27C, heat, fan high" may go
  *       via "27C, cool, fan low" & "27C, heat, fan low" depending on the order
@@ -353,6 +390,13 @@
 #include <IRtimer.h>
 #include <IRutils.h>
 #include <IRac.h>
+#include <IRmetrics.h>
+#if MQTT_CLIMATE_JSON
+#include <IRjson.h>
+#endif  // MQTT_CLIMATE_JSON
+#if MQTT_ENABLE && MQTT_FLEET_ENABLE
+#include <IRfleet.h>
+#endif  // MQTT_ENABLE && MQTT_FLEET_ENABLE
 #if MQTT_ENABLE
 #include <PubSubClient.h>
 #endif  // MQTT_ENABLE
@@ -387,7 +431,14 @@ uint16_t *codeArray;
 uint32_t lastReconnectAttempt = 0;  // MQTT last attempt reconnection number
 bool boot = true;
 volatile bool lockIr = false;  // Primitive locking for gating the IR LED.
-uint32_t sendReqCounter = 0;
+int16_t sendReqMetric = irmetrics::addCounter("irmqtt_send_requests_total");
+int16_t wifiRssiMetric = irmetrics::addGauge("irmqtt_wifi_rssi_dbm");
+int16_t freeHeapMetric = irmetrics::addGauge("irmqtt_free_heap_bytes");
+// "/batch" commands, & the time spent checking them. i.e. The per command
+// overhead, apart from sending.
+int16_t batchCmdMetric = irmetrics::addCounter("irmqtt_batch_commands_total");
+int16_t batchCheckMetric = irmetrics::addCounter(
+    "irmqtt_batch_check_us_total");
 bool lastSendSucceeded = false;  // Store the success status of the last send.
 uint32_t lastSendTime = 0;
 int8_t offset;  // The calculated period offset for this chip and library.
@@ -400,16 +451,21 @@ decode_results capture;  // Somewhere to store inbound IR messages.
 int8_t rx_gpio = kDefaultIrRx;
 String lastIrReceived = "None";
 uint32_t lastIrReceivedTime = 0;
-uint32_t irRecvCounter = 0;
+int16_t irRecvMetric = irmetrics::addCounter("irmqtt_ir_received_total");
 #endif  // IR_RX
 
 // Climate stuff
 IRac *climate[kNrOfIrTxGpios];
+#if MQTT_ENABLE && MQTT_FLEET_ENABLE
+IRFleet *fleet = NULL;  // Decides which server drives each shared unit.
+int16_t fleetUnit[kNrOfIrTxGpios];  // Each channel's fleet unit id, if any.
+#endif  // MQTT_ENABLE && MQTT_FLEET_ENABLE
 String channel_re = "(";  // Will be built later.
 uint16_t chan = 0;  // The channel to use for the aircon HTML page.
 
 TimerMs lastClimateIr = TimerMs();  // When we last sent the IR Climate mesg.
-uint32_t irClimateCounter = 0;  // How many have we sent?
+// How many have we sent?
+int16_t irClimateMetric = irmetrics::addCounter("irmqtt_climate_sent_total");
 // Store the success status of the last climate send.
 bool lastClimateSucceeded = false;
 bool hasClimateBeenSent = false;  // Has the Climate ever been sent?
@@ -421,9 +477,10 @@ String lastMqttCmdTopic = "None";
 uint32_t lastMqttCmdTime = 0;
 uint32_t lastConnectedTime = 0;
 uint32_t lastDisconnectedTime = 0;
-uint32_t mqttDisconnectCounter = 0;
-uint32_t mqttSentCounter = 0;
-uint32_t mqttRecvCounter = 0;
+int16_t mqttDisconnectMetric = irmetrics::addCounter(
+    "irmqtt_mqtt_disconnects_total");
+int16_t mqttSentMetric = irmetrics::addCounter("irmqtt_mqtt_sent_total");
+int16_t mqttRecvMetric = irmetrics::addCounter("irmqtt_mqtt_received_total");
 bool wasConnected = true;
 
 char MqttServer[kHostnameLength + 1] = "10.0.0.4";
@@ -1254,7 +1311,8 @@ void handleInfo(void) {
     "IR Send GPIO(s): " + listOfTxGpios() + "<br>"
     + irutils::addBoolToString(kInvertTxOutput,
                                "Inverting GPIO output", false) + "<br>"
-    "Total send requests: " + String(sendReqCounter) + "<br>"
+    "Total send requests: " +
+        uint64ToString(irmetrics::getCounter(sendReqMetric)) + "<br>"
     "Last message sent: " + String(lastSendSucceeded ? "Ok" : "FAILED") +
     " <i>(" + timeSince(lastSendTime) + ")</i><br>"
 #if IR_RX
@@ -1263,7 +1321,8 @@ void handleInfo(void) {
     " (pullup)"
 #endif  // IR_RX_PULLUP
     "<br>"
-    "Total IR Received: " + String(irRecvCounter) + "<br>"
+    "Total IR Received: " +
+        uint64ToString(irmetrics::getCounter(irRecvMetric)) + "<br>"
     "Last IR Received: " + lastIrReceived +
     " <i>(" + timeSince(lastIrReceivedTime) + ")</i><br>"
 #endif  // IR_RX
@@ -1295,7 +1354,8 @@ void handleInfo(void) {
     (mqtt_client.connected() ? "Connected " + timeSince(lastDisconnectedTime)
                              : "Disconnected " + timeSince(lastConnectedTime)) +
     ")</i><br>"
-    "Disconnections: " + String(mqttDisconnectCounter - 1) + "<br>"
+    "Disconnections: " + uint64ToString(
+        irmetrics::getCounter(mqttDisconnectMetric) - 1) + "<br>"
     "Buffer Size: " + String(mqtt_client.getBufferSize()) + " bytes<br>"
     "Client id: " + MqttClientId + "<br>"
     "Command topic(s): " + listOfCommandTopics() + "<br>"
@@ -1312,15 +1372,18 @@ void handleInfo(void) {
         irutils::htmlEscape(lastMqttCmdTopic) +
          "' (payload) '" + irutils::htmlEscape(lastMqttCmd) + "' <i>(" +
          timeSince(lastMqttCmdTime) + ")</i><br>"
-    "Total published: " + String(mqttSentCounter) + "<br>"
-    "Total received: " + String(mqttRecvCounter) + "<br>"
+    "Total published: " +
+        uint64ToString(irmetrics::getCounter(mqttSentMetric)) + "<br>"
+    "Total received: " +
+        uint64ToString(irmetrics::getCounter(mqttRecvMetric)) + "<br>"
     "</p>"
 #endif  // MQTT_ENABLE
     "<h4>Climate Information</h4>"
     "<p>"
     "IR Send GPIO: " + String(txGpioTable[0]) + "<br>"
     "Last update source: " + lastClimateSource + "<br>"
-    "Total sent: " + String(irClimateCounter) + "<br>"
+    "Total sent: " +
+        uint64ToString(irmetrics::getCounter(irClimateMetric)) + "<br>"
     "Last send: " + String(hasClimateBeenSent ?
         (String(lastClimateSucceeded ? "Ok" : "FAILED") +
          " <i>(" + timeElapsed(lastClimateIr.elapsed()) + ")</i>") :
@@ -1328,6 +1391,10 @@ void handleInfo(void) {
 #if MQTT_ENABLE
     "State listen period: " + msToString(kStatListenPeriodMs) + "<br>"
     "State broadcast period: " + msToString(kBroadcastPeriodMs) + "<br>"
+#if MQTT_FLEET_ENABLE
+    "Other fleet servers online: " +
+        String(fleet != NULL ? fleet->getLivePeers() : 0) + "<br>"
+#endif  // MQTT_FLEET_ENABLE
     "Last state broadcast: " + (hasBroadcastBeenSent ?
         timeElapsed(lastBroadcast.elapsed()) :
         String("<i>Never</i>")) + "<br>"
@@ -1355,6 +1422,16 @@ void handleInfo(void) {
   server.send(200, "text/html", html);
 }
 
+// Metrics pages. Prometheus text format, or JSON for "/metrics.json".
+void handleMetrics(void) {
+  irmetrics::set(wifiRssiMetric, WiFi.RSSI());
+  irmetrics::set(freeHeapMetric, ESP.getFreeHeap());
+  if (server.uri() == kUrlMetricsJson)
+    server.send(200, "application/json", irmetrics::toJson());
+  else
+    server.send(200, "text/plain; version=0.0.4", irmetrics::toPrometheus());
+}
+
 void doRestart(const char* str, const bool serial_only) {
 #if MQTT_ENABLE
   if (!serial_only)
@@ -1857,6 +1934,241 @@ void handleIr(void) {
   server.send(200, "text/html", html);
 }
 
+// Which A/C state fields a climate argument changes.
+//
+// Args:
+//   key: The name of the argument. e.g. KEY_TEMP
+// Returns:
+//   uint32_t: A mask of kAcField* bits. 0 if it isn't a climate argument.
+uint32_t climateKeyToFields(const String key) {
+  if (key.equals(KEY_PROTOCOL)) return kAcFieldProtocol;
+  if (key.equals(KEY_MODEL)) return kAcFieldModel;
+#if MQTT_CLIMATE_HA_MODE
+  // Power & mode change each other. See `updateClimate()`.
+  if (key.equals(KEY_POWER) || key.equals(KEY_MODE))
+    return kAcFieldPower | kAcFieldMode;
+#else  // MQTT_CLIMATE_HA_MODE
+  if (key.equals(KEY_POWER)) return kAcFieldPower;
+  if (key.equals(KEY_MODE)) return kAcFieldMode;
+#endif  // MQTT_CLIMATE_HA_MODE
+  if (key.equals(KEY_TEMP)) return kAcFieldDegrees;
+  if (key.equals(KEY_FANSPEED)) return kAcFieldFanspeed;
+  if (key.equals(KEY_SWINGV)) return kAcFieldSwingv;
+  if (key.equals(KEY_SWINGH)) return kAcFieldSwingh;
+  if (key.equals(KEY_QUIET)) return kAcFieldQuiet;
+  if (key.equals(KEY_TURBO)) return kAcFieldTurbo;
+  if (key.equals(KEY_ECONO)) return kAcFieldEcono;
+  if (key.equals(KEY_LIGHT)) return kAcFieldLight;
+  if (key.equals(KEY_BEEP)) return kAcFieldBeep;
+  if (key.equals(KEY_FILTER)) return kAcFieldFilter;
+  if (key.equals(KEY_CLEAN)) return kAcFieldClean;
+  if (key.equals(KEY_CELSIUS)) return kAcFieldCelsius;
+  if (key.equals(KEY_SLEEP)) return kAcFieldSleep;
+  return 0;
+}
+
+// Parse & check one line of a batch request.
+//
+// Args:
+//   body:      The whole request body.
+//   start:     Offset of the start of the line in `body`.
+//   end:       Offset of the end of the line in `body`.
+//   cmd:       Where to store the parsed command.
+//   protocols: The A/C protocol of each channel, after the earlier lines.
+// Returns:
+//   String: Empty if the line is valid, otherwise what is wrong with it.
+String parseBatchLine(const String &body, const uint16_t start,
+                      const uint16_t end, BatchCommand *cmd,
+                      decode_type_t protocols[]) {
+  int16_t channel = -1;
+  bool has_type = false;
+  cmd->is_climate = true;
+  cmd->type = decode_type_t::NEC;  // Default to NEC codes, like `/ir`.
+  cmd->code = 0;
+  cmd->code_start = 0;
+  cmd->code_end = 0;
+  cmd->bits = 0;
+  cmd->repeat = 0;
+  cmd->resend = false;
+  cmd->update.fields = 0;
+  IRac::initState(&cmd->update.values);
+  for (uint16_t pos = start; pos < end;) {
+    int next = body.indexOf('&', pos);
+    if (next < 0 || next > end) next = end;
+    const int equals = body.indexOf('=', pos);
+    if (equals < 0 || equals >= next)
+      return F("Argument has no value");
+    const String key = body.substring(pos, equals);
+    if (key.equals(KEY_CODE)) {
+      cmd->is_climate = false;
+      cmd->code_start = equals + 1;
+      cmd->code_end = next;
+      cmd->code = getUInt64fromHex(body.substring(equals + 1, next).c_str());
+    } else {
+      const String value = body.substring(equals + 1, next);
+      if (key.equals(KEY_TYPE)) {
+        has_type = true;
+        cmd->type = strToDecodeType(value.c_str());
+      } else if (key.equals(KEY_BITS)) {
+        cmd->bits = value.toInt();
+      } else if (key.equals(KEY_REPEAT)) {
+        cmd->repeat = value.toInt();
+      } else if (key.equals(KEY_CHANNEL)) {
+        channel = value.toInt();
+      } else if (key.equals(KEY_RESEND)) {
+        cmd->resend = IRac::strToBool(value.c_str());
+      } else {
+        const uint32_t fields = climateKeyToFields(key);
+        if (!fields) return "Unknown argument: " + key;
+        // `protocol` is also how `/ir` is told the type of an IR code.
+        if (key.equals(KEY_PROTOCOL)) {
+          has_type = true;
+          cmd->type = strToDecodeType(value.c_str());
+        }
+        cmd->update.fields |= fields;
+        updateClimate(&cmd->update.values, key, "", value);
+      }
+    }
+    pos = next + 1;
+  }
+  if (!cmd->is_climate) {  // An IR code.
+    if (channel < 0) channel = getDefaultIrSendIdx();
+    if (channel >= kNrOfIrTxGpios || IrSendTable[channel] == NULL)
+      return F("Invalid channel");
+    if (!has_type || cmd->type == decode_type_t::UNKNOWN)
+      return F("Unknown IR protocol");
+    cmd->channel = channel;
+    return "";
+  }
+  if (channel < 0) channel = chan;
+  if (channel >= kNrOfIrTxGpios || climate[channel] == NULL)
+    return F("Invalid channel");
+  if (!cmd->update.fields && !cmd->resend) return F("Nothing to do");
+  if (cmd->update.fields & kAcFieldProtocol)
+    protocols[channel] = cmd->update.values.protocol;
+  stdAc::capabilities_t caps;
+  if (!IRac::getCapabilities(protocols[channel], kAcAnyModel, &caps))
+    return F("Unsupported A/C protocol");
+  cmd->channel = channel;
+  return "";
+}
+
+// Send a command from a batch request.
+//
+// Args:
+//   body: The whole request body.
+//   cmd:  The parsed command.
+// Returns:
+//   bool: Successfully sent or not.
+bool sendBatchCommand(const String &body, const BatchCommand *cmd) {
+  if (!cmd->is_climate) {
+    // Only the protocols that need it get a copy of the unparsed code.
+    String code_str = "";
+    if (hasACState(cmd->type) || cmd->type == PRONTO || cmd->type == RAW ||
+        cmd->type == GLOBALCACHE)
+      code_str = body.substring(cmd->code_start, cmd->code_end);
+    lastSendSucceeded = sendIRCode(IrSendTable[cmd->channel], cmd->type,
+                                   cmd->code, code_str.c_str(), cmd->bits,
+                                   cmd->repeat);
+    return lastSendSucceeded;
+  }
+  IRac *ac_ptr = climate[cmd->channel];
+  ac_ptr->applyUpdate(cmd->update);
+  lastClimateSource = F("HTTP (batch)");
+#if MQTT_ENABLE
+  return sendClimate(genStatTopic(cmd->channel), true, false, cmd->resend,
+                     true, ac_ptr);
+#else  // MQTT_ENABLE
+  return sendClimate("", false, false, cmd->resend, true, ac_ptr);
+#endif  // MQTT_ENABLE
+}
+
+// Handle a batch of IR codes & A/C updates in a single request.
+// Every line is checked before anything is sent, so a typo doesn't leave a
+// "scene" half done. The results are streamed back as each command is sent.
+void handleBatch(void) {
+#if HTML_PASSWORD_ENABLE
+  if (!server.authenticate(HttpUsername, HttpPassword)) {
+    debug("Basic HTTP authentication failure for /batch.");
+    return server.requestAuthentication();
+  }
+#endif
+  if (server.method() != HTTP_POST) {
+    server.send(405, "text/plain", F("Please POST the commands.\n"));
+    return;
+  }
+  const uint32_t check_start = micros();
+  const String body = server.arg("plain");
+  debug("New batch received via HTTP");
+  // Find the lines that have a command on them.
+  uint16_t line_start[kBatchMaxCommands];
+  uint16_t line_end[kBatchMaxCommands];
+  uint16_t line_nr[kBatchMaxCommands];
+  uint16_t count = 0;
+  uint16_t nr = 0;
+  for (uint16_t pos = 0; pos < body.length();) {
+    int end = body.indexOf('\n', pos);
+    if (end < 0) end = body.length();
+    nr++;
+    uint16_t last = end;
+    if (last > pos && body[last - 1] == '\r') last--;
+    if (last > pos && body[pos] != '#') {
+      if (count >= kBatchMaxCommands) {
+        server.send(413, "text/plain", "Too many commands. Max is " +
+                    String(kBatchMaxCommands) + ".\n");
+        return;
+      }
+      line_start[count] = pos;
+      line_end[count] = last;
+      line_nr[count] = nr;
+      count++;
+    }
+    pos = end + 1;
+  }
+  if (!count) {
+    server.send(400, "text/plain", F("No commands.\n"));
+    return;
+  }
+  BatchCommand *cmds = new BatchCommand[count];
+  if (cmds == NULL) {
+    server.send(500, "text/plain", F("Out of memory.\n"));
+    return;
+  }
+  // Check all of them before sending any of them.
+  decode_type_t protocols[kNrOfIrTxGpios];
+  for (uint16_t i = 0; i < kNrOfIrTxGpios; i++)
+    protocols[i] = (climate[i] != NULL) ? climate[i]->next.protocol
+                                        : decode_type_t::UNKNOWN;
+  for (uint16_t i = 0; i < count; i++) {
+    const String error = parseBatchLine(body, line_start[i], line_end[i],
+                                        &cmds[i], protocols);
+    if (error.length()) {
+      server.send(400, "text/plain",
+                  "Line " + String(line_nr[i]) + ": " + error + "\n");
+      delete[] cmds;
+      return;
+    }
+  }
+  const uint32_t check_time = micros() - check_start;
+  irmetrics::add(batchCmdMetric, count);
+  irmetrics::add(batchCheckMetric, check_time);
+  // Send them in order, reporting each result as we go.
+  const uint32_t start = millis();
+  uint16_t sent = 0;
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/plain", "");
+  for (uint16_t i = 0; i < count; i++) {
+    const bool success = sendBatchCommand(body, &cmds[i]);
+    if (success) sent++;
+    server.sendContent(String(line_nr[i]) + (success ? " ok\n" : " failed\n"));
+  }
+  server.sendContent("done " + String(sent) + "/" + String(count) + " in " +
+                     String(millis() - start) + "ms, checked in " +
+                     String(check_time) + "us\n");
+  server.sendContent("");  // End of the response.
+  delete[] cmds;
+}
+
 // GPIO menu page
 void handleGpio(void) {
 #if HTML_PASSWORD_ENABLE
@@ -2068,6 +2380,19 @@ void init_vars(void) {
   MqttHAName = String(Hostname) + "_aircon";
   // Create a unique MQTT client id.
   MqttClientId = String(Hostname) + String(kChipId, HEX);
+#if MQTT_FLEET_ENABLE
+  // Tell the fleet which of the shared units we can reach.
+  fleet = new IRFleet(Hostname, MQTT_FLEET "/nodes", kFleetMaxPeers);
+  for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
+    fleetUnit[i] = kFleetNoUnit;
+    if (fleet != NULL && climate[i] != NULL && strlen(kFleetUnitNames[i]))
+      fleetUnit[i] = fleet->addUnit(kFleetUnitNames[i], i);
+  }
+  if (fleet != NULL) {
+    fleet->setPublisher(fleetPublish);
+    fleet->setOwnershipCallback(fleetOwnership);
+  }
+#endif  // MQTT_FLEET_ENABLE
 #endif  // MQTT_ENABLE
 }
 
@@ -2156,12 +2481,17 @@ void setup(void) {
 #endif  // EXAMPLES_ENABLE
   // Setup the page to handle web-based IR codes.
   server.on("/ir", handleIr);
+  // Setup the page to handle batches of IR codes & A/C updates.
+  server.on(kUrlBatch, handleBatch);
   // Setup the aircon page.
   server.on(kUrlAircon, handleAirCon);
   // Setup the aircon update page.
   server.on("/aircon/set", handleAirConSet);
   // Setup the info page.
   server.on(kUrlInfo, handleInfo);
+  // Setup the metrics pages.
+  server.on(kUrlMetrics, handleMetrics);
+  server.on(kUrlMetricsJson, handleMetrics);
   // Setup the admin page.
   server.on(kUrlAdmin, handleAdmin);
   // Setup a reset page to cause WiFiManager information to be reset.
@@ -2258,13 +2588,62 @@ void setup(void) {
 }
 
 #if MQTT_ENABLE
-String genStatTopic(const uint16_t channel) {
+// The base of the climate topics for a channel.
+String climateTopic(const uint16_t channel) {
+#if MQTT_FLEET_ENABLE
+  if (fleet != NULL && fleetUnit[channel] != kFleetNoUnit)
+    return String(MQTT_FLEET "/units/") +
+        fleet->getUnitName(fleetUnit[channel]);
+#endif  // MQTT_FLEET_ENABLE
   if (channel)  // Never use the '*_0' state channel.
-    return MqttClimate + "_" + String(channel) + '/' + MQTT_CLIMATE_STAT + '/';
+    return MqttClimate + "_" + String(channel);
   else
-    return MqttClimate + '/' + MQTT_CLIMATE_STAT + '/';
+    return MqttClimate;
+}
+
+String genStatTopic(const uint16_t channel) {
+  return climateTopic(channel) + '/' + MQTT_CLIMATE_STAT + '/';
+}
+
+// Are we the server that should drive the climate unit on this channel?
+bool ownsChannel(const uint16_t channel) {
+#if MQTT_FLEET_ENABLE
+  if (fleet != NULL && fleetUnit[channel] != kFleetNoUnit)
+    return fleet->isOwner(fleetUnit[channel]);
+#endif  // MQTT_FLEET_ENABLE
+  return true;
 }
 
+#if MQTT_FLEET_ENABLE
+// Publish a message for the fleet.
+bool fleetPublish(const char *topic, const char *payload, const bool retain,
+                  void *) {
+  if (!mqtt_client.connected()) return false;
+  irmetrics::add(mqttSentMetric);
+  return mqtt_client.publish(topic, payload, retain);
+}
+
+// We gained or lost a shared unit. When we don't own it, follow its state so
+// we are up to date if we ever have to take it over.
+void fleetOwnership(const int16_t unit, const bool owned, void *) {
+  const uint16_t channel = fleet->getEmitter(unit);
+  const String cmnd_topic = climateTopic(channel) + '/' + MQTT_CLIMATE_CMND +
+      "/+";
+  const String stat_topic = genStatTopic(channel) + '+';
+  mqttLog((String(owned ? "Took over " : "Handed over ") +
+           fleet->getUnitName(unit) + " (channel " + String(channel) +
+           ')').c_str());
+  if (!mqtt_client.connected()) return;  // `reconnect()` will subscribe.
+  if (owned) {
+    unsubscribing(stat_topic);
+    subscribing(cmnd_topic);
+  } else {
+    unsubscribing(cmnd_topic);
+    subscribing(stat_topic);
+  }
+}
+#endif  // MQTT_FLEET_ENABLE
+
 // MQTT subscribing to topic
 void subscribing(const String topic_name) {
   // subscription to topic for receiving data with QoS.
@@ -2288,7 +2667,7 @@ void unsubscribing(const String topic_name) {
 void mqttLog(const char* str) {
   debug(str);
   mqtt_client.publish(MqttLog.c_str(), str);
-  mqttSentCounter++;
+  irmetrics::add(mqttSentMetric);
 }
 
 bool reconnect(void) {
@@ -2317,17 +2696,30 @@ bool reconnect(void) {
 
       // Update Last Will & Testament to say we are back online.
       mqtt_client.publish(MqttLwt.c_str(), kLwtOnline, true);
-      mqttSentCounter++;
+      irmetrics::add(mqttSentMetric);
 
       // Subscribing to topic(s)
       subscribing(MqttSend);  // General base topic.
       subscribing(MqttClimateCmnd + '+');  // Base climate command topics
+#if MQTT_FLEET_ENABLE
+      if (fleet != NULL) subscribing(fleet->getSubscription());
+#endif  // MQTT_FLEET_ENABLE
       // Per channel topics
       for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
         // General
         if (IrSendTable[i] != NULL)
           subscribing(MqttSend + '_' + String(i));
         // Climate
+#if MQTT_FLEET_ENABLE
+        if (fleet != NULL && fleetUnit[i] != kFleetNoUnit) {
+          // Shared unit. Follow its state until we own it.
+          if (ownsChannel(i))
+            subscribing(climateTopic(i) + '/' + MQTT_CLIMATE_CMND + "/+");
+          else
+            subscribing(genStatTopic(i) + '+');
+          continue;
+        }
+#endif  // MQTT_FLEET_ENABLE
         if (climate[i] != NULL)
           subscribing(MqttClimate + '_' + String(i) + '/' + MQTT_CLIMATE_CMND +
                       '/' + '+');
@@ -2382,6 +2774,7 @@ void doBroadcast(TimerMs *timer, const uint32_t interval,
   if (force || (!lockMqttBroadcast && timer->elapsed() > interval)) {
     debug("Sending MQTT stat update broadcast.");
     for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
+      if (!ownsChannel(i)) continue;  // Another server reports on it.
       String stat_topic = genStatTopic(i);
       sendClimate(stat_topic, retain, true, false, true, climate[i]);
 #if REPORT_VCC
@@ -2410,29 +2803,55 @@ void receivingMQTT(String const topic_name, String const callback_str) {
   lastMqttCmdTopic = topic_name;
   lastMqttCmd = callback_str;
   lastMqttCmdTime = millis();
-  mqttRecvCounter++;
+  irmetrics::add(mqttRecvMetric);
 
-  // Check if a specific channel was requested by looking for a "*_[0-9]" suffix
-  // Or is for a specific ac/climate channel. e.g. "*/ac_[1-9]"
-  debug(("Checking for channel number in " + topic_name).c_str());
-  for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
-    if (topic_name.endsWith("_" + String(i)) ||
-        (i > 0 && topic_name.startsWith(MqttClimate + "_" + String(i)))) {
+  bool is_climate = topic_name.startsWith(MqttClimate);
+#if MQTT_FLEET_ENABLE
+  // Is it another server advertising itself?
+  if (fleet != NULL &&
+      fleet->handleMessage(topic_name.c_str(), callback_str.c_str()))
+    return;
+  // Or is it for one of the shared units?
+  for (uint16_t i = 0; !is_climate && i < kNrOfIrTxGpios; i++) {
+    if (fleet != NULL && fleetUnit[i] != kFleetNoUnit &&
+        topic_name.startsWith(climateTopic(i) + '/')) {
       channel = i;
-      break;
+      is_climate = true;
+    }
+  }
+  if (!is_climate)
+#endif  // MQTT_FLEET_ENABLE
+  {
+    // Check if a specific channel was requested by looking for a "*_[0-9]"
+    // suffix. Or is for a specific ac/climate channel. e.g. "*/ac_[1-9]"
+    debug(("Checking for channel number in " + topic_name).c_str());
+    for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
+      if (topic_name.endsWith("_" + String(i)) ||
+          (i > 0 && topic_name.startsWith(MqttClimate + "_" + String(i)))) {
+        channel = i;
+        break;
+      }
     }
   }
   debug(("Channel = " + String(channel)).c_str());
   // Is it a climate topic?
-  if (topic_name.startsWith(MqttClimate)) {
+  if (is_climate) {
     String alt_cmnd_topic = MqttClimate + "_" + String(channel) + '/' +
         MQTT_CLIMATE_CMND + '/';
+#if MQTT_FLEET_ENABLE
+    if (fleet != NULL && fleetUnit[channel] != kFleetNoUnit)
+      alt_cmnd_topic = climateTopic(channel) + '/' + MQTT_CLIMATE_CMND + '/';
+#endif  // MQTT_FLEET_ENABLE
     // Also accept climate commands on the '*_0' channel.
     String cmnd_topic = topic_name.startsWith(alt_cmnd_topic) ? alt_cmnd_topic
                                                               : MqttClimateCmnd;
     String stat_topic = genStatTopic(channel);
     if (topic_name.startsWith(cmnd_topic)) {
       debug("It's a climate command topic");
+      if (!ownsChannel(channel)) {
+        debug("Another server drives that unit. Ignoring it.");
+        return;
+      }
       updateClimate(&(climate[channel]->next), topic_name, cmnd_topic,
                     callback_str);
       // Handle the special command for forcing a resend of the state via IR.
@@ -2480,7 +2899,7 @@ void receivingMQTT(String const topic_name, String const callback_str) {
           delay(msecs);
           mqtt_client.publish(MqttAck.c_str(),
                               String(kPauseChar + String(msecs)).c_str());
-          mqttSentCounter++;
+          irmetrics::add(mqttSentMetric);
           break;
         }
       default:  // It's an IR command.
@@ -2584,7 +3003,7 @@ void sendMQTTDiscovery(const char *topic) {
     mqttLog("MQTT climate discovery successful sent.");
     hasDiscoveryBeenSent = true;
     lastDiscovery.reset();
-    mqttSentCounter++;
+    irmetrics::add(mqttSentMetric);
   } else {
     mqttLog("MQTT climate discovery FAILED to send.");
   }
@@ -2605,7 +3024,7 @@ void loop(void) {
     if (wasConnected) {
       lastDisconnectedTime = now;
       wasConnected = false;
-      mqttDisconnectCounter++;
+      irmetrics::add(mqttDisconnectMetric);
     }
     // Reconnect if it's longer than kMqttReconnectTime since we last tried.
     if (now - lastReconnectAttempt > kMqttReconnectTime) {
@@ -2639,8 +3058,13 @@ void loop(void) {
     // MQTT loop
     lastConnectedTime = now;
     mqtt_client.loop();
+#if MQTT_FLEET_ENABLE
+    if (fleet != NULL) fleet->poll();  // Heartbeats, failover etc.
+#endif  // MQTT_FLEET_ENABLE
     if (lockMqttBroadcast && statListenTime.elapsed() > kStatListenPeriodMs) {
       for (uint16_t i = 0; i < kNrOfIrTxGpios; i++) {
+        // Keep following the state of shared units we don't drive.
+        if (!ownsChannel(i)) continue;
         String stat_topic = genStatTopic(i);
         unsubscribing(stat_topic + '+');
         // Did something change?
@@ -2690,11 +3114,11 @@ void loop(void) {
       lastIrReceived += kCommandDelimiter[0] + String(capture.bits);
 #if MQTT_ENABLE
     mqtt_client.publish(MqttRecv.c_str(), lastIrReceived.c_str());
-    mqttSentCounter++;
+    irmetrics::add(mqttSentMetric);
     debug("Incoming IR message sent to MQTT:");
     debug(lastIrReceived.c_str());
 #endif  // MQTT_ENABLE
-    irRecvCounter++;
+    irmetrics::add(irRecvMetric);
 #if USE_DECODED_AC_SETTINGS
     if (decodeCommonAc(&capture)) lastClimateSource = F("IR");
 #endif  // USE_DECODED_AC_SETTINGS
@@ -2784,7 +3208,7 @@ bool sendIRCode(IRsend *irsend, decode_type_t const ir_type,
 
   // Indicate that we sent the message or not.
   if (success) {
-    sendReqCounter++;
+    irmetrics::add(sendReqMetric);
     debug("Sent the IR message:");
   } else {
     debug("Failed to send IR Message:");
@@ -2809,7 +3233,7 @@ bool sendIRCode(IRsend *irsend, decode_type_t const ir_type,
         mqtt_client.publish(MqttAck.c_str(), (String(ir_type) +
                                               kCommandDelimiter[0] +
                                               String(code_str)).c_str());
-      mqttSentCounter++;
+      irmetrics::add(mqttSentMetric);
     }
 #endif  // MQTT_ENABLE
   } else {  // For "short" codes, we break it down a bit more before we report.
@@ -2825,7 +3249,7 @@ bool sendIRCode(IRsend *irsend, decode_type_t const ir_type,
                                             String(bits) +
                                             kCommandDelimiter[0] +
                                             String(repeat)).c_str());
-      mqttSentCounter++;
+      irmetrics::add(mqttSentMetric);
     }
 #endif  // MQTT_ENABLE
   }
@@ -2834,7 +3258,7 @@ bool sendIRCode(IRsend *irsend, decode_type_t const ir_type,
 
 bool sendInt(const String topic, const int32_t num, const bool retain) {
 #if MQTT_ENABLE
-  mqttSentCounter++;
+  irmetrics::add(mqttSentMetric);
   return mqtt_client.publish(topic.c_str(), String(num).c_str(), retain);
 #else  // MQTT_ENABLE
   return true;
@@ -2843,7 +3267,7 @@ bool sendInt(const String topic, const int32_t num, const bool retain) {
 
 bool sendBool(const String topic, const bool on, const bool retain) {
 #if MQTT_ENABLE
-  mqttSentCounter++;
+  irmetrics::add(mqttSentMetric);
   return mqtt_client.publish(topic.c_str(), (on ? "on" : "off"), retain);
 #else  // MQTT_ENABLE
   return true;
@@ -2852,7 +3276,7 @@ bool sendBool(const String topic, const bool on, const bool retain) {
 
 bool sendString(const String topic, const String str, const bool retain) {
 #if MQTT_ENABLE
-  mqttSentCounter++;
+  irmetrics::add(mqttSentMetric);
   return mqtt_client.publish(topic.c_str(), str.c_str(), retain);
 #else  // MQTT_ENABLE
   return true;
@@ -2861,7 +3285,7 @@ bool sendString(const String topic, const String str, const bool retain) {
 
 bool sendFloat(const String topic, const float_t temp, const bool retain) {
 #if MQTT_ENABLE
-  mqttSentCounter++;
+  irmetrics::add(mqttSentMetric);
   return mqtt_client.publish(topic.c_str(), String(temp, 1).c_str(), retain);
 #else  // MQTT_ENABLE
   return true;
@@ -2871,89 +3295,22 @@ bool sendFloat(const String topic, const float_t temp, const bool retain) {
 #if MQTT_CLIMATE_JSON
 void sendJsonState(const stdAc::state_t state, const String topic,
                    const bool retain, const bool ha_mode) {
-  DynamicJsonDocument json(kJsonAcStateMaxSize);
-  json[KEY_PROTOCOL] = typeToString(state.protocol);
-  json[KEY_MODEL] = state.model;
-  json[KEY_POWER] = IRac::boolToString(state.power);
-  json[KEY_MODE] = IRac::opmodeToString(state.mode, ha_mode);
-  // Home Assistant wants mode to be off if power is also off & vice-versa.
-  if (ha_mode && (state.mode == stdAc::opmode_t::kOff || !state.power)) {
-    json[KEY_MODE] = IRac::opmodeToString(stdAc::opmode_t::kOff, ha_mode);
-    json[KEY_POWER] = IRac::boolToString(false);
-  }
-  json[KEY_CELSIUS] = IRac::boolToString(state.celsius);
-  json[KEY_TEMP] = state.degrees;
-  json[KEY_FANSPEED] = IRac::fanspeedToString(state.fanspeed);
-  json[KEY_SWINGV] = IRac::swingvToString(state.swingv);
-  json[KEY_SWINGH] = IRac::swinghToString(state.swingh);
-  json[KEY_QUIET] = IRac::boolToString(state.quiet);
-  json[KEY_TURBO] = IRac::boolToString(state.turbo);
-  json[KEY_ECONO] = IRac::boolToString(state.econo);
-  json[KEY_LIGHT] = IRac::boolToString(state.light);
-  json[KEY_FILTER] = IRac::boolToString(state.filter);
-  json[KEY_CLEAN] = IRac::boolToString(state.clean);
-  json[KEY_BEEP] = IRac::boolToString(state.beep);
-  json[KEY_SLEEP] = state.sleep;
-
-  String payload = "";
-  payload.reserve(200);
-  serializeJson(json, payload);
-  sendString(topic, payload, retain);
-}
-
-bool validJsonStr(DynamicJsonDocument doc, const char* key) {
-  return doc.containsKey(key) && doc[key].is<char*>();
-}
-
-bool validJsonInt(DynamicJsonDocument doc, const char* key) {
-  return doc.containsKey(key) && doc[key].is<signed int>();
+  char payload[irjson::kStateJsonMaxLength];
+  if (irjson::stateToJson(state, payload, sizeof(payload), ha_mode) >=
+      sizeof(payload)) {
+    debug("Climate state is too big for a JSON message. Skipping!");
+    return;
+  }
+#if MQTT_ENABLE
+  irmetrics::add(mqttSentMetric);
+  mqtt_client.publish(topic.c_str(), payload, retain);
+#endif  // MQTT_ENABLE
 }
 
 stdAc::state_t jsonToState(const stdAc::state_t current, const char *str) {
-  DynamicJsonDocument json(kJsonAcStateMaxSize);
-  if (deserializeJson(json, str, kJsonAcStateMaxSize)) {
-    debug("json MQTT message did not parse. Skipping!");
-    return current;
-  }
   stdAc::state_t result = current;
-  if (validJsonStr(json, KEY_PROTOCOL))
-    result.protocol = strToDecodeType(json[KEY_PROTOCOL]);
-  else if (validJsonInt(json, KEY_PROTOCOL))
-    result.protocol = (decode_type_t)json[KEY_PROTOCOL].as<signed int>();
-  if (validJsonStr(json, KEY_MODEL))
-    result.model = IRac::strToModel(json[KEY_MODEL].as<char*>());
-  else if (validJsonInt(json, KEY_MODEL))
-    result.model = json[KEY_MODEL];
-  if (validJsonStr(json, KEY_MODE))
-    result.mode = IRac::strToOpmode(json[KEY_MODE]);
-  if (validJsonStr(json, KEY_FANSPEED))
-    result.fanspeed = IRac::strToFanspeed(json[KEY_FANSPEED]);
-  if (validJsonStr(json, KEY_SWINGV))
-    result.swingv = IRac::strToSwingV(json[KEY_SWINGV]);
-  if (validJsonStr(json, KEY_SWINGH))
-    result.swingh = IRac::strToSwingH(json[KEY_SWINGH]);
-  if (json.containsKey(KEY_TEMP))
-    result.degrees = json[KEY_TEMP];
-  if (validJsonInt(json, KEY_SLEEP))
-    result.sleep = json[KEY_SLEEP];
-  if (validJsonStr(json, KEY_POWER))
-    result.power = IRac::strToBool(json[KEY_POWER]);
-  if (validJsonStr(json, KEY_QUIET))
-    result.quiet = IRac::strToBool(json[KEY_QUIET]);
-  if (validJsonStr(json, KEY_TURBO))
-    result.turbo = IRac::strToBool(json[KEY_TURBO]);
-  if (validJsonStr(json, KEY_ECONO))
-    result.econo = IRac::strToBool(json[KEY_ECONO]);
-  if (validJsonStr(json, KEY_LIGHT))
-    result.light = IRac::strToBool(json[KEY_LIGHT]);
-  if (validJsonStr(json, KEY_CLEAN))
-    result.clean = IRac::strToBool(json[KEY_CLEAN]);
-  if (validJsonStr(json, KEY_FILTER))
-    result.filter = IRac::strToBool(json[KEY_FILTER]);
-  if (validJsonStr(json, KEY_BEEP))
-    result.beep = IRac::strToBool(json[KEY_BEEP]);
-  if (validJsonStr(json, KEY_CELSIUS))
-    result.celsius = IRac::strToBool(json[KEY_CELSIUS]);
+  if (!irjson::jsonToState(str, &result))
+    debug("json MQTT message did not parse. Skipping!");
   return result;
 }
 #endif  // MQTT_CLIMATE_JSON
@@ -3113,7 +3470,7 @@ bool sendClimate(const String topic_prefix, const bool retain,
   }
   // Only send an IR message if we need to.
   if (enableIR && ((diff && !forceMQTT) || forceIR)) {
-    sendReqCounter++;
+    irmetrics::add(sendReqMetric);
     if (ac == NULL) {  // No climate object is available.
       debug("Can't send climate state as common A/C object doesn't exist!");
       return false;
@@ -3131,7 +3488,7 @@ bool sendClimate(const String topic_prefix, const bool retain,
     if (lastClimateSucceeded) hasClimateBeenSent = true;
     success &= lastClimateSucceeded;
     lastClimateIr.reset();
-    irClimateCounter++;
+    irmetrics::add(irClimateMetric);
   }
   // Mark the "next" value as old/previous.
   if (ac != NULL) {
@@ -5,6 +5,7 @@
 // to offer most common functionality across all supported devices.
 
 #include "IRac.h"
+#include "IRac_capabilities.h"
 #ifndef UNIT_TEST
 #include <Arduino.h>
 #endif
@@ -13,6 +14,7 @@
 #include <string>
 #endif
 #include "IRsend.h"
+#include "IRmetrics.h"
 #include "IRremoteESP8266.h"
 #include "IRtext.h"
 #include "IRutils.h"
@@ -2542,6 +2544,9 @@ bool IRac::sendAc(const decode_type_t vendor, const int16_t model,
 /// You need to use `power` for that.
 /// @return True, if accepted/converted/attempted etc. False, if unsupported.
 bool IRac::sendAc(const stdAc::state_t desired, const stdAc::state_t *prev) {
+#if ENABLE_IR_METRICS
+  const uint64_t airtime = irmetrics::getCounter(irmetrics::kSendAirtimeUs);
+#endif  // ENABLE_IR_METRICS
   // Convert the temp from Fahrenheit to Celsius if we are not in Celsius mode.
   float degC __attribute__((unused)) =
       desired.celsius ? desired.degrees : fahrenheitToCelsius(desired.degrees);
@@ -3074,8 +3079,12 @@ bool IRac::sendAc(const stdAc::state_t desired, const stdAc::state_t *prev) {
     }
 #endif  // SEND_TRANSCOLD_AC
     default:
+      IR_METRIC_INC(kAcUnsupported);
       return false;  // Fail, didn't match anything.
   }
+  IR_METRIC_INC(kAcSends);
+  IR_METRIC_OBSERVE(kAcAirtimeMs,
+      (irmetrics::getCounter(irmetrics::kSendAirtimeUs) - airtime) / 1000);
   return true;  // Success.
 }  // NOLINT(readability/fn_size)
 
@@ -3111,6 +3120,113 @@ bool IRac::cmpStates(const stdAc::state_t a, const stdAc::state_t b) {
 /// @return True if it has changed, False if not.
 bool IRac::hasStateChanged(void) { return cmpStates(next, _prev); }
 
+/// Work out which fields differ between two AirCon states.
+/// @note Unlike `cmpStates()`, the clock is included.
+/// @param[in] a A state_t to be compared.
+/// @param[in] b A state_t to be compared.
+/// @return A mask of `kAcField*` bits, one for each field that differs.
+uint32_t IRac::diffStates(const stdAc::state_t a, const stdAc::state_t b) {
+  uint32_t diff = 0;
+  if (a.protocol != b.protocol) diff |= kAcFieldProtocol;
+  if (a.model != b.model) diff |= kAcFieldModel;
+  if (a.power != b.power) diff |= kAcFieldPower;
+  if (a.mode != b.mode) diff |= kAcFieldMode;
+  if (a.degrees != b.degrees) diff |= kAcFieldDegrees;
+  if (a.celsius != b.celsius) diff |= kAcFieldCelsius;
+  if (a.fanspeed != b.fanspeed) diff |= kAcFieldFanspeed;
+  if (a.swingv != b.swingv) diff |= kAcFieldSwingv;
+  if (a.swingh != b.swingh) diff |= kAcFieldSwingh;
+  if (a.quiet != b.quiet) diff |= kAcFieldQuiet;
+  if (a.turbo != b.turbo) diff |= kAcFieldTurbo;
+  if (a.econo != b.econo) diff |= kAcFieldEcono;
+  if (a.light != b.light) diff |= kAcFieldLight;
+  if (a.filter != b.filter) diff |= kAcFieldFilter;
+  if (a.clean != b.clean) diff |= kAcFieldClean;
+  if (a.beep != b.beep) diff |= kAcFieldBeep;
+  if (a.sleep != b.sleep) diff |= kAcFieldSleep;
+  if (a.clock != b.clock) diff |= kAcFieldClock;
+  return diff;
+}
+
+/// Look up what the IRac class can control for a given protocol & model.
+/// @note The table is generated from `sendAc()` by
+///   `tools/generate_ac_capabilities.py`. Re-run it when `sendAc()` changes.
+/// @param[in] protocol The vendor/protocol type.
+/// @param[in] model The model number, or `kAcAnyModel`.
+/// @param[out] result A Ptr to where to store the capabilities.
+/// @return true if the protocol is supported, otherwise false.
+bool IRac::getCapabilities(const decode_type_t protocol, const int16_t model,
+                           stdAc::capabilities_t *result) {
+  const stdAc::capabilities_t *found = NULL;
+  for (uint16_t i = 0; kAcCapabilities[i].protocol != UNKNOWN; i++) {
+    const stdAc::capabilities_t *entry = &kAcCapabilities[i];
+    if (entry->protocol != protocol) continue;
+    if (entry->model == model) {  // An exact match always wins.
+      found = entry;
+      break;
+    }
+    if (entry->model == kAcAnyModel && found == NULL) found = entry;
+  }
+  if (found == NULL) return false;
+  *result = *found;
+  result->model = model;
+  return true;
+}
+
+/// Apply a sparse update to the internal state (`next`).
+/// Fields the (possibly new) protocol doesn't use are left untouched, and the
+/// temperature is limited to what the protocol can be set to.
+/// @param[in] update The fields to change, and their new values.
+/// @return A mask of `kAcField*` bits of the fields that actually changed.
+///   i.e. Zero if there is nothing worth sending.
+uint32_t IRac::applyUpdate(const stdAc::update_t update) {
+  const stdAc::state_t &values = update.values;
+  stdAc::state_t desired = next;
+  if (update.fields & kAcFieldProtocol) desired.protocol = values.protocol;
+  if (update.fields & kAcFieldModel) desired.model = values.model;
+  stdAc::capabilities_t caps;
+  if (!getCapabilities(desired.protocol, desired.model, &caps)) return 0;
+  const uint32_t fields = update.fields & caps.fields;
+  if (fields & kAcFieldPower) desired.power = values.power;
+  if (fields & kAcFieldMode) desired.mode = values.mode;
+  if (fields & kAcFieldDegrees) desired.degrees = values.degrees;
+  if (fields & kAcFieldCelsius) desired.celsius = values.celsius;
+  if (fields & kAcFieldFanspeed) desired.fanspeed = values.fanspeed;
+  if (fields & kAcFieldSwingv) desired.swingv = values.swingv;
+  if (fields & kAcFieldSwingh) desired.swingh = values.swingh;
+  if (fields & kAcFieldQuiet) desired.quiet = values.quiet;
+  if (fields & kAcFieldTurbo) desired.turbo = values.turbo;
+  if (fields & kAcFieldEcono) desired.econo = values.econo;
+  if (fields & kAcFieldLight) desired.light = values.light;
+  if (fields & kAcFieldFilter) desired.filter = values.filter;
+  if (fields & kAcFieldClean) desired.clean = values.clean;
+  if (fields & kAcFieldBeep) desired.beep = values.beep;
+  if (fields & kAcFieldSleep) desired.sleep = values.sleep;
+  if (fields & kAcFieldClock) desired.clock = values.clock;
+  if ((fields & kAcFieldDegrees) && caps.minTemp < caps.maxTemp) {
+    const float degC = desired.celsius ? desired.degrees
+                                       : fahrenheitToCelsius(desired.degrees);
+    float limit = degC;
+    if (degC < caps.minTemp) limit = caps.minTemp;
+    if (degC > caps.maxTemp) limit = caps.maxTemp;
+    if (limit != degC)
+      desired.degrees = desired.celsius ? limit : celsiusToFahrenheit(limit);
+  }
+  const uint32_t changed = diffStates(next, desired);
+  next = desired;
+  return changed;
+}
+
+/// Apply a sparse update to the internal state, and send it if needed.
+/// Updates that only touch fields the protocol doesn't use, or that don't
+/// change anything, are dropped before any message is built.
+/// @param[in] update The fields to change, and their new values.
+/// @return true if a message was sent, false if it was dropped or unsupported.
+bool IRac::sendUpdate(const stdAc::update_t update) {
+  if (!applyUpdate(update)) return false;
+  return sendAc();
+}
+
 /// Convert the supplied str into the appropriate enum.
 /// @param[in] str A Ptr to a C-style string to be converted.
 /// @param[in] def The enum to return if no conversion was possible.
@@ -47,6 +47,47 @@
 
 // Constants
 const int8_t kGpioUnused = -1;  ///< A placeholder for not using an actual GPIO.
+const int16_t kAcAnyModel = -1;  ///< Matches every model of a protocol.
+
+// Bit masks for the fields of a `stdAc::state_t`.
+// Used by `stdAc::update_t` & `stdAc::capabilities_t`.
+const uint32_t kAcFieldProtocol = 1UL << 0;  ///< `state_t::protocol`
+const uint32_t kAcFieldModel =    1UL << 1;  ///< `state_t::model`
+const uint32_t kAcFieldPower =    1UL << 2;  ///< `state_t::power`
+const uint32_t kAcFieldMode =     1UL << 3;  ///< `state_t::mode`
+const uint32_t kAcFieldDegrees =  1UL << 4;  ///< `state_t::degrees`
+const uint32_t kAcFieldCelsius =  1UL << 5;  ///< `state_t::celsius`
+const uint32_t kAcFieldFanspeed = 1UL << 6;  ///< `state_t::fanspeed`
+const uint32_t kAcFieldSwingv =   1UL << 7;  ///< `state_t::swingv`
+const uint32_t kAcFieldSwingh =   1UL << 8;  ///< `state_t::swingh`
+const uint32_t kAcFieldQuiet =    1UL << 9;  ///< `state_t::quiet`
+const uint32_t kAcFieldTurbo =    1UL << 10;  ///< `state_t::turbo`
+const uint32_t kAcFieldEcono =    1UL << 11;  ///< `state_t::econo`
+const uint32_t kAcFieldLight =    1UL << 12;  ///< `state_t::light`
+const uint32_t kAcFieldFilter =   1UL << 13;  ///< `state_t::filter`
+const uint32_t kAcFieldClean =    1UL << 14;  ///< `state_t::clean`
+const uint32_t kAcFieldBeep =     1UL << 15;  ///< `state_t::beep`
+const uint32_t kAcFieldSleep =    1UL << 16;  ///< `state_t::sleep`
+const uint32_t kAcFieldClock =    1UL << 17;  ///< `state_t::clock`
+const uint32_t kAcFieldAll =     (1UL << 18) - 1;  ///< Every field.
+
+namespace stdAc {
+/// A sparse change to a `state_t`.
+/// Only the fields flagged in `fields` are taken from `values`.
+struct update_t {
+  uint32_t fields;  ///< Which fields to change. A mask of `kAcField*` bits.
+  state_t values;  ///< The new values for those fields.
+};
+
+/// What the IRac class can control for a given protocol (& model).
+struct capabilities_t {
+  decode_type_t protocol;  ///< The protocol these capabilities are for.
+  int16_t model;  ///< The model they are for, or `kAcAnyModel`.
+  uint32_t fields;  ///< The `state_t` fields that affect the message sent.
+  float minTemp;  ///< Lowest temperature (Celsius) the protocol can be set to.
+  float maxTemp;  ///< Highest temperature (Celsius) it can be set to.
+};
+};  // namespace stdAc
 
 // Class
 /// A universal/common/generic interface for controling supported A/Cs.
@@ -79,6 +120,12 @@ class IRac {
               const bool beep, const int16_t sleep = -1,
               const int16_t clock = -1);
   static bool cmpStates(const stdAc::state_t a, const stdAc::state_t b);
+  static uint32_t diffStates(const stdAc::state_t a, const stdAc::state_t b);
+  static bool getCapabilities(const decode_type_t protocol,
+                              const int16_t model,
+                              stdAc::capabilities_t *result);
+  uint32_t applyUpdate(const stdAc::update_t update);
+  bool sendUpdate(const stdAc::update_t update);
   static bool strToBool(const char *str, const bool def = false);
   static int16_t strToModel(const char *str, const int16_t def = -1);
   static stdAc::opmode_t strToOpmode(
@@ -0,0 +1,404 @@
+// Copyright 2026 IRremoteESP8266 authors
+// This header file is only to be included by 'IRac.cpp'.
+//
+// WARNING: Do not edit this file! This file is automatically generated by
+//          '../tools/generate_ac_capabilities.py'.
+
+#ifndef IRAC_CAPABILITIES_H_
+#define IRAC_CAPABILITIES_H_
+
+#include "IRac.h"
+
+/// The fields & temperature ranges each A/C protocol honours.
+/// A model of kAcAnyModel applies to every model of the protocol.
+const stdAc::capabilities_t kAcCapabilities[] = {
+#if SEND_AIRWELL
+  {decode_type_t::AIRWELL, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed,
+    kAirwellMinTemp, kAirwellMaxTemp},
+#endif  // SEND_AIRWELL
+#if SEND_AMCOR
+  {decode_type_t::AMCOR, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed,
+    kAmcorMinTemp, kAmcorMaxTemp},
+#endif  // SEND_AMCOR
+#if SEND_ARGO
+  {decode_type_t::ARGO, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo |
+    kAcFieldSleep,
+    kArgoMinTemp, kArgoMaxTemp},
+#endif  // SEND_ARGO
+#if SEND_CARRIER_AC64
+  {decode_type_t::CARRIER_AC64, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSleep,
+    kCarrierAc64MinTemp, kCarrierAc64MaxTemp},
+#endif  // SEND_CARRIER_AC64
+#if SEND_COOLIX
+  {decode_type_t::COOLIX, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldTurbo | kAcFieldLight | kAcFieldClean | kAcFieldSleep,
+    kCoolixTempMin, kCoolixTempMax},
+#endif  // SEND_COOLIX
+#if SEND_CORONA_AC
+  {decode_type_t::CORONA_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldEcono,
+    kCoronaAcMinTemp, kCoronaAcMaxTemp},
+#endif  // SEND_CORONA_AC
+#if SEND_DAIKIN
+  {decode_type_t::DAIKIN, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldQuiet | kAcFieldTurbo | kAcFieldEcono | kAcFieldClean,
+    kDaikinMinTemp, kDaikinMaxTemp},
+#endif  // SEND_DAIKIN
+#if SEND_DAIKIN128
+  {decode_type_t::DAIKIN128, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldQuiet |
+    kAcFieldTurbo | kAcFieldEcono | kAcFieldLight | kAcFieldSleep |
+    kAcFieldClock,
+    kDaikin128MinTemp, kDaikin128MaxTemp},
+#endif  // SEND_DAIKIN128
+#if SEND_DAIKIN152
+  {decode_type_t::DAIKIN152, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldQuiet |
+    kAcFieldTurbo | kAcFieldEcono,
+    kDaikinMinTemp, kDaikinMaxTemp},
+#endif  // SEND_DAIKIN152
+#if SEND_DAIKIN160
+  {decode_type_t::DAIKIN160, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv,
+    kDaikinMinTemp, kDaikinMaxTemp},
+#endif  // SEND_DAIKIN160
+#if SEND_DAIKIN176
+  {decode_type_t::DAIKIN176, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingh,
+    kDaikinMinTemp, kDaikinMaxTemp},
+#endif  // SEND_DAIKIN176
+#if SEND_DAIKIN2
+  {decode_type_t::DAIKIN2, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldQuiet | kAcFieldTurbo | kAcFieldEcono | kAcFieldLight |
+    kAcFieldFilter | kAcFieldClean | kAcFieldBeep | kAcFieldSleep |
+    kAcFieldClock,
+    kDaikinMinTemp, kDaikinMaxTemp},
+#endif  // SEND_DAIKIN2
+#if SEND_DAIKIN216
+  {decode_type_t::DAIKIN216, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldQuiet | kAcFieldTurbo,
+    kDaikinMinTemp, kDaikinMaxTemp},
+#endif  // SEND_DAIKIN216
+#if SEND_DAIKIN64
+  {decode_type_t::DAIKIN64, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldQuiet |
+    kAcFieldTurbo | kAcFieldSleep | kAcFieldClock,
+    kDaikin64MinTemp, kDaikin64MaxTemp},
+#endif  // SEND_DAIKIN64
+#if SEND_DELONGHI_AC
+  {decode_type_t::DELONGHI_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldTurbo | kAcFieldSleep,
+    kDelonghiAcTempMinC, kDelonghiAcTempMaxC},
+#endif  // SEND_DELONGHI_AC
+#if SEND_ECOCLIM
+  {decode_type_t::ECOCLIM, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldClock,
+    kEcoclimTempMin, kEcoclimTempMax},
+#endif  // SEND_ECOCLIM
+#if SEND_ELECTRA_AC
+  {decode_type_t::ELECTRA_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldTurbo | kAcFieldLight | kAcFieldClean,
+    kElectraAcMinTemp, kElectraAcMaxTemp},
+#endif  // SEND_ELECTRA_AC
+#if SEND_FUJITSU_AC
+  {decode_type_t::FUJITSU_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldSwingh | kAcFieldQuiet | kAcFieldTurbo | kAcFieldEcono |
+    kAcFieldFilter | kAcFieldClean,
+    kFujitsuAcMinTemp, kFujitsuAcMaxTemp},
+#endif  // SEND_FUJITSU_AC
+#if SEND_GOODWEATHER
+  {decode_type_t::GOODWEATHER, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo |
+    kAcFieldLight | kAcFieldSleep,
+    kGoodweatherTempMin, kGoodweatherTempMax},
+#endif  // SEND_GOODWEATHER
+#if SEND_GREE
+  {decode_type_t::GREE, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldTurbo | kAcFieldLight | kAcFieldClean | kAcFieldSleep,
+    kGreeMinTempC, kGreeMaxTempC},
+#endif  // SEND_GREE
+#if SEND_HAIER_AC
+  {decode_type_t::HAIER_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldFilter |
+    kAcFieldSleep | kAcFieldClock,
+    kHaierAcMinTemp, kHaierAcMaxTemp},
+#endif  // SEND_HAIER_AC
+#if SEND_HAIER_AC176
+  {decode_type_t::HAIER_AC176, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo |
+    kAcFieldFilter | kAcFieldSleep,
+    kHaierAcMinTemp, kHaierAcMaxTemp},
+#endif  // SEND_HAIER_AC176
+#if SEND_HAIER_AC_YRW02
+  {decode_type_t::HAIER_AC_YRW02, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo |
+    kAcFieldFilter | kAcFieldSleep,
+    kHaierAcMinTemp, kHaierAcMaxTemp},
+#endif  // SEND_HAIER_AC_YRW02
+#if SEND_HITACHI_AC
+  {decode_type_t::HITACHI_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh,
+    kHitachiAcMinTemp, kHitachiAcMaxTemp},
+#endif  // SEND_HITACHI_AC
+#if SEND_HITACHI_AC1
+  {decode_type_t::HITACHI_AC1, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldSwingh | kAcFieldSleep,
+    kHitachiAcMinTemp, kHitachiAcMaxTemp},
+#endif  // SEND_HITACHI_AC1
+#if SEND_HITACHI_AC344
+  {decode_type_t::HITACHI_AC344, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh,
+    kHitachiAc344MinTemp, kHitachiAc344MaxTemp},
+#endif  // SEND_HITACHI_AC344
+#if SEND_HITACHI_AC424
+  {decode_type_t::HITACHI_AC424, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv,
+    kHitachiAc424MinTemp, kHitachiAc424MaxTemp},
+#endif  // SEND_HITACHI_AC424
+#if SEND_KELON
+  {decode_type_t::KELON, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo | kAcFieldSleep,
+    kKelonMinTemp, kKelonMaxTemp},
+#endif  // SEND_KELON
+#if SEND_KELVINATOR
+  {decode_type_t::KELVINATOR, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldQuiet | kAcFieldTurbo | kAcFieldLight | kAcFieldFilter |
+    kAcFieldClean,
+    kKelvinatorMinTemp, kKelvinatorMaxTemp},
+#endif  // SEND_KELVINATOR
+#if SEND_LG
+  {decode_type_t::LG, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldLight,
+    kLgAcMinTemp, kLgAcMaxTemp},
+  {decode_type_t::LG2, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldLight,
+    kLgAcMinTemp, kLgAcMaxTemp},
+#endif  // SEND_LG
+#if SEND_MIDEA
+  {decode_type_t::MIDEA, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo |
+    kAcFieldEcono | kAcFieldLight | kAcFieldSleep,
+    kMideaACMinTempC, kMideaACMaxTempC},
+#endif  // SEND_MIDEA
+#if SEND_MITSUBISHI_AC
+  {decode_type_t::MITSUBISHI_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldQuiet | kAcFieldClock,
+    kMitsubishiAcMinTemp, kMitsubishiAcMaxTemp},
+#endif  // SEND_MITSUBISHI_AC
+#if SEND_MITSUBISHI112
+  {decode_type_t::MITSUBISHI112, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldQuiet,
+    kMitsubishi112MinTemp, kMitsubishi112MaxTemp},
+#endif  // SEND_MITSUBISHI112
+#if SEND_MITSUBISHI136
+  {decode_type_t::MITSUBISHI136, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldQuiet,
+    kMitsubishi136MinTemp, kMitsubishi136MaxTemp},
+#endif  // SEND_MITSUBISHI136
+#if SEND_MITSUBISHIHEAVY
+  {decode_type_t::MITSUBISHI_HEAVY_88, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldTurbo | kAcFieldEcono | kAcFieldClean,
+    kMitsubishiHeavyMinTemp, kMitsubishiHeavyMaxTemp},
+#endif  // SEND_MITSUBISHIHEAVY
+#if SEND_MITSUBISHIHEAVY
+  {decode_type_t::MITSUBISHI_HEAVY_152, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldQuiet | kAcFieldTurbo | kAcFieldEcono | kAcFieldFilter |
+    kAcFieldClean | kAcFieldSleep,
+    kMitsubishiHeavyMinTemp, kMitsubishiHeavyMaxTemp},
+#endif  // SEND_MITSUBISHIHEAVY
+#if SEND_NEOCLIMA
+  {decode_type_t::NEOCLIMA, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh |
+    kAcFieldTurbo | kAcFieldEcono | kAcFieldLight | kAcFieldFilter |
+    kAcFieldSleep,
+    kNeoclimaMinTempC, kNeoclimaMaxTempC},
+#endif  // SEND_NEOCLIMA
+#if SEND_PANASONIC_AC
+  {decode_type_t::PANASONIC_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldSwingh | kAcFieldQuiet | kAcFieldTurbo | kAcFieldClock,
+    kPanasonicAcMinTemp, kPanasonicAcMaxTemp},
+#endif  // SEND_PANASONIC_AC
+#if SEND_PANASONIC_AC32
+  {decode_type_t::PANASONIC_AC32, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh,
+    kPanasonicAcMinTemp, kPanasonicAcMaxTemp},
+#endif  // SEND_PANASONIC_AC32
+#if SEND_RHOSS
+  {decode_type_t::RHOSS, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv,
+    kRhossTempMin, kRhossTempMax},
+#endif  // SEND_RHOSS
+#if SEND_SAMSUNG_AC
+  {decode_type_t::SAMSUNG_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldQuiet |
+    kAcFieldTurbo | kAcFieldLight | kAcFieldFilter | kAcFieldClean |
+    kAcFieldBeep,
+    kSamsungAcMinTemp, kSamsungAcMaxTemp},
+#endif  // SEND_SAMSUNG_AC
+#if SEND_SANYO_AC
+  {decode_type_t::SANYO_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldBeep |
+    kAcFieldSleep,
+    kSanyoAcTempMin, kSanyoAcTempMax},
+#endif  // SEND_SANYO_AC
+#if SEND_SANYO_AC88
+  {decode_type_t::SANYO_AC88, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo |
+    kAcFieldFilter | kAcFieldSleep | kAcFieldClock,
+    kSanyoAc88TempMin, kSanyoAc88TempMax},
+#endif  // SEND_SANYO_AC88
+#if SEND_SHARP_AC
+  {decode_type_t::SHARP_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldTurbo | kAcFieldLight | kAcFieldFilter | kAcFieldClean,
+    kSharpAcMinTemp, kSharpAcMaxTemp},
+#endif  // SEND_SHARP_AC
+#if (SEND_TCL112AC || SEND_TEKNOPOINT)
+  {decode_type_t::TCL112AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldSwingh | kAcFieldQuiet | kAcFieldTurbo | kAcFieldEcono |
+    kAcFieldLight | kAcFieldFilter,
+    kTcl112AcTempMin, kTcl112AcTempMax},
+  {decode_type_t::TEKNOPOINT, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldSwingh | kAcFieldQuiet | kAcFieldTurbo | kAcFieldEcono |
+    kAcFieldLight | kAcFieldFilter,
+    kTcl112AcTempMin, kTcl112AcTempMax},
+#endif  // (SEND_TCL112AC || SEND_TEKNOPOINT)
+#if SEND_TECHNIBEL_AC
+  {decode_type_t::TECHNIBEL_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSleep,
+    kTechnibelAcTempMinC, kTechnibelAcTempMaxC},
+#endif  // SEND_TECHNIBEL_AC
+#if SEND_TECO
+  {decode_type_t::TECO, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldLight |
+    kAcFieldSleep,
+    kTecoMinTemp, kTecoMaxTemp},
+#endif  // SEND_TECO
+#if SEND_TOSHIBA_AC
+  {decode_type_t::TOSHIBA_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo |
+    kAcFieldEcono,
+    kToshibaAcMinTemp, kToshibaAcMaxTemp},
+#endif  // SEND_TOSHIBA_AC
+#if SEND_TROTEC
+  {decode_type_t::TROTEC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSleep,
+    kTrotecMinTemp, kTrotecMaxTemp},
+#endif  // SEND_TROTEC
+#if SEND_TROTEC_3550
+  {decode_type_t::TROTEC_3550, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv,
+    kTrotec3550MinTempC, kTrotec3550MaxTempC},
+#endif  // SEND_TROTEC_3550
+#if SEND_TRUMA
+  {decode_type_t::TRUMA, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldQuiet,
+    kTrumaMinTemp, kTrumaMaxTemp},
+#endif  // SEND_TRUMA
+#if SEND_VESTEL_AC
+  {decode_type_t::VESTEL_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldTurbo |
+    kAcFieldFilter | kAcFieldSleep | kAcFieldClock,
+    kVestelAcMinTempC, kVestelAcMaxTemp},
+#endif  // SEND_VESTEL_AC
+#if SEND_VOLTAS
+  {decode_type_t::VOLTAS, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldSwingh | kAcFieldTurbo | kAcFieldEcono | kAcFieldLight |
+    kAcFieldSleep,
+    kVoltasMinTemp, kVoltasMaxTemp},
+#endif  // SEND_VOLTAS
+#if SEND_WHIRLPOOL_AC
+  {decode_type_t::WHIRLPOOL_AC, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldModel | kAcFieldPower | kAcFieldMode |
+    kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv |
+    kAcFieldTurbo | kAcFieldLight | kAcFieldSleep | kAcFieldClock,
+    kWhirlpoolAcMinTemp, kWhirlpoolAcMaxTemp},
+#endif  // SEND_WHIRLPOOL_AC
+#if SEND_TRANSCOLD
+  {decode_type_t::TRANSCOLD, kAcAnyModel,
+    kAcFieldProtocol | kAcFieldPower | kAcFieldMode | kAcFieldDegrees |
+    kAcFieldCelsius | kAcFieldFanspeed | kAcFieldSwingv | kAcFieldSwingh,
+    kTranscoldTempMin, kTranscoldTempMax},
+#endif  // SEND_TRANSCOLD
+  {decode_type_t::UNKNOWN, kAcAnyModel, 0, 0, 0}  // End marker.
+};
+
+#endif  // IRAC_CAPABILITIES_H_
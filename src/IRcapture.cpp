@@ -0,0 +1,191 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Alternative IR capture drivers for the IRrecv class.
+/// @see IRCaptureDriver
+
+#include "IRcapture.h"
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#include <algorithm>
+#ifdef UNIT_TEST
+#include <fstream>
+#include <sstream>
+#endif  // UNIT_TEST
+
+#if defined(ESP32)
+// Start of IRRmtCaptureDriver class -------------------
+
+/// Class constructor
+/// @param[in] recvpin The GPIO pin the IR receiver module's data pin is
+///   connected to.
+/// @param[in] timeout Nr. of milli-Seconds of no signal before we consider the
+///   message finished. Limited to what the RMT peripheral can measure. (~32ms)
+/// @param[in] channel The RMT channel to capture with.
+IRRmtCaptureDriver::IRRmtCaptureDriver(const uint16_t recvpin,
+                                       const uint8_t timeout,
+                                       const uint8_t channel)
+    : _recvpin(recvpin), _channel(static_cast<rmt_channel_t>(channel)),
+      _ringbuf(NULL), _running(false) {
+  _idle = std::min((uint32_t)MS_TO_USEC(timeout), (uint32_t)kRmtCaptureMaxIdle);
+}
+
+/// Install the RMT driver & start capturing.
+/// @param[in] pullup Should the GPIO use the internal pullup resistor?
+void IRRmtCaptureDriver::start(const bool pullup) {
+  if (_running) return;
+  pinMode(_recvpin, pullup ? INPUT_PULLUP : INPUT);
+  rmt_config_t config = {};
+  config.rmt_mode = RMT_MODE_RX;
+  config.channel = _channel;
+  config.gpio_num = static_cast<gpio_num_t>(_recvpin);
+  config.clk_div = 80;  // 80MHz / 80 = 1 uSec per tick.
+  config.mem_block_num = 4;  // Enough for ~256 edges before we must drain.
+  config.rx_config.filter_en = true;
+  config.rx_config.filter_ticks_thresh = 100;  // Ignore glitches < 1.25us.
+  config.rx_config.idle_threshold = _idle;
+  if (rmt_config(&config) != ESP_OK) return;
+  if (rmt_driver_install(_channel, kRmtCaptureRingBufSize, 0) != ESP_OK) return;
+  rmt_get_ringbuf_handle(_channel, &_ringbuf);
+  rmt_rx_start(_channel, true);
+  _running = true;
+}
+
+/// Stop capturing & uninstall the RMT driver.
+void IRRmtCaptureDriver::stop(void) {
+  if (!_running) return;
+  rmt_rx_stop(_channel);
+  rmt_driver_uninstall(_channel);
+  _ringbuf = NULL;
+  _running = false;
+}
+
+/// Hand any message the RMT peripheral has finished capturing to the receiver.
+void IRRmtCaptureDriver::poll(void) {
+  // Leave it in the ring buffer if the last message hasn't been decoded yet.
+  if (!_running || _ringbuf == NULL || !ready()) return;
+  size_t size = 0;
+  rmt_item32_t *items = static_cast<rmt_item32_t *>(
+      xRingbufferReceive(_ringbuf, &size, 0));
+  if (items == NULL) return;
+  const size_t nitems = size / sizeof(rmt_item32_t);
+  uint16_t block[kCaptureBlockSize];
+  uint16_t used = 0;
+  bool done = false;
+  for (size_t i = 0; i < nitems && !done; i++) {
+    const uint16_t pair[2] = {items[i].duration0, items[i].duration1};
+    for (uint8_t j = 0; j < 2; j++) {
+      if (pair[j] == 0) {  // A zero duration marks the end of the message.
+        done = true;
+        break;
+      }
+      block[used++] = pair[j];
+      if (used == kCaptureBlockSize) {
+        deliver(block, used, false);
+        used = 0;
+      }
+    }
+  }
+  deliver(block, used, true);
+  vRingbufferReturnItem(_ringbuf, items);
+}
+#endif  // ESP32
+
+#ifdef UNIT_TEST
+// Start of IRMockCaptureDriver class -------------------
+
+/// Class constructor
+/// @param[in] block_size Max nr. of durations to hand to the receiver in each
+///   `deliver()` call.
+IRMockCaptureDriver::IRMockCaptureDriver(const uint16_t block_size)
+    : _block_size(std::max(block_size, (uint16_t)1)), _running(false),
+      _blocks(0) {}
+
+/// Start "capturing". i.e. Allow queued messages to be delivered.
+/// @param[in] pullup Unused.
+void IRMockCaptureDriver::start(const bool pullup __attribute__((unused))) {
+  _running = true;
+}
+
+/// Stop "capturing". Queued messages are kept.
+void IRMockCaptureDriver::stop(void) { _running = false; }
+
+/// Is the driver running? i.e. Has the receiver started it?
+/// @return true if it is, otherwise false.
+bool IRMockCaptureDriver::isRunning(void) { return _running; }
+
+/// Hand the next queued message to the receiver, if it is ready for one.
+void IRMockCaptureDriver::poll(void) {
+  if (!_running || _frames.empty() || !ready()) return;
+  const std::vector<uint16_t> &frame = _frames.front();
+  const uint16_t len = frame.size();
+  uint16_t offset = 0;
+  do {
+    const uint16_t count = std::min((uint16_t)(len - offset), _block_size);
+    deliver(frame.data() + offset, count, offset + count >= len);
+    _blocks++;
+    offset += count;
+  } while (offset < len);
+  _frames.pop_front();
+}
+
+/// Queue a message to be delivered.
+/// @param[in] usecs An array of alternating mark & space durations in uSecs,
+///   starting with a mark.
+/// @param[in] len Nr. of entries in the array.
+void IRMockCaptureDriver::addFrame(const uint16_t *usecs, const uint16_t len) {
+  if (len) _frames.push_back(std::vector<uint16_t>(usecs, usecs + len));
+}
+
+/// Queue the messages described in some text.
+/// Durations are in microseconds, separated by commas and/or whitespace.
+/// A blank line ends a message. Anything after a '#' on a line is ignored.
+/// e.g. The output of a `rawData[]` array from `resultToSourceCode()`.
+/// @param[in] text The text to parse.
+/// @return The nr. of messages queued.
+uint16_t IRMockCaptureDriver::loadString(const std::string text) {
+  std::istringstream lines(text);
+  std::string line;
+  std::vector<uint16_t> frame;
+  uint16_t added = 0;
+  while (true) {
+    const bool more = static_cast<bool>(std::getline(lines, line));
+    line = line.substr(0, line.find('#'));
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream fields(line);
+    uint32_t value;
+    bool blank = true;
+    while (fields >> value) {
+      frame.push_back(std::min(value, (uint32_t)UINT16_MAX));
+      blank = false;
+    }
+    if ((blank || !more) && !frame.empty()) {
+      addFrame(frame.data(), frame.size());
+      frame.clear();
+      added++;
+    }
+    if (!more) return added;
+  }
+}
+
+/// Queue the messages stored in a file.
+/// @param[in] filename The file to read. See `loadString()` for the format.
+/// @return true if the file could be read, otherwise false.
+bool IRMockCaptureDriver::loadFile(const std::string filename) {
+  std::ifstream file(filename.c_str());
+  if (!file.is_open()) return false;
+  std::stringstream contents;
+  contents << file.rdbuf();
+  loadString(contents.str());
+  return true;
+}
+
+/// How many messages are queued & waiting to be delivered?
+/// @return The nr. of queued messages.
+uint16_t IRMockCaptureDriver::framesPending(void) { return _frames.size(); }
+
+/// How many blocks have been handed to the receiver?
+/// @return The nr. of `deliver()` calls made so far.
+uint32_t IRMockCaptureDriver::getBlocksDelivered(void) { return _blocks; }
+#endif  // UNIT_TEST
@@ -0,0 +1,81 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Alternative IR capture drivers for the IRrecv class.
+/// @see IRCaptureDriver
+
+#ifndef IRCAPTURE_H_
+#define IRCAPTURE_H_
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#ifdef UNIT_TEST
+#include <deque>
+#include <string>
+#include <vector>
+#endif  // UNIT_TEST
+#if defined(ESP32)
+#include <driver/rmt.h>
+#endif  // ESP32
+#include "IRremoteESP8266.h"
+#include "IRrecv.h"
+
+// Constants
+/// Nr. of durations handed to the receiver per `deliver()` call.
+const uint16_t kCaptureBlockSize = 64;
+/// Default RMT channel to use for capturing. (ESP32 Only)
+const uint8_t kDefaultRmtCaptureChannel = 4;
+/// Size (in bytes) of the RMT driver's receive ring buffer. (ESP32 Only)
+const uint16_t kRmtCaptureRingBufSize = 2048;
+/// Max. idle time (in usecs) the RMT peripheral can measure at 1us per tick.
+const uint16_t kRmtCaptureMaxIdle = 0x7FFF;
+
+#if defined(ESP32)
+/// A peripheral based capture driver for the ESP32.
+/// The RMT peripheral timestamps every edge in hardware & delivers a whole
+/// message at a time, so there is no interrupt per edge, and the receiver only
+/// sees one `deliver()` call per block of durations.
+class IRRmtCaptureDriver : public IRCaptureDriver {
+ public:
+  explicit IRRmtCaptureDriver(
+      const uint16_t recvpin, const uint8_t timeout = kTimeoutMs,
+      const uint8_t channel = kDefaultRmtCaptureChannel);
+  void start(const bool pullup);
+  void stop(void);
+  void poll(void);
+
+ private:
+  uint16_t _recvpin;  ///< The GPIO the IR demodulator is connected to.
+  uint16_t _idle;  ///< Nr. of usecs of no signal that ends a message.
+  rmt_channel_t _channel;  ///< The RMT channel we are using.
+  RingbufHandle_t _ringbuf;  ///< Where the RMT driver puts captured items.
+  bool _running;  ///< Is the RMT driver installed & running?
+};
+#endif  // ESP32
+
+#ifdef UNIT_TEST
+/// A host based capture driver that replays recorded edge streams.
+/// Messages are queued (from files or memory) & handed to the receiver, in
+/// blocks, one message per `IRrecv::decode()` call.
+class IRMockCaptureDriver : public IRCaptureDriver {
+ public:
+  explicit IRMockCaptureDriver(const uint16_t block_size = kCaptureBlockSize);
+  void start(const bool pullup);
+  void stop(void);
+  void poll(void);
+  bool loadFile(const std::string filename);
+  uint16_t loadString(const std::string text);
+  void addFrame(const uint16_t *usecs, const uint16_t len);
+  uint16_t framesPending(void);
+  uint32_t getBlocksDelivered(void);
+  bool isRunning(void);
+
+ private:
+  uint16_t _block_size;  ///< Max nr. of entries per `deliver()` call.
+  bool _running;  ///< Has the receiver started us?
+  uint32_t _blocks;  ///< Nr. of `deliver()` calls made so far.
+  std::deque<std::vector<uint16_t> > _frames;  ///< Queued messages.
+};
+#endif  // UNIT_TEST
+
+#endif  // IRCAPTURE_H_
@@ -0,0 +1,659 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief A content-addressed store of learned raw codes, & a delta sync
+///   protocol to share them between IR bridges ("nodes").
+/// @see IRCodeStore
+
+#include "IRcodes.h"
+#include <stdlib.h>
+#include <string.h>
+#include "IRutils.h"
+
+// Topics, relative to the base topic.
+const char kCodeManifestTopic[] = "manifest/";
+const char kCodeWantTopic[] = "want";
+const char kCodeCodeTopic[] = "code/";
+
+/// Is a name usable as a node name?
+/// @param[in] name The name.
+/// @return true if it is, otherwise false.
+static bool validName(const char *name) {
+  // Manifests & requests separate their fields with ':', & lists with ','.
+  return irutils::validTopicName(name, kCodeMaxNameLength, ",:");
+}
+
+/// Parse a hexadecimal code id.
+/// @param[in] str The text. e.g. "0123456789abcdef"
+/// @param[out] id Where to store the id. kCodeNoId if it isn't valid.
+/// @return A ptr to the first character after the id.
+static const char *parseId(const char *str, uint64_t *id) {
+  uint64_t value = 0;
+  uint8_t digits = 0;
+  for (; *str; str++, digits++) {
+    char c = *str;
+    uint8_t nibble;
+    if (c >= '0' && c <= '9')
+      nibble = c - '0';
+    else if (c >= 'a' && c <= 'f')
+      nibble = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      nibble = c - 'A' + 10;
+    else
+      break;
+    value = (value << 4) | nibble;
+  }
+  *id = (digits && digits <= 16) ? value : kCodeNoId;
+  return str;
+}
+
+/// Parse the header of a manifest. i.e. "<count>:<digest>:"
+/// @param[in] manifest The manifest.
+/// @param[out] count Where to store the nr. of codes in it.
+/// @param[out] digest Where to store its digest.
+/// @return A ptr to the first id, or NULL if it isn't a valid manifest.
+static const char *parseManifest(const char *manifest, uint16_t *count,
+                                 uint64_t *digest) {
+  if (manifest == NULL) return NULL;
+  char *end;
+  const uint32_t n = strtoul(manifest, &end, 10);
+  if (end == manifest || *end != ':' || n > UINT16_MAX) return NULL;
+  *count = n;
+  const char *next = parseId(end + 1, digest);
+  if (*digest == kCodeNoId && n) return NULL;
+  if (*next != ':') return NULL;
+  return next + 1;
+}
+
+/// Class constructor
+/// @param[in] node This node's name. Unique within the fleet. It can't
+///   contain '/', '+', '#', ',' or ':'.
+/// @param[in] base_topic The topic the sync messages live under.
+///   e.g. "ir_server/codes"
+/// @param[in] max_codes The max. nr. of codes to store.
+/// @param[in] max_pending The max. nr. of codes we can be asking for or
+///   about to send at once.
+/// @param[in] manifest_ms Nr. of milli-seconds between re-publishing our
+///   manifest, even if it hasn't changed. So a lost message can't stop the
+///   fleet converging.
+IRCodeStore::IRCodeStore(const char *node, const char *base_topic,
+                         const uint16_t max_codes, const uint16_t max_pending,
+                         const uint32_t manifest_ms)
+    : _base(base_topic), _capacity(max_codes), _nr_codes(0),
+      _max_pending(max_pending), _manifest_ms(manifest_ms), _now(0),
+      _last_manifest(0), _changed(true), _publish(NULL), _publish_arg(NULL) {
+  _node[0] = '\0';
+  if (validName(node)) strncpy(_node, node, sizeof(_node));
+  // Seed the random delays from our name, so each node's differ.
+  _seed = 2166136261UL;
+  for (const char *c = _node; *c; c++)
+    _seed = (_seed ^ (uint8_t)*c) * 16777619UL;
+  _codes = new code_t[_capacity];
+  if (_codes == NULL) {
+    DPRINTLN("Could not allocate memory for the code store.");
+    _capacity = 0;
+  }
+  _pending = new pending_t[_max_pending];
+  if (_pending == NULL) {
+    DPRINTLN("Could not allocate memory for the code store's pending list.");
+    _max_pending = 0;
+  }
+  for (uint16_t i = 0; i < _max_pending; i++) _pending[i].used = false;
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+/// Class destructor
+IRCodeStore::~IRCodeStore(void) {
+  for (uint16_t i = 0; i < _nr_codes; i++) delete[] _codes[i].packed;
+  delete[] _codes;
+  delete[] _pending;
+}
+
+/// Add a raw code. (As learned. e.g. From `resultToRawArray()`.)
+/// @param[in] name What to call it. (Max. kCodeMaxNameLength chars.)
+/// @param[in] raw An array of durations (microseconds). Marks then spaces.
+/// @param[in] len Nr. of elements in the raw[] array.
+/// @param[in] hz Its modulation frequency.
+/// @return Its id, or kCodeNoId if it couldn't be added.
+uint64_t IRCodeStore::add(const char *name, const uint16_t raw[],
+                          const uint16_t len, const uint16_t hz) {
+  uint8_t packed[kCodeMaxBytes];
+  const uint16_t nbytes = packRawData(raw, len, packed, kCodeMaxBytes);
+  if (nbytes > kCodeMaxBytes) return kCodeNoId;
+  return addPacked(name, packed, nbytes, hz);
+}
+
+/// Add a code that has already been packed by `packRawData()`.
+/// @param[in] name What to call it. (Max. kCodeMaxNameLength chars.)
+/// @param[in] packed The packed timings.
+/// @param[in] nbytes Nr. of bytes in the packed[] array.
+/// @param[in] hz Its modulation frequency.
+/// @return Its id, or kCodeNoId if it couldn't be added. If we already have
+///   the same code (under any name) its id is returned.
+uint64_t IRCodeStore::addPacked(const char *name, const uint8_t packed[],
+                                const uint16_t nbytes, const uint16_t hz) {
+  if (name == NULL || strlen(name) > kCodeMaxNameLength) return kCodeNoId;
+  const uint64_t id = hash(packed, nbytes, hz);
+  if (id == kCodeNoId) return kCodeNoId;
+  if (find(id) >= 0) return id;
+  return insert(name, packed, nbytes, hz, id) >= 0 ? id : kCodeNoId;
+}
+
+/// Remove a code.
+/// @note Only this node's copy is removed. Other nodes that have it will
+///   hand it back unless they remove it too.
+/// @param[in] id The code's id.
+/// @return true if it was removed, false if we didn't have it.
+bool IRCodeStore::remove(const uint64_t id) {
+  const int16_t index = find(id);
+  if (index < 0) return false;
+  delete[] _codes[index].packed;
+  memmove(&_codes[index], &_codes[index + 1],
+          (_nr_codes - index - 1) * sizeof(code_t));
+  _nr_codes--;
+  _changed = true;
+  return true;
+}
+
+/// Find a code by id.
+/// @param[in] id The code's id.
+/// @return The code's index, or -1 if we don't have it.
+int16_t IRCodeStore::find(const uint64_t id) {
+  // The codes are sorted by id, so a binary search will do.
+  int32_t low = 0;
+  int32_t high = static_cast<int32_t>(_nr_codes) - 1;
+  while (low <= high) {
+    const int32_t mid = (low + high) / 2;
+    if (_codes[mid].id == id) return mid;
+    if (_codes[mid].id < id)
+      low = mid + 1;
+    else
+      high = mid - 1;
+  }
+  return -1;
+}
+
+/// Find a code by name.
+/// @param[in] name The code's name.
+/// @return The index of the first code with that name, or -1 if none.
+int16_t IRCodeStore::findName(const char *name) {
+  if (name == NULL) return -1;
+  for (uint16_t i = 0; i < _nr_codes; i++)
+    if (strcmp(_codes[i].name, name) == 0) return i;
+  return -1;
+}
+
+/// Get the nr. of codes stored.
+/// @return The nr. of codes.
+uint16_t IRCodeStore::count(void) { return _nr_codes; }
+
+/// Get a code's id.
+/// @param[in] index The code's index. (0 to `count()` - 1)
+/// @return The id, or kCodeNoId if the index is invalid.
+uint64_t IRCodeStore::getId(const int16_t index) {
+  return (index >= 0 && index < _nr_codes) ? _codes[index].id : kCodeNoId;
+}
+
+/// Get a code's name.
+/// @param[in] index The code's index. (0 to `count()` - 1)
+/// @return The name, or NULL if the index is invalid.
+const char *IRCodeStore::getName(const int16_t index) {
+  return (index >= 0 && index < _nr_codes) ? _codes[index].name : NULL;
+}
+
+/// Get a code's modulation frequency.
+/// @param[in] index The code's index. (0 to `count()` - 1)
+/// @return The frequency, or 0 if the index is invalid.
+uint16_t IRCodeStore::getHz(const int16_t index) {
+  return (index >= 0 && index < _nr_codes) ? _codes[index].hz : 0;
+}
+
+/// Get a code's timings, in `sendRaw()` format.
+/// @param[in] index The code's index. (0 to `count()` - 1)
+/// @param[out] raw Where to store the durations. NULL to just count them.
+/// @param[in] size Nr. of elements the raw[] array can hold.
+/// @return The nr. of durations in the code, or 0 if the index is invalid.
+uint16_t IRCodeStore::getRaw(const int16_t index, uint16_t *raw,
+                             const uint16_t size) {
+  if (index < 0 || index >= _nr_codes) return 0;
+  return unpackRawData(_codes[index].packed, _codes[index].nbytes, raw, size);
+}
+
+/// Send a code.
+/// @param[in] irsend A Ptr to the IRsend object to send it with.
+/// @param[in] id The code's id.
+/// @return true if it was sent, false if we don't have it.
+bool IRCodeStore::send(IRsend *irsend, const uint64_t id) {
+  const int16_t index = find(id);
+  if (irsend == NULL || index < 0) return false;
+  // `pgm_read_byte()` reads RAM just as well on the ESP8266 & ESP32, so the
+  // packed timings don't need unpacking first.
+  irsend->sendRawPacked_P(_codes[index].packed, _codes[index].nbytes,
+                          _codes[index].hz);
+  return true;
+}
+
+/// Get a digest of all the codes we have. Stores with the same codes have
+/// the same digest, whatever order the codes were added in.
+/// @return The digest.
+uint64_t IRCodeStore::getDigest(void) {
+  uint64_t digest = 0;
+  for (uint16_t i = 0; i < _nr_codes; i++) digest += _codes[i].id;
+  return digest;
+}
+
+/// Get our manifest. i.e. "<count>:<digest>:<id>,<id>,..."
+/// @return The manifest.
+String IRCodeStore::getManifest(void) {
+  String manifest = "";
+  manifest.reserve(_nr_codes * 17 + 24);
+  manifest += uint64ToString(_nr_codes);
+  manifest += ':';
+  manifest += idToString(getDigest());
+  manifest += ':';
+  for (uint16_t i = 0; i < _nr_codes; i++) {
+    if (i) manifest += ',';
+    manifest += idToString(_codes[i].id);
+  }
+  return manifest;
+}
+
+/// Find the codes in another node's manifest that we don't have.
+/// @param[in] manifest The other node's manifest. (See `getManifest()`)
+/// @param[out] ids Where to store the ids we are missing. NULL to just count.
+/// @param[in] max_ids Nr. of elements the ids[] array can hold.
+/// @return Nr. of codes we are missing. If it is more than `max_ids`, only
+///   the first `max_ids` were stored.
+uint16_t IRCodeStore::getMissing(const char *manifest, uint64_t *ids,
+                                 const uint16_t max_ids) {
+  uint16_t count;
+  uint64_t digest;
+  const char *next = parseManifest(manifest, &count, &digest);
+  if (next == NULL) return 0;
+  // Same codes? Then there's no need to look at the ids.
+  if (count == _nr_codes && digest == getDigest()) return 0;
+  uint16_t missing = 0;
+  while (*next) {
+    uint64_t id;
+    next = parseId(next, &id);
+    if (id != kCodeNoId && find(id) < 0) {
+      if (ids != NULL && missing < max_ids) ids[missing] = id;
+      missing++;
+    }
+    if (*next == ',')
+      next++;
+    else
+      break;
+  }
+  return missing;
+}
+
+/// Export a code as text, for `importCode()` on another node.
+/// i.e. "<id>,<hz>,<packed timings in hex>,<name>"
+/// @param[in] id The code's id.
+/// @return The code as text, or "" if we don't have it.
+String IRCodeStore::exportCode(const uint64_t id) {
+  const int16_t index = find(id);
+  if (index < 0) return "";
+  const code_t *code = &_codes[index];
+  String result = "";
+  result.reserve(code->nbytes * 2 + kCodeMaxNameLength + 26);
+  result += idToString(id);
+  result += ',';
+  result += uint64ToString(code->hz);
+  result += ',';
+  for (uint16_t i = 0; i < code->nbytes; i++) {
+    if (code->packed[i] < 0x10) result += '0';
+    result += uint64ToString(code->packed[i], 16);
+  }
+  result += ',';
+  result += code->name;
+  return result;
+}
+
+/// Import a code exported by `exportCode()`.
+/// @param[in] payload The code as text.
+/// @return The code's id, or kCodeNoId if it is invalid, doesn't match its
+///   id, or couldn't be added.
+uint64_t IRCodeStore::importCode(const char *payload) {
+  if (payload == NULL) return kCodeNoId;
+  uint64_t id;
+  const char *next = parseId(payload, &id);
+  if (id == kCodeNoId || *next != ',') return kCodeNoId;
+  char *end;
+  const uint32_t hz = strtoul(next + 1, &end, 10);
+  if (end == next + 1 || *end != ',' || hz > UINT16_MAX) return kCodeNoId;
+  next = end + 1;
+  uint8_t packed[kCodeMaxBytes];
+  uint16_t nbytes = 0;
+  for (; *next && *next != ','; next += 2) {
+    uint64_t byte;
+    char hex[3] = {next[0], next[1], '\0'};
+    if (nbytes >= kCodeMaxBytes || parseId(hex, &byte) != hex + 2)
+      return kCodeNoId;
+    packed[nbytes++] = byte;
+  }
+  if (*next != ',') return kCodeNoId;
+  const char *name = next + 1;
+  if (strlen(name) > kCodeMaxNameLength) return kCodeNoId;
+  // Don't trust it unless it matches its id.
+  if (hash(packed, nbytes, hz) != id) {
+    _stats.codes_rejected++;
+    return kCodeNoId;
+  }
+  if (find(id) >= 0) return id;
+  if (insert(name, packed, nbytes, hz, id) < 0) return kCodeNoId;
+  _stats.codes_added++;
+  return id;
+}
+
+/// Calculate the id of a code. i.e. A 64-bit FNV-1a hash of its content.
+/// @param[in] packed The packed timings.
+/// @param[in] nbytes Nr. of bytes in the packed[] array.
+/// @param[in] hz Its modulation frequency.
+/// @return The id. Never kCodeNoId.
+uint64_t IRCodeStore::hash(const uint8_t packed[], const uint16_t nbytes,
+                           const uint16_t hz) {
+  uint64_t result = kFnvBasis64;
+  result = (result ^ (hz & 0xFF)) * kFnvPrime64;
+  result = (result ^ (hz >> 8)) * kFnvPrime64;
+  for (uint16_t i = 0; i < nbytes; i++)
+    result = (result ^ packed[i]) * kFnvPrime64;
+  return (result == kCodeNoId) ? 1 : result;
+}
+
+/// Convert a code id to text. (16 hexadecimal digits.)
+/// @param[in] id The id.
+/// @return The id as text.
+String IRCodeStore::idToString(const uint64_t id) {
+  const String hex = uint64ToString(id, 16);
+  String result = "";
+  for (uint8_t i = hex.length(); i < 16; i++) result += '0';
+  result += hex;
+  return result;
+}
+
+/// Convert text to a code id.
+/// @param[in] str The text. (Up to 16 hexadecimal digits.)
+/// @return The id, or kCodeNoId if it isn't valid.
+uint64_t IRCodeStore::idFromString(const char *str) {
+  uint64_t id = kCodeNoId;
+  if (str != NULL && *parseId(str, &id)) id = kCodeNoId;
+  return id;
+}
+
+/// Set the function used to publish our sync messages.
+/// @param[in] publish The function. NULL means don't publish.
+/// @param[in] arg An argument to pass to it.
+void IRCodeStore::setPublisher(IRPublish publish, void *arg) {
+  _publish = publish;
+  _publish_arg = arg;
+}
+
+/// Get the topic to subscribe to for the sync messages.
+/// @return The topic, including a wildcard. e.g. "ir_server/codes/#"
+String IRCodeStore::getSubscription(void) { return _base + "/#"; }
+
+/// Process a message from one of our topics.
+/// @param[in] topic The topic the message arrived on.
+/// @param[in] payload The message.
+/// @param[in] now_ms The current time, in milli-seconds. e.g. `millis()`
+/// @return true if it was a sync message (for this store), otherwise false.
+bool IRCodeStore::handleMessage(const char *topic, const char *payload,
+                                const uint32_t now_ms) {
+  if (topic == NULL || payload == NULL) return false;
+  _now = now_ms;
+  const uint16_t base_len = _base.length();
+  if (strncmp(topic, _base.c_str(), base_len) || topic[base_len] != '/')
+    return false;
+  topic += base_len + 1;
+  if (!strncmp(topic, kCodeManifestTopic, strlen(kCodeManifestTopic))) {
+    // Ignore our own manifest.
+    if (strcmp(topic + strlen(kCodeManifestTopic), _node))
+      handleManifest(payload);
+  } else if (!strcmp(topic, kCodeWantTopic)) {
+    handleWant(payload);
+  } else if (!strncmp(topic, kCodeCodeTopic, strlen(kCodeCodeTopic))) {
+    handleCode(topic + strlen(kCodeCodeTopic), payload);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// Publish our manifest & any requests or codes that are due.
+/// @param[in] now_ms The current time, in milli-seconds. e.g. `millis()`
+/// @return true if anything was published, otherwise false.
+bool IRCodeStore::poll(const uint32_t now_ms) {
+  _now = now_ms;
+  bool sent = false;
+  // Our manifest. Changes in quick succession are batched up.
+  if ((_changed && (!_stats.manifests_sent ||
+                    now_ms - _last_manifest >= kCodeSyncJitterMs)) ||
+      now_ms - _last_manifest >= _manifest_ms) {
+    if (publish(_base + '/' + kCodeManifestTopic + _node, getManifest(),
+                true)) {
+      _stats.manifests_sent++;
+      _changed = false;
+      sent = true;
+    }
+    _last_manifest = now_ms;
+  }
+  // If we're asking for anything, ask for everything we're missing at once.
+  bool asking = false;
+  for (uint16_t i = 0; i < _max_pending && !asking; i++)
+    asking = _pending[i].used && !_pending[i].send &&
+        static_cast<int32_t>(now_ms - _pending[i].due_ms) >= 0;
+  String want = "";
+  uint8_t nr_wanted = 0;
+  for (uint16_t i = 0; i < _max_pending; i++) {
+    pending_t *pending = &_pending[i];
+    if (!pending->used) continue;
+    if (static_cast<int32_t>(now_ms - pending->due_ms) < 0 &&
+        (pending->send || !asking || pending->tries))
+      continue;
+    const int16_t index = find(pending->id);
+    if (pending->send) {  // Someone needs one of our codes.
+      pending->used = false;
+      if (index >= 0 && publish(_base + '/' + kCodeCodeTopic +
+                                idToString(pending->id),
+                                exportCode(pending->id), false)) {
+        _stats.codes_sent++;
+        sent = true;
+      }
+    } else if (index >= 0 || pending->tries >= kCodeSyncTries) {
+      pending->used = false;  // We've got it, or we've given up on it.
+    } else if (nr_wanted < kCodeMaxWantIds) {  // We need one of theirs.
+      want += nr_wanted++ ? ',' : ':';
+      want += idToString(pending->id);
+      pending->tries++;
+      pending->due_ms = now_ms + kCodeSyncRetryMs;
+    }
+  }
+  if (nr_wanted && publish(_base + '/' + kCodeWantTopic, String(_node) + want,
+                           false)) {
+    _stats.wants_sent++;
+    sent = true;
+  }
+  return sent;
+}
+
+#ifndef UNIT_TEST
+/// Process a message from one of our topics.
+/// @param[in] topic The topic the message arrived on.
+/// @param[in] payload The message.
+/// @return true if it was a sync message (for this store), otherwise false.
+bool IRCodeStore::handleMessage(const char *topic, const char *payload) {
+  return handleMessage(topic, payload, millis());
+}
+
+/// Publish our manifest & any requests or codes that are due.
+/// @return true if anything was published, otherwise false.
+bool IRCodeStore::poll(void) { return poll(millis()); }
+#endif  // UNIT_TEST
+
+/// Get the nr. of codes we are waiting for, or about to send.
+/// @return The nr. of pending codes.
+uint16_t IRCodeStore::getPending(void) {
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < _max_pending; i++) count += _pending[i].used;
+  return count;
+}
+
+/// Get the sync statistics.
+/// @return The statistics.
+code_sync_stats_t IRCodeStore::getStats(void) { return _stats; }
+
+/// Add a code to the store, keeping it sorted by id.
+/// @param[in] name What to call it.
+/// @param[in] packed The packed timings.
+/// @param[in] nbytes Nr. of bytes in the packed[] array.
+/// @param[in] hz Its modulation frequency.
+/// @param[in] id Its id.
+/// @return Its index, or -1 if it couldn't be added.
+int16_t IRCodeStore::insert(const char *name, const uint8_t packed[],
+                            const uint16_t nbytes, const uint16_t hz,
+                            const uint64_t id) {
+  if (_nr_codes >= _capacity || nbytes == 0 || nbytes > kCodeMaxBytes) {
+    DPRINTLN("No room for another code.");
+    return -1;
+  }
+  uint8_t *copy = new uint8_t[nbytes];
+  if (copy == NULL) return -1;
+  memcpy(copy, packed, nbytes);
+  uint16_t index = _nr_codes;
+  while (index && _codes[index - 1].id > id) index--;
+  memmove(&_codes[index + 1], &_codes[index],
+          (_nr_codes - index) * sizeof(code_t));
+  code_t *code = &_codes[index];
+  code->id = id;
+  strncpy(code->name, name, sizeof(code->name));
+  code->name[kCodeMaxNameLength] = '\0';
+  code->hz = hz;
+  code->nbytes = nbytes;
+  code->packed = copy;
+  _nr_codes++;
+  _changed = true;
+  return index;
+}
+
+/// A random delay, so the nodes don't all act at once.
+/// @return A nr. of milli-seconds. (0 to kCodeSyncJitterMs - 1)
+uint32_t IRCodeStore::jitter(void) {
+  _seed = _seed * 1664525UL + 1013904223UL;  // A simple LCG.
+  return (_seed >> 8) % kCodeSyncJitterMs;
+}
+
+/// Find a pending action for a code.
+/// @param[in] id The code's id.
+/// @param[in] send true: Look for a send. false: Look for a request.
+/// @return A Ptr to the pending action, or NULL if there isn't one.
+IRCodeStore::pending_t *IRCodeStore::findPending(const uint64_t id,
+                                                 const bool send) {
+  for (uint16_t i = 0; i < _max_pending; i++)
+    if (_pending[i].used && _pending[i].id == id && _pending[i].send == send)
+      return &_pending[i];
+  return NULL;
+}
+
+/// Plan to ask for, or send, a code, unless we already plan to.
+/// @param[in] id The code's id.
+/// @param[in] send true: Send it. false: Ask for it.
+/// @param[in] delay_ms How long to wait first.
+void IRCodeStore::addPending(const uint64_t id, const bool send,
+                             const uint32_t delay_ms) {
+  if (findPending(id, send) != NULL) return;
+  for (uint16_t i = 0; i < _max_pending; i++) {
+    if (_pending[i].used) continue;
+    _pending[i].id = id;
+    _pending[i].due_ms = _now + delay_ms;
+    _pending[i].tries = 0;
+    _pending[i].send = send;
+    _pending[i].used = true;
+    return;
+  }
+  // We're full. It'll be picked up again from a later manifest.
+  DPRINTLN("No room for another pending code.");
+}
+
+/// Publish a message.
+/// @param[in] topic The topic.
+/// @param[in] payload The message.
+/// @param[in] retain Should the broker retain it?
+/// @return true if it was published, otherwise false.
+bool IRCodeStore::publish(const String &topic, const String &payload,
+                          const bool retain) {
+  if (_publish == NULL || !_node[0]) return false;
+  return _publish(topic.c_str(), payload.c_str(), retain, _publish_arg);
+}
+
+/// Process another node's manifest. Plan to ask for what we're missing.
+/// @param[in] payload The manifest.
+void IRCodeStore::handleManifest(const char *payload) {
+  uint16_t count;
+  uint64_t digest;
+  const char *next = parseManifest(payload, &count, &digest);
+  if (next == NULL) return;
+  if (count == _nr_codes && digest == getDigest()) return;  // In sync.
+  while (*next) {
+    uint64_t id;
+    next = parseId(next, &id);
+    if (id != kCodeNoId && find(id) < 0) addPending(id, false, jitter());
+    if (*next == ',')
+      next++;
+    else
+      break;
+  }
+}
+
+/// Process a request for codes. Plan to send the ones we have, & hold off
+/// asking for them ourselves.
+/// @param[in] payload The request. i.e. "<node>:<id>,<id>,..."
+void IRCodeStore::handleWant(const char *payload) {
+  const char *next = strchr(payload, ':');
+  if (next == NULL) return;
+  const uint16_t len = next - payload;
+  // Ignore our own requests.
+  if (len == strlen(_node) && !strncmp(payload, _node, len)) return;
+  next++;
+  while (*next) {
+    uint64_t id;
+    next = parseId(next, &id);
+    if (id != kCodeNoId) {
+      if (find(id) >= 0) {
+        addPending(id, true, jitter());
+      } else {
+        pending_t *want = findPending(id, false);
+        if (want != NULL) {  // Someone else asked, so wait for the answer.
+          if (!want->tries) _stats.wants_suppressed++;
+          want->due_ms = _now + kCodeSyncRetryMs;
+        }
+      }
+    }
+    if (*next == ',')
+      next++;
+    else
+      break;
+  }
+}
+
+/// Process a code sent by another node.
+/// @param[in] id_str The code's id, from the topic.
+/// @param[in] payload The code. (See `exportCode()`)
+void IRCodeStore::handleCode(const char *id_str, const char *payload) {
+  const uint64_t id = idFromString(id_str);
+  if (id == kCodeNoId) return;
+  // Someone else has sent it, so we don't need to.
+  pending_t *send = findPending(id, true);
+  if (send != NULL) {
+    send->used = false;
+    _stats.codes_suppressed++;
+  }
+  if (find(id) >= 0) return;  // We've already got it.
+  uint64_t payload_id;
+  parseId(payload, &payload_id);
+  if (payload_id == id && importCode(payload) == id) {
+    pending_t *want = findPending(id, false);
+    if (want != NULL) want->used = false;
+  }
+}
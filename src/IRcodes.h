@@ -0,0 +1,163 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief A content-addressed store of learned raw codes, & a delta sync
+///   protocol to share them between IR bridges ("nodes").
+/// @see IRCodeStore
+
+#ifndef IRCODES_H_
+#define IRCODES_H_
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#ifndef ARDUINO
+#include <string>
+#endif  // ARDUINO
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRutils.h"
+
+// Constants
+/// Max. length of a code's or node's name, excluding the null.
+const uint8_t kCodeMaxNameLength = 31;
+/// Max. nr. of bytes in a code's packed timings. (See `packRawData()`)
+const uint16_t kCodeMaxBytes = 256;
+/// Max. nr. of code ids in a single request for missing codes.
+const uint8_t kCodeMaxWantIds = 16;
+/// Max. random delay (msecs) before asking for, or sending, a code. The first
+/// node to do so saves all the others from having to.
+const uint32_t kCodeSyncJitterMs = 2000;
+/// Nr. of milli-seconds to wait for a code we've asked for before asking
+/// again.
+const uint32_t kCodeSyncRetryMs = 10000;
+/// Nr. of times to ask for a code before giving up on it. (Until another
+/// manifest lists it.)
+const uint8_t kCodeSyncTries = 3;
+/// Default nr. of milli-seconds between re-publishing our manifest.
+const uint32_t kCodeManifestMs = 15 * 60 * 1000;
+/// Returned instead of a code id when a code could not be found or added.
+const uint64_t kCodeNoId = 0;
+
+/// Sync statistics. See `IRCodeStore::getStats()`.
+typedef struct {
+  uint32_t manifests_sent;  ///< Manifests we published.
+  uint32_t wants_sent;  ///< Requests for missing codes we published.
+  uint32_t wants_suppressed;  ///< Requests made unnecessary by another node.
+  uint32_t codes_sent;  ///< Codes we published for others.
+  uint32_t codes_suppressed;  ///< Codes another node published before us.
+  uint32_t codes_added;  ///< Codes we got from other nodes.
+  uint32_t codes_rejected;  ///< Codes that failed their integrity check.
+} code_sync_stats_t;
+
+/// A store of learned raw codes, keyed by a hash of their content, that a
+/// fleet of nodes keep in sync by only exchanging the codes they're missing.
+///
+/// A code's id is a 64-bit FNV-1a hash of its frequency & its packed timings
+/// (See `packRawData()`), so the same code has the same id on every node, &
+/// a received code can be checked against its id. A node's manifest is its
+/// code count, a digest of all its ids, & the ids themselves. Nodes with the
+/// same digest have the same codes, so they skip comparing ids.
+///
+/// Over MQTT, under `<base_topic>`:
+/// - `manifest/<node>` (retained) Each node's manifest, when it changes.
+/// - `want` "<node>:<id>,<id>,..." A request for the codes listed.
+/// - `code/<id>` "<id>,<hz>,<packed timings in hex>,<name>" A code.
+///
+/// Every node hears every request & code, so one copy of a code serves all
+/// the nodes missing it. To stop hundreds of nodes all asking for (or all
+/// sending) the same code, each waits a random time first, & stands down if
+/// another node asks for (or sends) it in the meantime.
+/// @note It knows nothing of MQTT, so give it a publish function & pass it
+///   the messages on its topics. The codes can just as well be moved over
+///   HTTP etc. via `getManifest()`, `getMissing()`, `exportCode()` &
+///   `importCode()`.
+class IRCodeStore {
+ public:
+  IRCodeStore(const char *node, const char *base_topic,
+              const uint16_t max_codes, const uint16_t max_pending = 32,
+              const uint32_t manifest_ms = kCodeManifestMs);
+  ~IRCodeStore(void);
+  uint64_t add(const char *name, const uint16_t raw[], const uint16_t len,
+               const uint16_t hz);
+  uint64_t addPacked(const char *name, const uint8_t packed[],
+                     const uint16_t nbytes, const uint16_t hz);
+  bool remove(const uint64_t id);
+  int16_t find(const uint64_t id);
+  int16_t findName(const char *name);
+  uint16_t count(void);
+  uint64_t getId(const int16_t index);
+  const char *getName(const int16_t index);
+  uint16_t getHz(const int16_t index);
+  uint16_t getRaw(const int16_t index, uint16_t *raw, const uint16_t size);
+  bool send(IRsend *irsend, const uint64_t id);
+  uint64_t getDigest(void);
+  String getManifest(void);
+  uint16_t getMissing(const char *manifest, uint64_t *ids,
+                      const uint16_t max_ids);
+  String exportCode(const uint64_t id);
+  uint64_t importCode(const char *payload);
+  static uint64_t hash(const uint8_t packed[], const uint16_t nbytes,
+                       const uint16_t hz);
+  static String idToString(const uint64_t id);
+  static uint64_t idFromString(const char *str);
+  // Syncing.
+  void setPublisher(IRPublish publish, void *arg = NULL);
+  String getSubscription(void);
+  bool handleMessage(const char *topic, const char *payload,
+                     const uint32_t now_ms);
+  bool poll(const uint32_t now_ms);
+#ifndef UNIT_TEST
+  bool handleMessage(const char *topic, const char *payload);
+  bool poll(void);
+#endif  // UNIT_TEST
+  uint16_t getPending(void);
+  code_sync_stats_t getStats(void);
+
+ private:
+  /// A code in the store.
+  struct code_t {
+    uint64_t id;  ///< Hash of its content.
+    char name[kCodeMaxNameLength + 1];  ///< Its (not necessarily unique) name.
+    uint16_t hz;  ///< Its modulation frequency.
+    uint16_t nbytes;  ///< Nr. of bytes of packed timings.
+    uint8_t *packed;  ///< Its packed timings. (Heap allocated.)
+  };
+  /// Something we intend to publish, unless another node beats us to it.
+  struct pending_t {
+    uint64_t id;  ///< The code.
+    uint32_t due_ms;  ///< When to act.
+    uint8_t tries;  ///< Nr. of times we've asked for it.
+    bool send;  ///< true: Send it. false: Ask for it.
+    bool used;  ///< Is this entry in use?
+  };
+  char _node[kCodeMaxNameLength + 1];  ///< This node's name.
+  String _base;  ///< The base topic.
+  uint16_t _capacity;  ///< Max. nr. of codes.
+  uint16_t _nr_codes;  ///< Nr. of codes stored.
+  code_t *_codes;  ///< The codes. Sorted by id.
+  uint16_t _max_pending;  ///< Max. nr. of pending actions.
+  pending_t *_pending;  ///< The pending actions.
+  uint32_t _manifest_ms;  ///< Milli-seconds between our manifests.
+  uint32_t _now;  ///< The latest time we were given.
+  uint32_t _last_manifest;  ///< When we last published our manifest.
+  bool _changed;  ///< Has the store changed since our last manifest?
+  uint32_t _seed;  ///< State of the random delay generator.
+  code_sync_stats_t _stats;
+  IRPublish _publish;
+  void *_publish_arg;
+
+  int16_t insert(const char *name, const uint8_t packed[],
+                 const uint16_t nbytes, const uint16_t hz, const uint64_t id);
+  uint32_t jitter(void);
+  pending_t *findPending(const uint64_t id, const bool send);
+  void addPending(const uint64_t id, const bool send, const uint32_t delay_ms);
+  bool publish(const String &topic, const String &payload, const bool retain);
+  void handleManifest(const char *payload);
+  void handleWant(const char *payload);
+  void handleCode(const char *id_str, const char *payload);
+};
+
+#endif  // IRCODES_H_
@@ -0,0 +1,293 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Software demodulation of carrier-level IR captures.
+/// @see IRDemodulator
+
+#include "IRdemod.h"
+#include <algorithm>
+#include "IRcapture.h"
+
+/// Class constructor
+/// @param[in] sample_hz The sample rate, or the rate edge times are counted
+///   at. e.g. 1000000 for times in usecs.
+/// @param[in] bufsize Max. nr. of mark & space durations in a message.
+/// @param[in] timeout_ms Nr. of milli-seconds of darkness that ends a message.
+/// @param[in] max_gap_us The longest gap (usecs) between the carrier pulses
+///   of a single mark.
+IRDemodulator::IRDemodulator(const uint32_t sample_hz, const uint16_t bufsize,
+                             const uint8_t timeout_ms,
+                             const uint16_t max_gap_us)
+    : _rate(std::max(sample_hz, (uint32_t)1)), _bufsize(bufsize) {
+  _durations = new uint16_t[_bufsize];
+  if (_durations == NULL) {
+    DPRINTLN("Could not allocate memory for the demodulated durations.");
+    _bufsize = 0;
+  }
+  _max_gap = toSamples(max_gap_us);
+  _timeout = toSamples(timeout_ms * 1000UL);
+  reset();
+}
+
+/// Class destructor
+IRDemodulator::~IRDemodulator(void) { delete[] _durations; }
+
+/// Feed it some 1-bit samples.
+/// @param[in] words The samples, packed 32 per word. The oldest sample is in
+///   the least significant bit of the first word. 1 means light.
+/// @param[in] nsamples Nr. of samples in the words[] array.
+void IRDemodulator::feedSamples(const uint32_t *words,
+                                const uint32_t nsamples) {
+  for (uint32_t done = 0; done < nsamples; done += 32, words++) {
+    const uint8_t nbits = std::min(nsamples - done, (uint32_t)32);
+    const uint32_t mask = (nbits < 32) ? (1UL << nbits) - 1 : UINT32_MAX;
+    const uint32_t word = *words & mask;
+    // Each set bit differs from the sample before it. i.e. Is an edge.
+    uint32_t edges = (word ^ ((word << 1) | _level)) & mask;
+    while (edges) {
+      const uint8_t bit = __builtin_ctz(edges);
+      if ((word >> bit) & 1)
+        rise(_time + bit);
+      else
+        _last_fall = _time + bit;
+      edges &= edges - 1;  // Clear the lowest set bit.
+    }
+    _level = (word >> (nbits - 1)) & 1;
+    _time += nbits;
+    idle(_time);
+  }
+}
+
+/// Feed it the times of some edges. Each edge toggles the level.
+/// @param[in] times When each edge happened. (In 1/sample_hz ticks.)
+/// @param[in] count Nr. of entries in the times[] array.
+/// @param[in] first_level The level after the first edge. true means light.
+void IRDemodulator::feedEdges(const uint32_t *times, const uint16_t count,
+                              const bool first_level) {
+  bool level = first_level;
+  for (uint16_t i = 0; i < count; i++, level = !level)
+    feedEdge(times[i], level);
+  idle(_time);
+}
+
+/// Feed it a single edge.
+/// @param[in] time When it happened. (In 1/sample_hz ticks.)
+/// @param[in] level The level after the edge. true means light.
+void IRDemodulator::feedEdge(const uint32_t time, const bool level) {
+  _time = time;
+  if (level == _level) return;  // Not really an edge.
+  _level = level;
+  if (level)
+    rise(time);
+  else
+    _last_fall = time;
+}
+
+/// There is no more signal to come, so end any message in progress.
+void IRDemodulator::finish(void) {
+  if (_in_mark) endMark();
+  endMessage();
+}
+
+/// Is there a complete message waiting?
+/// @return true if there is, otherwise false.
+bool IRDemodulator::isComplete(void) { return _complete; }
+
+/// Get the mark & space durations (usecs) of the message. Starting with a
+/// mark, & ending with one.
+/// @return A Ptr to the durations.
+const uint16_t *IRDemodulator::getDurations(void) { return _durations; }
+
+/// Get the nr. of durations in the message.
+/// @return The nr. of durations.
+uint16_t IRDemodulator::getLength(void) { return _len; }
+
+/// Did the message have more durations than would fit?
+/// @return true if it did, otherwise false.
+bool IRDemodulator::hasOverflowed(void) { return _overflow; }
+
+/// Get the carrier of the message. (Or the one in progress.)
+/// @return The carrier's frequency & duty cycle.
+carrier_info_t IRDemodulator::getCarrier(void) {
+  carrier_info_t result;
+  result.cycles = _cycles;
+  result.hz = 0;
+  result.duty = 0;
+  if (_period_sum) {
+    result.hz = ((uint64_t)_rate * _cycles + _period_sum / 2) / _period_sum;
+    result.duty = (_high_sum * 100 + _period_sum / 2) / _period_sum;
+  }
+  return result;
+}
+
+/// Discard the message, & start on the next one.
+void IRDemodulator::resume(void) {
+  _len = 0;
+  _overflow = false;
+  _complete = false;
+  _after = false;
+  // Keep the mark that started while we were waiting, if it is the first one
+  // of the next message. Otherwise, don't record the tail of it.
+  _discard = _in_mark && !_held;
+  if (_held) {
+    _period_sum = 0;
+    _high_sum = 0;
+    _cycles = 0;
+  }
+  _held = false;
+}
+
+/// Forget everything, & restart the clock from zero.
+void IRDemodulator::reset(void) {
+  _len = 0;
+  _overflow = false;
+  _complete = false;
+  _discard = false;
+  _held = false;
+  _after = false;
+  _dropped = 0;
+  _time = 0;
+  _level = false;
+  _in_mark = false;
+  _mark_start = 0;
+  _mark_end = 0;
+  _last_rise = 0;
+  _last_fall = 0;
+  _mark_cycles = 0;
+  _period_sum = 0;
+  _high_sum = 0;
+  _cycles = 0;
+}
+
+/// Get the time of the latest sample or edge fed to us.
+/// @return The time. (In 1/sample_hz ticks.)
+uint32_t IRDemodulator::getTime(void) { return _time; }
+
+/// Get the nr. of marks ignored because a complete message was waiting to be
+/// collected. See `resume()`.
+/// @return The nr. of marks.
+uint32_t IRDemodulator::getDropped(void) { return _dropped; }
+
+/// Handle a rising edge. i.e. The start of a carrier pulse.
+/// @param[in] time When it happened.
+void IRDemodulator::rise(const uint32_t time) {
+  if (_in_mark && time - _last_rise > _max_gap) endMark();
+  if (!_in_mark) {  // A new mark.
+    if (_len && !_complete) {
+      if (time - _mark_end < _timeout)
+        add(time - _mark_end);
+      else
+        endMessage();
+    }
+    if (_complete) {
+      // Only the first mark after a message can be kept for the next one.
+      _held = !_after;
+      if (!_held) _dropped++;
+      _after = true;
+    } else if (!_len) {  // A new message.
+      _period_sum = 0;
+      _high_sum = 0;
+      _cycles = 0;
+    }
+    _in_mark = true;
+    _mark_start = time;
+    _mark_cycles = 0;
+  } else if (!_complete && !_discard) {
+    // Another cycle of the carrier. Measure it, if we saw all of it, and
+    // it isn't obviously missing a pulse.
+    const uint32_t period = time - _last_rise;
+    const uint32_t high = _last_fall - _last_rise;
+    if (high < period &&
+        (!_cycles || (uint64_t)period * 2 * _cycles < 3 * _period_sum)) {
+      _period_sum += period;
+      _high_sum += high;
+      _cycles++;
+    }
+    _mark_cycles++;
+  }
+  _last_rise = time;
+}
+
+/// Check for the end of a mark or message, as time passes without any edges.
+/// @param[in] time The current time.
+void IRDemodulator::idle(const uint32_t time) {
+  if (_in_mark && !_level && time - _last_rise > _max_gap) endMark();
+  if (!_in_mark && _len && !_complete && time - _mark_end >= _timeout)
+    endMessage();
+}
+
+/// End the current mark, & record it.
+void IRDemodulator::endMark(void) {
+  _in_mark = false;
+  // The mark lasts a whole nr. of cycles, so it ends a cycle after the last
+  // pulse started. If we've no idea how long a cycle is, use the pulse.
+  uint32_t cycle = _last_fall - _last_rise;
+  if (_cycles)
+    cycle = (_period_sum + _cycles / 2) / _cycles;
+  else if (_mark_cycles)
+    cycle = (_last_rise - _mark_start) / _mark_cycles;
+  _mark_end = _last_rise + std::max(cycle, (uint32_t)1);
+  if (_discard) {
+    _discard = false;
+    return;
+  }
+  if (!_complete) {
+    add(_mark_end - _mark_start);
+  } else if (_held) {  // It ended before anyone collected the message.
+    _held = false;
+    _dropped++;
+  }
+}
+
+/// The message is complete.
+void IRDemodulator::endMessage(void) { if (_len) _complete = true; }
+
+/// Record a duration.
+/// @param[in] samples The duration. (In 1/sample_hz ticks.)
+void IRDemodulator::add(const uint32_t samples) {
+  if (_len >= _bufsize) {
+    _overflow = true;
+    return;
+  }
+  const uint64_t usecs = ((uint64_t)samples * 1000000 + _rate / 2) / _rate;
+  _durations[_len++] = std::min(usecs, (uint64_t)UINT16_MAX);
+}
+
+/// Convert micro-seconds to a nr. of samples.
+/// @param[in] usecs The time in micro-seconds.
+/// @return The nr. of samples. At least 1.
+uint32_t IRDemodulator::toSamples(const uint32_t usecs) {
+  return std::max((uint64_t)usecs * _rate / 1000000, (uint64_t)1);
+}
+
+// Start of IRDemodCaptureDriver class -------------------
+
+/// Class constructor
+/// @param[in] demod A Ptr to the demodulator to take the messages from.
+IRDemodCaptureDriver::IRDemodCaptureDriver(IRDemodulator *demod)
+    : _demod(demod), _running(false) {}
+
+/// Start "capturing". i.e. Allow demodulated messages to be delivered.
+void IRDemodCaptureDriver::start(const bool) { _running = true; }
+
+/// Stop "capturing".
+void IRDemodCaptureDriver::stop(void) { _running = false; }
+
+/// Hand a complete message to the receiver, if it is ready for one.
+void IRDemodCaptureDriver::poll(void) {
+  if (!_running || _demod == NULL || !_demod->isComplete() || !ready()) return;
+  const uint16_t *durations = _demod->getDurations();
+  const uint16_t len = _demod->getLength();
+  uint16_t offset = 0;
+  do {
+    const uint16_t count = std::min((uint16_t)(len - offset),
+                                    kCaptureBlockSize);
+    deliver(durations + offset, count, offset + count >= len);
+    offset += count;
+  } while (offset < len);
+  _demod->resume();
+}
+
+/// Get the demodulator the messages come from.
+/// @return A Ptr to the demodulator.
+IRDemodulator *IRDemodCaptureDriver::getDemodulator(void) { return _demod; }
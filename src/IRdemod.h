@@ -0,0 +1,112 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Software demodulation of carrier-level IR captures.
+/// @see IRDemodulator
+
+#ifndef IRDEMOD_H_
+#define IRDEMOD_H_
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRrecv.h"
+
+// Constants
+/// Default longest gap (usecs) between carrier pulses within a mark. Longer
+/// than the period of any common carrier, but much shorter than any space.
+const uint16_t kDemodMaxCarrierGapUs = 100;
+
+/// The carrier of a demodulated message.
+typedef struct {
+  uint32_t hz;  ///< Carrier frequency. 0 if unknown.
+  uint8_t duty;  ///< Duty cycle, in percent. 0 if unknown.
+  uint32_t cycles;  ///< Nr. of complete carrier cycles measured.
+} carrier_info_t;
+
+/// Turns a carrier-level signal (e.g. From a photodiode, or a logic analyser)
+/// into the mark & space durations a TSOP-style demodulator would have given,
+/// & measures the carrier's frequency & duty cycle along the way. e.g. To use
+/// with `IRsend::enableIROut()` when repeating an unknown code.
+///
+/// It accepts either a stream of 1-bit samples (packed 32 per word, oldest in
+/// the least significant bit, 1 = light), or the times of each edge.
+/// Samples are processed a word at a time: dark words (the bulk of any
+/// capture) cost one comparison, & otherwise the time is only spent on the
+/// edges, found via a count-trailing-zeros instruction, never per sample.
+///
+/// A mark is a run of carrier pulses less than `max_gap_us` apart. It is
+/// taken to last a whole number of carrier cycles. A space longer than the
+/// timeout ends the message.
+class IRDemodulator {
+ public:
+  explicit IRDemodulator(const uint32_t sample_hz,
+                         const uint16_t bufsize = kRawBuf,
+                         const uint8_t timeout_ms = kTimeoutMs,
+                         const uint16_t max_gap_us = kDemodMaxCarrierGapUs);
+  ~IRDemodulator(void);
+  void feedSamples(const uint32_t *words, const uint32_t nsamples);
+  void feedEdges(const uint32_t *times, const uint16_t count,
+                 const bool first_level = true);
+  void feedEdge(const uint32_t time, const bool level);
+  void finish(void);
+  bool isComplete(void);
+  const uint16_t *getDurations(void);
+  uint16_t getLength(void);
+  bool hasOverflowed(void);
+  carrier_info_t getCarrier(void);
+  void resume(void);
+  void reset(void);
+  uint32_t getTime(void);
+  uint32_t getDropped(void);
+
+ private:
+  uint32_t _rate;  ///< Samples (or edge time ticks) per second.
+  uint16_t *_durations;  ///< The demodulated message. (usecs)
+  uint16_t _bufsize;  ///< Max. nr. of durations.
+  uint16_t _len;  ///< Nr. of durations so far.
+  bool _overflow;  ///< Did the message not fit?
+  bool _complete;  ///< Is the message complete?
+  bool _discard;  ///< Should the current mark be ignored?
+  bool _held;  ///< Is the current mark the start of the next message?
+  bool _after;  ///< Has a mark started since the message completed?
+  uint32_t _dropped;  ///< Nr. of marks dropped while a message was waiting.
+  uint32_t _max_gap;  ///< Longest gap within a mark. (samples)
+  uint32_t _timeout;  ///< Shortest space that ends a message. (samples)
+  uint32_t _time;  ///< Nr. of samples fed so far.
+  bool _level;  ///< The level of the latest sample.
+  bool _in_mark;  ///< Are we in a mark?
+  uint32_t _mark_start;  ///< When the current mark started.
+  uint32_t _mark_end;  ///< When the previous mark ended.
+  uint32_t _last_rise;  ///< Time of the latest rising edge.
+  uint32_t _last_fall;  ///< Time of the latest falling edge.
+  uint32_t _mark_cycles;  ///< Nr. of carrier cycles in the current mark.
+  uint64_t _period_sum;  ///< Total length of the measured cycles. (samples)
+  uint64_t _high_sum;  ///< Total time lit in the measured cycles. (samples)
+  uint32_t _cycles;  ///< Nr. of measured cycles.
+
+  void rise(const uint32_t time);
+  void idle(const uint32_t time);
+  void endMark(void);
+  void endMessage(void);
+  void add(const uint32_t samples);
+  uint32_t toSamples(const uint32_t usecs);
+};
+
+/// A capture driver that hands the messages an `IRDemodulator` demodulates to
+/// the receiver, so they are decoded like any other capture.
+/// Feed the signal to `getDemodulator()`, then call `IRrecv::decode()`.
+class IRDemodCaptureDriver : public IRCaptureDriver {
+ public:
+  explicit IRDemodCaptureDriver(IRDemodulator *demod);
+  void start(const bool pullup);
+  void stop(void);
+  void poll(void);
+  IRDemodulator *getDemodulator(void);
+
+ private:
+  IRDemodulator *_demod;  ///< Where the messages come from.
+  bool _running;  ///< Has the receiver started us?
+};
+
+#endif  // IRDEMOD_H_
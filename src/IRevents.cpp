@@ -0,0 +1,384 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Stream decoded IR messages ("events") to many network clients.
+/// @see IREventServer
+
+#include "IRevents.h"
+#ifndef ARDUINO
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#endif  // ARDUINO
+#include <string.h>
+#include "IRutils.h"
+
+#ifndef ARDUINO
+#ifdef MSG_NOSIGNAL
+/// Don't raise SIGPIPE when writing to a socket the other end has closed.
+const int kEventSendFlags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else  // MSG_NOSIGNAL
+const int kEventSendFlags = MSG_DONTWAIT;
+#endif  // MSG_NOSIGNAL
+
+/// Class constructor
+/// @param[in] fd The socket to write to. The caller still owns it.
+IREventFdSink::IREventFdSink(const int fd) : _fd(fd) {}
+
+/// Write as much as can be written right now, without waiting.
+/// @param[in] data The bytes to write.
+/// @param[in] length Nr. of bytes to write.
+/// @return Nr. of bytes written (0 if it would have to wait), or -1 if the
+///   socket is closed or has failed.
+int32_t IREventFdSink::write(const uint8_t *data, const uint16_t length) {
+  if (_fd < 0) return -1;
+  if (length == 0) return 0;
+  const ssize_t written = send(_fd, data, length, kEventSendFlags);
+  if (written >= 0) return written;
+  if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return 0;
+  return -1;
+}
+
+/// Get the socket we write to.
+/// @return The socket's file descriptor.
+int IREventFdSink::getFd(void) const { return _fd; }
+#endif  // ARDUINO
+
+/// Add text to a buffer, if it fits.
+/// @param[in,out] buffer Where to add it.
+/// @param[in] size The size of the buffer.
+/// @param[in,out] pos Where to add it in the buffer. Moved past the text.
+/// @param[in] text The text to add.
+/// @param[in] length Nr. of characters of text.
+/// @return true if it fit, otherwise false.
+static bool append(uint8_t *buffer, const uint16_t size, uint16_t *pos,
+                   const char *text, const uint16_t length) {
+  if (*pos + length > size) return false;
+  memcpy(buffer + *pos, text, length);
+  *pos += length;
+  return true;
+}
+
+/// Add a number, in text, to a buffer, if it fits.
+/// @param[in,out] buffer Where to add it.
+/// @param[in] size The size of the buffer.
+/// @param[in,out] pos Where to add it in the buffer. Moved past the text.
+/// @param[in] value The number.
+/// @param[in] base The base to write it in. 10 or 16.
+/// @return true if it fit, otherwise false.
+static bool appendNumber(uint8_t *buffer, const uint16_t size, uint16_t *pos,
+                         uint64_t value, const uint8_t base) {
+  static const char kDigits[] = "0123456789ABCDEF";
+  char digits[20];
+  uint8_t n = 0;
+  do {
+    digits[n++] = kDigits[value % base];
+    value /= base;
+  } while (value);
+  if (*pos + n > size) return false;
+  while (n) buffer[(*pos)++] = digits[--n];
+  return true;
+}
+
+/// Serialise a decoded message as an event.
+/// @param[in] results The decoded message.
+/// @param[in] seq Its sequence number.
+/// @param[in] format The format to write it in.
+/// @param[out] buffer Where to write it.
+/// @param[in] size The size of the buffer.
+/// @return Nr. of bytes written to the buffer. 0 if it didn't fit.
+uint16_t IREventServer::serialise(const decode_results *results,
+                                  const uint32_t seq,
+                                  const event_format_t format,
+                                  uint8_t *buffer, const uint16_t size) {
+  if (results == NULL || buffer == NULL) return 0;
+  const bool has_state = hasACState(results->decode_type);
+  const uint16_t nbytes = has_state ? std::min((uint16_t)(results->bits / 8),
+                                               kStateSizeMax) : 0;
+  uint16_t pos = 0;
+  if (format == kEventBinary) {
+    const uint16_t length = kEventBinaryHeaderLength +
+        (has_state ? nbytes : 8);
+    if (length > size || length - 2 > UINT8_MAX) return 0;
+    const uint16_t type = (int16_t)results->decode_type;
+    buffer[pos++] = kEventBinaryMagic;
+    buffer[pos++] = length - 2;
+    for (int8_t shift = 24; shift >= 0; shift -= 8)
+      buffer[pos++] = seq >> shift;
+    buffer[pos++] = type >> 8;
+    buffer[pos++] = type;
+    buffer[pos++] = results->bits >> 8;
+    buffer[pos++] = results->bits;
+    buffer[pos++] = (results->repeat ? kEventBinaryRepeat : 0) |
+                    (has_state ? kEventBinaryState : 0);
+    if (has_state) {
+      memcpy(buffer + pos, results->state, nbytes);
+      pos += nbytes;
+    } else {
+      for (int8_t shift = 56; shift >= 0; shift -= 8)
+        buffer[pos++] = results->value >> shift;
+    }
+    return pos;
+  }
+  // kEventLine
+  const String protocol = typeToString(results->decode_type);
+  bool fits = appendNumber(buffer, size, &pos, seq, 10) &&
+      append(buffer, size, &pos, ",", 1) &&
+      append(buffer, size, &pos, protocol.c_str(), protocol.length()) &&
+      append(buffer, size, &pos, ",", 1) &&
+      appendNumber(buffer, size, &pos, results->bits, 10) &&
+      append(buffer, size, &pos, ",0x", 3);
+  if (has_state) {
+    for (uint16_t i = 0; fits && i < nbytes; i++) {
+      static const char kHex[] = "0123456789ABCDEF";
+      const char hex[2] = {kHex[results->state[i] >> 4],
+                           kHex[results->state[i] & 0xF]};
+      fits = append(buffer, size, &pos, hex, 2);
+    }
+  } else {
+    fits = fits && appendNumber(buffer, size, &pos, results->value, 16);
+  }
+  fits = fits && append(buffer, size, &pos, results->repeat ? ",1\n" : ",0\n",
+                        3);
+  return fits ? pos : 0;
+}
+
+/// Class constructor
+/// @param[in] max_clients The max. nr. of clients at once.
+/// @param[in] queue_depth Max. nr. of events waiting to be sent per client.
+/// @param[in] format The format to send the events in.
+/// @note The memory needed is roughly
+///   `max_clients * queue_depth * kEventMaxLength` bytes, so every client can
+///   have a full queue of different events.
+IREventServer::IREventServer(const uint8_t max_clients,
+                             const uint8_t queue_depth,
+                             const event_format_t format)
+    : _max_clients(max_clients), _depth(std::max(queue_depth, (uint8_t)1)),
+      _format(format), _seq(0) {
+  _pool_size = _max_clients * _depth + 1;
+  _pool = new message_t[_pool_size];
+  _clients = new client_t[_max_clients];
+  _queues = new uint16_t[_max_clients * _depth];
+  if (_pool == NULL || _clients == NULL || _queues == NULL) {
+    DPRINTLN("Could not allocate memory for the event server.");
+    _max_clients = 0;
+    _pool_size = 0;
+  }
+  for (uint16_t i = 0; i < _pool_size; i++) _pool[i].refs = 0;
+  for (uint8_t i = 0; i < _max_clients; i++) {
+    _clients[i].sink = NULL;
+    _clients[i].queue = _queues + i * _depth;
+  }
+}
+
+/// Class destructor
+IREventServer::~IREventServer(void) {
+  delete[] _pool;
+  delete[] _clients;
+  delete[] _queues;
+}
+
+/// Find a client.
+/// @param[in] sink The client's connection.
+/// @return Its index, or -1 if it isn't one of ours.
+int16_t IREventServer::findClient(const IREventSink *sink) const {
+  if (sink == NULL) return -1;
+  for (uint8_t i = 0; i < _max_clients; i++)
+    if (_clients[i].sink == sink) return i;
+  return -1;
+}
+
+/// Add a client. It gets every event published from now on.
+/// @param[in] sink The client's connection. The caller still owns it.
+/// @param[in] policy What to do with new events when its queue is full.
+/// @return The client's index, or -1 if there was no room for it.
+int8_t IREventServer::addClient(IREventSink *sink,
+                                const event_policy_t policy) {
+  if (sink == NULL || findClient(sink) >= 0) return -1;
+  for (uint8_t i = 0; i < _max_clients; i++) {
+    client_t *client = &_clients[i];
+    if (client->sink != NULL) continue;
+    client->sink = sink;
+    client->policy = policy;
+    client->head = 0;
+    client->count = 0;
+    client->offset = 0;
+    memset(&client->stats, 0, sizeof(client->stats));
+    return i;
+  }
+  return -1;
+}
+
+/// Remove a client. Any events waiting for it are discarded.
+/// @param[in] sink The client's connection.
+/// @return true if it was removed, false if it wasn't one of ours.
+bool IREventServer::removeClient(IREventSink *sink) {
+  const int16_t index = findClient(sink);
+  if (index < 0) return false;
+  client_t *client = &_clients[index];
+  while (client->count) {
+    release(client->queue[client->head]);
+    client->head = (client->head + 1) % _depth;
+    client->count--;
+  }
+  client->sink = NULL;
+  return true;
+}
+
+/// Is a connection one of our clients?
+/// @param[in] sink The client's connection.
+/// @return true if it is, otherwise false. e.g. It was removed when its
+///   connection closed.
+bool IREventServer::hasClient(const IREventSink *sink) const {
+  return findClient(sink) >= 0;
+}
+
+/// Get the nr. of clients.
+/// @return The nr. of clients.
+uint8_t IREventServer::countClients(void) const {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < _max_clients; i++)
+    if (_clients[i].sink != NULL) count++;
+  return count;
+}
+
+/// Get the nr. of events waiting to be sent to a client.
+/// @param[in] sink The client's connection.
+/// @return The nr. of events. Including one that has been partly sent.
+uint8_t IREventServer::getQueued(const IREventSink *sink) const {
+  const int16_t index = findClient(sink);
+  return index < 0 ? 0 : _clients[index].count;
+}
+
+/// Get a client's statistics.
+/// @param[in] sink The client's connection.
+/// @return Its statistics. All zero if it isn't one of ours.
+event_client_stats_t IREventServer::getClientStats(
+    const IREventSink *sink) const {
+  const int16_t index = findClient(sink);
+  if (index >= 0) return _clients[index].stats;
+  event_client_stats_t none;
+  memset(&none, 0, sizeof(none));
+  return none;
+}
+
+/// Release a queue's reference to a message.
+/// @param[in] index The index of the message in the pool.
+void IREventServer::release(const uint16_t index) {
+  if (_pool[index].refs) _pool[index].refs--;
+}
+
+/// Drop the oldest event in a client's queue that it hasn't started on.
+/// @param[in,out] client The client.
+void IREventServer::dropOldest(client_t *client) {
+  // A partly sent event has to be finished, or the stream is corrupted.
+  const uint8_t skip = client->offset ? 1 : 0;
+  if (client->count <= skip) return;
+  const uint8_t oldest = (client->head + skip) % _depth;
+  release(client->queue[oldest]);
+  if (skip) client->queue[oldest] = client->queue[client->head];
+  client->head = (client->head + 1) % _depth;
+  client->count--;
+  client->stats.dropped++;
+}
+
+/// Drop every event in a client's queue that it hasn't started on.
+/// @param[in,out] client The client.
+void IREventServer::clear(client_t *client) {
+  while (client->count > (client->offset ? 1 : 0)) dropOldest(client);
+}
+
+/// Add an event to the end of a client's queue, if there is room.
+/// @param[in,out] client The client.
+/// @param[in] index The index of the event in the pool.
+void IREventServer::push(client_t *client, const uint16_t index) {
+  if (client->count >= _depth) {
+    client->stats.dropped++;
+    return;
+  }
+  client->queue[(client->head + client->count) % _depth] = index;
+  client->count++;
+  _pool[index].refs++;
+}
+
+/// Publish a decoded message to every client.
+/// It is serialised once, queued for each client, & as much as possible is
+/// sent straight away.
+/// @param[in] results The decoded message.
+/// @return The event's sequence number. 0 if it couldn't be serialised.
+uint32_t IREventServer::publish(const decode_results *results) {
+  if (results == NULL) return 0;
+  _seq++;
+  if (_seq == 0) _seq++;  // 0 is reserved for failures.
+  if (countClients() == 0) return _seq;
+  // There is always a free message, as every client could have a full queue
+  // of different messages, & there is one more than that.
+  uint16_t index = 0;
+  while (index < _pool_size && _pool[index].refs) index++;
+  if (index >= _pool_size) return 0;
+  message_t *message = &_pool[index];
+  message->length = serialise(results, _seq, _format, message->data,
+                              kEventMaxLength);
+  if (message->length == 0) return 0;
+  for (uint8_t i = 0; i < _max_clients; i++) {
+    client_t *client = &_clients[i];
+    if (client->sink == NULL) continue;
+    if (client->count >= _depth) {
+      switch (client->policy) {
+        case kEventDropOldest:
+          dropOldest(client);
+          break;
+        case kEventCoalesce:
+          clear(client);
+          break;
+        default:  // kEventDropNewest
+          break;
+      }
+    }
+    push(client, index);
+  }
+  poll();
+  return _seq;
+}
+
+/// Send as much as a client will take, without waiting.
+/// @param[in,out] client The client.
+/// @return Nr. of bytes sent, or UINT32_MAX if its connection has closed.
+uint32_t IREventServer::flush(client_t *client) {
+  uint32_t total = 0;
+  while (client->count) {
+    const uint16_t index = client->queue[client->head];
+    const message_t *message = &_pool[index];
+    const int32_t written = client->sink->write(
+        message->data + client->offset, message->length - client->offset);
+    if (written < 0) return UINT32_MAX;
+    if (written == 0) break;
+    total += written;
+    client->stats.bytes += written;
+    client->offset += written;
+    if (client->offset < message->length) continue;
+    // That event is done.
+    release(index);
+    client->head = (client->head + 1) % _depth;
+    client->count--;
+    client->offset = 0;
+    client->stats.sent++;
+  }
+  return total;
+}
+
+/// Send as much as each client will take, without waiting. Call this often.
+/// e.g. Every `loop()`. Clients whose connections have closed are removed.
+/// @return Nr. of bytes sent.
+uint32_t IREventServer::poll(void) {
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < _max_clients; i++) {
+    if (_clients[i].sink == NULL) continue;
+    const uint32_t written = flush(&_clients[i]);
+    if (written == UINT32_MAX)
+      removeClient(_clients[i].sink);
+    else
+      total += written;
+  }
+  return total;
+}
@@ -0,0 +1,168 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Stream decoded IR messages ("events") to many network clients.
+/// @see IREventServer
+
+#ifndef IREVENTS_H_
+#define IREVENTS_H_
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include <algorithm>
+#include "IRremoteESP8266.h"
+#include "IRrecv.h"
+
+// Constants
+/// Default nr. of events each client can have waiting to be sent.
+const uint8_t kEventQueueDepth = 8;
+/// Max. size (in bytes) of a serialised event.
+const uint16_t kEventMaxLength = 2 * kStateSizeMax + 64;
+/// First byte of every event in the binary format.
+const uint8_t kEventBinaryMagic = 0xA5;
+/// Nr. of bytes in a binary event before its value or state.
+const uint8_t kEventBinaryHeaderLength = 11;
+/// Flag bits of a binary event.
+const uint8_t kEventBinaryRepeat = 0b01;  ///< It is a repeat.
+const uint8_t kEventBinaryState = 0b10;  ///< It has a state, not a value.
+
+/// How events are written to the clients.
+enum event_format_t {
+  /// One line of text per event. "<seq>,<protocol>,<bits>,0x<hex>,<repeat>\n"
+  /// e.g. "42,NEC,32,0x20DF10EF,0\n"
+  kEventLine = 0,
+  /// A frame per event. All multi-byte fields are big endian.
+  /// [0] kEventBinaryMagic, [1] Nr. of bytes after this one,
+  /// [2-5] seq, [6-7] decode_type_t, [8-9] bits, [10] flags,
+  /// then the 8 byte value, or the state's bytes.
+  kEventBinary,
+};
+
+/// What to do with a new event for a client that already has a full queue.
+/// i.e. It is reading slower than events are happening.
+enum event_policy_t {
+  kEventDropOldest = 0,  ///< Drop its oldest waiting event.
+  kEventDropNewest,  ///< Drop the new event.
+  kEventCoalesce,  ///< Drop all its waiting events. It only gets the latest.
+};
+
+/// Statistics for a client. See `IREventServer::getClientStats()`.
+typedef struct {
+  uint32_t sent;  ///< Events completely written to it.
+  uint32_t dropped;  ///< Events it missed because its queue was full.
+  uint32_t bytes;  ///< Bytes written to it.
+} event_client_stats_t;
+
+/// Interface to a connection to a client. e.g. A TCP socket.
+class IREventSink {
+ public:
+  virtual ~IREventSink(void) {}
+  /// Write as much as can be written right now, without waiting.
+  /// @param[in] data The bytes to write.
+  /// @param[in] length Nr. of bytes to write.
+  /// @return Nr. of bytes written (0 if it would have to wait), or -1 if the
+  ///   connection is closed.
+  virtual int32_t write(const uint8_t *data, const uint16_t length) = 0;
+};
+
+/// A sink for any Arduino style network client. e.g. `WiFiClient`.
+/// @tparam Client A class with `connected()`, `availableForWrite()` &
+///   `write(const uint8_t *, size_t)` methods.
+template <class Client>
+class IREventClientSink : public IREventSink {
+ public:
+  /// Class constructor
+  /// @param[in] client The client's connection.
+  explicit IREventClientSink(Client *client) : _client(client) {}
+  /// Write as much as can be written right now, without waiting.
+  /// @param[in] data The bytes to write.
+  /// @param[in] length Nr. of bytes to write.
+  /// @return Nr. of bytes written, or -1 if the client has disconnected.
+  int32_t write(const uint8_t *data, const uint16_t length) {
+    if (!_client->connected()) return -1;
+    const int32_t room = _client->availableForWrite();
+    if (room <= 0) return 0;
+    return _client->write(data, std::min((int32_t)length, room));
+  }
+
+ private:
+  Client *_client;
+};
+
+#ifndef ARDUINO
+/// A sink for a POSIX socket. e.g. One returned by `accept()`.
+class IREventFdSink : public IREventSink {
+ public:
+  explicit IREventFdSink(const int fd);
+  int32_t write(const uint8_t *data, const uint16_t length);
+  int getFd(void) const;
+
+ private:
+  int _fd;  ///< The socket.
+};
+#endif  // ARDUINO
+
+/// Broadcasts decoded IR messages to many clients at once.
+///
+/// Each event is serialised once, into a shared pool, & every client's queue
+/// just refers to it. Nothing is allocated per event. Clients are written to
+/// without ever waiting, so a slow client can't hold up the others, or the
+/// receiver. Instead, its queue fills up & its policy decides which events
+/// it misses. A client whose connection closes is removed.
+class IREventServer {
+ public:
+  explicit IREventServer(const uint8_t max_clients,
+                         const uint8_t queue_depth = kEventQueueDepth,
+                         const event_format_t format = kEventLine);
+  ~IREventServer(void);
+  int8_t addClient(IREventSink *sink,
+                   const event_policy_t policy = kEventDropOldest);
+  bool removeClient(IREventSink *sink);
+  bool hasClient(const IREventSink *sink) const;
+  uint8_t countClients(void) const;
+  uint8_t getQueued(const IREventSink *sink) const;
+  event_client_stats_t getClientStats(const IREventSink *sink) const;
+  uint32_t publish(const decode_results *results);
+  uint32_t poll(void);
+  static uint16_t serialise(const decode_results *results, const uint32_t seq,
+                            const event_format_t format, uint8_t *buffer,
+                            const uint16_t size);
+
+ private:
+  /// A serialised event, shared by the queues of the clients it is for.
+  struct message_t {
+    uint8_t data[kEventMaxLength];
+    uint16_t length;  ///< Nr. of bytes in `data`.
+    uint8_t refs;  ///< Nr. of queues it is in. 0 if the slot is free.
+  };
+  /// A connected client.
+  struct client_t {
+    IREventSink *sink;  ///< Its connection. NULL if the slot is free.
+    event_policy_t policy;
+    uint16_t *queue;  ///< Ring buffer of indexes into `_pool`.
+    uint8_t head;  ///< Position of its oldest event in `queue`.
+    uint8_t count;  ///< Nr. of events in `queue`.
+    uint16_t offset;  ///< Nr. of bytes of its oldest event already sent.
+    event_client_stats_t stats;
+  };
+  uint8_t _max_clients;
+  uint8_t _depth;  ///< Max. nr. of events per client queue.
+  event_format_t _format;
+  uint16_t _pool_size;  ///< Nr. of messages in `_pool`.
+  message_t *_pool;
+  client_t *_clients;
+  uint16_t *_queues;  ///< Storage for all the client queues.
+  uint32_t _seq;  ///< Sequence nr. of the last event.
+
+  int16_t findClient(const IREventSink *sink) const;
+  void release(const uint16_t index);
+  void dropOldest(client_t *client);
+  void push(client_t *client, const uint16_t index);
+  void clear(client_t *client);
+  uint32_t flush(client_t *client);
+};
+
+#endif  // IREVENTS_H_
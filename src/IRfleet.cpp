@@ -0,0 +1,331 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Coordinates which of several IR bridges ("nodes") drives each unit.
+/// @see IRFleet
+
+#include "IRfleet.h"
+#include <string.h>
+#include "IRutils.h"
+
+/// Is a name usable as a node or unit name?
+/// @param[in] name The name.
+/// @return true if it is, otherwise false.
+static bool validName(const char *name) {
+  // Advertisements list the units separated by ','.
+  return irutils::validTopicName(name, kFleetMaxNameLength, ",");
+}
+
+/// Class constructor
+/// @param[in] node This node's name. Unique within the fleet. It can't
+///   contain '/', '+', '#' or ','.
+/// @param[in] base_topic The topic the nodes advertise under.
+///   e.g. "ir_server/fleet"
+/// @param[in] max_peers The max. nr. of other nodes to keep track of.
+/// @param[in] heartbeat_ms Nr. of milli-seconds between our advertisements.
+/// @param[in] timeout_ms Nr. of milli-seconds without an advertisement from
+///   another node before it is considered dead.
+IRFleet::IRFleet(const char *node, const char *base_topic,
+                 const uint16_t max_peers, const uint32_t heartbeat_ms,
+                 const uint32_t timeout_ms)
+    : _base(base_topic), _capacity(max_peers), _heartbeat(heartbeat_ms),
+      _timeout(timeout_ms), _now(0), _start(0), _last_advert(0),
+      _started(false), _advertised(false), _nr_units(0), _owned(0),
+      _publish(NULL), _publish_arg(NULL), _ownership(NULL),
+      _ownership_arg(NULL) {
+  _node[0] = '\0';
+  if (validName(node)) strncpy(_node, node, sizeof(_node));
+  _peers = new peer_t[_capacity];
+  if (_peers == NULL) {
+    DPRINTLN("Could not allocate memory for the fleet's peers.");
+    _capacity = 0;
+  }
+  for (uint16_t i = 0; i < _capacity; i++) _peers[i].used = false;
+}
+
+/// Class destructor
+IRFleet::~IRFleet(void) { delete[] _peers; }
+
+/// Set the function used to publish our advertisements.
+/// @param[in] publish The function. NULL means don't publish.
+/// @param[in] arg An argument to pass to it.
+void IRFleet::setPublisher(IRPublish publish, void *arg) {
+  _publish = publish;
+  _publish_arg = arg;
+}
+
+/// Set the function to call when we gain or lose ownership of a unit.
+/// e.g. To (un)subscribe to the unit's command topics.
+/// @param[in] callback The function. NULL means don't call anything.
+/// @param[in] arg An argument to pass to it.
+void IRFleet::setOwnershipCallback(IRFleetOwnership callback, void *arg) {
+  _ownership = callback;
+  _ownership_arg = arg;
+}
+
+/// Add a unit this node can reach.
+/// @param[in] name The unit's name, as used by every node. It can't contain
+///   '/', '+', '#' or ','.
+/// @param[in] emitter Which of this node's emitters (e.g. IR channels)
+///   reaches it.
+/// @return The unit's id, or kFleetNoUnit if it couldn't be added.
+int16_t IRFleet::addUnit(const char *name, const uint8_t emitter) {
+  if (!validName(name) || _nr_units >= kFleetMaxUnits ||
+      findUnit(name) != kFleetNoUnit)
+    return kFleetNoUnit;
+  strncpy(_units[_nr_units].name, name, sizeof(_units[_nr_units].name));
+  _units[_nr_units].emitter = emitter;
+  _advertised = false;  // Tell the others as soon as we can.
+  return _nr_units++;
+}
+
+/// Find a unit this node can reach by name.
+/// @param[in] name The unit's name.
+/// @return The unit's id, or kFleetNoUnit if it isn't one of ours.
+int16_t IRFleet::findUnit(const char *name) {
+  if (name == NULL) return kFleetNoUnit;
+  for (uint8_t i = 0; i < _nr_units; i++)
+    if (strcmp(_units[i].name, name) == 0) return i;
+  return kFleetNoUnit;
+}
+
+/// Get the nr. of units this node can reach.
+/// @return The nr. of units.
+uint8_t IRFleet::getUnits(void) { return _nr_units; }
+
+/// Get the name of a unit.
+/// @param[in] unit The unit's id.
+/// @return The unit's name, or NULL if the id is invalid.
+const char *IRFleet::getUnitName(const int16_t unit) {
+  return (unit >= 0 && unit < _nr_units) ? _units[unit].name : NULL;
+}
+
+/// Get which of this node's emitters reaches a unit.
+/// @param[in] unit The unit's id.
+/// @return The emitter, or 0 if the id is invalid.
+uint8_t IRFleet::getEmitter(const int16_t unit) {
+  return (unit >= 0 && unit < _nr_units) ? _units[unit].emitter : 0;
+}
+
+/// Get the topic to subscribe to for the other nodes' advertisements.
+/// @return The topic, including a wildcard. e.g. "ir_server/fleet/+"
+String IRFleet::getSubscription(void) { return _base + "/+"; }
+
+/// Process a message from one of our topics.
+/// An advertisement's payload is the comma separated list of the units the
+/// node can reach. An empty payload means the node has left.
+/// @param[in] topic The topic the message arrived on.
+/// @param[in] payload The message.
+/// @param[in] now_ms The current time, in milli-seconds. e.g. `millis()`
+/// @return true if it was an advertisement (for this fleet), otherwise false.
+bool IRFleet::handleMessage(const char *topic, const char *payload,
+                            const uint32_t now_ms) {
+  if (topic == NULL || payload == NULL) return false;
+  _now = now_ms;
+  const uint16_t base_len = _base.length();
+  if (strncmp(topic, _base.c_str(), base_len) || topic[base_len] != '/')
+    return false;
+  const char *node = topic + base_len + 1;
+  if (!validName(node)) return false;
+  if (strcmp(node, _node) == 0) return true;  // Our own advertisement.
+  peer_t *peer = NULL;
+  peer_t *spare = NULL;
+  for (uint16_t i = 0; i < _capacity && peer == NULL; i++) {
+    if (!_peers[i].used) {
+      if (spare == NULL) spare = &_peers[i];
+    } else if (strcmp(_peers[i].name, node) == 0) {
+      peer = &_peers[i];
+    }
+  }
+  if (*payload == '\0') {  // It has left.
+    if (peer != NULL) peer->used = false;
+    update();
+    return true;
+  }
+  if (peer == NULL) {
+    // Reuse a dead peer's entry if we're full.
+    for (uint16_t i = 0; i < _capacity && spare == NULL; i++)
+      if (!isLive(&_peers[i])) spare = &_peers[i];
+    if (spare == NULL) {
+      DPRINTLN("No room for another fleet peer.");
+      return true;
+    }
+    peer = spare;
+    strncpy(peer->name, node, sizeof(peer->name));
+    peer->used = true;
+  }
+  peer->reach = 0;
+  peer->last_ms = _now;
+  // Only the units we can reach matter to us.
+  char name[kFleetMaxNameLength + 1];
+  while (*payload) {
+    const char *end = strchr(payload, ',');
+    const uint16_t len = end ? end - payload : strlen(payload);
+    if (len <= kFleetMaxNameLength) {
+      memcpy(name, payload, len);
+      name[len] = '\0';
+      const int16_t unit = findUnit(name);
+      if (unit != kFleetNoUnit) peer->reach |= 1UL << unit;
+    }
+    payload += len;
+    if (*payload == ',') payload++;
+  }
+  update();
+  return true;
+}
+
+/// Advertise when due, expire dead nodes, & work out which units we own.
+/// @param[in] now_ms The current time, in milli-seconds. e.g. `millis()`
+/// @return true if our advertisement was published, otherwise false.
+bool IRFleet::poll(const uint32_t now_ms) {
+  _now = now_ms;
+  if (!_started) {
+    _started = true;
+    _start = now_ms;
+  }
+  bool sent = false;
+  if (!_advertised || now_ms - _last_advert >= _heartbeat) sent = advertise();
+  for (uint16_t i = 0; i < _capacity; i++)
+    if (_peers[i].used && !isLive(&_peers[i])) {
+      DPRINT("Fleet peer timed out: ");
+      DPRINTLN(_peers[i].name);
+      _peers[i].used = false;
+    }
+  update();
+  return sent;
+}
+
+#ifndef UNIT_TEST
+/// Process a message from one of our topics.
+/// @param[in] topic The topic the message arrived on.
+/// @param[in] payload The message.
+/// @return true if it was an advertisement (for this fleet), otherwise false.
+bool IRFleet::handleMessage(const char *topic, const char *payload) {
+  return handleMessage(topic, payload, millis());
+}
+
+/// Advertise when due, expire dead nodes, & work out which units we own.
+/// @return true if our advertisement was published, otherwise false.
+bool IRFleet::poll(void) { return poll(millis()); }
+#endif  // UNIT_TEST
+
+/// Tell the other nodes we are leaving, & give up all our units.
+/// @return true if the message was published, otherwise false.
+bool IRFleet::leave(void) {
+  for (uint8_t i = 0; i < _nr_units; i++)
+    if (_owned & (1UL << i)) {
+      _owned &= ~(1UL << i);
+      if (_ownership != NULL) _ownership(i, false, _ownership_arg);
+    }
+  _started = false;
+  _advertised = false;
+  if (_publish == NULL || !_node[0]) return false;
+  return _publish((_base + '/' + _node).c_str(), "", true, _publish_arg);
+}
+
+/// Does this node own a unit? i.e. Should it drive & report on it?
+/// @param[in] unit The unit's id.
+/// @return true if it does, otherwise false.
+bool IRFleet::isOwner(const int16_t unit) {
+  return unit >= 0 && unit < _nr_units && (_owned & (1UL << unit));
+}
+
+/// Which node owns a unit?
+/// @param[in] unit The unit's id.
+/// @return The owner's name, or "" if nobody does (yet).
+String IRFleet::getOwner(const int16_t unit) {
+  if (unit < 0 || unit >= _nr_units) return "";
+  const char *name = owner(unit);
+  return name ? name : "";
+}
+
+/// Get the nr. of other nodes we've heard from recently.
+/// @return The nr. of live peers.
+uint16_t IRFleet::getLivePeers(void) {
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < _capacity; i++) count += isLive(&_peers[i]);
+  return count;
+}
+
+/// The rendezvous hashing weight of a node for a unit. The live node with
+/// the highest weight for a unit owns it.
+/// @param[in] unit The unit's name.
+/// @param[in] node The node's name.
+/// @return The weight.
+uint32_t IRFleet::weight(const char *unit, const char *node) {
+  // FNV-1a, with a separator so "ab"+"c" & "a"+"bc" differ.
+  uint32_t hash = 2166136261UL;
+  for (; *unit; unit++) hash = (hash ^ (uint8_t)*unit) * 16777619UL;
+  hash = (hash ^ 0xFF) * 16777619UL;
+  for (; *node; node++) hash = (hash ^ (uint8_t)*node) * 16777619UL;
+  // Finalise it (as per MurmurHash3) so similar names spread out.
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6BUL;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35UL;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+/// Have we heard from a peer recently?
+/// @param[in] peer A Ptr to the peer.
+/// @return true if it is alive, otherwise false.
+bool IRFleet::isLive(const peer_t *peer) {
+  return peer->used && _now - peer->last_ms < _timeout;
+}
+
+/// Work out which node should own a unit.
+/// @param[in] unit The unit's id.
+/// @return The owner's name, or NULL if nobody can yet.
+const char *IRFleet::owner(const uint8_t unit) {
+  const char *best = NULL;
+  uint32_t best_weight = 0;
+  // We can't claim anything until we've given the others a chance to be
+  // heard, or we'd briefly drive units another node already owns.
+  if (_started && _node[0] && _now - _start >= kFleetSettleMs) {
+    best = _node;
+    best_weight = weight(_units[unit].name, _node);
+  }
+  for (uint16_t i = 0; i < _capacity; i++) {
+    const peer_t *peer = &_peers[i];
+    if (!isLive(peer) || !(peer->reach & (1UL << unit))) continue;
+    const uint32_t w = weight(_units[unit].name, peer->name);
+    if (best == NULL || w > best_weight ||
+        (w == best_weight && strcmp(peer->name, best) < 0)) {
+      best = peer->name;
+      best_weight = w;
+    }
+  }
+  return best;
+}
+
+/// Publish our advertisement. (Retained, so new nodes hear it straight away.)
+/// @return true if it was published, otherwise false.
+bool IRFleet::advertise(void) {
+  if (_publish == NULL || !_node[0]) return false;
+  String payload = "";
+  for (uint8_t i = 0; i < _nr_units; i++) {
+    if (i) payload += ',';
+    payload += _units[i].name;
+  }
+  // An empty payload means we've left, so advertise something harmless.
+  if (!_nr_units) payload = ",";
+  _last_advert = _now;
+  _advertised = _publish((_base + '/' + _node).c_str(), payload.c_str(), true,
+                         _publish_arg);
+  return _advertised;
+}
+
+/// Re-work out which units we own, & report any changes.
+void IRFleet::update(void) {
+  for (uint8_t i = 0; i < _nr_units; i++) {
+    const uint32_t bit = 1UL << i;
+    const bool owned = (owner(i) == _node);
+    if (owned == static_cast<bool>(_owned & bit)) continue;
+    if (owned)
+      _owned |= bit;
+    else
+      _owned &= ~bit;
+    if (_ownership != NULL) _ownership(i, owned, _ownership_arg);
+  }
+}
@@ -0,0 +1,120 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Coordinates which of several IR bridges ("nodes") drives each unit.
+/// @see IRFleet
+
+#ifndef IRFLEET_H_
+#define IRFLEET_H_
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#ifndef ARDUINO
+#include <string>
+#endif  // ARDUINO
+#include "IRremoteESP8266.h"
+#include "IRutils.h"
+
+// Constants
+/// Max. nr. of units a node can reach. (One bit each in a uint32_t.)
+const uint8_t kFleetMaxUnits = 32;
+/// Max. length of a node or unit name, excluding the null.
+const uint8_t kFleetMaxNameLength = 31;
+/// Default nr. of milli-seconds between each node's advertisements.
+const uint32_t kFleetHeartbeatMs = 30000;
+/// Default nr. of milli-seconds without an advertisement before a node is
+/// considered dead. i.e. Three missed heartbeats.
+const uint32_t kFleetTimeoutMs = 3 * kFleetHeartbeatMs + kFleetHeartbeatMs / 2;
+/// Nr. of milli-seconds after starting to listen for the other nodes before
+/// claiming any units.
+const uint32_t kFleetSettleMs = 5000;
+/// Returned instead of a unit id when a unit could not be found or added.
+const int16_t kFleetNoUnit = -1;
+
+/// A function called when this node gains or loses ownership of a unit.
+/// @param[in] unit The unit's id.
+/// @param[in] owned true if this node now owns the unit, false if it doesn't.
+/// @param[in] arg The argument given to `setOwnershipCallback()`.
+typedef void (*IRFleetOwnership)(const int16_t unit, const bool owned,
+                                 void *arg);
+
+/// Coordinates a fleet of IR bridges ("nodes") that can reach overlapping
+/// sets of units (e.g. A/Cs), so each unit is driven by exactly one of them.
+/// Each node periodically advertises the units it can reach on
+/// `<base_topic>/<node>`. Every node then independently picks the same owner
+/// for each unit via rendezvous (highest random weight) hashing over the live
+/// nodes that can reach it, so adding or losing a node only moves the units
+/// that node wins or owned. A node that hasn't advertised within the timeout
+/// is considered dead, & its units fail over to the next best node.
+/// @note Only the units this node can reach are tracked. All memory is
+///   allocated when the object is created. It knows nothing of MQTT, so
+///   give it a publish function & pass it the messages on its topics.
+class IRFleet {
+ public:
+  IRFleet(const char *node, const char *base_topic, const uint16_t max_peers,
+          const uint32_t heartbeat_ms = kFleetHeartbeatMs,
+          const uint32_t timeout_ms = kFleetTimeoutMs);
+  ~IRFleet(void);
+  void setPublisher(IRPublish publish, void *arg = NULL);
+  void setOwnershipCallback(IRFleetOwnership callback, void *arg = NULL);
+  int16_t addUnit(const char *name, const uint8_t emitter = 0);
+  int16_t findUnit(const char *name);
+  uint8_t getUnits(void);
+  const char *getUnitName(const int16_t unit);
+  uint8_t getEmitter(const int16_t unit);
+  String getSubscription(void);
+  bool handleMessage(const char *topic, const char *payload,
+                     const uint32_t now_ms);
+  bool poll(const uint32_t now_ms);
+#ifndef UNIT_TEST
+  bool handleMessage(const char *topic, const char *payload);
+  bool poll(void);
+#endif  // UNIT_TEST
+  bool leave(void);
+  bool isOwner(const int16_t unit);
+  String getOwner(const int16_t unit);
+  uint16_t getLivePeers(void);
+  static uint32_t weight(const char *unit, const char *node);
+
+ private:
+  /// Another node we've heard from.
+  struct peer_t {
+    char name[kFleetMaxNameLength + 1];  ///< Its name.
+    uint32_t reach;  ///< Bit mask of our units it can reach.
+    uint32_t last_ms;  ///< When we last heard from it.
+    bool used;  ///< Is this entry in use?
+  };
+  /// A unit this node can reach.
+  struct unit_t {
+    char name[kFleetMaxNameLength + 1];  ///< Its name, as used by all nodes.
+    uint8_t emitter;  ///< Which of this node's emitters reaches it.
+  };
+  char _node[kFleetMaxNameLength + 1];  ///< This node's name.
+  String _base;  ///< The base topic the nodes advertise under.
+  uint16_t _capacity;  ///< Max. nr. of peers.
+  uint32_t _heartbeat;  ///< Milli-seconds between our advertisements.
+  uint32_t _timeout;  ///< Milli-seconds of silence before a peer is dead.
+  uint32_t _now;  ///< The latest time we were given.
+  uint32_t _start;  ///< When we started listening.
+  uint32_t _last_advert;  ///< When we last advertised.
+  bool _started;  ///< Has `poll()` been called yet?
+  bool _advertised;  ///< Have we advertised yet?
+  uint8_t _nr_units;  ///< Nr. of units added.
+  uint32_t _owned;  ///< Bit mask of the units we own.
+  unit_t _units[kFleetMaxUnits];  ///< The units this node can reach.
+  peer_t *_peers;  ///< The other nodes.
+  IRPublish _publish;
+  void *_publish_arg;
+  IRFleetOwnership _ownership;
+  void *_ownership_arg;
+
+  bool isLive(const peer_t *peer);
+  const char *owner(const uint8_t unit);
+  bool advertise(void);
+  void update(void);
+};
+
+#endif  // IRFLEET_H_
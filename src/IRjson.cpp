@@ -0,0 +1,561 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief A streaming JSON codec for `stdAc::state_t`.
+/// @see irjson
+
+#include "IRjson.h"
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "IRac.h"
+#include "IRtext.h"
+#include "IRutils.h"
+
+// Not all environments have a PSTR() macro.
+#ifndef PSTR
+#define PSTR
+#endif  // PSTR
+
+// On the ESP8266 platform we need to use a set of ..._P functions
+// to handle the strings stored in the flash address space.
+#if defined(ESP8266)
+#define STRLEN(PTR) strlen_P(PTR)
+#define STRCMP(LHS, RHS) strcmp_P(LHS, RHS)
+#else  // ESP8266
+#define STRLEN(PTR) strlen(PTR)
+#define STRCMP(LHS, RHS) strcmp(LHS, RHS)
+#endif  // ESP8266
+
+/// Get a plain char ptr to a (possibly flash based) IRtext string.
+#define TEXT(STR) reinterpret_cast<const char*>(STR)
+
+namespace irjson {
+/// The fields of the state, in the order they are written.
+enum field_t {
+  kProtocol = 0,
+  kModel,
+  kPower,
+  kMode,
+  kCelsius,
+  kTemp,
+  kFanspeed,
+  kSwingV,
+  kSwingH,
+  kQuiet,
+  kTurbo,
+  kEcono,
+  kLight,
+  kFilter,
+  kClean,
+  kBeep,
+  kSleep,
+  kFields,  ///< Nr. of fields.
+};
+
+/// The key of each field, in field_t order, each ending in a null.
+/// The same keys IRMQTTServer has always used.
+const char kKeys[] PROGMEM =
+    "protocol\0"
+    "model\0"
+    "power\0"
+    "mode\0"
+    "use_celsius\0"
+    "temp\0"
+    "fanspeed\0"
+    "swingv\0"
+    "swingh\0"
+    "quiet\0"
+    "turbo\0"
+    "econo\0"
+    "light\0"
+    "filter\0"
+    "clean\0"
+    "beep\0"
+    "sleep\0";
+
+/// Where the JSON text is being written to.
+struct writer_t {
+  char *buffer;  ///< The caller's buffer.
+  uint16_t size;  ///< Size of the buffer.
+  uint16_t length;  ///< Length of the full text so far. May exceed the size.
+};
+
+/// The kinds of JSON value the reader cares about.
+enum value_kind_t {
+  kString = 0,
+  kNumber,
+  kTrue,
+  kFalse,
+  kOther,  ///< null, an object, or an array.
+};
+
+/// A JSON value, as read from the text.
+struct value_t {
+  value_kind_t kind;  ///< What sort of value it is.
+  char text[kMaxValueLength + 1];  ///< A string's contents. (kString)
+  double number;  ///< A number's value. (kNumber)
+  bool integral;  ///< Was the number written as an integer? (kNumber)
+};
+
+/// Where the JSON text is being read from.
+struct reader_t {
+  const char *pos;  ///< The next character.
+  const char *end;  ///< Just past the last character we may look at.
+};
+
+/// Add a character, if there is room for it.
+/// @param[in,out] w The writer.
+/// @param[in] c The character.
+static void put(writer_t *w, const char c) {
+  if (w->length + 1 < w->size) w->buffer[w->length] = c;
+  w->length++;
+}
+
+/// Add a (possibly flash based) null terminated string, escaping as needed.
+/// @param[in,out] w The writer.
+/// @param[in] str The string.
+/// @param[in] quote Put it in double quotes?
+static void putText(writer_t *w, const char *str, const bool quote = true) {
+  if (quote) put(w, '"');
+  for (char c = pgm_read_byte(str); c; c = pgm_read_byte(++str)) {
+    if (c == '"' || c == '\\') {
+      put(w, '\\');
+    } else if ((uint8_t)c < 0x20) {  // A control character.
+      putText(w, PSTR("\\u00"), false);
+      put(w, '0' + (c >> 4));
+      c = "0123456789abcdef"[c & 0xF];
+    }
+    put(w, c);
+  }
+  if (quote) put(w, '"');
+}
+
+/// Add an integer.
+/// @param[in,out] w The writer.
+/// @param[in] value The integer.
+static void putInt(writer_t *w, const int32_t value) {
+  uint32_t magnitude = value;
+  if (value < 0) {
+    put(w, '-');
+    magnitude = -magnitude;
+  }
+  char digits[10];
+  uint8_t n = 0;
+  do {
+    digits[n++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude);
+  while (n) put(w, digits[--n]);
+}
+
+/// Add a number, to at most 3 decimal places, without any trailing zeros.
+/// e.g. 25, 21.5, -0.125
+/// @param[in,out] w The writer.
+/// @param[in] value The number. null if it isn't a (reasonable) number.
+static void putFloat(writer_t *w, const float value) {
+  if (!(value > -1e6 && value < 1e6)) {  // Also catches NaN.
+    putText(w, PSTR("null"), false);
+    return;
+  }
+  int32_t thousandths = value * 1000 + (value < 0 ? -0.5 : 0.5);
+  if (thousandths < 0) {
+    put(w, '-');
+    thousandths = -thousandths;
+  }
+  putInt(w, thousandths / 1000);
+  int16_t fraction = thousandths % 1000;
+  if (!fraction) return;
+  put(w, '.');
+  for (int16_t unit = 100; fraction; unit /= 10) {
+    put(w, '0' + fraction / unit);
+    fraction %= unit;
+  }
+}
+
+/// Start a field, with its key.
+/// @param[in,out] w The writer.
+/// @param[in] field The field.
+static void putKey(writer_t *w, const field_t field) {
+  const char *key = kKeys;
+  for (uint8_t i = 0; i < field; i++) key += STRLEN(key) + 1;
+  if (field != kProtocol) put(w, ',');
+  putText(w, key);
+  put(w, ':');
+}
+
+/// Add a boolean, the way `IRac::boolToString()` would.
+/// @param[in,out] w The writer.
+/// @param[in] field The field.
+/// @param[in] value The value.
+static void putBool(writer_t *w, const field_t field, const bool value) {
+  putKey(w, field);
+  putText(w, value ? TEXT(kOnStr) : TEXT(kOffStr));
+}
+
+/// Get the text `IRac::opmodeToString()` would give, without the String.
+/// @param[in] mode The enum to be converted.
+/// @param[in] ha A flag to indicate we want GoogleHome/HomeAssistant output.
+/// @return A Ptr to the (possibly flash based) text.
+static const char *opmodeText(const stdAc::opmode_t mode, const bool ha) {
+  switch (mode) {
+    case stdAc::opmode_t::kOff:  return TEXT(kOffStr);
+    case stdAc::opmode_t::kAuto: return TEXT(kAutoStr);
+    case stdAc::opmode_t::kCool: return TEXT(kCoolStr);
+    case stdAc::opmode_t::kHeat: return TEXT(kHeatStr);
+    case stdAc::opmode_t::kDry:  return TEXT(kDryStr);
+    case stdAc::opmode_t::kFan:  return ha ? TEXT(kFanOnlyStr) : TEXT(kFanStr);
+    default:                     return TEXT(kUnknownStr);
+  }
+}
+
+/// Get the text `IRac::fanspeedToString()` would give, without the String.
+/// @param[in] speed The enum to be converted.
+/// @return A Ptr to the (possibly flash based) text.
+static const char *fanspeedText(const stdAc::fanspeed_t speed) {
+  switch (speed) {
+    case stdAc::fanspeed_t::kAuto:   return TEXT(kAutoStr);
+    case stdAc::fanspeed_t::kMax:    return TEXT(kMaxStr);
+    case stdAc::fanspeed_t::kHigh:   return TEXT(kHighStr);
+    case stdAc::fanspeed_t::kMedium: return TEXT(kMediumStr);
+    case stdAc::fanspeed_t::kLow:    return TEXT(kLowStr);
+    case stdAc::fanspeed_t::kMin:    return TEXT(kMinStr);
+    default:                         return TEXT(kUnknownStr);
+  }
+}
+
+/// Get the text `IRac::swingvToString()` would give, without the String.
+/// @param[in] swingv The enum to be converted.
+/// @return A Ptr to the (possibly flash based) text.
+static const char *swingvText(const stdAc::swingv_t swingv) {
+  switch (swingv) {
+    case stdAc::swingv_t::kOff:     return TEXT(kOffStr);
+    case stdAc::swingv_t::kAuto:    return TEXT(kAutoStr);
+    case stdAc::swingv_t::kHighest: return TEXT(kHighestStr);
+    case stdAc::swingv_t::kHigh:    return TEXT(kHighStr);
+    case stdAc::swingv_t::kMiddle:  return TEXT(kMiddleStr);
+    case stdAc::swingv_t::kLow:     return TEXT(kLowStr);
+    case stdAc::swingv_t::kLowest:  return TEXT(kLowestStr);
+    default:                        return TEXT(kUnknownStr);
+  }
+}
+
+/// Get the text `IRac::swinghToString()` would give, without the String.
+/// @param[in] swingh The enum to be converted.
+/// @return A Ptr to the (possibly flash based) text.
+static const char *swinghText(const stdAc::swingh_t swingh) {
+  switch (swingh) {
+    case stdAc::swingh_t::kOff:      return TEXT(kOffStr);
+    case stdAc::swingh_t::kAuto:     return TEXT(kAutoStr);
+    case stdAc::swingh_t::kLeftMax:  return TEXT(kLeftMaxStr);
+    case stdAc::swingh_t::kLeft:     return TEXT(kLeftStr);
+    case stdAc::swingh_t::kMiddle:   return TEXT(kMiddleStr);
+    case stdAc::swingh_t::kRight:    return TEXT(kRightStr);
+    case stdAc::swingh_t::kRightMax: return TEXT(kRightMaxStr);
+    case stdAc::swingh_t::kWide:     return TEXT(kWideStr);
+    default:                         return TEXT(kUnknownStr);
+  }
+}
+
+/// Write an A/C state as a JSON object, straight into a buffer.
+/// The same keys, order & values IRMQTTServer has always published. e.g.
+///   {"protocol":"DAIKIN","model":-1,"power":"On","mode":"Cool",...}
+/// @param[in] state The state to write.
+/// @param[out] buffer Where to put the null terminated JSON text. The text is
+///   truncated if it doesn't fit. See `kStateJsonMaxLength`.
+/// @param[in] size The size of the buffer, in bytes.
+/// @param[in] ha_mode Write it the way Home Assistant wants. i.e. Its mode
+///   names, & the mode is off if, & only if, the power is off.
+/// @return The length of the full text, excluding the null. If it is not less
+///   than `size`, the text was truncated.
+uint16_t stateToJson(const stdAc::state_t &state, char *buffer,
+                     const uint16_t size, const bool ha_mode) {
+  writer_t w = {buffer, size, 0};
+  // Home Assistant wants mode to be off if power is also off & vice-versa.
+  const bool off = ha_mode && (state.mode == stdAc::opmode_t::kOff ||
+                               !state.power);
+  put(&w, '{');
+  putKey(&w, kProtocol);
+  char name[32];  // Longer than any protocol name.
+  if (typeToName(state.protocol, name, sizeof(name)))
+    putText(&w, name);
+  else
+    putText(&w, TEXT(kUnknownStr));
+  putKey(&w, kModel);
+  putInt(&w, state.model);
+  putBool(&w, kPower, state.power && !off);
+  putKey(&w, kMode);
+  putText(&w, opmodeText(off ? stdAc::opmode_t::kOff : state.mode, ha_mode));
+  putBool(&w, kCelsius, state.celsius);
+  putKey(&w, kTemp);
+  putFloat(&w, state.degrees);
+  putKey(&w, kFanspeed);
+  putText(&w, fanspeedText(state.fanspeed));
+  putKey(&w, kSwingV);
+  putText(&w, swingvText(state.swingv));
+  putKey(&w, kSwingH);
+  putText(&w, swinghText(state.swingh));
+  putBool(&w, kQuiet, state.quiet);
+  putBool(&w, kTurbo, state.turbo);
+  putBool(&w, kEcono, state.econo);
+  putBool(&w, kLight, state.light);
+  putBool(&w, kFilter, state.filter);
+  putBool(&w, kClean, state.clean);
+  putBool(&w, kBeep, state.beep);
+  putKey(&w, kSleep);
+  putInt(&w, state.sleep);
+  put(&w, '}');
+  if (size) buffer[std::min(w.length, (uint16_t)(size - 1))] = '\0';
+  return w.length;
+}
+
+/// Look at the next character, without consuming it.
+/// @param[in] r The reader.
+/// @return The character. '\0' if there are no more.
+static char peek(const reader_t *r) { return r->pos < r->end ? *r->pos : 0; }
+
+/// Is a character a decimal digit? Unlike isdigit(), this is safe for any
+/// byte. e.g. UTF-8 text, where a plain char can be negative.
+/// @param[in] c The character.
+/// @return true if it is a digit, otherwise false.
+static bool isDigit(const char c) { return c >= '0' && c <= '9'; }
+
+/// Is a character a hexadecimal digit? Safe for any byte, like `isDigit()`.
+/// @param[in] c The character.
+/// @return true if it is a hex digit, otherwise false.
+static bool isHexDigit(const char c) {
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/// Skip any whitespace.
+/// @param[in,out] r The reader.
+static void skipSpace(reader_t *r) {
+  while (peek(r) == ' ' || peek(r) == '\t' || peek(r) == '\n' ||
+         peek(r) == '\r')
+    r->pos++;
+}
+
+/// Skip any whitespace, then consume the next character if it is the one
+/// expected.
+/// @param[in,out] r The reader.
+/// @param[in] c The character expected.
+/// @return true if it was consumed, otherwise false.
+static bool accept(reader_t *r, const char c) {
+  skipSpace(r);
+  if (peek(r) != c) return false;
+  r->pos++;
+  return true;
+}
+
+/// Read the rest of a string, after its opening quote.
+/// @param[in,out] r The reader.
+/// @param[out] text Where to put the null terminated contents. Empty if they
+///   won't fit. NULL to just skip the string.
+/// @param[in] size The size of the text buffer.
+/// @return true if it was a valid string, otherwise false.
+static bool readString(reader_t *r, char *text, const uint8_t size) {
+  uint8_t len = 0;
+  bool fits = true;
+  for (char c = peek(r); c != '"'; c = peek(r)) {
+    if (!c || (uint8_t)c < 0x20) return false;
+    r->pos++;
+    if (c == '\\') {
+      switch (c = peek(r)) {
+        case '"': case '\\': case '/': break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'u':  // None of our values need these, so no need to decode it.
+          for (uint8_t i = 0; i < 4; i++)
+            if (++r->pos >= r->end || !isHexDigit(*r->pos)) return false;
+          c = '?';
+          break;
+        default: return false;
+      }
+      r->pos++;
+    }
+    if (len + 1 < size)
+      text[len++] = c;
+    else
+      fits = false;
+  }
+  r->pos++;  // The closing quote.
+  if (text != NULL) text[fits ? len : 0] = '\0';
+  return true;
+}
+
+/// Read the rest of a number, after its first character.
+/// @param[in,out] r The reader.
+/// @param[in] first The first character.
+/// @param[out] value Where to put the number.
+/// @return true if it was a valid number, otherwise false.
+static bool readNumber(reader_t *r, const char first, value_t *value) {
+  char digits[24];  // Far longer than any number a state could need.
+  uint8_t len = 0;
+  digits[len++] = first;
+  value->integral = true;
+  for (char c = peek(r); isDigit(c) || c == '.' || c == 'e' || c == 'E' ||
+       c == '+' || c == '-'; c = peek(r)) {
+    if (len + 1U >= sizeof(digits)) return false;
+    if (!isDigit(c)) value->integral = false;
+    digits[len++] = c;
+    r->pos++;
+  }
+  digits[len] = '\0';
+  char *end;
+  value->number = strtod(digits, &end);
+  value->kind = kNumber;
+  return end == digits + len && isDigit(digits[len - 1]);
+}
+
+/// Read a literal. e.g. true
+/// @param[in,out] r The reader.
+/// @param[in] literal The rest of the literal, after its first character.
+/// @return true if it matched, otherwise false.
+static bool readLiteral(reader_t *r, const char *literal) {
+  for (; *literal; literal++, r->pos++)
+    if (peek(r) != *literal) return false;
+  return true;
+}
+
+/// Read a value.
+/// @param[in,out] r The reader.
+/// @param[out] value Where to put the value. Objects & arrays are skipped.
+/// @param[in] depth How deeply nested the value is.
+/// @return true if it was a valid value, otherwise false.
+static bool readValue(reader_t *r, value_t *value, const uint8_t depth) {
+  skipSpace(r);
+  const char c = peek(r);
+  if (c) r->pos++;
+  value->kind = kOther;
+  switch (c) {
+    case '"':
+      value->kind = kString;
+      return readString(r, value->text, sizeof(value->text));
+    case 't':
+      value->kind = kTrue;
+      return readLiteral(r, "rue");
+    case 'f':
+      value->kind = kFalse;
+      return readLiteral(r, "alse");
+    case 'n':
+      return readLiteral(r, "ull");
+    case '{':
+    case '[': {
+      if (depth >= 8) return false;  // Nothing we want is nested this deep.
+      const char close = (c == '{') ? '}' : ']';
+      if (accept(r, close)) return true;
+      do {
+        if (c == '{' && (!accept(r, '"') || !readString(r, NULL, 0) ||
+                         !accept(r, ':')))
+          return false;
+        if (!readValue(r, value, depth + 1)) return false;
+      } while (accept(r, ','));
+      value->kind = kOther;
+      return accept(r, close);
+    }
+    default:
+      if (c == '-' || isDigit(c)) return readNumber(r, c, value);
+      return false;
+  }
+}
+
+/// Which field does a key belong to?
+/// @param[in] key The key.
+/// @return The field. kFields if it isn't one of ours.
+static field_t findField(const char *key) {
+  const char *name = kKeys;
+  for (uint8_t field = 0; field < kFields; field++) {
+    if (!STRCMP(key, name)) return (field_t)field;
+    name += STRLEN(name) + 1;
+  }
+  return kFields;
+}
+
+/// Update a field of the state from a value, the way IRMQTTServer always has.
+/// Values of the wrong kind are ignored.
+/// @param[in] field The field.
+/// @param[in] value The value.
+/// @param[in,out] state The state to update.
+static void apply(const field_t field, const value_t &value,
+                  stdAc::state_t *state) {
+  const bool str = value.kind == kString;
+  const bool integer = value.kind == kNumber && value.integral;
+  const bool boolean = str || value.kind == kTrue || value.kind == kFalse;
+  const bool truth = str ? IRac::strToBool(value.text) : value.kind == kTrue;
+  switch (field) {
+    case kProtocol:
+      if (str) state->protocol = strToDecodeType(value.text);
+      else if (integer) state->protocol = (decode_type_t)value.number;
+      break;
+    case kModel:
+      if (str) state->model = IRac::strToModel(value.text);
+      else if (integer) state->model = value.number;
+      break;
+    case kMode:
+      if (str) state->mode = IRac::strToOpmode(value.text);
+      break;
+    case kFanspeed:
+      if (str) state->fanspeed = IRac::strToFanspeed(value.text);
+      break;
+    case kSwingV:
+      if (str) state->swingv = IRac::strToSwingV(value.text);
+      break;
+    case kSwingH:
+      if (str) state->swingh = IRac::strToSwingH(value.text);
+      break;
+    case kTemp:
+      if (value.kind == kNumber) state->degrees = value.number;
+      break;
+    case kSleep:
+      if (integer) state->sleep = value.number;
+      break;
+    case kPower:   if (boolean) state->power = truth; break;
+    case kCelsius: if (boolean) state->celsius = truth; break;
+    case kQuiet:   if (boolean) state->quiet = truth; break;
+    case kTurbo:   if (boolean) state->turbo = truth; break;
+    case kEcono:   if (boolean) state->econo = truth; break;
+    case kLight:   if (boolean) state->light = truth; break;
+    case kFilter:  if (boolean) state->filter = truth; break;
+    case kClean:   if (boolean) state->clean = truth; break;
+    case kBeep:    if (boolean) state->beep = truth; break;
+    default: break;
+  }
+}
+
+/// Update an A/C state from a JSON object, in a single pass over the text.
+/// Keys that are missing, unknown, or have a value of the wrong type are
+/// ignored, so only the fields given are changed. The keys & values are those
+/// `stateToJson()` writes, plus: the protocol & model may be numbers, & the
+/// booleans may also be true/false.
+/// @param[in] json The JSON text.
+/// @param[in,out] result The state to update. Unchanged if the text isn't a
+///   valid JSON object.
+/// @param[in] length The most characters of the text to look at. It also
+///   stops at a null.
+/// @return true if the text was a valid JSON object, otherwise false.
+bool jsonToState(const char *json, stdAc::state_t *result,
+                 const uint16_t length) {
+  if (json == NULL || result == NULL) return false;
+  reader_t r = {json, json + strnlen(json, length)};
+  if (!accept(&r, '{')) return false;
+  stdAc::state_t state = *result;
+  value_t value;
+  char key[16];  // Longer than any of our keys.
+  if (!accept(&r, '}')) {
+    do {
+      if (!accept(&r, '"') || !readString(&r, key, sizeof(key)) ||
+          !accept(&r, ':') || !readValue(&r, &value, 0))
+        return false;
+      apply(findField(key), value, &state);
+    } while (accept(&r, ','));
+    if (!accept(&r, '}')) return false;
+  }
+  skipSpace(&r);
+  if (peek(&r)) return false;  // Something after the object.
+  *result = state;
+  return true;
+}
+}  // namespace irjson
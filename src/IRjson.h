@@ -0,0 +1,31 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief A streaming JSON codec for `stdAc::state_t`.
+/// Writes the state straight into the caller's buffer, & reads it back in a
+/// single pass over the text. Neither builds a document tree, or allocates
+/// any memory.
+/// @see irjson
+
+#ifndef IRJSON_H_
+#define IRJSON_H_
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+
+namespace irjson {
+/// Big enough for any state `stateToJson()` writes, with the default locale.
+const uint16_t kStateJsonMaxLength = 384;
+/// Longest string value `jsonToState()` will look at. Longer ones are treated
+/// as unrecognised.
+const uint8_t kMaxValueLength = 40;
+
+uint16_t stateToJson(const stdAc::state_t &state, char *buffer,
+                     const uint16_t size, const bool ha_mode = false);
+bool jsonToState(const char *json, stdAc::state_t *result,
+                 const uint16_t length = UINT16_MAX);
+}  // namespace irjson
+
+#endif  // IRJSON_H_
@@ -0,0 +1,231 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief A small, statically allocated registry of library metrics.
+/// @see irmetrics
+
+#include "IRmetrics.h"
+#include <string.h>
+#include "IRutils.h"
+
+namespace irmetrics {
+registry_t registry;
+
+/// The names of the library's counters, in counter_t order, each ending in a
+/// null.
+const char kCounterNames[] PROGMEM =
+    "ir_recv_messages_total\0"
+    "ir_recv_unknown_total\0"
+    "ir_recv_missed_total\0"
+    "ir_recv_overflow_total\0"
+    "ir_recv_noise_pulses_total\0"
+    "ir_send_messages_total\0"
+    "ir_send_airtime_usecs_total\0"
+    "ir_send_deferrals_total\0"
+    "ir_send_forced_total\0"
+    "ir_ac_sends_total\0"
+    "ir_ac_unsupported_total\0"
+    "ir_scheduler_runs_total\0";
+
+/// The names of the library's gauges, in gauge_t order.
+const char kGaugeNames[] PROGMEM =
+    "ir_recv_last_length\0"
+    "ir_scheduler_pending\0";
+
+/// The names of the histograms, in histogram_t order.
+const char kHistogramNames[] PROGMEM =
+    "ir_scheduler_late_msecs\0"
+    "ir_ac_airtime_msecs\0";
+
+/// The upper bound (inclusive) of each bucket of each histogram.
+const uint32_t kBucketBounds[kHistograms][kHistogramBuckets] PROGMEM = {
+    {0, 1, 5, 10, 50, 100, 500, 1000},  // kSchedulerLateMs
+    {25, 50, 100, 200, 300, 500, 1000, 2000},  // kAcAirtimeMs
+};
+
+/// Record a value in a histogram.
+/// @param[in] histogram The histogram.
+/// @param[in] value The value.
+void observe(const histogram_t histogram, const uint32_t value) {
+  histogram_value_t *h = &registry.histograms[histogram];
+  uint8_t bucket = 0;
+  while (bucket < kHistogramBuckets &&
+         value > pgm_read_dword(&kBucketBounds[histogram][bucket]))
+    bucket++;
+  h->buckets[bucket]++;
+  h->sum += value;
+  h->count++;
+}
+
+/// Get the value of a counter.
+/// @param[in] counter The counter. (A counter_t or an id from `addCounter()`)
+/// @return The value.
+uint64_t getCounter(const uint8_t counter) {
+  return (counter < kCounters) ? registry.counters[counter] : 0;
+}
+
+/// Get the value of a gauge.
+/// @param[in] gauge The gauge. (A gauge_t or an id from `addGauge()`)
+/// @return The value.
+int32_t getGauge(const uint8_t gauge) {
+  return (gauge < kGauges) ? registry.gauges[gauge] : 0;
+}
+
+/// Get the value of a histogram.
+/// @param[in] histogram The histogram.
+/// @return A copy of its value.
+histogram_value_t getHistogram(const histogram_t histogram) {
+  return registry.histograms[histogram];
+}
+
+/// Get the upper bound of a bucket of a histogram.
+/// @param[in] histogram The histogram.
+/// @param[in] bucket The bucket.
+/// @return The (inclusive) upper bound, or UINT32_MAX for the "+Inf" bucket.
+uint32_t getBucketBound(const histogram_t histogram, const uint8_t bucket) {
+  if (bucket >= kHistogramBuckets) return UINT32_MAX;
+  return pgm_read_dword(&kBucketBounds[histogram][bucket]);
+}
+
+/// Add a user counter or gauge.
+/// @param[in] kind 0 for a counter, 1 for a gauge.
+/// @param[in] name Its name. It must stay valid. e.g. A string literal.
+/// @return The id to use, or kNoMetric if there is no room.
+static int16_t addUserMetric(const uint8_t kind, const char *name) {
+  if (name == NULL || registry.nr_user[kind] >= kMaxUserMetrics)
+    return kNoMetric;
+  registry.user_names[kind][registry.nr_user[kind]] = name;
+  const uint8_t first = kind ? (uint8_t)kUserGauge : (uint8_t)kUserCounter;
+  return first + registry.nr_user[kind]++;
+}
+
+/// Add a counter of your own, e.g. For an example sketch's own events.
+/// @param[in] name Its name. It must stay valid. e.g. A string literal.
+/// @return Its id for `add()` & `getCounter()`, or kNoMetric if there is no
+///   room.
+int16_t addCounter(const char *name) { return addUserMetric(0, name); }
+
+/// Add a gauge of your own.
+/// @param[in] name Its name. It must stay valid. e.g. A string literal.
+/// @return Its id for `set()` & `getGauge()`, or kNoMetric if there is no
+///   room.
+int16_t addGauge(const char *name) { return addUserMetric(1, name); }
+
+/// Zero all the metrics. The user's counters & gauges stay registered.
+void reset(void) {
+  memset(registry.counters, 0, sizeof(registry.counters));
+  memset(registry.gauges, 0, sizeof(registry.gauges));
+  memset(registry.histograms, 0, sizeof(registry.histograms));
+}
+
+/// Append a null terminated string from flash.
+/// @param[in,out] output The string to add to.
+/// @param[in] str A Ptr to the string in flash.
+/// @return A Ptr to just after the string's null.
+static const char *addFlashStr(String *output, const char *str) {
+  char c;
+  while ((c = pgm_read_byte(str++)) != '\0') *output += c;
+  return str;
+}
+
+/// Export all the metrics in the Prometheus text exposition format.
+/// @return A String containing the metrics.
+String toPrometheus(void) {
+  String result = "";
+  result.reserve(1024);  // Reserve some heap for the string to reduce frag.
+  const char *name = kCounterNames;
+  for (uint8_t i = 0; i < kUserCounter + registry.nr_user[0]; i++) {
+    String metric = "";
+    if (i < kUserCounter)
+      name = addFlashStr(&metric, name);
+    else
+      metric = registry.user_names[0][i - kUserCounter];
+    result += "# TYPE " + metric + " counter\n";
+    result += metric + ' ' + uint64ToString(registry.counters[i]) + '\n';
+  }
+  name = kGaugeNames;
+  for (uint8_t i = 0; i < kUserGauge + registry.nr_user[1]; i++) {
+    String metric = "";
+    if (i < kUserGauge)
+      name = addFlashStr(&metric, name);
+    else
+      metric = registry.user_names[1][i - kUserGauge];
+    result += "# TYPE " + metric + " gauge\n";
+    const int32_t value = registry.gauges[i];
+    result += metric + ' ' + (value < 0 ? "-" : "") +
+        uint64ToString(value < 0 ? -(int64_t)value : value) + '\n';
+  }
+  name = kHistogramNames;
+  for (uint8_t i = 0; i < kHistograms; i++) {
+    const histogram_value_t *h = &registry.histograms[i];
+    String metric = "";
+    name = addFlashStr(&metric, name);
+    result += "# TYPE " + metric + " histogram\n";
+    uint32_t cumulative = 0;
+    for (uint8_t b = 0; b <= kHistogramBuckets; b++) {
+      cumulative += h->buckets[b];
+      result += metric + "_bucket{le=\"";
+      if (b < kHistogramBuckets)
+        result += uint64ToString(getBucketBound((histogram_t)i, b));
+      else
+        result += "+Inf";
+      result += "\"} " + uint64ToString(cumulative) + '\n';
+    }
+    result += metric + "_sum " + uint64ToString(h->sum) + '\n';
+    result += metric + "_count " + uint64ToString(h->count) + '\n';
+  }
+  return result;
+}
+
+/// Export all the metrics as compact JSON.
+/// e.g. `{"ir_recv_messages_total":3,...,"ir_ac_airtime_msecs":{"le":[25,...],
+///   "buckets":[0,...],"sum":0,"count":0}}`
+/// @note Histogram buckets are not cumulative, & the last one is "+Inf".
+/// @return A String containing the JSON object.
+String toJson(void) {
+  String result = "{";
+  result.reserve(768);  // Reserve some heap for the string to reduce frag.
+  const char *name = kCounterNames;
+  for (uint8_t i = 0; i < kUserCounter + registry.nr_user[0]; i++) {
+    if (i) result += ',';
+    result += '"';
+    if (i < kUserCounter)
+      name = addFlashStr(&result, name);
+    else
+      result += registry.user_names[0][i - kUserCounter];
+    result += "\":" + uint64ToString(registry.counters[i]);
+  }
+  name = kGaugeNames;
+  for (uint8_t i = 0; i < kUserGauge + registry.nr_user[1]; i++) {
+    result += ",\"";
+    if (i < kUserGauge)
+      name = addFlashStr(&result, name);
+    else
+      result += registry.user_names[1][i - kUserGauge];
+    const int32_t value = registry.gauges[i];
+    result += "\":";
+    if (value < 0) result += '-';
+    result += uint64ToString(value < 0 ? -(int64_t)value : value);
+  }
+  name = kHistogramNames;
+  for (uint8_t i = 0; i < kHistograms; i++) {
+    const histogram_value_t *h = &registry.histograms[i];
+    result += ",\"";
+    name = addFlashStr(&result, name);
+    result += "\":{\"le\":[";
+    for (uint8_t b = 0; b < kHistogramBuckets; b++) {
+      if (b) result += ',';
+      result += uint64ToString(getBucketBound((histogram_t)i, b));
+    }
+    result += "],\"buckets\":[";
+    for (uint8_t b = 0; b <= kHistogramBuckets; b++) {
+      if (b) result += ',';
+      result += uint64ToString(h->buckets[b]);
+    }
+    result += "],\"sum\":" + uint64ToString(h->sum) + ",\"count\":" +
+        uint64ToString(h->count) + '}';
+  }
+  result += '}';
+  return result;
+}
+}  // namespace irmetrics
@@ -0,0 +1,125 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief A small, statically allocated registry of library metrics.
+/// Counters, gauges & fixed-bucket histograms that the library updates as it
+/// works, plus a few slots for the user's own counters, with exporters to the
+/// Prometheus text format & compact JSON.
+/// @note Set `ENABLE_IR_METRICS` to false to stop the library updating its
+///   metrics. The registry is still there for the user's own.
+
+#ifndef IRMETRICS_H_
+#define IRMETRICS_H_
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#include <stdint.h>
+#ifndef ARDUINO
+#include <string>
+#endif  // ARDUINO
+#include "IRremoteESP8266.h"
+
+#if ENABLE_IR_METRICS
+#define IR_METRIC_INC(NAME) irmetrics::add(irmetrics::NAME)
+#define IR_METRIC_ADD(NAME, N) irmetrics::add(irmetrics::NAME, N)
+#define IR_METRIC_SET(NAME, V) irmetrics::set(irmetrics::NAME, V)
+#define IR_METRIC_OBSERVE(NAME, V) irmetrics::observe(irmetrics::NAME, V)
+#else  // ENABLE_IR_METRICS
+#define IR_METRIC_INC(NAME) do {} while (0)
+#define IR_METRIC_ADD(NAME, N) do {} while (0)
+#define IR_METRIC_SET(NAME, V) do {} while (0)
+#define IR_METRIC_OBSERVE(NAME, V) do {} while (0)
+#endif  // ENABLE_IR_METRICS
+
+namespace irmetrics {
+/// The counters. They only ever go up.
+enum counter_t {
+  kRecvMessages = 0,  ///< Captures handed to `IRrecv::decode()`.
+  kRecvUnknown,  ///< Captures that only matched as a hash. (UNKNOWN)
+  kRecvMissed,  ///< Captures that nothing accepted.
+  kRecvOverflow,  ///< Captures that overflowed the capture buffer.
+  kRecvNoisePulses,  ///< Pulses removed by the noise filter.
+  kSendMessages,  ///< Times `IRsend::enableIROut()` set up a transmission.
+  kSendAirtimeUs,  ///< Total time spent sending marks & spaces. (usecs)
+  kSendDeferrals,  ///< Transmissions delayed by carrier sense.
+  kSendForced,  ///< Transmissions carrier sense gave up waiting for.
+  kAcSends,  ///< A/C messages sent by `IRac`.
+  kAcUnsupported,  ///< A/C messages `IRac` couldn't send.
+  kSchedulerRuns,  ///< Jobs run by `IRScheduler`.
+  // Add new library counters above this line.
+  kUserCounter,  ///< The first of the counters added by `addCounter()`.
+};
+
+/// The gauges. They hold the latest value of something.
+enum gauge_t {
+  kRecvLastLength = 0,  ///< The `rawlen` of the latest capture.
+  kSchedulerPending,  ///< Jobs waiting in the latest `IRScheduler` used.
+  // Add new library gauges above this line.
+  kUserGauge,  ///< The first of the gauges added by `addGauge()`.
+};
+
+/// The histograms. Their buckets are fixed at compile time.
+enum histogram_t {
+  kSchedulerLateMs = 0,  ///< How late `IRScheduler` jobs ran. (msecs)
+  kAcAirtimeMs,  ///< How long each A/C message took to send. (msecs)
+  // Add new histograms above this line.
+  kHistograms,  ///< Nr. of histograms.
+};
+
+/// Nr. of counters or gauges the user can add.
+const uint8_t kMaxUserMetrics = 8;
+/// Nr. of counters, incl. the user's.
+const uint8_t kCounters = kUserCounter + kMaxUserMetrics;
+/// Nr. of gauges, incl. the user's.
+const uint8_t kGauges = kUserGauge + kMaxUserMetrics;
+/// Nr. of buckets in each histogram, excluding the "+Inf" one.
+const uint8_t kHistogramBuckets = 8;
+/// Returned instead of an id when a metric could not be added.
+const int16_t kNoMetric = -1;
+
+/// The value of a histogram.
+struct histogram_value_t {
+  uint32_t buckets[kHistogramBuckets + 1];  ///< Counts (not cumulative).
+  uint64_t sum;  ///< The sum of all the values observed.
+  uint32_t count;  ///< Nr. of values observed.
+};
+
+/// The storage for all the metrics.
+struct registry_t {
+  uint64_t counters[kCounters];  ///< The counter values.
+  int32_t gauges[kGauges];  ///< The gauge values.
+  histogram_value_t histograms[kHistograms];  ///< The histogram values.
+  const char *user_names[2][kMaxUserMetrics];  ///< Counter & gauge names.
+  uint8_t nr_user[2];  ///< Nr. of user counters & gauges added.
+};
+
+extern registry_t registry;
+
+/// Add to a counter.
+/// @param[in] counter The counter. (A counter_t or an id from `addCounter()`)
+/// @param[in] amount How much to add.
+inline void add(const uint8_t counter, const uint32_t amount = 1) {
+  if (counter < kCounters) registry.counters[counter] += amount;
+}
+
+/// Set a gauge.
+/// @param[in] gauge The gauge. (A gauge_t or an id from `addGauge()`)
+/// @param[in] value The new value.
+inline void set(const uint8_t gauge, const int32_t value) {
+  if (gauge < kGauges) registry.gauges[gauge] = value;
+}
+
+void observe(const histogram_t histogram, const uint32_t value);
+uint64_t getCounter(const uint8_t counter);
+int32_t getGauge(const uint8_t gauge);
+histogram_value_t getHistogram(const histogram_t histogram);
+uint32_t getBucketBound(const histogram_t histogram, const uint8_t bucket);
+int16_t addCounter(const char *name);
+int16_t addGauge(const char *name);
+void reset(void);
+String toPrometheus(void);
+String toJson(void);
+}  // namespace irmetrics
+
+#endif  // IRMETRICS_H_
@@ -0,0 +1,87 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Output policies for the software carrier in `IRsend::mark()`.
+/// A policy is any class with `void on(void)` & `void off(void)` methods that
+/// switch the IR LED. `IRsend::markWith()` is templated on the policy, so a
+/// policy whose pin & polarity are known at compile time inlines each toggle
+/// down to a single register store, instead of a call to `digitalWrite()`
+/// with a run-time pin & polarity, twice per carrier cycle.
+/// @see IR_SEND_FIXED_PIN
+
+#ifndef IROUTPUT_H_
+#define IROUTPUT_H_
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#if defined(ESP32)
+#include <soc/gpio_struct.h>
+#endif  // ESP32
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+
+/// An output policy for an IR LED on a GPIO fixed at compile time.
+/// On the ESP8266 & ESP32 the GPIO's set/clear registers are written to
+/// directly. Elsewhere it is a `digitalWrite()` with constant arguments.
+/// @tparam kPin The GPIO the IR LED is on.
+/// @tparam kInverted Is the LED illuminated when the GPIO is LOW?
+/// @note The pin must already be an output. e.g. Via `IRsend::begin()`.
+template <uint8_t kPin, bool kInverted = false>
+class IRoutputFixedPin {
+ public:
+  /// Turn the IR LED on.
+  inline void on(void) { write(!kInverted); }
+  /// Turn the IR LED off.
+  inline void off(void) { write(kInverted); }
+
+ private:
+  /// Set the level of the GPIO.
+  /// @param[in] high Should the GPIO be HIGH?
+  static inline void write(const bool high) {
+#if defined(ESP8266)
+    if (kPin < 16) {
+      if (high)
+        GPOS = (uint32_t)1 << kPin;
+      else
+        GPOC = (uint32_t)1 << kPin;
+      return;
+    }
+#elif defined(ESP32)
+    if (kPin < 32) {
+      if (high)
+        GPIO.out_w1ts = (uint32_t)1 << kPin;
+      else
+        GPIO.out_w1tc = (uint32_t)1 << kPin;
+    } else {
+      if (high)
+        GPIO.out1_w1ts.val = (uint32_t)1 << (kPin - 32);
+      else
+        GPIO.out1_w1tc.val = (uint32_t)1 << (kPin - 32);
+    }
+    return;
+#endif  // ESP8266
+#ifndef UNIT_TEST
+    digitalWrite(kPin, high ? HIGH : LOW);
+#else
+    (void)high;
+#endif  // UNIT_TEST
+  }
+};
+
+#ifdef UNIT_TEST
+/// An output policy that only records what it was asked to do.
+class IRoutputMock {
+ public:
+  IRoutputMock(void) : ons(0), offs(0), lit(false) {}
+  /// Turn the (pretend) IR LED on.
+  inline void on(void) { ons++; lit = true; }
+  /// Turn the (pretend) IR LED off.
+  inline void off(void) { offs++; lit = false; }
+  uint32_t ons;  ///< Nr. of times it was turned on.
+  uint32_t offs;  ///< Nr. of times it was turned off.
+  bool lit;  ///< Is it on right now?
+};
+#endif  // UNIT_TEST
+
+#endif  // IROUTPUT_H_
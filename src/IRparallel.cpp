@@ -0,0 +1,84 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Run the parts of a parallel decode on a pool of threads.
+/// @see IRrecv::setDecodeRunner()
+
+#include "IRparallel.h"
+#if defined(UNIT_TEST) || defined(ESP32)
+#include <algorithm>
+
+/// Class constructor
+/// @param[in] parts Nr. of parts to split a decode into. One thread is
+///   started for each, except the first, which the caller runs.
+IRThreadDecodeRunner::IRThreadDecodeRunner(const uint8_t parts)
+    : _parts(std::max((uint8_t)1, std::min(parts, kDecodeMaxParts))),
+      _job(NULL), _arg(NULL), _count(0), _generation(0), _pending(0),
+      _stop(false) {
+  for (uint8_t part = 1; part < _parts; part++)
+    _threads.push_back(std::thread(&IRThreadDecodeRunner::work, this, part));
+}
+
+/// Class destructor
+/// Stops & waits for all the threads.
+IRThreadDecodeRunner::~IRThreadDecodeRunner(void) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _start.notify_all();
+  for (size_t i = 0; i < _threads.size(); i++) _threads[i].join();
+}
+
+/// Nr. of parts a decode should be split into.
+/// @return The nr. of parts.
+uint8_t IRThreadDecodeRunner::parts(void) const { return _parts; }
+
+/// Run `job(arg, part)` for every part from 0 to `count - 1`, at the same
+/// time, & wait for them all to finish.
+/// @param[in] job The work to do.
+/// @param[in,out] arg What to pass to the job.
+/// @param[in] count Nr. of parts. No more than `parts()` are run.
+/// @note Only one thread may call this at a time.
+void IRThreadDecodeRunner::run(void (*job)(void *arg, const uint8_t part),
+                               void *arg, const uint8_t count) {
+  const uint8_t parts = std::min(count, _parts);
+  if (parts == 0) return;
+  if (parts == 1) {
+    job(arg, 0);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _job = job;
+    _arg = arg;
+    _count = parts;
+    _pending = parts - 1;
+    _generation++;
+  }
+  _start.notify_all();
+  job(arg, 0);
+  std::unique_lock<std::mutex> lock(_mutex);
+  _done.wait(lock, [this] { return _pending == 0; });
+}
+
+/// The body of each of the threads.
+/// @param[in] part Which part of each piece of work it runs.
+void IRThreadDecodeRunner::work(const uint8_t part) {
+  uint32_t seen = 0;
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _start.wait(lock, [this, seen] { return _stop || _generation != seen; });
+    if (_stop) return;
+    seen = _generation;
+    if (part >= _count) continue;  // Not needed this time.
+    void (*job)(void *arg, const uint8_t part) = _job;
+    void *arg = _arg;
+    lock.unlock();
+    job(arg, part);
+    lock.lock();
+    if (--_pending == 0) _done.notify_one();
+  }
+}
+
+#endif  // defined(UNIT_TEST) || defined(ESP32)
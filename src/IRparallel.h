@@ -0,0 +1,50 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Run the parts of a parallel decode on a pool of threads.
+/// @see IRrecv::setDecodeRunner()
+
+#ifndef IRPARALLEL_H_
+#define IRPARALLEL_H_
+
+#if defined(UNIT_TEST) || defined(ESP32)
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+#include "IRrecv.h"
+
+/// Runs the parts of a parallel decode on `std::thread`s.
+///
+/// The threads are started once, & then wait to be given work, so a decode
+/// only costs a wake up per extra part, rather than starting a thread. The
+/// calling thread runs the first part itself.
+/// @note On an ESP32, two parts suit its two cores.
+class IRThreadDecodeRunner : public IRDecodeRunner {
+ public:
+  explicit IRThreadDecodeRunner(const uint8_t parts = 2);
+  ~IRThreadDecodeRunner(void);
+  uint8_t parts(void) const;
+  void run(void (*job)(void *arg, const uint8_t part), void *arg,
+           const uint8_t count);
+
+ private:
+  uint8_t _parts;
+  std::vector<std::thread> _threads;
+  std::mutex _mutex;
+  std::condition_variable _start;  ///< Signalled when there is new work.
+  std::condition_variable _done;  ///< Signalled when the work has finished.
+  void (*_job)(void *arg, const uint8_t part);
+  void *_arg;
+  uint8_t _count;  ///< Nr. of parts in the current work.
+  uint32_t _generation;  ///< Incremented for each new piece of work.
+  uint8_t _pending;  ///< Nr. of threads still working on it.
+  bool _stop;
+
+  void work(const uint8_t part);
+};
+
+#endif  // defined(UNIT_TEST) || defined(ESP32)
+#endif  // IRPARALLEL_H_
@@ -15,9 +15,13 @@ extern "C" {
 #include <Arduino.h>
 #endif
 #include <algorithm>
+#if defined(UNIT_TEST) || defined(ESP32)
+#include <atomic>  // NOLINT(build/c++11)
+#endif  // defined(UNIT_TEST) || defined(ESP32)
 #ifdef UNIT_TEST
 #include <cassert>
 #endif  // UNIT_TEST
+#include "IRmetrics.h"
 #include "IRremoteESP8266.h"
 #include "IRutils.h"
 
@@ -230,6 +234,117 @@ static void USE_IRAM_ATTR gpio_intr() {
 }
 #endif  // UNIT_TEST
 
+// Start of IRCaptureDriver class -------------------
+
+/// Is the receiver able to accept more captured data?
+/// @return false if a captured message is still waiting to be decoded.
+bool IRCaptureDriver::ready(void) { return params.rcvstate != kStopState; }
+
+/// Hand a block of captured mark/space durations to the receiver.
+/// Intended for drivers that collect edges in batches (e.g. via a peripheral)
+/// so the receiver is only touched once per block rather than once per edge.
+/// @param[in] usecs An array of alternating mark & space durations in
+///   microseconds. A new message must start with a mark.
+/// @param[in] count Nr. of entries in the `usecs` array.
+/// @param[in] end_of_frame Is this the last block of the current message?
+/// @return Nr. of entries accepted into the capture buffer.
+uint16_t IRCaptureDriver::deliver(const uint16_t *usecs, const uint16_t count,
+                                  const bool end_of_frame) {
+  if (params.rcvstate == kStopState) return 0;  // Not decoded yet. Drop it.
+  uint16_t rawlen = params.rawlen;
+  uint16_t accepted = 0;
+  if (count && params.rcvstate == kIdleState && rawlen < params.bufsize) {
+    params.rcvstate = kMarkState;
+    params.rawbuf[rawlen++] = 1;  // The leading gap, as per gpio_intr().
+  }
+  for (; accepted < count; accepted++) {
+    if (rawlen >= params.bufsize) {
+      params.overflow = true;
+      params.rcvstate = kStopState;
+      break;
+    }
+    params.rawbuf[rawlen++] = usecs[accepted] / kRawTick;
+  }
+  params.rawlen = rawlen;
+  if (end_of_frame && rawlen) {
+    // decode() needs a spare entry after the message to mark its end.
+    if (rawlen >= params.bufsize) params.overflow = true;
+    params.rcvstate = kStopState;
+  }
+  return accepted;
+}
+
+// Start of IRGpioCaptureDriver class -------------------
+
+#if defined(ESP32)
+/// Class constructor
+/// @param[in] timer_num Nr. of the ESP32 timer to use (0 to 3) (ESP32 Only)
+IRGpioCaptureDriver::IRGpioCaptureDriver(const uint8_t timer_num) {
+  // There are only 4 timers. 0 to 3.
+  _timer_num = std::min(timer_num, (uint8_t)3);
+}
+#endif  // ESP32
+
+/// Attach the GPIO interrupt & set up the message timeout timer.
+/// @param[in] pullup A flag indicating should the GPIO use the internal pullup
+/// resistor.
+void IRGpioCaptureDriver::start(const bool pullup) {
+  // ESP32's seem to require explicitly setting the GPIO to INPUT etc.
+  // This wasn't required on the ESP8266s, but it shouldn't hurt to make sure.
+  if (pullup) {
+#ifndef UNIT_TEST
+    pinMode(params.recvpin, INPUT_PULLUP);
+  } else {
+    pinMode(params.recvpin, INPUT);
+#endif  // UNIT_TEST
+  }
+#if defined(ESP32)
+  // Initialise the ESP32 timer.
+  // 80MHz / 80 = 1 uSec granularity.
+  timer = timerBegin(_timer_num, 80, true);
+  // Set the timer so it only fires once, and set it's trigger in uSeconds.
+  timerAlarmWrite(timer, MS_TO_USEC(params.timeout), ONCE);
+  // Note: Interrupt needs to be attached before it can be enabled or disabled.
+  timerAttachInterrupt(timer, &read_timeout, true);
+  timerAlarmDisable(timer);
+#endif  // ESP32
+
+#ifndef UNIT_TEST
+#if defined(ESP8266)
+  // Initialise ESP8266 timer.
+  os_timer_disarm(&timer);
+  os_timer_setfn(&timer, reinterpret_cast<os_timer_func_t *>(read_timeout),
+                 NULL);
+#endif  // ESP8266
+  // Attach Interrupt
+  attachInterrupt(params.recvpin, gpio_intr, CHANGE);
+#endif  // UNIT_TEST
+}
+
+/// Detach the GPIO interrupt & release the message timeout timer.
+void IRGpioCaptureDriver::stop(void) {
+#ifndef UNIT_TEST
+#if defined(ESP8266)
+  os_timer_disarm(&timer);
+#endif  // ESP8266
+#if defined(ESP32)
+  if (timer != NULL) {
+    timerAlarmDisable(timer);
+    timerEnd(timer);
+    timer = NULL;
+  }
+#endif  // ESP32
+  detachInterrupt(params.recvpin);
+#endif  // UNIT_TEST
+}
+
+/// Disarm the message timeout timer, ready for the next message.
+void IRGpioCaptureDriver::resume(void) {
+#if defined(ESP32)
+  if (timer != NULL) timerAlarmDisable(timer);
+#endif  // ESP32
+}
+
 // Start of IRrecv class -------------------
 
 /// Class constructor
@@ -246,9 +361,7 @@ static void USE_IRAM_ATTR gpio_intr() {
 #if defined(ESP32)
 IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
                const uint8_t timeout, const bool save_buffer,
-               const uint8_t timer_num) {
-  // There are only 4 timers. 0 to 3.
-  _timer_num = std::min(timer_num, (uint8_t)3);
+               const uint8_t timer_num) : _gpio(timer_num) {
 #else  // ESP32
 /// @cond IGNORE
 /// Class constructor
@@ -270,7 +383,9 @@ IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
   // Ensure we are going to be able to store all possible values in the
   // capture buffer.
   params.timeout = std::min(timeout, (uint8_t)kMaxTimeoutMs);
-  params.rawbuf = new uint16_t[bufsize];
+  _timeout = params.timeout;
+  _rawbuf = new uint16_t[bufsize];
+  params.rawbuf = _rawbuf;
   if (params.rawbuf == NULL) {
     DPRINTLN(
         "Could not allocate memory for the primary IR buffer.\n"
@@ -297,8 +412,17 @@ IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
   }
 #if DECODE_HASH
   _unknown_threshold = kUnknownThreshold;
+  _unknown_fingerprint = false;
 #endif  // DECODE_HASH
   _tolerance = kTolerance;
+#ifndef UNIT_TEST
+  _driver = &_gpio;
+#else  // UNIT_TEST
+  // There is no capture hardware when testing. Tests either supply their own
+  // `decode_results` buffer, or attach a (mock) driver via setCaptureDriver().
+  _driver = NULL;
+#endif  // UNIT_TEST
+  _runner = NULL;
 }
 
 /// Class destructor
@@ -307,10 +431,9 @@ IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
 /// timers or interrupts used.
 IRrecv::~IRrecv(void) {
   disableIRIn();
-#if defined(ESP32)
-  if (timer != NULL) timerEnd(timer);  // Cleanup the ESP32 timeout timer.
-#endif  // ESP32
-  delete[] params.rawbuf;
+  // Another IRrecv may have been created since, & be using its own buffer.
+  if (params.rawbuf == _rawbuf) params.rawbuf = NULL;
+  delete[] _rawbuf;
   if (params_save != NULL) {
     delete[] params_save->rawbuf;
     delete params_save;
@@ -321,53 +444,15 @@ IRrecv::~IRrecv(void) {
 /// @param[in] pullup A flag indicating should the GPIO use the internal pullup
 /// resistor. (Default: `false`. i.e. No.)
 void IRrecv::enableIRIn(const bool pullup) {
-  // ESP32's seem to require explicitly setting the GPIO to INPUT etc.
-  // This wasn't required on the ESP8266s, but it shouldn't hurt to make sure.
-  if (pullup) {
-#ifndef UNIT_TEST
-    pinMode(params.recvpin, INPUT_PULLUP);
-  } else {
-    pinMode(params.recvpin, INPUT);
-#endif  // UNIT_TEST
-  }
-#if defined(ESP32)
-  // Initialise the ESP32 timer.
-  // 80MHz / 80 = 1 uSec granularity.
-  timer = timerBegin(_timer_num, 80, true);
-  // Set the timer so it only fires once, and set it's trigger in uSeconds.
-  timerAlarmWrite(timer, MS_TO_USEC(params.timeout), ONCE);
-  // Note: Interrupt needs to be attached before it can be enabled or disabled.
-  timerAttachInterrupt(timer, &read_timeout, true);
-#endif  // ESP32
-
   // Initialise state machine variables
   resume();
-
-#ifndef UNIT_TEST
-#if defined(ESP8266)
-  // Initialise ESP8266 timer.
-  os_timer_disarm(&timer);
-  os_timer_setfn(&timer, reinterpret_cast<os_timer_func_t *>(read_timeout),
-                 NULL);
-#endif  // ESP8266
-  // Attach Interrupt
-  attachInterrupt(params.recvpin, gpio_intr, CHANGE);
-#endif  // UNIT_TEST
+  if (_driver != NULL) _driver->start(pullup);
 }
 
 /// Stop collection of any received IR data.
 /// Disable any timers and interrupts.
 void IRrecv::disableIRIn(void) {
-#ifndef UNIT_TEST
-#if defined(ESP8266)
-  os_timer_disarm(&timer);
-#endif  // ESP8266
-#if defined(ESP32)
-  timerAlarmDisable(timer);
-  timerEnd(timer);
-#endif  // ESP32
-  detachInterrupt(params.recvpin);
-#endif  // UNIT_TEST
+  if (_driver != NULL) _driver->stop();
 }
 
 /// Resume collection of received IR data.
@@ -378,11 +463,39 @@ void IRrecv::resume(void) {
   params.rcvstate = kIdleState;
   params.rawlen = 0;
   params.overflow = false;
-#if defined(ESP32)
-  timerAlarmDisable(timer);
-#endif  // ESP32
+  if (_driver != NULL) _driver->resume();
+}
+
+/// Change the mechanism used to capture IR edges.
+/// @param[in] driver A ptr to the capture driver to use. NULL means none.
+/// @note The previous driver is stopped. Call `enableIRIn()` to start the new
+///   one. The driver must outlive this object, or be detached first.
+void IRrecv::setCaptureDriver(IRCaptureDriver *driver) {
+  disableIRIn();
+  _driver = driver;
 }
 
+/// Get the mechanism being used to capture IR edges.
+/// @return A ptr to the capture driver in use.
+IRCaptureDriver *IRrecv::getCaptureDriver(void) { return _driver; }
+
+/// Split each decode into parts, & run them at the same time.
+/// The result is the same as decoding normally, i.e. The protocol that would
+/// have been found first still wins. Only how long it takes changes.
+/// @param[in] runner What runs the parts. e.g. An IRThreadDecodeRunner.
+///   NULL means decode normally. It must outlive this object, or be
+///   detached first.
+/// @note The common protocols at the head of the cascade are still tried on
+///   the calling thread first, so only messages that get past them (e.g. A/C
+///   & UNKNOWN messages) are split up. Each part costs a thread hand-off, so
+///   it only pays when the rest of the cascade takes a lot longer than that,
+///   & there are idle cores to run the parts.
+void IRrecv::setDecodeRunner(IRDecodeRunner *runner) { _runner = runner; }
+
+/// Get what is running parallel decodes.
+/// @return A ptr to the runner in use. NULL means none.
+IRDecodeRunner *IRrecv::getDecodeRunner(void) { return _runner; }
+
 /// Make a copy of the interrupt state & buffer data.
 /// Needed because irparams is marked as volatile, thus memcpy() isn't allowed.
 /// Only call this when you know the interrupt handlers won't modify anything.
@@ -415,12 +528,33 @@ void IRrecv::copyIrParams(volatile irparams_t *src, irparams_t *dst) {
 /// @return The size of the buffer that is in use by the object.
 uint16_t IRrecv::getBufSize(void) { return params.bufsize; }
 
+/// Get the nr. of msecs of no signal before a capture is considered complete.
+/// @return The timeout in use, in milli-Seconds.
+uint8_t IRrecv::getTimeout(void) { return _timeout; }
+
+/// Is a message being captured right now? i.e. Is the IR channel busy?
+/// @return true if part of a message has been seen but it hasn't ended yet,
+///   otherwise false. Also false while a captured message is waiting to be
+///   `decode()`d, as the receiver isn't listening then.
+bool IRrecv::isReceiving(void) {
+  return params.rcvstate == kMarkState || params.rcvstate == kSpaceState;
+}
+
 #if DECODE_HASH
 /// Set the minimum length we will consider for reporting UNKNOWN message types.
 /// @param[in] length Min nr. of mark/space pulses required to be considered.
 void IRrecv::setUnknownThreshold(const uint16_t length) {
   _unknown_threshold = length;
 }
+
+/// Set how UNKNOWN message types are hashed.
+/// @param[in] enable true, to report the timing fingerprint of the message in
+///   `value`, & the legacy hash in `command`. false (the default), to report
+///   just the legacy hash, in `value`.
+/// @see resultToFingerprint()
+void IRrecv::setUnknownFingerprint(const bool enable) {
+  _unknown_fingerprint = enable;
+}
 #endif  // DECODE_HASH
 
 
@@ -458,6 +592,7 @@ void IRrecv::crudeNoiseFilter(decode_results *results, const uint16_t floor) {
         results->rawbuf[offset - 1] += addition;
       }
       results->rawlen -= 2;  // Adjust the length.
+      IR_METRIC_ADD(kRecvNoisePulses, 2);
     } else {
       offset++;  // Move along.
     }
@@ -505,10 +640,16 @@ void IRrecv::crudeNoiseFilter(decode_results *results, const uint16_t floor) {
 /// @return A boolean indicating if an IR message is ready or not.
 bool IRrecv::decode(decode_results *results, irparams_t *save,
                     uint8_t max_skip, uint16_t noise_floor) {
-  // Proceed only if an IR message been received.
 #ifndef UNIT_TEST
-  if (params.rcvstate != kStopState) return false;
-#endif
+  const bool use_params = true;
+#else  // UNIT_TEST
+  // Without a capture driver, tests supply their own `results->rawbuf`.
+  const bool use_params = (_driver != NULL);
+#endif  // UNIT_TEST
+  // Give batch/polled capture drivers a chance to deliver what they have.
+  if (_driver != NULL) _driver->poll();
+  // Proceed only if an IR message been received.
+  if (use_params && params.rcvstate != kStopState) return false;
 
   // Clear the entry we are currently pointing to when we got the timeout.
   // i.e. Stopped collecting IR data.
@@ -520,20 +661,21 @@ bool IRrecv::decode(decode_results *results, irparams_t *save,
   // resume() but that is a much more expensive operation compare to this.
   // However, don't do this if rawbuf is already full as we stomp over the heap.
   // See: https://github.com/crankyoldgit/IRremoteESP8266/issues/1516
-  if (!params.overflow) params.rawbuf[params.rawlen] = 0;
+  if (use_params && !params.overflow) params.rawbuf[params.rawlen] = 0;
 
   bool resumed = false;  // Flag indicating if we have resumed.
 
   // If we were requested to use a save buffer previously, do so.
-  if (save == NULL) save = params_save;
+  if (use_params && save == NULL) save = params_save;
 
-  if (save == NULL) {
+  if (!use_params) {
+    // The caller supplied `results->rawbuf`. Leave the capture state, which is
+    // shared by every IRrecv object, alone. Others may be decoding with theirs.
+  } else if (save == NULL) {
     // We haven't been asked to copy it so use the existing memory.
-#ifndef UNIT_TEST
     results->rawbuf = params.rawbuf;
     results->rawlen = params.rawlen;
     results->overflow = params.overflow;
-#endif
   } else {
     copyIrParams(&params, save);  // Duplicate the interrupt's memory.
     resume();  // It's now safe to rearm. The IR message won't be overridden.
@@ -552,44 +694,127 @@ bool IRrecv::decode(decode_results *results, irparams_t *save,
   results->command = 0;
   results->repeat = false;
 
+  IR_METRIC_INC(kRecvMessages);
+  if (results->overflow) IR_METRIC_INC(kRecvOverflow);
+  IR_METRIC_SET(kRecvLastLength, results->rawlen);
 #if ENABLE_NOISE_FILTER_OPTION
   crudeNoiseFilter(results, noise_floor);
 #endif  // ENABLE_NOISE_FILTER_OPTION
   // Keep looking for protocols until we've run out of entries to skip or we
   // find a valid protocol message.
-  for (uint16_t offset = kStartOffset;
-       offset <= (max_skip * 2) + kStartOffset;
-       offset += 2) {
+  if (_runner != NULL && _runner->parts() > 1) {
+    if (decodeParallel(results, max_skip)) return true;
+  } else {
+    for (uint16_t offset = kStartOffset;
+         offset <= (max_skip * 2) + kStartOffset;
+         offset += 2)
+      if (decodeCascade(results, offset)) return true;
+  }
+#if DECODE_HASH
+  // decodeHash returns a hash on any input.
+  // Thus, it needs to be last in the list.
+  // If you add any decodes, add them before this.
+  if (decodeHash(results)) {
+    IR_METRIC_INC(kRecvUnknown);
+    return true;
+  }
+#endif  // DECODE_HASH
+  IR_METRIC_INC(kRecvMissed);
+  // Throw away and start over
+  if (use_params && !resumed)  // Check if we have already resumed.
+    resume();
+  return false;
+}
+
+/// The work shared by the parts of a parallel decode.
+struct decode_job_t {
+  IRrecv *irrecv;
+  uint16_t offset;
+  uint8_t parts;
+  bool head;  ///< Only try the (serial) head of the cascade?
+  decode_results results[kDecodeMaxParts];  ///< Each part's own copy.
+  uint16_t position[kDecodeMaxParts];  ///< Where each part matched. 0 is none.
+  /// The earliest position any part has matched at so far. The parts skip any
+  /// decoder after it, as it can no longer win.
+#if defined(UNIT_TEST) || defined(ESP32)
+  std::atomic<uint16_t> best;
+#else  // defined(UNIT_TEST) || defined(ESP32)
+  uint16_t best;  // Nothing here can run the parts at the same time.
+#endif  // defined(UNIT_TEST) || defined(ESP32)
+};
+
+/// The earliest position any part of a parallel decode has matched at so far.
+/// @param[in] job The parallel decode.
+/// @return The position in the cascade. UINT16_MAX if none have matched.
+static uint16_t bestPosition(const decode_job_t *job) {
+#if defined(UNIT_TEST) || defined(ESP32)
+  return job->best.load(std::memory_order_relaxed);
+#else  // defined(UNIT_TEST) || defined(ESP32)
+  return job->best;
+#endif  // defined(UNIT_TEST) || defined(ESP32)
+}
+
+/// Should a part of a decode try the next decoder in the cascade?
+/// @param[in] job The parallel decode.
+/// @param[in] part Which part is asking.
+/// @param[in] position The decoder's position in the cascade. (from 1)
+/// @param[in] head Is the decoder in the head of the cascade?
+/// @return true, if it should be tried.
+static bool tryDecoder(const decode_job_t *job, const uint8_t part,
+                       const uint16_t position, const bool head) {
+  if (head || job->head) return head && job->head;
+  return position % job->parts == part && position < bestPosition(job);
+}
+
+/// Try each of the enabled protocol decoders, in order, at an offset.
+/// @param[in,out] results Ptr to the data to decode & where to store it.
+/// @param[in] offset Index of the first entry in the capture buffer to use.
+/// @param[in] job The parallel decode this is a part of. NULL means try every
+///   decoder.
+/// @param[in] part Which part of the `job` this is.
+/// @return The position in the cascade (from 1) of the decoder that matched,
+///   or 0 if none did.
+/// @note The order matters. Some protocols look like others, so the more
+///   specific ones need to be tried first. (See the comments below.) A
+///   parallel decode keeps to that order by preferring the match with the
+///   lowest position, no matter which part found it.
+uint16_t IRrecv::decodeCascade(decode_results *results, const uint16_t offset,
+                               decode_job_t *job, const uint8_t part) {
+  uint16_t position = 0;
+  bool head = true;  // Are we still in the head of the cascade?
+// Should we (or our part of a parallel decode) try the next decoder?
+#define TRY_NEXT_DECODER \
+    (++position, job == NULL || tryDecoder(job, part, position, head))
 #if DECODE_AIWA_RC_T501
-    DPRINTLN("Attempting Aiwa RC T501 decode");
-    // Try decodeAiwaRCT501() before decodeSanyoLC7461() & decodeNEC()
-    // because the protocols are similar. This protocol is more specific than
-    // those ones, so should go before them.
-    if (decodeAiwaRCT501(results, offset)) return true;
+  DPRINTLN("Attempting Aiwa RC T501 decode");
+  // Try decodeAiwaRCT501() before decodeSanyoLC7461() & decodeNEC()
+  // because the protocols are similar. This protocol is more specific than
+  // those ones, so should go before them.
+  if (TRY_NEXT_DECODER && decodeAiwaRCT501(results, offset)) return position;
 #endif
 #if DECODE_SANYO
-    DPRINTLN("Attempting Sanyo LC7461 decode");
-    // Try decodeSanyoLC7461() before decodeNEC() because the protocols are
-    // similar in timings & structure, but the Sanyo one is much longer than the
-    // NEC protocol (42 vs 32 bits) so this one should be tried first to try to
-    // reduce false detection as a NEC packet.
-    if (decodeSanyoLC7461(results, offset)) return true;
+  DPRINTLN("Attempting Sanyo LC7461 decode");
+  // Try decodeSanyoLC7461() before decodeNEC() because the protocols are
+  // similar in timings & structure, but the Sanyo one is much longer than the
+  // NEC protocol (42 vs 32 bits) so this one should be tried first to try to
+  // reduce false detection as a NEC packet.
+  if (TRY_NEXT_DECODER && decodeSanyoLC7461(results, offset)) return position;
 #endif
 #if DECODE_CARRIER_AC
-    DPRINTLN("Attempting Carrier AC decode");
-    // Try decodeCarrierAC() before decodeNEC() because the protocols are
-    // similar in timings & structure, but the Carrier one is much longer than
-    // the NEC protocol (3x32 bits vs 1x32 bits) so this one should be tried
-    // first to try to reduce false detection as a NEC packet.
-    if (decodeCarrierAC(results, offset)) return true;
+  DPRINTLN("Attempting Carrier AC decode");
+  // Try decodeCarrierAC() before decodeNEC() because the protocols are
+  // similar in timings & structure, but the Carrier one is much longer than
+  // the NEC protocol (3x32 bits vs 1x32 bits) so this one should be tried
+  // first to try to reduce false detection as a NEC packet.
+  if (TRY_NEXT_DECODER && decodeCarrierAC(results, offset)) return position;
 #endif
 #if DECODE_PIONEER
-    DPRINTLN("Attempting Pioneer decode");
-    // Try decodePioneer() before decodeNEC() because the protocols are
-    // similar in timings & structure, but the Pioneer one is much longer than
-    // the NEC protocol (2x32 bits vs 1x32 bits) so this one should be tried
-    // first to try to reduce false detection as a NEC packet.
-    if (decodePioneer(results, offset)) return true;
+  DPRINTLN("Attempting Pioneer decode");
+  // Try decodePioneer() before decodeNEC() because the protocols are
+  // similar in timings & structure, but the Pioneer one is much longer than
+  // the NEC protocol (2x32 bits vs 1x32 bits) so this one should be tried
+  // first to try to reduce false detection as a NEC packet.
+  if (TRY_NEXT_DECODER && decodePioneer(results, offset)) return position;
 #endif
 #if DECODE_EPSON
   DPRINTLN("Attempting Epson decode");
@@ -597,466 +822,473 @@ bool IRrecv::decode(decode_results *results, irparams_t *save,
   // similar in timings & structure, but the Epson one is much longer than the
   // NEC protocol (3x32 identical bits vs 1x32 bits) so this one should be tried
   // first to try to reduce false detection as a NEC packet.
-  if (decodeEpson(results, offset)) return true;
+  if (TRY_NEXT_DECODER && decodeEpson(results, offset)) return position;
 #endif
 #if DECODE_NEC
-    DPRINTLN("Attempting NEC decode");
-    if (decodeNEC(results, offset)) return true;
+  DPRINTLN("Attempting NEC decode");
+  if (TRY_NEXT_DECODER && decodeNEC(results, offset)) return position;
 #endif
 #if DECODE_MILESTAG2
-    DPRINTLN("Attempting MilesTag2 decode");
+  DPRINTLN("Attempting MilesTag2 decode");
   // Try decodeMilestag2() before decodeSony() because the protocols are
   // similar in timings & structure, but the Miles one differs in nbits
   // so this one should be tried first to try to reduce false detection
-    if (decodeMilestag2(results, offset, kMilesTag2MsgBits) ||
-        decodeMilestag2(results, offset, kMilesTag2ShotBits)) return true;
+  if (TRY_NEXT_DECODER &&
+      (decodeMilestag2(results, offset, kMilesTag2MsgBits) ||
+       decodeMilestag2(results, offset, kMilesTag2ShotBits)))
+    return position;
 #endif
 #if DECODE_SONY
-    DPRINTLN("Attempting Sony decode");
-    if (decodeSony(results, offset)) return true;
+  DPRINTLN("Attempting Sony decode");
+  if (TRY_NEXT_DECODER && decodeSony(results, offset)) return position;
 #endif
 #if DECODE_MITSUBISHI
-    DPRINTLN("Attempting Mitsubishi decode");
-    if (decodeMitsubishi(results, offset)) return true;
+  DPRINTLN("Attempting Mitsubishi decode");
+  if (TRY_NEXT_DECODER && decodeMitsubishi(results, offset)) return position;
 #endif
 #if DECODE_MITSUBISHI_AC
-    DPRINTLN("Attempting Mitsubishi AC decode");
-    if (decodeMitsubishiAC(results, offset)) return true;
+  DPRINTLN("Attempting Mitsubishi AC decode");
+  if (TRY_NEXT_DECODER && decodeMitsubishiAC(results, offset)) return position;
 #endif
 #if DECODE_MITSUBISHI2
-    DPRINTLN("Attempting Mitsubishi2 decode");
-    if (decodeMitsubishi2(results, offset)) return true;
+  DPRINTLN("Attempting Mitsubishi2 decode");
+  if (TRY_NEXT_DECODER && decodeMitsubishi2(results, offset)) return position;
 #endif
 #if DECODE_RC5
-    DPRINTLN("Attempting RC5 decode");
-    if (decodeRC5(results, offset)) return true;
+  DPRINTLN("Attempting RC5 decode");
+  if (TRY_NEXT_DECODER && decodeRC5(results, offset)) return position;
 #endif
 #if DECODE_RC6
-    DPRINTLN("Attempting RC6 decode");
-    if (decodeRC6(results, offset)) return true;
+  DPRINTLN("Attempting RC6 decode");
+  if (TRY_NEXT_DECODER && decodeRC6(results, offset)) return position;
 #endif
 #if DECODE_RCMM
-    DPRINTLN("Attempting RC-MM decode");
-    if (decodeRCMM(results, offset)) return true;
+  DPRINTLN("Attempting RC-MM decode");
+  if (TRY_NEXT_DECODER && decodeRCMM(results, offset)) return position;
 #endif
 #if DECODE_FUJITSU_AC
-    // Fujitsu A/C needs to precede Panasonic and Denon as it has a short
-    // message which looks exactly the same as a Panasonic/Denon message.
-    DPRINTLN("Attempting Fujitsu A/C decode");
-    if (decodeFujitsuAC(results, offset)) return true;
+  // Fujitsu A/C needs to precede Panasonic and Denon as it has a short
+  // message which looks exactly the same as a Panasonic/Denon message.
+  DPRINTLN("Attempting Fujitsu A/C decode");
+  if (TRY_NEXT_DECODER && decodeFujitsuAC(results, offset)) return position;
 #endif
 #if DECODE_DENON
-    // Denon needs to precede Panasonic as it is a special case of Panasonic.
-    DPRINTLN("Attempting Denon decode");
-    if (decodeDenon(results, offset, kDenon48Bits) ||
-        decodeDenon(results, offset, kDenonBits) ||
-        decodeDenon(results, offset, kDenonLegacyBits))
-      return true;
+  // Denon needs to precede Panasonic as it is a special case of Panasonic.
+  DPRINTLN("Attempting Denon decode");
+  if (TRY_NEXT_DECODER &&
+      (decodeDenon(results, offset, kDenon48Bits) ||
+       decodeDenon(results, offset, kDenonBits) ||
+       decodeDenon(results, offset, kDenonLegacyBits)))
+    return position;
 #endif
 #if DECODE_PANASONIC
-    DPRINTLN("Attempting Panasonic decode");
-    if (decodePanasonic(results, offset)) return true;
+  DPRINTLN("Attempting Panasonic decode");
+  if (TRY_NEXT_DECODER && decodePanasonic(results, offset)) return position;
 #endif
 #if DECODE_LG
-    DPRINTLN("Attempting LG (28-bit) decode");
-    if (decodeLG(results, offset, kLgBits, true)) return true;
-    DPRINTLN("Attempting LG (32-bit) decode");
-    // LG32 should be tried before Samsung
-    if (decodeLG(results, offset, kLg32Bits, true)) return true;
+  DPRINTLN("Attempting LG (28-bit) decode");
+  if (TRY_NEXT_DECODER && decodeLG(results, offset, kLgBits, true))
+    return position;
+  DPRINTLN("Attempting LG (32-bit) decode");
+  // LG32 should be tried before Samsung
+  if (TRY_NEXT_DECODER && decodeLG(results, offset, kLg32Bits, true))
+    return position;
 #endif
 #if DECODE_GICABLE
-    // Note: Needs to happen before JVC decode, because it looks similar except
-    //       with a required NEC-like repeat code.
-    DPRINTLN("Attempting GICable decode");
-    if (decodeGICable(results, offset)) return true;
+  // Note: Needs to happen before JVC decode, because it looks similar except
+  //       with a required NEC-like repeat code.
+  DPRINTLN("Attempting GICable decode");
+  if (TRY_NEXT_DECODER && decodeGICable(results, offset)) return position;
 #endif
 #if DECODE_JVC
-    DPRINTLN("Attempting JVC decode");
-    if (decodeJVC(results, offset)) return true;
+  DPRINTLN("Attempting JVC decode");
+  if (TRY_NEXT_DECODER && decodeJVC(results, offset)) return position;
 #endif
 #if DECODE_SAMSUNG
-    DPRINTLN("Attempting SAMSUNG decode");
-    if (decodeSAMSUNG(results, offset)) return true;
+  DPRINTLN("Attempting SAMSUNG decode");
+  if (TRY_NEXT_DECODER && decodeSAMSUNG(results, offset)) return position;
 #endif
 #if DECODE_SAMSUNG36
-    DPRINTLN("Attempting Samsung36 decode");
-    if (decodeSamsung36(results, offset)) return true;
+  DPRINTLN("Attempting Samsung36 decode");
+  if (TRY_NEXT_DECODER && decodeSamsung36(results, offset)) return position;
 #endif
 #if DECODE_WHYNTER
-    DPRINTLN("Attempting Whynter decode");
-    if (decodeWhynter(results, offset)) return true;
+  DPRINTLN("Attempting Whynter decode");
+  if (TRY_NEXT_DECODER && decodeWhynter(results, offset)) return position;
 #endif
 #if DECODE_DISH
-    DPRINTLN("Attempting DISH decode");
-    if (decodeDISH(results, offset)) return true;
+  DPRINTLN("Attempting DISH decode");
+  if (TRY_NEXT_DECODER && decodeDISH(results, offset)) return position;
 #endif
 #if DECODE_SHARP
-    DPRINTLN("Attempting Sharp decode");
-    if (decodeSharp(results, offset)) return true;
+  DPRINTLN("Attempting Sharp decode");
+  if (TRY_NEXT_DECODER && decodeSharp(results, offset)) return position;
 #endif
+  // The protocols above are common & quick to rule out, so a parallel decode
+  // tries them first, on this thread, & only splits up the ones below. Most
+  // messages then never pay for handing work off to another thread.
+  if (job != NULL && job->head) return 0;
+  head = false;
 #if DECODE_COOLIX
-    DPRINTLN("Attempting Coolix decode");
-    if (decodeCOOLIX(results, offset)) return true;
+  DPRINTLN("Attempting Coolix decode");
+  if (TRY_NEXT_DECODER && decodeCOOLIX(results, offset)) return position;
 #endif
 #if DECODE_NIKAI
-    DPRINTLN("Attempting Nikai decode");
-    if (decodeNikai(results, offset)) return true;
+  DPRINTLN("Attempting Nikai decode");
+  if (TRY_NEXT_DECODER && decodeNikai(results, offset)) return position;
 #endif
 #if DECODE_KELVINATOR
-    // Kelvinator based-devices use a similar code to Gree ones, to avoid false
-    // matches this needs to happen before decodeGree().
-    DPRINTLN("Attempting Kelvinator decode");
-    if (decodeKelvinator(results, offset)) return true;
-#endif
-#if DECODE_DAIKIN
-    DPRINTLN("Attempting Daikin decode");
-    if (decodeDaikin(results, offset)) return true;
-#endif
-#if DECODE_DAIKIN2
-    DPRINTLN("Attempting Daikin2 decode");
-    if (decodeDaikin2(results, offset)) return true;
-#endif
-#if DECODE_DAIKIN216
-    DPRINTLN("Attempting Daikin216 decode");
-    if (decodeDaikin216(results, offset)) return true;
+  // Kelvinator based-devices use a similar code to Gree ones, to avoid false
+  // matches this needs to happen before decodeGree().
+  DPRINTLN("Attempting Kelvinator decode");
+  if (TRY_NEXT_DECODER && decodeKelvinator(results, offset)) return position;
 #endif
+#if DECODE_DAIKIN_FAMILY
+  // All of the Daikin variants.
+  if (TRY_NEXT_DECODER && decodeDaikinFamily(results, offset)) return position;
+#endif  // DECODE_DAIKIN_FAMILY
 #if DECODE_TOSHIBA_AC
-    DPRINTLN("Attempting Toshiba AC 72bit decode");
-    if (decodeToshibaAC(results, offset)) return true;
-    DPRINTLN("Attempting Toshiba AC 80bit decode");
-    if (decodeToshibaAC(results, offset, kToshibaACBitsLong)) return true;
-    DPRINTLN("Attempting Toshiba AC 56bit decode");
-    if (decodeToshibaAC(results, offset, kToshibaACBitsShort)) return true;
+  DPRINTLN("Attempting Toshiba AC 72bit decode");
+  if (TRY_NEXT_DECODER && decodeToshibaAC(results, offset)) return position;
+  DPRINTLN("Attempting Toshiba AC 80bit decode");
+  if (TRY_NEXT_DECODER && decodeToshibaAC(results, offset, kToshibaACBitsLong))
+    return position;
+  DPRINTLN("Attempting Toshiba AC 56bit decode");
+  if (TRY_NEXT_DECODER && decodeToshibaAC(results, offset, kToshibaACBitsShort))
+    return position;
 #endif
 #if DECODE_MIDEA
-    DPRINTLN("Attempting Midea decode");
-    if (decodeMidea(results, offset)) return true;
+  DPRINTLN("Attempting Midea decode");
+  if (TRY_NEXT_DECODER && decodeMidea(results, offset)) return position;
 #endif
 #if DECODE_MAGIQUEST
-    DPRINTLN("Attempting Magiquest decode");
-    if (decodeMagiQuest(results, offset)) return true;
+  DPRINTLN("Attempting Magiquest decode");
+  if (TRY_NEXT_DECODER && decodeMagiQuest(results, offset)) return position;
 #endif
   /* NOTE: Disabled due to poor quality.
 #if DECODE_SANYO
-    // The Sanyo S866500B decoder is very poor quality & depricated.
-    // *IF* you are going to enable it, do it near last to avoid false positive
-    // matches.
-    DPRINTLN("Attempting Sanyo SA8650B decode");
-    if (decodeSanyo(results, offset))
-      return true;
+  // The Sanyo S866500B decoder is very poor quality & depricated.
+  // *IF* you are going to enable it, do it near last to avoid false positive
+  // matches.
+  DPRINTLN("Attempting Sanyo SA8650B decode");
+  if (decodeSanyo(results, offset))
+    return true;
 #endif
   */
 #if DECODE_NEC
-    // Some devices send NEC-like codes that don't follow the true NEC spec.
-    // This should detect those. e.g. Apple TV remote etc.
-    // This needs to be done after all other codes that use strict and some
-    // other protocols that are NEC-like as well, as turning off strict may
-    // cause this to match other valid protocols.
-    DPRINTLN("Attempting NEC (non-strict) decode");
-    if (decodeNEC(results, offset, kNECBits, false)) {
-      results->decode_type = NEC_LIKE;
-      return true;
-    }
+  // Some devices send NEC-like codes that don't follow the true NEC spec.
+  // This should detect those. e.g. Apple TV remote etc.
+  // This needs to be done after all other codes that use strict and some
+  // other protocols that are NEC-like as well, as turning off strict may
+  // cause this to match other valid protocols.
+  DPRINTLN("Attempting NEC (non-strict) decode");
+  if (TRY_NEXT_DECODER && decodeNEC(results, offset, kNECBits, false)) {
+    results->decode_type = NEC_LIKE;
+    return position;
+  }
 #endif
 #if DECODE_LASERTAG
-    DPRINTLN("Attempting Lasertag decode");
-    if (decodeLasertag(results, offset)) return true;
+  DPRINTLN("Attempting Lasertag decode");
+  if (TRY_NEXT_DECODER && decodeLasertag(results, offset)) return position;
 #endif
 #if DECODE_GREE
-    // Gree based-devices use a similar code to Kelvinator ones, to avoid false
-    // matches this needs to happen after decodeKelvinator().
-    DPRINTLN("Attempting Gree decode");
-    if (decodeGree(results, offset)) return true;
+  // Gree based-devices use a similar code to Kelvinator ones, to avoid false
+  // matches this needs to happen after decodeKelvinator().
+  DPRINTLN("Attempting Gree decode");
+  if (TRY_NEXT_DECODER && decodeGree(results, offset)) return position;
 #endif
 #if DECODE_HAIER_AC
-    DPRINTLN("Attempting Haier AC decode");
-    if (decodeHaierAC(results, offset)) return true;
+  DPRINTLN("Attempting Haier AC decode");
+  if (TRY_NEXT_DECODER && decodeHaierAC(results, offset)) return position;
 #endif
 #if DECODE_HAIER_AC_YRW02
-    DPRINTLN("Attempting Haier AC YR-W02 decode");
-    if (decodeHaierACYRW02(results, offset)) return true;
+  DPRINTLN("Attempting Haier AC YR-W02 decode");
+  if (TRY_NEXT_DECODER && decodeHaierACYRW02(results, offset)) return position;
 #endif
 #if DECODE_HAIER_AC176
-    DPRINTLN("Attempting Haier AC 176 bit decode");
-    if (decodeHaierAC176(results, offset)) return true;
+  DPRINTLN("Attempting Haier AC 176 bit decode");
+  if (TRY_NEXT_DECODER && decodeHaierAC176(results, offset)) return position;
 #endif  // DECODE_HAIER_AC176
-#if DECODE_HITACHI_AC424
-    // HitachiAc424 should be checked before HitachiAC, HitachiAC2,
-    // & HitachiAC184
-    DPRINTLN("Attempting Hitachi AC 424 decode");
-    if (decodeHitachiAc424(results, offset, kHitachiAc424Bits)) return true;
-#endif  // DECODE_HITACHI_AC424
 #if DECODE_MITSUBISHI136
-    // Needs to happen before HitachiAc3 decode.
-    DPRINTLN("Attempting Mitsubishi136 decode");
-    if (decodeMitsubishi136(results, offset)) return true;
+  // Needs to happen before the Hitachi family's HitachiAc3 decode.
+  DPRINTLN("Attempting Mitsubishi136 decode");
+  if (TRY_NEXT_DECODER && decodeMitsubishi136(results, offset)) return position;
 #endif  // DECODE_MITSUBISHI136
-#if DECODE_HITACHI_AC3
-    // HitachiAc3 should be checked before HitachiAC & HitachiAC2
-    // Attempt normal before the short version.
-    DPRINTLN("Attempting Hitachi AC3 decode");
-    // Order these in decreasing bit size, as it is more optimal.
-    if (decodeHitachiAc3(results, offset, kHitachiAc3Bits) ||
-        decodeHitachiAc3(results, offset, kHitachiAc3Bits - 4 * 8) ||
-        decodeHitachiAc3(results, offset, kHitachiAc3Bits - 6 * 8) ||
-        decodeHitachiAc3(results, offset, kHitachiAc3MinBits + 2 * 8) ||
-        decodeHitachiAc3(results, offset, kHitachiAc3MinBits))
-      return true;
-#endif  // DECODE_HITACHI_AC3
-#if DECODE_HITACHI_AC344
-    // HitachiAC344 should be checked before HitachiAC
-    DPRINTLN("Attempting Hitachi AC344 decode");
-    if (decodeHitachiAC(results, offset, kHitachiAc344Bits, true, false))
-      return true;
-#endif  // DECODE_HITACHI_AC344
-#if DECODE_HITACHI_AC2
-    // HitachiAC2 should be checked before HitachiAC
-    DPRINTLN("Attempting Hitachi AC2 decode");
-    if (decodeHitachiAC(results, offset, kHitachiAc2Bits)) return true;
-#endif  // DECODE_HITACHI_AC2
-#if DECODE_HITACHI_AC
-    DPRINTLN("Attempting Hitachi AC decode");
-    if (decodeHitachiAC(results, offset, kHitachiAcBits)) return true;
-#endif
-#if DECODE_HITACHI_AC1
-    DPRINTLN("Attempting Hitachi AC1 decode");
-    if (decodeHitachiAC(results, offset, kHitachiAc1Bits)) return true;
-#endif
+#if DECODE_HITACHI_FAMILY
+  // All of the Hitachi A/C variants.
+  if (TRY_NEXT_DECODER && decodeHitachiFamily(results, offset))
+    return position;
+#endif  // DECODE_HITACHI_FAMILY
 #if DECODE_WHIRLPOOL_AC
-    DPRINTLN("Attempting Whirlpool AC decode");
-    if (decodeWhirlpoolAC(results, offset)) return true;
+  DPRINTLN("Attempting Whirlpool AC decode");
+  if (TRY_NEXT_DECODER && decodeWhirlpoolAC(results, offset)) return position;
 #endif
 #if DECODE_SAMSUNG_AC
-    DPRINTLN("Attempting Samsung AC (extended) decode");
-    // Check the extended size first, as it should fail fast due to longer
-    // length.
-    if (decodeSamsungAC(results, offset, kSamsungAcExtendedBits, false))
-      return true;
-    // Now check for the more common length.
-    DPRINTLN("Attempting Samsung AC decode");
-    if (decodeSamsungAC(results, offset, kSamsungAcBits)) return true;
+  DPRINTLN("Attempting Samsung AC (extended) decode");
+  // Check the extended size first, as it should fail fast due to longer
+  // length.
+  if (TRY_NEXT_DECODER &&
+      decodeSamsungAC(results, offset, kSamsungAcExtendedBits, false))
+    return position;
+  // Now check for the more common length.
+  DPRINTLN("Attempting Samsung AC decode");
+  if (TRY_NEXT_DECODER && decodeSamsungAC(results, offset, kSamsungAcBits))
+    return position;
 #endif
 #if DECODE_ELECTRA_AC
-    DPRINTLN("Attempting Electra AC decode");
-    if (decodeElectraAC(results, offset)) return true;
+  DPRINTLN("Attempting Electra AC decode");
+  if (TRY_NEXT_DECODER && decodeElectraAC(results, offset)) return position;
 #endif
 #if DECODE_PANASONIC_AC
-    DPRINTLN("Attempting Panasonic AC decode");
-    if (decodePanasonicAC(results, offset)) return true;
-    DPRINTLN("Attempting Panasonic AC short decode");
-    if (decodePanasonicAC(results, offset, kPanasonicAcShortBits)) return true;
+  DPRINTLN("Attempting Panasonic AC decode");
+  if (TRY_NEXT_DECODER && decodePanasonicAC(results, offset)) return position;
+  DPRINTLN("Attempting Panasonic AC short decode");
+  if (TRY_NEXT_DECODER &&
+      decodePanasonicAC(results, offset, kPanasonicAcShortBits))
+    return position;
 #endif
 #if DECODE_LUTRON
-    DPRINTLN("Attempting Lutron decode");
-    if (decodeLutron(results, offset)) return true;
+  DPRINTLN("Attempting Lutron decode");
+  if (TRY_NEXT_DECODER && decodeLutron(results, offset)) return position;
 #endif
 #if DECODE_MWM
-    DPRINTLN("Attempting MWM decode");
-    if (decodeMWM(results, offset)) return true;
+  DPRINTLN("Attempting MWM decode");
+  if (TRY_NEXT_DECODER && decodeMWM(results, offset)) return position;
 #endif
 #if DECODE_VESTEL_AC
-    DPRINTLN("Attempting Vestel AC decode");
-    if (decodeVestelAc(results, offset)) return true;
+  DPRINTLN("Attempting Vestel AC decode");
+  if (TRY_NEXT_DECODER && decodeVestelAc(results, offset)) return position;
 #endif
 #if DECODE_MITSUBISHI112 || DECODE_TCL112AC
-    // Mitsubish112 and Tcl112 share the same decoder.
-    DPRINTLN("Attempting Mitsubishi112/TCL112AC decode");
-    if (decodeMitsubishi112(results, offset)) return true;
+  // Mitsubish112 and Tcl112 share the same decoder.
+  DPRINTLN("Attempting Mitsubishi112/TCL112AC decode");
+  if (TRY_NEXT_DECODER && decodeMitsubishi112(results, offset)) return position;
 #endif  // DECODE_MITSUBISHI112 || DECODE_TCL112AC
 #if DECODE_TECO
-    DPRINTLN("Attempting Teco decode");
-    if (decodeTeco(results, offset)) return true;
+  DPRINTLN("Attempting Teco decode");
+  if (TRY_NEXT_DECODER && decodeTeco(results, offset)) return position;
 #endif
 #if DECODE_LEGOPF
-    DPRINTLN("Attempting LEGOPF decode");
-    if (decodeLegoPf(results, offset)) return true;
+  DPRINTLN("Attempting LEGOPF decode");
+  if (TRY_NEXT_DECODER && decodeLegoPf(results, offset)) return position;
 #endif
 #if DECODE_MITSUBISHIHEAVY
-    DPRINTLN("Attempting MITSUBISHIHEAVY (152 bit) decode");
-    if (decodeMitsubishiHeavy(results, offset, kMitsubishiHeavy152Bits))
-      return true;
-    DPRINTLN("Attempting MITSUBISHIHEAVY (88 bit) decode");
-    if (decodeMitsubishiHeavy(results, offset, kMitsubishiHeavy88Bits))
-      return true;
+  DPRINTLN("Attempting MITSUBISHIHEAVY (152 bit) decode");
+  if (TRY_NEXT_DECODER &&
+      decodeMitsubishiHeavy(results, offset, kMitsubishiHeavy152Bits))
+    return position;
+  DPRINTLN("Attempting MITSUBISHIHEAVY (88 bit) decode");
+  if (TRY_NEXT_DECODER &&
+      decodeMitsubishiHeavy(results, offset, kMitsubishiHeavy88Bits))
+    return position;
 #endif
 #if DECODE_ARGO
-    DPRINTLN("Attempting Argo decode");
-    if (decodeArgo(results, offset)) return true;
+  DPRINTLN("Attempting Argo decode");
+  if (TRY_NEXT_DECODER && decodeArgo(results, offset)) return position;
 #endif  // DECODE_ARGO
 #if DECODE_SHARP_AC
-    DPRINTLN("Attempting SHARP_AC decode");
-    if (decodeSharpAc(results, offset)) return true;
+  DPRINTLN("Attempting SHARP_AC decode");
+  if (TRY_NEXT_DECODER && decodeSharpAc(results, offset)) return position;
 #endif
 #if DECODE_GOODWEATHER
-    DPRINTLN("Attempting GOODWEATHER decode");
-    if (decodeGoodweather(results, offset)) return true;
+  DPRINTLN("Attempting GOODWEATHER decode");
+  if (TRY_NEXT_DECODER && decodeGoodweather(results, offset)) return position;
 #endif  // DECODE_GOODWEATHER
 #if DECODE_INAX
-    DPRINTLN("Attempting Inax decode");
-    if (decodeInax(results, offset)) return true;
+  DPRINTLN("Attempting Inax decode");
+  if (TRY_NEXT_DECODER && decodeInax(results, offset)) return position;
 #endif  // DECODE_INAX
 #if DECODE_TROTEC
-    DPRINTLN("Attempting Trotec decode");
-    if (decodeTrotec(results, offset)) return true;
+  DPRINTLN("Attempting Trotec decode");
+  if (TRY_NEXT_DECODER && decodeTrotec(results, offset)) return position;
 #endif  // DECODE_TROTEC
 #if DECODE_TROTEC_3550
-    DPRINTLN("Attempting Trotec 3550 decode");
-    if (decodeTrotec3550(results, offset)) return true;
+  DPRINTLN("Attempting Trotec 3550 decode");
+  if (TRY_NEXT_DECODER && decodeTrotec3550(results, offset)) return position;
 #endif  // DECODE_TROTEC_3550
-#if DECODE_DAIKIN160
-    DPRINTLN("Attempting Daikin160 decode");
-    if (decodeDaikin160(results, offset)) return true;
-#endif  // DECODE_DAIKIN160
 #if DECODE_NEOCLIMA
-    DPRINTLN("Attempting Neoclima decode");
-    if (decodeNeoclima(results, offset)) return true;
+  DPRINTLN("Attempting Neoclima decode");
+  if (TRY_NEXT_DECODER && decodeNeoclima(results, offset)) return position;
 #endif  // DECODE_NEOCLIMA
-#if DECODE_DAIKIN176
-    DPRINTLN("Attempting Daikin176 decode");
-    if (decodeDaikin176(results, offset)) return true;
-#endif  // DECODE_DAIKIN176
-#if DECODE_DAIKIN128
-    DPRINTLN("Attempting Daikin128 decode");
-    if (decodeDaikin128(results, offset)) return true;
-#endif  // DECODE_DAIKIN128
 #if DECODE_AMCOR
-    DPRINTLN("Attempting Amcor decode");
-    if (decodeAmcor(results, offset)) return true;
+  DPRINTLN("Attempting Amcor decode");
+  if (TRY_NEXT_DECODER && decodeAmcor(results, offset)) return position;
 #endif  // DECODE_AMCOR
-#if DECODE_DAIKIN152
-    DPRINTLN("Attempting Daikin152 decode");
-    if (decodeDaikin152(results, offset)) return true;
-#endif  // DECODE_DAIKIN152
 #if DECODE_SYMPHONY
-    DPRINTLN("Attempting Symphony decode");
-    if (decodeSymphony(results, offset)) return true;
+  DPRINTLN("Attempting Symphony decode");
+  if (TRY_NEXT_DECODER && decodeSymphony(results, offset)) return position;
 #endif  // DECODE_SYMPHONY
-#if DECODE_DAIKIN64
-    DPRINTLN("Attempting Daikin64 decode");
-    if (decodeDaikin64(results, offset)) return true;
-#endif  // DECODE_DAIKIN64
 #if DECODE_AIRWELL
-    DPRINTLN("Attempting Airwell decode");
-    if (decodeAirwell(results, offset)) return true;
+  DPRINTLN("Attempting Airwell decode");
+  if (TRY_NEXT_DECODER && decodeAirwell(results, offset)) return position;
 #endif  // DECODE_AIRWELL
 #if DECODE_DELONGHI_AC
-    DPRINTLN("Attempting Delonghi AC decode");
-    if (decodeDelonghiAc(results, offset)) return true;
+  DPRINTLN("Attempting Delonghi AC decode");
+  if (TRY_NEXT_DECODER && decodeDelonghiAc(results, offset)) return position;
 #endif  // DECODE_DELONGHI_AC
 #if DECODE_DOSHISHA
-    DPRINTLN("Attempting Doshisha decode");
-    if (decodeDoshisha(results, offset)) return true;
+  DPRINTLN("Attempting Doshisha decode");
+  if (TRY_NEXT_DECODER && decodeDoshisha(results, offset)) return position;
 #endif  // DECODE_DOSHISHA
 #if DECODE_TRUMA
-    // Needs to happen before decodeMultibrackets() as they can appear similar.
-    DPRINTLN("Attempting Truma decode");
-    if (decodeTruma(results, offset)) return true;
+  // Needs to happen before decodeMultibrackets() as they can appear similar.
+  DPRINTLN("Attempting Truma decode");
+  if (TRY_NEXT_DECODER && decodeTruma(results, offset)) return position;
 #endif  // DECODE_TRUMA
 #if DECODE_MULTIBRACKETS
-    DPRINTLN("Attempting Multibrackets decode");
-    if (decodeMultibrackets(results, offset)) return true;
+  DPRINTLN("Attempting Multibrackets decode");
+  if (TRY_NEXT_DECODER && decodeMultibrackets(results, offset)) return position;
 #endif  // DECODE_MULTIBRACKETS
 #if DECODE_CARRIER_AC40
-    DPRINTLN("Attempting Carrier 40bit decode");
-    if (decodeCarrierAC40(results, offset)) return true;
+  DPRINTLN("Attempting Carrier 40bit decode");
+  if (TRY_NEXT_DECODER && decodeCarrierAC40(results, offset)) return position;
 #endif  // DECODE_CARRIER_AC40
 #if DECODE_CARRIER_AC64
-    DPRINTLN("Attempting Carrier 64bit decode");
-    if (decodeCarrierAC64(results, offset)) return true;
+  DPRINTLN("Attempting Carrier 64bit decode");
+  if (TRY_NEXT_DECODER && decodeCarrierAC64(results, offset)) return position;
 #endif  // DECODE_CARRIER_AC64
 #if DECODE_TECHNIBEL_AC
-    DPRINTLN("Attempting Technibel AC decode");
-    if (decodeTechnibelAc(results, offset)) return true;
+  DPRINTLN("Attempting Technibel AC decode");
+  if (TRY_NEXT_DECODER && decodeTechnibelAc(results, offset)) return position;
 #endif  // DECODE_TECHNIBEL_AC
 #if DECODE_CORONA_AC
-    DPRINTLN("Attempting CoronaAc decode");
-    if (decodeCoronaAc(results, offset)) return true;
+  DPRINTLN("Attempting CoronaAc decode");
+  if (TRY_NEXT_DECODER && decodeCoronaAc(results, offset)) return position;
 #endif  // DECODE_CORONA_AC
 #if DECODE_MIDEA24
-    DPRINTLN("Attempting Midea-Nec decode");
-    if (decodeMidea24(results, offset)) return true;
+  DPRINTLN("Attempting Midea-Nec decode");
+  if (TRY_NEXT_DECODER && decodeMidea24(results, offset)) return position;
 #endif  // DECODE_MIDEA24
 #if DECODE_ZEPEAL
-    DPRINTLN("Attempting Zepeal decode");
-    if (decodeZepeal(results, offset)) return true;
+  DPRINTLN("Attempting Zepeal decode");
+  if (TRY_NEXT_DECODER && decodeZepeal(results, offset)) return position;
 #endif  // DECODE_ZEPEAL
 #if DECODE_SANYO_AC
-    DPRINTLN("Attempting Sanyo AC decode");
-    if (decodeSanyoAc(results, offset)) return true;
+  DPRINTLN("Attempting Sanyo AC decode");
+  if (TRY_NEXT_DECODER && decodeSanyoAc(results, offset)) return position;
 #endif  // DECODE_SANYO_AC
 #if DECODE_VOLTAS
   DPRINTLN("Attempting Voltas decode");
-  if (decodeVoltas(results)) return true;
+  if (TRY_NEXT_DECODER && decodeVoltas(results)) return position;
 #endif  // DECODE_VOLTAS
 #if DECODE_METZ
-    DPRINTLN("Attempting Metz decode");
-    if (decodeMetz(results, offset)) return true;
+  DPRINTLN("Attempting Metz decode");
+  if (TRY_NEXT_DECODER && decodeMetz(results, offset)) return position;
 #endif  // DECODE_METZ
 #if DECODE_TRANSCOLD
-    DPRINTLN("Attempting Transcold decode");
-    if (decodeTranscold(results, offset)) return true;
+  DPRINTLN("Attempting Transcold decode");
+  if (TRY_NEXT_DECODER && decodeTranscold(results, offset)) return position;
 #endif  // DECODE_TRANSCOLD
 #if DECODE_MIRAGE
-    DPRINTLN("Attempting Mirage decode");
-    if (decodeMirage(results, offset)) return true;
+  DPRINTLN("Attempting Mirage decode");
+  if (TRY_NEXT_DECODER && decodeMirage(results, offset)) return position;
 #endif  // DECODE_MIRAGE
 #if DECODE_ELITESCREENS
-    DPRINTLN("Attempting EliteScreens decode");
-    if (decodeElitescreens(results, offset)) return true;
+  DPRINTLN("Attempting EliteScreens decode");
+  if (TRY_NEXT_DECODER && decodeElitescreens(results, offset)) return position;
 #endif  // DECODE_ELITESCREENS
 #if DECODE_PANASONIC_AC32
-    DPRINTLN("Attempting Panasonic AC (32bit) long decode");
-    if (decodePanasonicAC32(results, offset, kPanasonicAc32Bits)) return true;
-    DPRINTLN("Attempting Panasonic AC (32bit) short decode");
-    if (decodePanasonicAC32(results, offset, kPanasonicAc32Bits / 2))
-      return true;
+  DPRINTLN("Attempting Panasonic AC (32bit) long decode");
+  if (TRY_NEXT_DECODER &&
+      decodePanasonicAC32(results, offset, kPanasonicAc32Bits))
+    return position;
+  DPRINTLN("Attempting Panasonic AC (32bit) short decode");
+  if (TRY_NEXT_DECODER &&
+      decodePanasonicAC32(results, offset, kPanasonicAc32Bits / 2))
+    return position;
 #endif  // DECODE_PANASONIC_AC32
 #if DECODE_ECOCLIM
-    DPRINTLN("Attempting Ecoclim decode");
-    if (decodeEcoclim(results, offset, kEcoclimBits) ||
-        decodeEcoclim(results, offset, kEcoclimShortBits)) return true;
+  DPRINTLN("Attempting Ecoclim decode");
+  if (TRY_NEXT_DECODER &&
+      (decodeEcoclim(results, offset, kEcoclimBits) ||
+       decodeEcoclim(results, offset, kEcoclimShortBits)))
+    return position;
 #endif  // DECODE_ECOCLIM
 #if DECODE_XMP
-    DPRINTLN("Attempting XMP decode");
-    if (decodeXmp(results, offset, kXmpBits)) return true;
+  DPRINTLN("Attempting XMP decode");
+  if (TRY_NEXT_DECODER && decodeXmp(results, offset, kXmpBits)) return position;
 #endif  // DECODE_XMP
 #if DECODE_TEKNOPOINT
-    DPRINTLN("Attempting Teknopoint decode");
-    if (decodeTeknopoint(results, offset)) return true;
+  DPRINTLN("Attempting Teknopoint decode");
+  if (TRY_NEXT_DECODER && decodeTeknopoint(results, offset)) return position;
 #endif  // DECODE_TEKNOPOINT
 #if DECODE_KELON
-    DPRINTLN("Attempting Kelon decode");
-    if (decodeKelon(results, offset)) return true;
+  DPRINTLN("Attempting Kelon decode");
+  if (TRY_NEXT_DECODER && decodeKelon(results, offset)) return position;
 #endif  // DECODE_KELON
 #if DECODE_SANYO_AC88
-    DPRINTLN("Attempting SanyoAc88 decode");
-    if (decodeSanyoAc88(results, offset)) return true;
+  DPRINTLN("Attempting SanyoAc88 decode");
+  if (TRY_NEXT_DECODER && decodeSanyoAc88(results, offset)) return position;
 #endif  // DECODE_SANYO_AC88
 #if DECODE_BOSE
-    DPRINTLN("Attempting Bose decode");
-    if (decodeBose(results, offset)) return true;
+  DPRINTLN("Attempting Bose decode");
+  if (TRY_NEXT_DECODER && decodeBose(results, offset)) return position;
 #endif  // DECODE_BOSE
 #if DECODE_ARRIS
-    DPRINTLN("Attempting Arris decode");
-    if (decodeArris(results, offset)) return true;
+  DPRINTLN("Attempting Arris decode");
+  if (TRY_NEXT_DECODER && decodeArris(results, offset)) return position;
 #endif  // DECODE_ARRIS
 #if DECODE_RHOSS
-    DPRINTLN("Attempting Rhoss decode");
-    if (decodeRhoss(results, offset)) return true;
+  DPRINTLN("Attempting Rhoss decode");
+  if (TRY_NEXT_DECODER && decodeRhoss(results, offset)) return position;
 #endif  // DECODE_RHOSS
   // Typically new protocols are added above this line.
+#undef TRY_NEXT_DECODER
+  return 0;
+}
+
+/// Run one part of a parallel decode. See `decodeParallel()`.
+/// @param[in,out] arg Ptr to the decode_job_t.
+/// @param[in] part Which part to run.
+void IRrecv::decodePart(void *arg, const uint8_t part) {
+  decode_job_t *job = static_cast<decode_job_t *>(arg);
+  const uint16_t position = job->irrecv->decodeCascade(
+      &job->results[part], job->offset, job, part);
+  job->position[part] = position;
+  if (!position) return;
+  // Let the other parts know they can stop at this position.
+#if defined(UNIT_TEST) || defined(ESP32)
+  uint16_t best = bestPosition(job);
+  while (position < best && !job->best.compare_exchange_weak(best, position)) {
   }
-#if DECODE_HASH
-  // decodeHash returns a hash on any input.
-  // Thus, it needs to be last in the list.
-  // If you add any decodes, add them before this.
-  if (decodeHash(results)) {
-    return true;
+#else  // defined(UNIT_TEST) || defined(ESP32)
+  if (position < job->best) job->best = position;
+#endif  // defined(UNIT_TEST) || defined(ESP32)
+}
+
+/// Split the cascade of decoders into parts, & run them at the same time.
+/// The head of the cascade is tried first, as normal. Then every part decodes
+/// the same capture into its own copy of the results, & the match the normal
+/// (serial) cascade would have found first is kept.
+/// @param[in,out] results Ptr to the data to decode & where to store it.
+/// @param[in] max_skip Maximum Nr. of pulses at the beginning of a capture we
+///   can skip when attempting to find a protocol we can successfully decode.
+/// @return A boolean. True if one of the decoders matched.
+bool IRrecv::decodeParallel(decode_results *results, const uint8_t max_skip) {
+  decode_job_t job;
+  job.irrecv = this;
+  job.parts = std::min(_runner->parts(), kDecodeMaxParts);
+  for (uint16_t offset = kStartOffset;
+       offset <= (max_skip * 2) + kStartOffset;
+       offset += 2) {
+    job.offset = offset;
+    job.head = true;
+    if (decodeCascade(results, offset, &job)) return true;
+    job.head = false;
+    job.best = UINT16_MAX;
+    for (uint8_t part = 0; part < job.parts; part++)
+      job.results[part] = *results;
+    _runner->run(decodePart, &job, job.parts);
+    uint8_t best = job.parts;
+    for (uint8_t part = 0; part < job.parts; part++)
+      if (job.position[part] &&
+          (best == job.parts || job.position[part] < job.position[best]))
+        best = part;
+    if (best < job.parts) {
+      *results = job.results[best];
+      return true;
+    }
   }
-#endif  // DECODE_HASH
-  // Throw away and start over
-  if (!resumed)  // Check if we have already resumed.
-    resume();
   return false;
 }
 
@@ -1138,12 +1370,12 @@ bool IRrecv::matchAtLeast(uint32_t measured, uint32_t desired,
   DPRINT(". Matching: ");
   DPRINT(measured);
   DPRINT(" >= ");
-  DPRINT(ticksLow(std::min(desired, MS_TO_USEC(params.timeout)), tolerance,
+  DPRINT(ticksLow(std::min(desired, MS_TO_USEC(_timeout)), tolerance,
                   delta));
   DPRINT(" [min(");
   DPRINT(ticksLow(desired, tolerance, delta));
   DPRINT(", ");
-  DPRINT(ticksLow(MS_TO_USEC(params.timeout), tolerance, delta));
+  DPRINT(ticksLow(MS_TO_USEC(_timeout), tolerance, delta));
   DPRINTLN(")]");
 #ifdef UNIT_TEST
   // Sanity checks that we don't have values that cause integer over/underflow.
@@ -1159,10 +1391,26 @@ bool IRrecv::matchAtLeast(uint32_t measured, uint32_t desired,
   // We really should never get a value of 0, except as the last value
   // in the buffer. If that is the case, then assume infinity and return true.
   if (measured == 0) return true;
-  return measured >= ticksLow(std::min(desired, MS_TO_USEC(params.timeout)),
+  return measured >= ticksLow(std::min(desired, MS_TO_USEC(_timeout)),
                               tolerance, delta);
 }
 
+/// Check if a message could end at a given position in the capture.
+/// i.e. The capture has ended there, or it holds a long enough gap.
+/// This is the same test `matchGeneric()` makes of an "at least" footer space.
+/// @param[in] results Ptr to the captured data.
+/// @param[in] index The position in `results->rawbuf` to check.
+/// @param[in] gap The minimum length of the gap. (uSeconds)
+/// @param[in] tolerance A percentage expressed as an integer. e.g. 10 is 10%.
+/// @param[in] delta A non-scaling amount to reduce usecs by.
+/// @return A Boolean. true if it could end there, false if it can't.
+bool IRrecv::matchGapAt(const decode_results *results, const uint16_t index,
+                        const uint32_t gap, const uint8_t tolerance,
+                        const uint16_t delta) {
+  return index >= results->rawlen ||
+      matchAtLeast(results->rawbuf[index], gap, tolerance, delta);
+}
+
 /// Check if we match a mark signal(measured) with the desired within
 ///  +/-tolerance percent, after an expected is excess is added.
 /// @param[in] measured The recorded period of the signal pulse.
@@ -1246,11 +1494,11 @@ bool IRrecv::matchSpaceRange(const uint32_t measured, const uint32_t desired,
 /// @param[in] oldval Nr. of ticks.
 /// @param[in] newval Nr. of ticks.
 /// @return 0 if newval is shorter, 1 if it is equal, & 2 if it is longer.
-/// @note Use a tolerance of 20%
+/// @note Use a tolerance of 20%. i.e. x < y * 0.8, but in integer maths.
 uint16_t IRrecv::compare(const uint16_t oldval, const uint16_t newval) {
-  if (newval < oldval * 0.8)
+  if (newval * 5UL < oldval * 4UL)
     return 0;
-  else if (oldval < newval * 0.8)
+  else if (oldval * 5UL < newval * 4UL)
     return 2;
   else
     return 1;
@@ -1268,6 +1516,8 @@ uint16_t IRrecv::compare(const uint16_t oldval, const uint16_t newval) {
 /// @see http://arcfn.com/2010/01/using-arbitrary-remotes-with-arduino.html
 /// @note This isn't a "real" decoding, just an arbitrary value.
 ///   Hopefully this code is unique for each button.
+/// @note If `setUnknownFingerprint()` is enabled, `value` is instead the
+///   64-bit timing fingerprint of the message, & `command` is the hash above.
 bool IRrecv::decodeHash(decode_results *results) {
   // Require at least some samples to prevent triggering on noise
   if (results->rawlen < _unknown_threshold) return false;
@@ -1281,10 +1531,15 @@ bool IRrecv::decodeHash(decode_results *results) {
     // Add value into the hash
     hash = (hash * kFnvPrime32) ^ value;
   }
-  results->value = hash & 0xFFFFFFFF;
   results->bits = results->rawlen / 2;
   results->address = 0;
-  results->command = 0;
+  if (_unknown_fingerprint) {
+    results->value = resultToFingerprint(results);
+    results->command = hash & 0xFFFFFFFF;
+  } else {
+    results->value = hash & 0xFFFFFFFF;
+    results->command = 0;
+  }
   results->decode_type = UNKNOWN;
   return true;
 }
@@ -51,6 +51,19 @@ const uint16_t kMaxTimeoutMs = kRawTick * (UINT16_MAX / MS_TO_USEC(1));
 // Use FNV hash algorithm: http://isthe.com/chongo/tech/comp/fnv/#FNV-param
 const uint32_t kFnvPrime32 = 16777619UL;
 const uint32_t kFnvBasis32 = 2166136261UL;
+const uint64_t kFnvPrime64 = 1099511628211ULL;
+const uint64_t kFnvBasis64 = 14695981039346656037ULL;
+
+// Timing fingerprints of unknown messages. See `resultToFingerprint()`.
+const uint16_t kFingerprintNoiseUs = 100;  // Shorter marks are trimmed off.
+const uint8_t kFingerprintTolerance = 20;  // Percentage.
+const uint8_t kFingerprintMaxClusters = 8;  // Per kind. i.e. Marks or spaces.
+const uint8_t kFingerprintMinCount = 4;  // Durations to be used as a symbol.
+const uint8_t kFingerprintSpread = 173;  // Percentage. Above/below a symbol.
+const uint8_t kFingerprintHeaderRatio = 160;  // Percentage. Mark vs. space.
+
+// Max. nr. of parts a parallel decode can be split into.
+const uint8_t kDecodeMaxParts = 8;
 
 // Which of the ESP32 timers to use by default. (0-3)
 const uint8_t kDefaultESP32Timer = 3;
@@ -88,6 +101,62 @@ typedef struct {
 
 // Classes
 
+/// Interface for the mechanism that captures IR edges for an IRrecv object.
+/// Drivers hand the receiver blocks of mark/space durations via `deliver()`,
+/// & flag the end of each message, so decoding doesn't care how the edges
+/// were captured. e.g. An interrupt per GPIO edge, a peripheral that collects
+/// a whole message in hardware, or a mock that replays edges from a file.
+class IRCaptureDriver {
+ public:
+  virtual ~IRCaptureDriver(void) {}
+  /// Start capturing IR edges.
+  /// @param[in] pullup Should the input use the internal pullup resistor?
+  virtual void start(const bool pullup) = 0;
+  /// Stop capturing IR edges.
+  virtual void stop(void) = 0;
+  /// The receiver is ready to capture a new message.
+  virtual void resume(void) {}
+  /// Service the driver from outside of an interrupt. Called by `decode()`.
+  virtual void poll(void) {}
+
+ protected:
+  static bool ready(void);
+  static uint16_t deliver(const uint16_t *usecs, const uint16_t count,
+                          const bool end_of_frame);
+};
+
+/// The default capture driver. An interrupt on every edge of the GPIO, plus
+/// a timer to detect the end of a message.
+class IRGpioCaptureDriver : public IRCaptureDriver {
+ public:
+#if defined(ESP32)
+  explicit IRGpioCaptureDriver(const uint8_t timer_num = kDefaultESP32Timer);
+#endif  // ESP32
+  void start(const bool pullup);
+  void stop(void);
+  void resume(void);
+#if defined(ESP32)
+
+ private:
+  uint8_t _timer_num;
+#endif  // ESP32
+};
+
+/// Interface for running the parts of a parallel decode at the same time.
+/// e.g. On other threads, or the other core of an ESP32.
+/// @see IRrecv::setDecodeRunner()
+class IRDecodeRunner {
+ public:
+  virtual ~IRDecodeRunner(void) {}
+  /// Nr. of parts a decode should be split into. i.e. How many can run at
+  /// once.
+  virtual uint8_t parts(void) const = 0;
+  /// Run `job(arg, part)` for every part from 0 to `count - 1`, & only return
+  /// once they have all finished.
+  virtual void run(void (*job)(void *arg, const uint8_t part), void *arg,
+                   const uint8_t count) = 0;
+};
+
 /// Results returned from the decoder
 class decode_results {
  public:
@@ -110,6 +179,8 @@ class decode_results {
   bool repeat;  // Is the result a repeat code?
 };
 
+struct decode_job_t;  // The state of a parallel decode. See IRrecv.cpp
+
 /// Class for receiving IR messages.
 class IRrecv {
  public:
@@ -132,8 +203,15 @@ class IRrecv {
   void disableIRIn(void);
   void resume(void);
   uint16_t getBufSize(void);
+  uint8_t getTimeout(void);
+  bool isReceiving(void);
+  void setCaptureDriver(IRCaptureDriver *driver);
+  IRCaptureDriver *getCaptureDriver(void);
+  void setDecodeRunner(IRDecodeRunner *runner);
+  IRDecodeRunner *getDecodeRunner(void);
 #if DECODE_HASH
   void setUnknownThreshold(const uint16_t length);
+  void setUnknownFingerprint(const bool enable);
 #endif
   bool match(const uint32_t measured, const uint32_t desired,
              const uint8_t tolerance = kUseDefTol,
@@ -155,12 +233,15 @@ class IRrecv {
  private:
 #endif
   irparams_t *irparams_save;
+  uint16_t *_rawbuf;  ///< The capture buffer this object allocated.
   uint8_t _tolerance;
-#if defined(ESP32)
-  uint8_t _timer_num;
-#endif  // defined(ESP32)
+  uint8_t _timeout;  ///< A copy of `params.timeout`, for decoding.
+  IRGpioCaptureDriver _gpio;  ///< The default (GPIO interrupt) driver.
+  IRCaptureDriver *_driver;  ///< The capture driver in use.
+  IRDecodeRunner *_runner;  ///< Runs parallel decodes. NULL if none.
 #if DECODE_HASH
   uint16_t _unknown_threshold;
+  bool _unknown_fingerprint;
 #endif
 #ifdef UNIT_TEST
   volatile irparams_t *_getParamsPtr(void);
@@ -178,6 +259,9 @@ class IRrecv {
   bool matchAtLeast(const uint32_t measured, const uint32_t desired,
                     const uint8_t tolerance = kUseDefTol,
                     const uint16_t delta = 0);
+  bool matchGapAt(const decode_results *results, const uint16_t index,
+                  const uint32_t gap, const uint8_t tolerance = kUseDefTol,
+                  const uint16_t delta = 0);
   uint16_t _matchGeneric(volatile uint16_t *data_ptr,
                          uint64_t *result_bits_ptr,
                          uint8_t *result_ptr,
@@ -272,6 +356,10 @@ class IRrecv {
                            const bool MSBfirst = true,
                            const bool GEThomas = true);
   void crudeNoiseFilter(decode_results *results, const uint16_t floor = 0);
+  uint16_t decodeCascade(decode_results *results, const uint16_t offset,
+                         decode_job_t *job = NULL, const uint8_t part = 0);
+  bool decodeParallel(decode_results *results, const uint8_t max_skip);
+  static void decodePart(void *arg, const uint8_t part);
   bool decodeHash(decode_results *results);
 #if DECODE_VOLTAS
   bool decodeVoltas(decode_results *results,
@@ -460,6 +548,19 @@ class IRrecv {
                         const uint16_t nbits = kKelvinatorBits,
                         const bool strict = true);
 #endif
+#if DECODE_DAIKIN_FAMILY
+  bool decodeDaikinFamily(decode_results *results,
+                          uint16_t offset = kStartOffset);
+#endif  // DECODE_DAIKIN_FAMILY
+#if (DECODE_DAIKIN || DECODE_DAIKIN2 || DECODE_DAIKIN160 || \
+     DECODE_DAIKIN176 || DECODE_DAIKIN216)
+  uint16_t matchDaikinSections(decode_results *results, uint16_t offset,
+                               const uint8_t sizes[], const uint8_t sections,
+                               const uint16_t hdrmark, const uint32_t hdrspace,
+                               const uint16_t bitmark, const uint32_t onespace,
+                               const uint32_t zerospace, const uint32_t gap,
+                               const uint8_t tolerance);
+#endif
 #if DECODE_DAIKIN
   bool decodeDaikin(decode_results *results, uint16_t offset = kStartOffset,
                     const uint16_t nbits = kDaikinBits,
@@ -585,6 +686,10 @@ class IRrecv {
                         const uint16_t nbits = kHaierAC176Bits,
                         const bool strict = true);
 #endif  // DECODE_HAIER_AC176
+#if DECODE_HITACHI_FAMILY
+  bool decodeHitachiFamily(decode_results *results,
+                           uint16_t offset = kStartOffset);
+#endif  // DECODE_HITACHI_FAMILY
 #if (DECODE_HITACHI_AC || DECODE_HITACHI_AC2 || DECODE_HITACHI_AC344)
   bool decodeHitachiAC(decode_results *results, uint16_t offset = kStartOffset,
                        const uint16_t nbits = kHitachiAcBits,
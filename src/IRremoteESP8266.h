@@ -827,6 +827,16 @@
 #define DECODE_AC false   // We don't need that infrastructure.
 #endif
 
+// A vendor's variants are tried together by a single family decoder.
+// e.g. `IRrecv::decodeDaikinFamily()`
+#define DECODE_DAIKIN_FAMILY (DECODE_DAIKIN || DECODE_DAIKIN2 || \
+                              DECODE_DAIKIN64 || DECODE_DAIKIN128 || \
+                              DECODE_DAIKIN152 || DECODE_DAIKIN160 || \
+                              DECODE_DAIKIN176 || DECODE_DAIKIN216)
+#define DECODE_HITACHI_FAMILY (DECODE_HITACHI_AC || DECODE_HITACHI_AC1 || \
+                               DECODE_HITACHI_AC2 || DECODE_HITACHI_AC3 || \
+                               DECODE_HITACHI_AC344 || DECODE_HITACHI_AC424)
+
 // Use millisecond 'delay()' calls where we can to avoid tripping the WDT.
 // Note: If you plan to send IR messages in the callbacks of the AsyncWebserver
 //       library, you need to set ALLOW_DELAY_CALLS to false.
@@ -835,6 +845,42 @@
 #define ALLOW_DELAY_CALLS true
 #endif  // ALLOW_DELAY_CALLS
 
+// Switch the IR LED in `IRsend::mark()` by writing straight to the GPIO's
+// set/clear registers (ESP8266 & ESP32), rather than calling `digitalWrite()`
+// with a run-time pin & polarity twice per carrier cycle. See `IRoutput.h`.
+// Only use it if every IRsend object in the program uses the same GPIO.
+// e.g. `-D IR_SEND_FIXED_PIN=4`. Set IR_SEND_FIXED_INVERTED to true if the LED
+// is lit when the GPIO is LOW. (The `inverted` constructor argument is then
+// not used by `mark()`.) Re-run `IRsend::calibrate()` as the loop is faster.
+// #define IR_SEND_FIXED_PIN 4
+#ifndef IR_SEND_FIXED_INVERTED
+#define IR_SEND_FIXED_INVERTED false
+#endif  // IR_SEND_FIXED_INVERTED
+
+// Store the protocol names in flash compressed with a small dictionary.
+// See `src/IRtext_protocols.h`, which is generated by
+// `tools/generate_irtext_protocols.py`. If you change any of the protocol
+// names (e.g. in a locale), re-run that tool, or set this to false.
+#ifndef COMPRESS_PROTOCOL_NAMES
+#define COMPRESS_PROTOCOL_NAMES true
+#endif  // COMPRESS_PROTOCOL_NAMES
+
+// Keep counters, gauges & histograms of what the library is doing.
+// e.g. Decode misses, buffer overflows, send airtime etc. See `IRmetrics.h`.
+// Each update costs only a few instructions & the storage is static (about
+// 350 bytes of RAM). Set this to false to remove the updates from the library.
+#ifndef ENABLE_IR_METRICS
+#define ENABLE_IR_METRICS true
+#endif  // ENABLE_IR_METRICS
+
+// Carrier sense (listen-before-talk) for IRsend. i.e. Wait for a paired IRrecv
+// to hear a quiet channel before transmitting. See `IRsend::setCarrierSense()`.
+// Its state & statistics add about 40 bytes to every IRsend object, so it is
+// off by default. Set this to true to use it.
+#ifndef ENABLE_CARRIER_SENSE
+#define ENABLE_CARRIER_SENSE false
+#endif  // ENABLE_CARRIER_SENSE
+
 // Enable a run-time settable high-pass filter on captured data **before**
 // trying any protocol decoding.
 // i.e. Try to remove/merge any really short pulses detected in the raw data.
@@ -1092,6 +1138,7 @@ const uint16_t kLegoPfBits = 16;
 const uint16_t kLegoPfMinRepeat = kNoRepeat;
 const uint16_t kLgBits = 28;
 const uint16_t kLg32Bits = 32;
+const uint8_t  kLgAcChecksumSize = 4;  // Size in bits.
 const uint16_t kLgDefaultRepeat = kNoRepeat;
 const uint16_t kLutronBits = 35;
 const uint16_t kMagiquestBits = 56;
@@ -1296,6 +1343,19 @@ const uint16_t kRhossDefaultRepeat = 0;
 // See: https://github.com/crankyoldgit/IRremoteESP8266/issues/667
 #define F(x) x
 #endif  // F
+// Likewise for the PROGMEM helpers, which just read RAM outside of Arduino.
+#ifndef PROGMEM
+#define PROGMEM
+#endif  // PROGMEM
+#ifndef pgm_read_byte
+#define pgm_read_byte(ADDR) (*reinterpret_cast<const uint8_t*>(ADDR))
+#endif  // pgm_read_byte
+#ifndef pgm_read_word
+#define pgm_read_word(ADDR) (*reinterpret_cast<const uint16_t*>(ADDR))
+#endif  // pgm_read_word
+#ifndef pgm_read_dword
+#define pgm_read_dword(ADDR) (*reinterpret_cast<const uint32_t*>(ADDR))
+#endif  // pgm_read_dword
 typedef std::string String;
 #endif  // UNIT_TEST
 
@@ -0,0 +1,377 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief A timer-wheel scheduler for timed & periodic IR transmissions.
+/// Each level of the wheel has kSchedulerSlots slots. A slot in level `n`
+/// covers kSchedulerSlots^n ticks. Jobs are put in the lowest level that can
+/// hold them, and move ("cascade") down a level each time the level below has
+/// gone all the way around. Only the jobs in the current slot of level 0 are
+/// due, so a tick never has to look at the jobs that aren't.
+/// @see IRScheduler
+
+#include "IRscheduler.h"
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#include <algorithm>
+#include "IRmetrics.h"
+
+// Constants
+/// Nr. of list heads used by the wheel (+1 for the list of jobs being run).
+const uint16_t kSchedulerHeads = kSchedulerSlots * kSchedulerLevels + 1;
+/// Mask to get a slot number from a tick count.
+const uint32_t kSchedulerSlotMask = kSchedulerSlots - 1;
+
+/// Class constructor
+/// @param[in] max_jobs The max. nr. of jobs that can be scheduled at once.
+/// @param[in] tick_ms The resolution of the scheduler, in milli-seconds.
+/// @note The scheduler uses the time from its first `poll()` as the start.
+IRScheduler::IRScheduler(const uint16_t max_jobs, const uint16_t tick_ms)
+    : _tick_ms(std::max(tick_ms, (uint16_t)1)), _pending(0), _now(0),
+      _last_ms(0), _started(false) {
+  _capacity = std::min(max_jobs, (uint16_t)(UINT16_MAX - kSchedulerHeads));
+  _jobs = new job_t[_capacity];
+  _next = new uint16_t[_capacity + kSchedulerHeads];
+  _prev = new uint16_t[_capacity + kSchedulerHeads];
+  if (_jobs == NULL || _next == NULL || _prev == NULL) {
+    DPRINTLN("Could not allocate memory for the IR scheduler.");
+    _capacity = 0;
+  }
+  // Every list head starts empty. i.e. Pointing at itself.
+  for (uint16_t i = _capacity; i < _capacity + kSchedulerHeads; i++)
+    _next[i] = _prev[i] = i;
+  // Chain all the jobs into the free list.
+  for (uint16_t i = 0; i < _capacity; i++) {
+    _jobs[i].active = false;
+    _jobs[i].generation = 1;
+    _next[i] = i + 1;
+  }
+  _free = 0;
+}
+
+/// Class destructor
+IRScheduler::~IRScheduler(void) {
+  delete[] _jobs;
+  delete[] _next;
+  delete[] _prev;
+}
+
+/// Schedule a simple (up to 64 bit) IR message to be sent.
+/// @param[in] delay_ms Nr. of milli-seconds from the last `poll()` before the
+///   first send.
+/// @param[in] period_ms Nr. of milli-seconds between sends. 0 is send once.
+/// @param[in] irsend A Ptr to the IRsend object (emitter) to send it with.
+/// @param[in] type The protocol to use.
+/// @param[in] data The message to send.
+/// @param[in] nbits Nr. of bits of data in the message.
+/// @param[in] repeat Nr. of times the message is to be repeated.
+/// @return A job id for use with `cancel()`, or kSchedulerNoJob if it
+///   couldn't be scheduled.
+uint32_t IRScheduler::scheduleSend(const uint32_t delay_ms,
+                                   const uint32_t period_ms,
+                                   IRsend *irsend, const decode_type_t type,
+                                   const uint64_t data, const uint16_t nbits,
+                                   const uint16_t repeat) {
+  if (irsend == NULL) return kSchedulerNoJob;
+  const uint32_t job = add(delay_ms, period_ms, kSendJob, irsend);
+  if (job != kSchedulerNoJob) {
+    job_t *entry = &_jobs[find(job)];
+    entry->u.send.data = data;
+    entry->u.send.nbits = nbits;
+    entry->u.send.repeat = repeat;
+    entry->u.send.type = type;
+  }
+  return job;
+}
+
+/// Schedule a state based (e.g. A/C) IR message to be sent.
+/// @param[in] delay_ms Nr. of milli-seconds from the last `poll()` before the
+///   first send.
+/// @param[in] period_ms Nr. of milli-seconds between sends. 0 is send once.
+/// @param[in] irsend A Ptr to the IRsend object (emitter) to send it with.
+/// @param[in] type The protocol to use.
+/// @param[in] state A Ptr to the state to send. It is not copied, so it must
+///   stay valid until the job has finished or been cancelled.
+/// @param[in] nbytes Nr. of bytes in the state.
+/// @return A job id for use with `cancel()`, or kSchedulerNoJob if it
+///   couldn't be scheduled.
+uint32_t IRScheduler::scheduleSendState(const uint32_t delay_ms,
+                                        const uint32_t period_ms,
+                                        IRsend *irsend,
+                                        const decode_type_t type,
+                                        const uint8_t *state,
+                                        const uint16_t nbytes) {
+  if (irsend == NULL || state == NULL) return kSchedulerNoJob;
+  const uint32_t job = add(delay_ms, period_ms, kSendStateJob, irsend);
+  if (job != kSchedulerNoJob) {
+    job_t *entry = &_jobs[find(job)];
+    entry->u.state.state = state;
+    entry->u.state.nbytes = nbytes;
+    entry->u.state.type = type;
+  }
+  return job;
+}
+
+/// Schedule an update to an A/C. e.g. Turn it off at night.
+/// The update is sent via `IRac::sendUpdate()`, so nothing is sent if it
+/// doesn't change anything the A/C's protocol supports.
+/// @param[in] delay_ms Nr. of milli-seconds from the last `poll()` before the
+///   first update.
+/// @param[in] period_ms Nr. of milli-seconds between updates. 0 is once.
+/// @param[in] ac A Ptr to the IRac object controlling the A/C.
+/// @param[in] update A Ptr to the update to apply. It is not copied, so it
+///   must stay valid until the job has finished or been cancelled.
+/// @return A job id for use with `cancel()`, or kSchedulerNoJob if it
+///   couldn't be scheduled.
+uint32_t IRScheduler::scheduleAc(const uint32_t delay_ms,
+                                 const uint32_t period_ms,
+                                 IRac *ac, const stdAc::update_t *update) {
+  if (ac == NULL || update == NULL) return kSchedulerNoJob;
+  const uint32_t job = add(delay_ms, period_ms, kAcJob, ac);
+  if (job != kSchedulerNoJob) _jobs[find(job)].u.update = update;
+  return job;
+}
+
+/// Schedule a function to be called.
+/// @param[in] delay_ms Nr. of milli-seconds from the last `poll()` before the
+///   first call.
+/// @param[in] period_ms Nr. of milli-seconds between calls. 0 is call once.
+/// @param[in] callback The function to call.
+/// @param[in] arg The argument to pass to the function.
+/// @return A job id for use with `cancel()`, or kSchedulerNoJob if it
+///   couldn't be scheduled.
+uint32_t IRScheduler::scheduleCall(const uint32_t delay_ms,
+                                   const uint32_t period_ms,
+                                   IRSchedulerCallback callback, void *arg) {
+  if (callback == NULL) return kSchedulerNoJob;
+  const uint32_t job = add(delay_ms, period_ms, kCallJob, arg);
+  if (job != kSchedulerNoJob) _jobs[find(job)].u.callback = callback;
+  return job;
+}
+
+/// Cancel a scheduled job.
+/// @note A job may cancel itself while it is being run.
+/// @param[in] job The id of the job.
+/// @return true if the job was cancelled, false if it wasn't scheduled.
+bool IRScheduler::cancel(const uint32_t job) {
+  const uint16_t entry = find(job);
+  if (entry >= _capacity) return false;
+  unlink(entry);
+  release(entry);
+  return true;
+}
+
+/// Is a job still scheduled?
+/// @param[in] job The id of the job.
+/// @return true if it is, false if it has finished or been cancelled.
+bool IRScheduler::isScheduled(const uint32_t job) {
+  return find(job) < _capacity;
+}
+
+/// Get the nr. of jobs currently scheduled.
+/// @return The nr. of jobs.
+uint16_t IRScheduler::getPending(void) { return _pending; }
+
+/// Get the max. nr. of jobs that can be scheduled at once.
+/// @return The nr. of jobs.
+uint16_t IRScheduler::getCapacity(void) { return _capacity; }
+
+/// Run any jobs that are due.
+/// @param[in] now_ms The current time, in milli-seconds. e.g. `millis()`
+/// @return The nr. of jobs run.
+uint16_t IRScheduler::poll(const uint32_t now_ms) {
+  if (!_started) {
+    _started = true;
+    _last_ms = now_ms;
+    return 0;
+  }
+  const uint32_t ticks = (now_ms - _last_ms) / _tick_ms;  // Handles wrapping.
+  _last_ms += ticks * _tick_ms;
+  uint16_t ran = 0;
+  for (uint32_t i = 0; i < ticks; i++) {
+    const uint16_t due = tick();
+#if ENABLE_IR_METRICS
+    // How long ago that tick should have happened.
+    const uint32_t late = (ticks - 1 - i) * _tick_ms + now_ms - _last_ms;
+    for (uint16_t j = 0; j < due; j++)
+      irmetrics::observe(irmetrics::kSchedulerLateMs, late);
+#endif  // ENABLE_IR_METRICS
+    ran += due;
+  }
+  IR_METRIC_ADD(kSchedulerRuns, ran);
+  return ran;
+}
+
+#ifndef UNIT_TEST
+/// Run any jobs that are due.
+/// @return The nr. of jobs run.
+uint16_t IRScheduler::poll(void) { return poll(millis()); }
+#endif  // UNIT_TEST
+
+/// Take a job from the free list & put it in the wheel.
+/// @param[in] delay_ms Nr. of milli-seconds from now before the first run.
+/// @param[in] period_ms Nr. of milli-seconds between runs. 0 is run once.
+/// @param[in] kind The type of job.
+/// @param[in] target A Ptr to the object the job uses.
+/// @return The job id, or kSchedulerNoJob if there is no room.
+uint32_t IRScheduler::add(const uint32_t delay_ms, const uint32_t period_ms,
+                          const uint8_t kind, void *target) {
+  if (_free >= _capacity) return kSchedulerNoJob;
+  const uint16_t entry = _free;
+  _free = _next[entry];
+  job_t *job = &_jobs[entry];
+  // Round up, so we never run a job early. Always wait at least one tick.
+  const uint32_t delay = std::max((delay_ms + _tick_ms - 1) / _tick_ms,
+                                  (uint32_t)1);
+  job->expires = _now + delay;
+  job->period = (period_ms + _tick_ms - 1) / _tick_ms;
+  if (period_ms) job->period = std::max(job->period, (uint32_t)1);
+  job->kind = kind;
+  job->target = target;
+  job->active = true;
+  _next[entry] = _prev[entry] = entry;
+  place(entry);
+  _pending++;
+  IR_METRIC_SET(kSchedulerPending, _pending);
+  return ((uint32_t)job->generation << 16) | entry;
+}
+
+/// Find the job that a job id refers to.
+/// @param[in] job The job id.
+/// @return The index of the job, or `_capacity` if it isn't scheduled.
+uint16_t IRScheduler::find(const uint32_t job) {
+  const uint16_t entry = job & UINT16_MAX;
+  if (entry >= _capacity || !_jobs[entry].active ||
+      _jobs[entry].generation != (job >> 16))
+    return _capacity;
+  return entry;
+}
+
+/// Get the list head for a slot in the wheel.
+/// @param[in] level The level of the wheel.
+/// @param[in] slot The slot in that level.
+/// @return The index of the list head.
+uint16_t IRScheduler::head(const uint8_t level, const uint16_t slot) {
+  return _capacity + level * kSchedulerSlots + slot;
+}
+
+/// Add an entry to the end of a list.
+/// @param[in] entry The entry to add.
+/// @param[in] list The list head to add it to.
+void IRScheduler::link(const uint16_t entry, const uint16_t list) {
+  _prev[entry] = _prev[list];
+  _next[entry] = list;
+  _next[_prev[list]] = entry;
+  _prev[list] = entry;
+}
+
+/// Remove an entry from whatever list it is in.
+/// @param[in] entry The entry to remove.
+void IRScheduler::unlink(const uint16_t entry) {
+  _next[_prev[entry]] = _next[entry];
+  _prev[_next[entry]] = _prev[entry];
+  _next[entry] = _prev[entry] = entry;
+}
+
+/// Put a job in the right slot of the wheel for when it is due.
+/// @param[in] entry The job to place.
+void IRScheduler::place(const uint16_t entry) {
+  uint32_t expires = _jobs[entry].expires;
+  // Park jobs that are further away than the wheel can hold. They will be
+  // placed again when their slot cascades.
+  if (expires - _now > kSchedulerMaxTicks) expires = _now + kSchedulerMaxTicks;
+  const uint32_t delta = expires - _now;
+  uint8_t level = 0;
+  while (level < kSchedulerLevels - 1 &&
+         delta >= (1UL << (kSchedulerSlotBits * (level + 1))))
+    level++;
+  const uint16_t slot = (expires >> (kSchedulerSlotBits * level)) &
+                        kSchedulerSlotMask;
+  link(entry, head(level, slot));
+}
+
+/// Move the jobs in the current slot of a level to the levels below.
+/// @param[in] level The level to cascade. (>= 1)
+void IRScheduler::cascade(const uint8_t level) {
+  const uint16_t list = head(
+      level, (_now >> (kSchedulerSlotBits * level)) & kSchedulerSlotMask);
+  while (_next[list] != list) {
+    const uint16_t entry = _next[list];
+    unlink(entry);
+    place(entry);
+  }
+}
+
+/// Advance the wheel by one tick, and run the jobs that are now due.
+/// @return The nr. of jobs run.
+uint16_t IRScheduler::tick(void) {
+  _now++;
+  for (uint8_t level = 1; level < kSchedulerLevels; level++) {
+    // Only cascade a level when all the levels below it have wrapped around.
+    if ((_now >> (kSchedulerSlotBits * (level - 1))) & kSchedulerSlotMask)
+      break;
+    cascade(level);
+  }
+  const uint16_t slot = head(0, _now & kSchedulerSlotMask);
+  if (_next[slot] == slot) return 0;
+  // Move the due jobs to the work list, so the jobs we run can safely
+  // schedule or cancel other jobs.
+  const uint16_t work = _capacity + kSchedulerHeads - 1;
+  _next[work] = _next[slot];
+  _prev[work] = _prev[slot];
+  _prev[_next[work]] = work;
+  _next[_prev[work]] = work;
+  _next[slot] = _prev[slot] = slot;
+  uint16_t ran = 0;
+  while (_next[work] != work) {
+    const uint16_t entry = _next[work];
+    unlink(entry);
+    run(entry);
+    ran++;
+  }
+  return ran;
+}
+
+/// Run a job, then reschedule it if it is periodic.
+/// @param[in] entry The job to run. It must not be in a list.
+void IRScheduler::run(const uint16_t entry) {
+  job_t *job = &_jobs[entry];
+  const uint16_t generation = job->generation;
+  switch (job->kind) {
+    case kSendJob:
+      static_cast<IRsend *>(job->target)->send(
+          job->u.send.type, job->u.send.data, job->u.send.nbits,
+          job->u.send.repeat);
+      break;
+    case kSendStateJob:
+      static_cast<IRsend *>(job->target)->send(
+          job->u.state.type, job->u.state.state, job->u.state.nbytes);
+      break;
+    case kAcJob:
+      static_cast<IRac *>(job->target)->sendUpdate(*job->u.update);
+      break;
+    case kCallJob:
+      job->u.callback(job->target);
+      break;
+  }
+  // The job may have cancelled itself (and the entry been reused) while it ran.
+  if (!job->active || job->generation != generation) return;
+  if (job->period) {
+    job->expires += job->period;  // Keep to the original timetable.
+    place(entry);
+  } else {
+    release(entry);
+  }
+}
+
+/// Return a job to the free list.
+/// @param[in] entry The job to free.
+void IRScheduler::release(const uint16_t entry) {
+  _jobs[entry].active = false;
+  // Invalidate any job ids that refer to this entry. Never use 0.
+  if (++_jobs[entry].generation == 0) _jobs[entry].generation = 1;
+  _next[entry] = _free;
+  _free = entry;
+  _pending--;
+  IR_METRIC_SET(kSchedulerPending, _pending);
+}
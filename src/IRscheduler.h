@@ -0,0 +1,126 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief A timer-wheel scheduler for timed & periodic IR transmissions.
+/// @see IRScheduler
+
+#ifndef IRSCHEDULER_H_
+#define IRSCHEDULER_H_
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRac.h"
+
+// Constants
+/// Default resolution of the scheduler, in milli-seconds.
+const uint16_t kSchedulerTickMs = 10;
+/// Nr. of bits of the tick count handled by each level of the wheel.
+const uint8_t kSchedulerSlotBits = 6;
+/// Nr. of slots in each level of the wheel.
+const uint16_t kSchedulerSlots = 1 << kSchedulerSlotBits;
+/// Nr. of levels in the wheel.
+const uint8_t kSchedulerLevels = 4;
+/// Furthest (in ticks) a job can be placed in the wheel. Jobs due later than
+/// this are parked in the last level & re-placed as the wheel turns.
+const uint32_t kSchedulerMaxTicks =
+    (1UL << (kSchedulerSlotBits * kSchedulerLevels)) - 1;
+/// Returned instead of a job id when a job could not be scheduled.
+const uint32_t kSchedulerNoJob = 0;
+
+/// A function a scheduled job can call.
+/// @param[in] arg The argument given when the job was scheduled.
+typedef void (*IRSchedulerCallback)(void *arg);
+
+/// Schedules IR transmissions (& other work) to happen later, once or
+/// periodically.
+/// Jobs live in a hierarchical timer wheel, so adding & cancelling a job are
+/// O(1), and each tick only looks at the jobs due in that tick, no matter
+/// how many jobs are waiting. Due jobs are run in tick order, from `poll()`.
+/// @note All memory is allocated when the object is created.
+class IRScheduler {
+ public:
+  explicit IRScheduler(const uint16_t max_jobs,
+                       const uint16_t tick_ms = kSchedulerTickMs);
+  ~IRScheduler(void);
+  uint32_t scheduleSend(const uint32_t delay_ms, const uint32_t period_ms,
+                        IRsend *irsend, const decode_type_t type,
+                        const uint64_t data, const uint16_t nbits,
+                        const uint16_t repeat = kNoRepeat);
+  uint32_t scheduleSendState(const uint32_t delay_ms, const uint32_t period_ms,
+                             IRsend *irsend, const decode_type_t type,
+                             const uint8_t *state, const uint16_t nbytes);
+  uint32_t scheduleAc(const uint32_t delay_ms, const uint32_t period_ms,
+                      IRac *ac, const stdAc::update_t *update);
+  uint32_t scheduleCall(const uint32_t delay_ms, const uint32_t period_ms,
+                        IRSchedulerCallback callback, void *arg);
+  bool cancel(const uint32_t job);
+  bool isScheduled(const uint32_t job);
+  uint16_t getPending(void);
+  uint16_t getCapacity(void);
+  uint16_t poll(const uint32_t now_ms);
+#ifndef UNIT_TEST
+  uint16_t poll(void);
+#endif  // UNIT_TEST
+
+ private:
+  /// The kinds of work a job can do.
+  enum job_kind_t {
+    kSendJob = 0,
+    kSendStateJob,
+    kAcJob,
+    kCallJob,
+  };
+  /// A scheduled job.
+  struct job_t {
+    uint32_t expires;  ///< The tick the job is due in.
+    uint32_t period;  ///< Nr. of ticks between runs. 0 means run once.
+    uint16_t generation;  ///< Bumped each time the slot is reused.
+    uint8_t kind;  ///< What sort of job it is. (job_kind_t)
+    bool active;  ///< Is the job waiting to run?
+    void *target;  ///< The IRsend/IRac object, or the callback's argument.
+    union {
+      struct {
+        uint64_t data;
+        uint16_t nbits;
+        uint16_t repeat;
+        decode_type_t type;
+      } send;  ///< For kSendJob.
+      struct {
+        const uint8_t *state;
+        uint16_t nbytes;
+        decode_type_t type;
+      } state;  ///< For kSendStateJob.
+      const stdAc::update_t *update;  ///< For kAcJob.
+      IRSchedulerCallback callback;  ///< For kCallJob.
+    } u;  ///< The details of the work to do.
+  };
+  uint16_t _capacity;  ///< Max. nr. of jobs.
+  uint16_t _tick_ms;  ///< Nr. of milli-seconds per tick.
+  uint16_t _pending;  ///< Nr. of jobs currently scheduled.
+  uint16_t _free;  ///< The first unused job, or `_capacity` if there isn't one.
+  uint32_t _now;  ///< The next tick to be processed.
+  uint32_t _last_ms;  ///< The time (in ms) `_now` corresponds to.
+  bool _started;  ///< Has `poll()` been given the time yet?
+  job_t *_jobs;  ///< The job storage.
+  // Intrusive circular doubly-linked lists. Entries [0, _capacity) are the
+  // jobs. The following entries are the list heads for each slot of each
+  // level of the wheel, then the list of jobs currently being run.
+  uint16_t *_next;  ///< The next entry in each list.
+  uint16_t *_prev;  ///< The previous entry in each list.
+
+  uint32_t add(const uint32_t delay_ms, const uint32_t period_ms,
+               const uint8_t kind, void *target);
+  uint16_t find(const uint32_t job);
+  uint16_t head(const uint8_t level, const uint16_t slot);
+  void link(const uint16_t entry, const uint16_t list);
+  void unlink(const uint16_t entry);
+  void place(const uint16_t entry);
+  void cascade(const uint8_t level);
+  uint16_t tick(void);
+  void run(const uint16_t entry);
+  void release(const uint16_t entry);
+};
+
+#endif  // IRSCHEDULER_H_
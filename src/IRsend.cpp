@@ -13,7 +13,10 @@
 #ifdef UNIT_TEST
 #include <cmath>
 #endif
+#include "IRmetrics.h"
+#include "IRrecv.h"
 #include "IRtimer.h"
+#include "IRutils.h"
 
 /// Constructor for an IRsend object.
 /// @param[in] IRsendPin Which GPIO pin to use when sending an IR command.
@@ -26,7 +29,14 @@
 ///  i.e. If not, assume a 100% duty cycle. Ignore attempts to change the
 ///  duty cycle etc.
 IRsend::IRsend(uint16_t IRsendPin, bool inverted, bool use_modulation)
-    : IRpin(IRsendPin), periodOffset(kPeriodOffset) {
+    : IRpin(IRsendPin), periodOffset(kPeriodOffset), _queued_usecs(0),
+      _queued_mark(false) {
+#if ENABLE_CARRIER_SENSE
+  _cs_protocol_guard = 0;
+  _cs_seed = IRsendPin;
+  setCarrierSense(NULL);
+  resetCarrierSenseStats();
+#endif  // ENABLE_CARRIER_SENSE
   if (inverted) {
     outputOn = LOW;
     outputOff = HIGH;
@@ -89,7 +99,12 @@ uint32_t IRsend::calcUSecPeriod(uint32_t hz, bool use_offset) {
 /// @note Integer timing functions & math mean we can't do fractions of
 ///  microseconds timing. Thus minor changes to the freq & duty values may have
 ///  limited effect. You've been warned.
+/// @note If carrier sense is enabled, this is where we wait for the channel
+///  to be free before a transmission. See `setCarrierSense()`.
 void IRsend::enableIROut(uint32_t freq, uint8_t duty) {
+#if ENABLE_CARRIER_SENSE
+  if (_cs_receiver != NULL) listenBeforeTalk();
+#endif  // ENABLE_CARRIER_SENSE
   // Set the duty cycle to use if we want freq. modulation.
   if (modulation) {
     _dutycycle = std::min(duty, kDutyMax);
@@ -106,6 +121,7 @@ void IRsend::enableIROut(uint32_t freq, uint8_t duty) {
   onTimePeriod = (period * _dutycycle) / kDutyMax;
   // Nr. of uSeconds the LED will be off per pulse.
   offTimePeriod = period - onTimePeriod;
+  IR_METRIC_INC(kSendMessages);
 }
 
 #if ALLOW_DELAY_CALLS
@@ -154,36 +170,19 @@ void IRsend::_delayMicroseconds(uint32_t usec) {
 ///   Hence, for greater compatibility & choice, we don't use that method.
 /// Ref:
 ///   https://www.analysir.com/blog/2017/01/29/updated-esp8266-nodemcu-backdoor-upwm-hack-for-ir-signals/
+/// @note The LED is switched via `ledOn()` & `ledOff()`, unless
+///   `IR_SEND_FIXED_PIN` is defined. See `markWith()`.
 uint16_t IRsend::mark(uint16_t usec) {
-  // Handle the simple case of no required frequency modulation.
-  if (!modulation || _dutycycle >= 100) {
-    ledOn();
-    _delayMicroseconds(usec);
-    ledOff();
-    return 1;
-  }
-
-  // Not simple, so do it assuming frequency modulation.
-  uint16_t counter = 0;
-  IRtimer usecTimer = IRtimer();
-  // Cache the time taken so far. This saves us calling time, and we can be
-  // assured that we can't have odd math problems. i.e. unsigned under/overflow.
-  uint32_t elapsed = usecTimer.elapsed();
-
-  while (elapsed < usec) {  // Loop until we've met/exceeded our required time.
-    ledOn();
-    // Calculate how long we should pulse on for.
-    // e.g. Are we to close to the end of our requested mark time (usec)?
-    _delayMicroseconds(std::min((uint32_t)onTimePeriod, usec - elapsed));
-    ledOff();
-    counter++;
-    if (elapsed + onTimePeriod >= usec)
-      return counter;  // LED is now off & we've passed our allotted time.
-    // Wait for the lesser of the rest of the duty cycle, or the time remaining.
-    _delayMicroseconds(
-        std::min(usec - elapsed - onTimePeriod, (uint32_t)offTimePeriod));
-    elapsed = usecTimer.elapsed();  // Update & recache the actual elapsed time.
-  }
+  IR_METRIC_ADD(kSendAirtimeUs, usec);
+#if defined(IR_SEND_FIXED_PIN) && !defined(UNIT_TEST)
+  IRoutputFixedPin<IR_SEND_FIXED_PIN, IR_SEND_FIXED_INVERTED> output;
+#else  // defined(IR_SEND_FIXED_PIN) && !defined(UNIT_TEST)
+  LedOutput output(this);
+#endif  // defined(IR_SEND_FIXED_PIN) && !defined(UNIT_TEST)
+  const uint16_t counter = markWith(&output, usec);
+#if ENABLE_CARRIER_SENSE
+  if (_cs_receiver != NULL) _cs_last.reset();
+#endif  // ENABLE_CARRIER_SENSE
   return counter;
 }
 
@@ -194,9 +193,150 @@ uint16_t IRsend::mark(uint16_t usec) {
 void IRsend::space(uint32_t time) {
   ledOff();
   if (time == 0) return;
+  IR_METRIC_ADD(kSendAirtimeUs, time);
   _delayMicroseconds(time);
+#if ENABLE_CARRIER_SENSE
+  if (_cs_receiver != NULL) _cs_last.reset();
+#endif  // ENABLE_CARRIER_SENSE
+}
+
+/// Queue a mark, to be sent when the level next changes.
+/// Adjacent marks are merged into a single `mark()`, so the carrier isn't
+/// restarted part way through what is really one long mark.
+/// @param[in] usec Nr. of microseconds to add to the mark. 0 is ignored.
+/// @note Call `flushQueued()` to send whatever is still queued.
+void IRsend::queueMark(const uint32_t usec) {
+  if (usec == 0) return;
+  if (!_queued_mark) flushQueued();
+  _queued_mark = true;
+  _queued_usecs += usec;
+}
+
+/// Queue a space, to be sent when the level next changes.
+/// Adjacent spaces are merged into a single `space()`.
+/// @param[in] usec Nr. of microseconds to add to the space. 0 is ignored.
+/// @note Call `flushQueued()` to send whatever is still queued.
+void IRsend::queueSpace(const uint32_t usec) {
+  if (usec == 0) return;
+  if (_queued_mark) flushQueued();
+  _queued_usecs += usec;
+}
+
+/// Send the queued mark or space, if any. See `queueMark()` & `queueSpace()`.
+void IRsend::flushQueued(void) {
+  if (_queued_mark) {
+    for (; _queued_usecs > UINT16_MAX; _queued_usecs -= UINT16_MAX)
+      mark(UINT16_MAX);
+    mark(_queued_usecs);
+  } else if (_queued_usecs) {
+    space(_queued_usecs);
+  }
+  _queued_usecs = 0;
+  _queued_mark = false;
+}
+
+/// Send the queued mark, if any, but leave any queued space queued.
+/// Useful when timing a message, as the queued space can still be extended.
+/// @return Nr. of microseconds of space still queued.
+uint32_t IRsend::flushQueuedMark(void) {
+  if (_queued_mark) flushQueued();
+  return _queued_usecs;
+}
+
+#if ENABLE_CARRIER_SENSE
+/// Enable/disable carrier sense (listen-before-talk) collision avoidance.
+/// Before each transmission, a paired receiver is asked if it is part way
+/// through capturing a message. e.g. Someone is using a physical remote.
+/// If it is, the transmission is deferred until the channel has been quiet
+/// for the guard time, plus a random backoff that grows each time the channel
+/// goes busy again while we wait. After `max_wait_ms` we send it anyway.
+/// @param[in] receiver A Ptr to an enabled IRrecv object that can hear the
+///   same room as we send into. NULL disables carrier sense.
+/// @param[in] guard_ms Nr. of msecs the channel must be quiet for before we
+///   send. 0 means use `carrierSenseGuard()` for messages sent via `send()`,
+///   & kCarrierSenseGuardMs for everything else.
+/// @param[in] max_wait_ms Max. nr. of msecs to defer a transmission for.
+/// @note A receiver holding a message that hasn't been `decode()`d yet can't
+///   hear anything, so the channel is treated as free. Keep on decoding.
+/// @note The receiver also hears our own transmissions, so the channel isn't
+///   checked again until the receiver's timeout has passed since we last
+///   sent anything. i.e. Not between the sections/repeats of a message.
+void IRsend::setCarrierSense(IRrecv *receiver, const uint16_t guard_ms,
+                             const uint16_t max_wait_ms) {
+  _cs_receiver = receiver;
+  _cs_guard = guard_ms;
+  _cs_max_wait = max_wait_ms;
+  _cs_active = false;
+#ifndef UNIT_TEST
+  _cs_seed ^= micros();
+#endif  // UNIT_TEST
+}
+
+/// Get the statistics of the carrier sense option.
+/// @return A copy of the statistics.
+carrier_sense_stats_t IRsend::getCarrierSenseStats(void) { return _cs_stats; }
+
+/// Zero the statistics of the carrier sense option.
+void IRsend::resetCarrierSenseStats(void) {
+  _cs_stats.checks = 0;
+  _cs_stats.deferrals = 0;
+  _cs_stats.backoffs = 0;
+  _cs_stats.forced = 0;
+  _cs_stats.deferred_ms = 0;
 }
 
+/// How long should the channel be quiet for before sending a given protocol?
+/// @param[in] protocol The protocol about to be sent.
+/// @return The guard time in msecs.
+uint16_t IRsend::carrierSenseGuard(const decode_type_t protocol) {
+  return hasACState(protocol) ? kCarrierSenseAcGuardMs : kCarrierSenseGuardMs;
+}
+
+/// Wait (within reason) until the paired receiver reports a quiet channel.
+/// Polls the receiver every msec. Each time the channel goes busy again
+/// while we wait, the random backoff window is doubled, up to
+/// kCarrierSenseMaxBackoffMs.
+void IRsend::listenBeforeTalk(void) {
+  const uint32_t hold = MS_TO_USEC(_cs_receiver->getTimeout());
+  if (_cs_active && _cs_last.elapsed() < hold) return;  // Still our own echo.
+  _cs_stats.checks++;
+  if (_cs_receiver->isReceiving()) {
+    _cs_stats.deferrals++;
+    IR_METRIC_INC(kSendDeferrals);
+    const uint16_t guard = _cs_guard ? _cs_guard :
+        (_cs_protocol_guard ? _cs_protocol_guard : kCarrierSenseGuardMs);
+    uint16_t window = kCarrierSenseSlotMs;
+    uint32_t target = 0;
+    uint32_t quiet = 0;
+    uint32_t waited = 0;
+    for (; waited < _cs_max_wait; waited++) {
+      if (_cs_receiver->isReceiving()) {
+        if (target) {  // It went busy again. Back off some more.
+          _cs_stats.backoffs++;
+          window = std::min((uint16_t)(window * 2), kCarrierSenseMaxBackoffMs);
+        }
+        target = 0;
+        quiet = 0;
+      } else {
+        if (!target) {  // A simple LCG is random enough for a backoff.
+          _cs_seed = _cs_seed * 1103515245UL + 12345;
+          target = guard + (_cs_seed >> 16) % window;
+        }
+        if (quiet++ >= target) break;
+      }
+      _delayMicroseconds(1000);
+    }
+    _cs_stats.deferred_ms += waited;
+    if (waited >= _cs_max_wait) {
+      _cs_stats.forced++;
+      IR_METRIC_INC(kSendForced);
+    }
+  }
+  _cs_active = true;
+  _cs_last.reset();
+}
+#endif  // ENABLE_CARRIER_SENSE
+
 /// Calculate & set any offsets to account for execution times during sending.
 ///
 /// @param[in] hz The frequency to calibrate at >= 1000Hz. Default is 38000Hz.
@@ -246,32 +386,52 @@ int8_t IRsend::calibrate(uint16_t hz) {
 void IRsend::sendData(uint16_t onemark, uint32_t onespace, uint16_t zeromark,
                       uint32_t zerospace, uint64_t data, uint16_t nbits,
                       bool MSBfirst) {
+  queueData(onemark, onespace, zeromark, zerospace, data, nbits, MSBfirst);
+  flushQueued();
+}
+
+/// Queue the bits of a message, encoded by the length of their marks & spaces.
+/// Like `sendData()`, but it doesn't send what is left in the queue at the
+/// end, so it can be merged with whatever comes next.
+/// @param[in] onemark Nr. of usecs for the led to be pulsed for a '1' bit.
+/// @param[in] onespace Nr. of usecs for the led to be fully off for a '1' bit.
+/// @param[in] zeromark Nr. of usecs for the led to be pulsed for a '0' bit.
+/// @param[in] zerospace Nr. of usecs for the led to be fully off for a '0' bit.
+/// @param[in] data The data to be transmitted.
+/// @param[in] nbits Nr. of bits of data to be sent.
+/// @param[in] MSBfirst Flag for bit transmission order.
+///   Defaults to MSB->LSB order.
+void IRsend::queueData(const uint16_t onemark, const uint32_t onespace,
+                       const uint16_t zeromark, const uint32_t zerospace,
+                       const uint64_t data, const uint16_t nbits,
+                       const bool MSBfirst) {
   if (nbits == 0)  // If we are asked to send nothing, just return.
     return;
+  uint16_t bits = nbits;
   if (MSBfirst) {  // Send the MSB first.
     // Send 0's until we get down to a bit size we can actually manage.
-    while (nbits > sizeof(data) * 8) {
-      mark(zeromark);
-      space(zerospace);
-      nbits--;
+    for (; bits > sizeof(data) * 8; bits--) {
+      queueMark(zeromark);
+      queueSpace(zerospace);
     }
     // Send the supplied data.
-    for (uint64_t mask = 1ULL << (nbits - 1); mask; mask >>= 1)
+    for (uint64_t mask = 1ULL << (bits - 1); mask; mask >>= 1)
       if (data & mask) {  // Send a 1
-        mark(onemark);
-        space(onespace);
+        queueMark(onemark);
+        queueSpace(onespace);
       } else {  // Send a 0
-        mark(zeromark);
-        space(zerospace);
+        queueMark(zeromark);
+        queueSpace(zerospace);
       }
   } else {  // Send the Least Significant Bit (LSB) first / MSB last.
-    for (uint16_t bit = 0; bit < nbits; bit++, data >>= 1)
-      if (data & 1) {  // Send a 1
-        mark(onemark);
-        space(onespace);
+    uint64_t copy = data;
+    for (; bits; bits--, copy >>= 1)
+      if (copy & 1) {  // Send a 1
+        queueMark(onemark);
+        queueSpace(onespace);
       } else {  // Send a 0
-        mark(zeromark);
-        space(zerospace);
+        queueMark(zeromark);
+        queueSpace(zerospace);
       }
   }
 }
@@ -363,20 +523,23 @@ void IRsend::sendGeneric(const uint16_t headermark, const uint32_t headerspace,
     usecs.reset();
 
     // Header
-    if (headermark) mark(headermark);
-    if (headerspace) space(headerspace);
+    queueMark(headermark);
+    queueSpace(headerspace);
 
     // Data
-    sendData(onemark, onespace, zeromark, zerospace, data, nbits, MSBfirst);
+    queueData(onemark, onespace, zeromark, zerospace, data, nbits, MSBfirst);
 
     // Footer
-    if (footermark) mark(footermark);
-    uint32_t elapsed = usecs.elapsed();
+    queueMark(footermark);
+    // Include any trailing space we haven't sent yet.
+    const uint32_t queued = flushQueuedMark();
+    const uint32_t elapsed = usecs.elapsed() + queued;
     // Avoid potential unsigned integer underflow. e.g. when mesgtime is 0.
     if (elapsed >= mesgtime)
-      space(gap);
+      queueSpace(gap);
     else
-      space(std::max(gap, mesgtime - elapsed));
+      queueSpace(std::max(gap, mesgtime - elapsed));
+    flushQueued();
   }
 }
 
@@ -418,17 +581,18 @@ void IRsend::sendGeneric(const uint16_t headermark, const uint32_t headerspace,
   // We always send a message, even for repeat=0, hence '<= repeat'.
   for (uint16_t r = 0; r <= repeat; r++) {
     // Header
-    if (headermark) mark(headermark);
-    if (headerspace) space(headerspace);
+    queueMark(headermark);
+    queueSpace(headerspace);
 
     // Data
     for (uint16_t i = 0; i < nbytes; i++)
-      sendData(onemark, onespace, zeromark, zerospace, *(dataptr + i), 8,
-               MSBfirst);
+      queueData(onemark, onespace, zeromark, zerospace, *(dataptr + i), 8,
+                MSBfirst);
 
     // Footer
-    if (footermark) mark(footermark);
-    space(gap);
+    queueMark(footermark);
+    queueSpace(gap);
+    flushQueued();
   }
 }
 
@@ -446,6 +610,27 @@ void IRsend::sendManchesterData(const uint16_t half_period,
                                 const uint64_t data,
                                 const uint16_t nbits, const bool MSBfirst,
                                 const bool GEThomas) {
+  queueManchesterData(half_period, data, nbits, MSBfirst, GEThomas);
+  flushQueued();
+}
+
+/// Queue the bits of a Manchester code message.
+/// Like `sendManchesterData()`, but it doesn't send what is left in the queue
+/// at the end, so it can be merged with whatever comes next.
+/// @param[in] half_period Nr. of uSeconds for half the clock's period.
+///   (1/2 wavelength)
+/// @param[in] data The data to be transmitted.
+/// @param[in] nbits Nr. of bits of data to be sent.
+/// @param[in] MSBfirst Flag for bit transmission order.
+///   Defaults to MSB->LSB order.
+/// @param[in] GEThomas Use G.E. Thomas (true/default) or IEEE 802.3 (false).
+/// @note Half of each bit is the same level as the half next to it in the
+///   bit before, whenever the bits differ. Queuing merges those into a single
+///   mark or space.
+void IRsend::queueManchesterData(const uint16_t half_period,
+                                 const uint64_t data,
+                                 const uint16_t nbits, const bool MSBfirst,
+                                 const bool GEThomas) {
   if (nbits == 0) return;  // Nothing to send.
   uint16_t bits = nbits;
   uint64_t copy = (GEThomas) ? data : ~data;
@@ -453,27 +638,27 @@ void IRsend::sendManchesterData(const uint16_t half_period,
   if (MSBfirst) {  // Send the MSB first.
     // Send 0's until we get down to a bit size we can actually manage.
     if (bits > (sizeof(data) * 8)) {
-      sendManchesterData(half_period, 0ULL, bits - sizeof(data) * 8, MSBfirst,
-                         GEThomas);
+      queueManchesterData(half_period, 0ULL, bits - sizeof(data) * 8, MSBfirst,
+                          GEThomas);
       bits = sizeof(data) * 8;
     }
     // Send the supplied data.
     for (uint64_t mask = 1ULL << (bits - 1); mask; mask >>= 1)
       if (copy & mask) {
-        mark(half_period);
-        space(half_period);
+        queueMark(half_period);
+        queueSpace(half_period);
       } else {
-        space(half_period);
-        mark(half_period);
+        queueSpace(half_period);
+        queueMark(half_period);
       }
   } else {  // Send the Least Significant Bit (LSB) first / MSB last.
     for (bits = 0; bits < nbits; bits++, copy >>= 1)
       if (copy & 1) {
-        mark(half_period);
-        space(half_period);
+        queueMark(half_period);
+        queueSpace(half_period);
       } else {
-        space(half_period);
-        mark(half_period);
+        queueSpace(half_period);
+        queueMark(half_period);
       }
   }
 }
@@ -517,13 +702,14 @@ void IRsend::sendManchester(const uint16_t headermark,
   // We always send a message, even for repeat=0, hence '<= repeat'.
   for (uint16_t r = 0; r <= repeat; r++) {
     // Header
-    if (headermark) mark(headermark);
-    if (headerspace) space(headerspace);
+    queueMark(headermark);
+    queueSpace(headerspace);
     // Data
-    sendManchesterData(half_period, data, nbits, MSBfirst, GEThomas);
+    queueManchesterData(half_period, data, nbits, MSBfirst, GEThomas);
     // Footer
-    if (footermark) mark(footermark);
-    if (gap) space(gap);
+    queueMark(footermark);
+    queueSpace(gap);
+    flushQueued();
   }
 }
 
@@ -542,11 +728,101 @@ void IRsend::sendRaw(const uint16_t buf[], const uint16_t len,
   enableIROut(hz);
   for (uint16_t i = 0; i < len; i++) {
     if (i & 1) {  // Odd bit.
-      space(buf[i]);
+      queueSpace(buf[i]);
     } else {  // Even bit.
-      mark(buf[i]);
+      queueMark(buf[i]);
+    }
+  }
+  flushQueued();
+  ledOff();  // We potentially have ended with a mark(), so turn of the LED.
+}
+
+/// Send a raw IRremote message stored in flash (PROGMEM), without copying it
+/// into RAM first.
+///
+/// @param[in] buf A PROGMEM array of uint16_t's that has microseconds elements.
+/// @param[in] len Nr. of elements in the buf[] array.
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+/// @note Same format as `sendRaw()`. i.e. Add `PROGMEM` to the output of
+///   `resultToSourceCode()`.
+void IRsend::sendRaw_P(const uint16_t buf[], const uint16_t len,
+                       const uint16_t hz) {
+  enableIROut(hz);
+  for (uint16_t i = 0; i < len; i++) {
+    const uint16_t usecs = pgm_read_word(&buf[i]);
+    if (i & 1)  // Odd bit.
+      queueSpace(usecs);
+    else  // Even bit.
+      queueMark(usecs);
+  }
+  flushQueued();
+  ledOff();  // We potentially have ended with a mark(), so turn of the LED.
+}
+
+/// Send a raw IRremote message stored in flash (PROGMEM) in packed form,
+/// without unpacking it into RAM first.
+///
+/// @param[in] packed A PROGMEM array of bytes, as made by `packRawData()`.
+/// @param[in] nbytes Nr. of bytes in the packed[] array.
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+/// @note Each duration is stored as the difference from the previous mark or
+///   space (as appropriate), zig-zag encoded, in little-endian base-128.
+///   i.e. 7 bits per byte, with the top bit set if more bytes follow.
+///   Most raw messages need 1 or 2 bytes per duration, and durations up to
+///   32 bits long (5 bytes) are supported.
+void IRsend::sendRawPacked_P(const uint8_t packed[], const uint16_t nbytes,
+                             const uint16_t hz) {
+  enableIROut(hz);
+  uint32_t last[2] = {0, 0};  // The previous mark & space.
+  uint32_t value = 0;
+  uint8_t shift = 0;
+  bool is_space = false;
+  for (uint16_t i = 0; i < nbytes; i++) {
+    const uint8_t byte = pgm_read_byte(&packed[i]);
+    if (shift < 32) value |= (uint32_t)(byte & 0x7F) << shift;
+    shift += 7;
+    if (byte & 0x80) continue;  // There is more of this value to come.
+    // Undo the zig-zag encoding & apply the difference.
+    const uint32_t usecs = last[is_space] + ((value >> 1) ^ -(value & 1));
+    last[is_space] = usecs;
+    if (is_space)
+      queueSpace(usecs);
+    else
+      queueMark(usecs);
+    is_space = !is_space;
+    value = 0;
+    shift = 0;
+  }
+  flushQueued();
+  ledOff();  // We potentially have ended with a mark(), so turn of the LED.
+}
+
+/// Send a raw IRremote message that has been compacted by `compactRaw()`.
+///
+/// @param[in] buf An array of uint16_t's that has microseconds elements.
+///   i.e. The lead-in (if any), followed by a single copy of the frame.
+/// @param[in] info A Ptr to the layout of buf[]. (As set by `compactRaw()`.)
+/// @param[in] hz Frequency to send the message at. (kHz < 1000; Hz >= 1000)
+void IRsend::sendRawCompact(const uint16_t buf[], const raw_compact_t *info,
+                            const uint16_t hz) {
+  enableIROut(hz);
+  for (uint16_t i = 0; i < info->lead_len; i++) {
+    if (i & 1)  // Odd bit.
+      queueSpace(buf[i]);
+    else  // Even bit.
+      queueMark(buf[i]);
+  }
+  const uint16_t *frame = buf + info->lead_len;
+  for (uint16_t r = 0; r <= info->repeat; r++) {
+    if (r) queueSpace(info->gap);
+    for (uint16_t i = 0; i < info->frame_len; i++) {
+      if (i & 1)  // Odd bit.
+        queueSpace(frame[i]);
+      else  // Even bit.
+        queueMark(frame[i]);
     }
   }
+  flushQueued();
   ledOff();  // We potentially have ended with a mark(), so turn of the LED.
 }
 #endif  // SEND_RAW
@@ -783,6 +1059,9 @@ bool IRsend::send(const decode_type_t type, const uint64_t data,
                   const uint16_t nbits, const uint16_t repeat) {
   uint16_t min_repeat __attribute__((unused)) =
       std::max(IRsend::minRepeats(type), repeat);
+#if ENABLE_CARRIER_SENSE
+  _cs_protocol_guard = carrierSenseGuard(type);
+#endif  // ENABLE_CARRIER_SENSE
   switch (type) {
 #if SEND_AIRWELL
     case AIRWELL:
@@ -1078,8 +1357,14 @@ bool IRsend::send(const decode_type_t type, const uint64_t data,
       break;
 #endif  // SEND_ZEPEAL
     default:
+#if ENABLE_CARRIER_SENSE
+      _cs_protocol_guard = 0;
+#endif  // ENABLE_CARRIER_SENSE
       return false;
   }
+#if ENABLE_CARRIER_SENSE
+  _cs_protocol_guard = 0;
+#endif  // ENABLE_CARRIER_SENSE
   return true;
 }
 
@@ -1091,6 +1376,9 @@ bool IRsend::send(const decode_type_t type, const uint64_t data,
 /// @return True if it is a type we can attempt to send, false if not.
 bool IRsend::send(const decode_type_t type, const uint8_t *state,
                   const uint16_t nbytes) {
+#if ENABLE_CARRIER_SENSE
+  _cs_protocol_guard = carrierSenseGuard(type);
+#endif  // ENABLE_CARRIER_SENSE
   switch (type) {
 #if SEND_VOLTAS
     case VOLTAS:
@@ -1311,7 +1599,13 @@ bool IRsend::send(const decode_type_t type, const uint8_t *state,
       break;
 #endif  // SEND_WHIRLPOOL_AC
     default:
+#if ENABLE_CARRIER_SENSE
+      _cs_protocol_guard = 0;
+#endif  // ENABLE_CARRIER_SENSE
       return false;
   }
+#if ENABLE_CARRIER_SENSE
+  _cs_protocol_guard = 0;
+#endif  // ENABLE_CARRIER_SENSE
   return true;
 }
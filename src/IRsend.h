@@ -6,7 +6,10 @@
 
 #define __STDC_LIMIT_MACROS
 #include <stdint.h>
+#include <algorithm>
 #include "IRremoteESP8266.h"
+#include "IRoutput.h"
+#include "IRtimer.h"
 
 // Originally from https://github.com/shirriff/Arduino-IRremote/
 // Updated by markszabo (https://github.com/crankyoldgit/IRremoteESP8266) for
@@ -40,6 +43,38 @@ const uint16_t kMaxAccurateUsecDelay = 16383;
 //  Usecs to wait between messages we don't know the proper gap time.
 const uint32_t kDefaultMessageGap = 100000;
 
+/// A raw message stored as an optional lead-in, then one frame sent one or
+/// more times. See `compactRaw()` & `IRsend::sendRawCompact()`.
+struct raw_compact_t {
+  uint16_t lead_len;  ///< Nr. of entries before the frame, incl. their gap.
+  uint16_t frame_len;  ///< Nr. of entries in the frame. (It ends in a mark.)
+  uint32_t gap;  ///< The space between each copy of the frame. (usecs)
+  uint16_t repeat;  ///< Nr. of extra times the frame is sent.
+};
+
+// Carrier sense (listen-before-talk). See `IRsend::setCarrierSense()`.
+// Only built if ENABLE_CARRIER_SENSE is set. See IRremoteESP8266.h
+/// Default msecs the channel must be quiet for before we transmit.
+const uint16_t kCarrierSenseGuardMs = 50;
+/// Msecs the channel must be quiet for before sending an A/C (state) message.
+/// Their remotes often send several sections or copies with long gaps.
+const uint16_t kCarrierSenseAcGuardMs = 120;
+/// The first (& smallest) random backoff window. (msecs)
+const uint16_t kCarrierSenseSlotMs = 8;
+/// The largest random backoff window. (msecs)
+const uint16_t kCarrierSenseMaxBackoffMs = 128;
+/// Default max. msecs to defer a transmission before sending it anyway.
+const uint16_t kCarrierSenseMaxWaitMs = 1000;
+
+/// Statistics kept by the carrier sense (listen-before-talk) option.
+typedef struct {
+  uint32_t checks;  ///< Nr. of times the channel was checked before sending.
+  uint32_t deferrals;  ///< Nr. of transmissions delayed by a busy channel.
+  uint32_t backoffs;  ///< Nr. of times it went busy again while we waited.
+  uint32_t forced;  ///< Nr. sent on a busy channel after waiting too long.
+  uint32_t deferred_ms;  ///< Total msecs transmissions were delayed by.
+} carrier_sense_stats_t;
+
 /// Enumerators and Structures for the Common A/C API.
 namespace stdAc {
   /// Common A/C settings for A/C operating modes.
@@ -188,6 +223,7 @@ enum lg_ac_remote_model_t {
 
 
 // Classes
+class IRrecv;  // Forward declaration. Only needed for carrier sense.
 
 /// Class for sending all basic IR protocols.
 /// @note Originally from https://github.com/shirriff/Arduino-IRremote/
@@ -202,14 +238,39 @@ class IRsend {
   VIRTUAL void _delayMicroseconds(uint32_t usec);
   VIRTUAL uint16_t mark(uint16_t usec);
   VIRTUAL void space(uint32_t usec);
+  template <class Output>
+  uint16_t markWith(Output *output, const uint16_t usec);
+  void queueMark(const uint32_t usec);
+  void queueSpace(const uint32_t usec);
+  void flushQueued(void);
+  uint32_t flushQueuedMark(void);
   int8_t calibrate(uint16_t hz = 38000U);
+#if ENABLE_CARRIER_SENSE
+  void setCarrierSense(IRrecv *receiver, const uint16_t guard_ms = 0,
+                       const uint16_t max_wait_ms = kCarrierSenseMaxWaitMs);
+  carrier_sense_stats_t getCarrierSenseStats(void);
+  void resetCarrierSenseStats(void);
+  static uint16_t carrierSenseGuard(const decode_type_t protocol);
+#endif  // ENABLE_CARRIER_SENSE
   void sendRaw(const uint16_t buf[], const uint16_t len, const uint16_t hz);
+  void sendRaw_P(const uint16_t buf[], const uint16_t len, const uint16_t hz);
+  void sendRawPacked_P(const uint8_t packed[], const uint16_t nbytes,
+                       const uint16_t hz);
+  void sendRawCompact(const uint16_t buf[], const raw_compact_t *info,
+                      const uint16_t hz);
   void sendData(uint16_t onemark, uint32_t onespace, uint16_t zeromark,
                 uint32_t zerospace, uint64_t data, uint16_t nbits,
                 bool MSBfirst = true);
+  void queueData(const uint16_t onemark, const uint32_t onespace,
+                 const uint16_t zeromark, const uint32_t zerospace,
+                 const uint64_t data, const uint16_t nbits,
+                 const bool MSBfirst = true);
   void sendManchesterData(const uint16_t half_period, const uint64_t data,
                           const uint16_t nbits, const bool MSBfirst = true,
                           const bool GEThomas = true);
+  void queueManchesterData(const uint16_t half_period, const uint64_t data,
+                           const uint16_t nbits, const bool MSBfirst = true,
+                           const bool GEThomas = true);
   void sendManchester(const uint16_t headermark, const uint32_t headerspace,
                       const uint16_t half_period, const uint16_t footermark,
                       const uint32_t gap, const uint64_t data,
@@ -250,7 +311,8 @@ class IRsend {
      SEND_MIDEA24)
   void sendNEC(uint64_t data, uint16_t nbits = kNECBits,
                uint16_t repeat = kNoRepeat);
-  uint32_t encodeNEC(uint16_t address, uint16_t command);
+  static constexpr uint32_t encodeNEC(const uint16_t address,
+                                     const uint16_t command);
 #endif
 #if SEND_SONY
   // sendSony() should typically be called with repeat=2 as Sony devices
@@ -262,8 +324,10 @@ class IRsend {
                 const uint16_t repeat = kSonyMinRepeat);
   void sendSony38(const uint64_t data, const uint16_t nbits = kSony20Bits,
                   const uint16_t repeat = kSonyMinRepeat + 1);
-  uint32_t encodeSony(const uint16_t nbits, const uint16_t command,
-                      const uint16_t address, const uint16_t extended = 0);
+  static constexpr uint32_t encodeSony(const uint16_t nbits,
+                                      const uint16_t command,
+                                      const uint16_t address,
+                                      const uint16_t extended = 0);
 #endif  // SEND_SONY
 #if SEND_SHERWOOD
   void sendSherwood(uint64_t data, uint16_t nbits = kSherwoodBits,
@@ -272,7 +336,8 @@ class IRsend {
 #if SEND_SAMSUNG
   void sendSAMSUNG(const uint64_t data, const uint16_t nbits = kSamsungBits,
                    const uint16_t repeat = kNoRepeat);
-  uint32_t encodeSAMSUNG(const uint8_t customer, const uint8_t command);
+  static constexpr uint32_t encodeSAMSUNG(const uint8_t customer,
+                                         const uint8_t command);
 #endif
 #if SEND_SAMSUNG36
   void sendSamsung36(const uint64_t data, const uint16_t nbits = kSamsung36Bits,
@@ -288,12 +353,15 @@ class IRsend {
               uint16_t repeat = kNoRepeat);
   void sendLG2(uint64_t data, uint16_t nbits = kLgBits,
                uint16_t repeat = kNoRepeat);
-  uint32_t encodeLG(uint16_t address, uint16_t command);
+  static constexpr uint32_t encodeLG(const uint16_t address,
+                                    const uint16_t command);
 #endif
 #if (SEND_SHARP || SEND_DENON)
-  uint32_t encodeSharp(const uint16_t address, const uint16_t command,
-                       const uint16_t expansion = 1, const uint16_t check = 0,
-                       const bool MSBfirst = false);
+  static constexpr uint32_t encodeSharp(const uint16_t address,
+                                       const uint16_t command,
+                                       const uint16_t expansion = 1,
+                                       const uint16_t check = 0,
+                                       const bool MSBfirst = false);
   void sendSharp(const uint16_t address, const uint16_t command,
                  const uint16_t nbits = kSharpBits,
                  const uint16_t repeat = kNoRepeat);
@@ -308,7 +376,8 @@ class IRsend {
 #if SEND_JVC
   void sendJVC(uint64_t data, uint16_t nbits = kJvcBits,
                uint16_t repeat = kNoRepeat);
-  uint16_t encodeJVC(uint8_t address, uint8_t command);
+  static constexpr uint16_t encodeJVC(const uint8_t address,
+                                     const uint8_t command);
 #endif
 #if SEND_DENON
   void sendDenon(uint64_t data, uint16_t nbits = kDenonBits,
@@ -345,23 +414,28 @@ class IRsend {
   void sendPanasonic(const uint16_t address, const uint32_t data,
                      const uint16_t nbits = kPanasonicBits,
                      const uint16_t repeat = kNoRepeat);
-  uint64_t encodePanasonic(const uint16_t manufacturer, const uint8_t device,
-                           const uint8_t subdevice, const uint8_t function);
+  static constexpr uint64_t encodePanasonic(const uint16_t manufacturer,
+                                           const uint8_t device,
+                                           const uint8_t subdevice,
+                                           const uint8_t function);
 #endif
 #if SEND_RC5
   void sendRC5(const uint64_t data, uint16_t nbits = kRC5XBits,
                const uint16_t repeat = kNoRepeat);
-  uint16_t encodeRC5(const uint8_t address, const uint8_t command,
-                     const bool key_released = false);
-  uint16_t encodeRC5X(const uint8_t address, const uint8_t command,
-                      const bool key_released = false);
+  static constexpr uint16_t encodeRC5(const uint8_t address,
+                                     const uint8_t command,
+                                     const bool key_released = false);
+  static constexpr uint16_t encodeRC5X(const uint8_t address,
+                                      const uint8_t command,
+                                      const bool key_released = false);
   uint64_t toggleRC5(const uint64_t data);
 #endif
 #if SEND_RC6
   void sendRC6(const uint64_t data, const uint16_t nbits = kRC6Mode0Bits,
                const uint16_t repeat = kNoRepeat);
-  uint64_t encodeRC6(const uint32_t address, const uint8_t command,
-                     const uint16_t mode = kRC6Mode0Bits);
+  static constexpr uint64_t encodeRC6(const uint32_t address,
+                                     const uint8_t command,
+                                     const uint16_t mode = kRC6Mode0Bits);
   uint64_t toggleRC6(const uint64_t data, const uint16_t nbits = kRC6Mode0Bits);
 #endif
 #if SEND_RCMM
@@ -617,7 +691,8 @@ class IRsend {
 #if SEND_PIONEER
   void sendPioneer(const uint64_t data, const uint16_t nbits = kPioneerBits,
                    const uint16_t repeat = kNoRepeat);
-  uint64_t encodePioneer(uint16_t address, uint16_t command);
+  static constexpr uint64_t encodePioneer(const uint16_t address,
+                                         const uint16_t command);
 #endif
 #if SEND_MWM
   void sendMWM(const unsigned char data[], const uint16_t nbytes,
@@ -768,6 +843,16 @@ class IRsend {
   uint8_t outputOff;
   VIRTUAL void ledOff();
   VIRTUAL void ledOn();
+  /// The default output policy. The object's own `ledOn()` & `ledOff()`.
+  class LedOutput {
+   public:
+    explicit LedOutput(IRsend *irsend) : _irsend(irsend) {}
+    inline void on(void) { _irsend->ledOn(); }
+    inline void off(void) { _irsend->ledOff(); }
+
+   private:
+    IRsend *_irsend;
+  };
 #ifndef UNIT_TEST
 
  private:
@@ -780,11 +865,318 @@ class IRsend {
   int8_t periodOffset;
   uint8_t _dutycycle;
   bool modulation;
+#if ENABLE_CARRIER_SENSE
+  IRrecv *_cs_receiver;  ///< Receiver to listen with before sending, or NULL.
+  uint16_t _cs_guard;  ///< Quiet msecs needed before sending. 0 is auto.
+  uint16_t _cs_max_wait;  ///< Max. msecs to defer a transmission for.
+  uint16_t _cs_protocol_guard;  ///< Guard for the `send()` in progress, or 0.
+  uint32_t _cs_seed;  ///< State of the backoff's pseudo-random generator.
+  bool _cs_active;  ///< Have we sent or checked the channel yet?
+  IRtimer _cs_last;  ///< Time since we last sent or checked the channel.
+  carrier_sense_stats_t _cs_stats;
+#endif  // ENABLE_CARRIER_SENSE
+  uint32_t _queued_usecs;  ///< Length of the queued mark or space.
+  bool _queued_mark;  ///< Is the queued level a mark?
   uint32_t calcUSecPeriod(uint32_t hz, bool use_offset = true);
+#if ENABLE_CARRIER_SENSE
+  void listenBeforeTalk(void);
+#endif  // ENABLE_CARRIER_SENSE
 #if SEND_SONY
   void _sendSony(const uint64_t data, const uint16_t nbits,
                  const uint16_t repeat, const uint16_t freq);
 #endif  // SEND_SONY
+  static constexpr uint64_t _reverseBits(const uint64_t input,
+                                         const uint16_t nbits,
+                                         const uint64_t output = 0);
+  static constexpr uint8_t _sumNibbles(const uint64_t data,
+                                       const uint8_t count);
 };
 
+/// Modulate the IR LED for the given period (usec), at the frequency & duty
+/// cycle set, via a given output policy. See `IRoutput.h`.
+/// @tparam Output The output policy's class.
+/// @param[in,out] output A Ptr to the output policy to switch the LED with.
+/// @param[in] usec The period of time to modulate the IR LED for, in
+///  microseconds.
+/// @return Nr. of pulses actually sent.
+/// @note This is the loop used by `mark()`. Only the output differs.
+template <class Output>
+uint16_t IRsend::markWith(Output *output, const uint16_t usec) {
+  // Handle the simple case of no required frequency modulation.
+  if (!modulation || _dutycycle >= 100) {
+    output->on();
+    _delayMicroseconds(usec);
+    output->off();
+    return 1;
+  }
+
+  // Not simple, so do it assuming frequency modulation.
+  uint16_t counter = 0;
+  IRtimer usecTimer = IRtimer();
+  // Cache the time taken so far. This saves us calling time, and we can be
+  // assured that we can't have odd math problems. i.e. unsigned under/overflow.
+  uint32_t elapsed = usecTimer.elapsed();
+
+  while (elapsed < usec) {  // Loop until we've met/exceeded our required time.
+    output->on();
+    // Calculate how long we should pulse on for.
+    // e.g. Are we to close to the end of our requested mark time (usec)?
+    _delayMicroseconds(std::min((uint32_t)onTimePeriod, usec - elapsed));
+    output->off();
+    counter++;
+    if (elapsed + onTimePeriod >= usec)
+      return counter;  // LED is now off & we've passed our allotted time.
+    // Wait for the lesser of the rest of the duty cycle, or the time remaining.
+    _delayMicroseconds(
+        std::min(usec - elapsed - onTimePeriod, (uint32_t)offTimePeriod));
+    elapsed = usecTimer.elapsed();  // Update & recache the actual elapsed time.
+  }
+  return counter;
+}
+
+
+// The simple protocols' encoders are constexpr, so tables of codes built with
+// them can be calculated at compile time & live in flash. e.g.
+//   static const uint32_t kCodes[] = {IRsend::encodeNEC(0x4, 0x8), ...};
+// They are written as single expressions, as C++11 requires.
+
+/// Reverse the order of the lowest `nbits` bits of a value.
+/// A compile-time version of `reverseBits()` for values that fit in `nbits`.
+/// @param[in] input The value, which must fit in `nbits` bits.
+/// @param[in] nbits The nr. of bits to reverse.
+/// @param[in] output The bits reversed so far.
+/// @return The reversed bits.
+constexpr uint64_t IRsend::_reverseBits(const uint64_t input,
+                                        const uint16_t nbits,
+                                        const uint64_t output) {
+  return nbits ? _reverseBits(input >> 1, nbits - 1,
+                              (output << 1) | (input & 1)) : output;
+}
+
+/// Sum the lowest `count` nibbles of a value, keeping only the last nibble.
+/// A compile-time version of `irutils::sumNibbles(data, count)`.
+/// @param[in] data The value to sum.
+/// @param[in] count The nr. of nibbles to sum.
+/// @return The lowest nibble of the sum.
+constexpr uint8_t IRsend::_sumNibbles(const uint64_t data,
+                                      const uint8_t count) {
+  return count ? ((data & 0xF) + _sumNibbles(data >> 4, count - 1)) & 0xF : 0;
+}
+
+#if (SEND_NEC || SEND_SHERWOOD || SEND_AIWA_RC_T501 || SEND_SANYO || \
+     SEND_MIDEA24)
+/// Calculate the raw NEC data based on address and command.
+/// Status: STABLE / Expected to work.
+/// @param[in] address An address value.
+/// @param[in] command An 8-bit command value.
+/// @return A raw 32-bit NEC message suitable for use with `sendNEC()`.
+/// @note sendNEC() sends MSB first, but the protocol is LSB first.
+/// @see http://www.sbprojects.net/knowledge/ir/nec.php
+constexpr uint32_t IRsend::encodeNEC(const uint16_t address,
+                                     const uint16_t command) {
+  return ((address > 0xFF) ?
+          (uint32_t)_reverseBits(address, 16) << 16 :  // Extended.
+          ((uint32_t)_reverseBits(address, 8) << 24) |  // Normal.
+          (((uint32_t)_reverseBits(address, 8) ^ 0xFF) << 16)) |
+      // We only want the least significant byte of command.
+      ((uint32_t)_reverseBits(command & 0xFF, 8) << 8) |
+      ((uint32_t)_reverseBits(command & 0xFF, 8) ^ 0xFF);
+}
+#endif  // (SEND_NEC || SEND_SHERWOOD || SEND_AIWA_RC_T501 || SEND_SANYO ||
+        //  SEND_MIDEA24)
+
+#if SEND_SONY
+/// Convert Sony/SIRC command, address, & extended bits into sendSony format.
+/// Status: STABLE / Should be working.
+/// @param[in] nbits Sony protocol bit size.
+/// @param[in] command Sony command bits.
+/// @param[in] address Sony address bits.
+/// @param[in] extended Sony extended bits.
+/// @return A `sendSony()` etc compatible data message. 0 if `nbits` isn't a
+///   Sony size.
+constexpr uint32_t IRsend::encodeSony(const uint16_t nbits,
+                                      const uint16_t command,
+                                      const uint16_t address,
+                                      const uint16_t extended) {
+  // 12: 5 address bits, 15: 8 address bits, 20: 5 address & 8 extended bits.
+  // All sizes have 7 command bits. sendSony uses reverse ordered bits.
+  return (nbits == kSony12Bits || nbits == kSony15Bits ||
+          nbits == kSony20Bits) ?
+      _reverseBits(
+          (((uint32_t)(address & (nbits == kSony15Bits ? 0xFF : 0x1F)) |
+            (nbits == kSony20Bits ? (uint32_t)(extended & 0xFF) << 5 : 0))
+           << 7) | (command & 0x7F),
+          nbits) :
+      0;  // This is not an expected Sony bit size/protocol.
+}
+#endif  // SEND_SONY
+
+#if SEND_SAMSUNG
+/// Construct a raw Samsung message from the supplied customer(address) &
+/// command.
+/// Status: STABLE / Should be working.
+/// @param[in] customer The customer code. (aka. Address)
+/// @param[in] command The command code.
+/// @return A raw 32-bit Samsung message suitable for `sendSAMSUNG()`.
+constexpr uint32_t IRsend::encodeSAMSUNG(const uint8_t customer,
+                                         const uint8_t command) {
+  return ((uint32_t)_reverseBits(command, 8) ^ 0xFF) |
+         ((uint32_t)_reverseBits(command, 8) << 8) |
+         ((uint32_t)_reverseBits(customer, 8) << 16) |
+         ((uint32_t)_reverseBits(customer, 8) << 24);
+}
+#endif  // SEND_SAMSUNG
+
+#if SEND_LG
+/// Construct a raw 28-bit LG message code from the supplied address & command.
+/// Status: STABLE / Works.
+/// @param[in] address The address code.
+/// @param[in] command The command code.
+/// @return A raw 28-bit LG message code suitable for sendLG() etc.
+/// @note Sequence of bits = address + command + checksum.
+constexpr uint32_t IRsend::encodeLG(const uint16_t address,
+                                    const uint16_t command) {
+  return ((uint32_t)address << 20) | ((uint32_t)command << kLgAcChecksumSize) |
+         _sumNibbles(command, 4);
+}
+#endif  // SEND_LG
+
+#if (SEND_SHARP || SEND_DENON)
+/// Encode a (raw) Sharp message from it's components.
+/// Status: STABLE / Works okay.
+/// @param[in] address The value of the address to be sent.
+/// @param[in] command The value of the address to be sent. (8 bits)
+/// @param[in] expansion The value of the expansion bit to use.
+///   (0 or 1, typically 1)
+/// @param[in] check The value of the check bit to use. (0 or 1, typically 0)
+/// @param[in] MSBfirst Flag indicating MSB first or LSB first order.
+/// @return A uint32_t containing the raw Sharp message for `sendSharpRaw()`.
+/// @note Assumes the standard Sharp bit sizes.
+///   Historically sendSharp() sends address & command in
+///   MSB first order. This is actually incorrect. It should be sent in LSB
+///   order. The behaviour of sendSharp() hasn't been changed to maintain
+///   backward compatibility.
+constexpr uint32_t IRsend::encodeSharp(const uint16_t address,
+                                       const uint16_t command,
+                                       const uint16_t expansion,
+                                       const uint16_t check,
+                                       const bool MSBfirst) {
+  // Mask any unexpected bits, & correct the bit order if needed.
+  return ((uint32_t)(MSBfirst ?
+                     address & ((1 << kSharpAddressBits) - 1) :
+                     _reverseBits(address & ((1 << kSharpAddressBits) - 1),
+                                  kSharpAddressBits))
+          << (kSharpCommandBits + 2)) |
+         ((uint32_t)(MSBfirst ?
+                     command & ((1 << kSharpCommandBits) - 1) :
+                     _reverseBits(command & ((1 << kSharpCommandBits) - 1),
+                                  kSharpCommandBits)) << 2) |
+         ((expansion & 1) << 1) | (check & 1);
+}
+#endif  // (SEND_SHARP || SEND_DENON)
+
+#if SEND_JVC
+/// Calculate the raw JVC data based on address and command.
+/// Status: STABLE / Works fine.
+/// @param[in] address An 8-bit address value.
+/// @param[in] command An 8-bit command value.
+/// @return A raw JVC message code, suitable for sendJVC()..
+/// @see http://www.sbprojects.net/knowledge/ir/jvc.php
+constexpr uint16_t IRsend::encodeJVC(const uint8_t address,
+                                     const uint8_t command) {
+  return _reverseBits(((uint16_t)command << 8) | address, 16);
+}
+#endif  // SEND_JVC
+
+#if (SEND_PANASONIC || SEND_DENON)
+/// Calculate the raw Panasonic data based on device, subdevice, & function.
+/// Status: STABLE / Should be working.
+/// @param[in] manufacturer A 16-bit manufacturer code. e.g. 0x4004 is Panasonic
+/// @param[in] device An 8-bit code.
+/// @param[in] subdevice An 8-bit code.
+/// @param[in] function An 8-bit code.
+/// @return A value suitable for use with `sendPanasonic64()`.
+/// @note Panasonic 48-bit protocol is a modified version of Kaseikyo.
+/// @see http://www.remotecentral.com/cgi-bin/mboard/rc-pronto/thread.cgi?2615
+constexpr uint64_t IRsend::encodePanasonic(const uint16_t manufacturer,
+                                           const uint8_t device,
+                                           const uint8_t subdevice,
+                                           const uint8_t function) {
+  return ((uint64_t)manufacturer << 32) | ((uint64_t)device << 24) |
+         ((uint64_t)subdevice << 16) | ((uint64_t)function << 8) |
+         (uint8_t)(device ^ subdevice ^ function);  // Checksum
+}
+#endif  // (SEND_PANASONIC || SEND_DENON)
+
+#if SEND_RC5
+/// Encode a Philips RC-5 data message.
+/// Status: Beta / Should be working.
+/// @param[in] address The 5-bit address value for the message.
+/// @param[in] command The 6-bit command value for the message.
+/// @param[in] key_released Indicate if the remote key has been released.
+/// @return A message suitable for use in sendRC5().
+constexpr uint16_t IRsend::encodeRC5(const uint8_t address,
+                                     const uint8_t command,
+                                     const bool key_released) {
+  return ((uint16_t)key_released << (kRC5Bits - 1)) |
+         ((address & 0x1f) << 6) | (command & 0x3F);
+}
+
+/// Encode a Philips RC-5X data message.
+/// Status: Beta / Should be working.
+/// @param[in] address The 5-bit address value for the message.
+/// @param[in] command The 7-bit command value for the message.
+/// @param[in] key_released Indicate if the remote key has been released.
+/// @return A message suitable for use in sendRC5().
+constexpr uint16_t IRsend::encodeRC5X(const uint8_t address,
+                                      const uint8_t command,
+                                      const bool key_released) {
+  // The 2nd start/field bit (MSB of the return value) is the value of the 7th
+  // command bit.
+  return ((uint16_t)((command >> 6) & 1) << (kRC5XBits - 1)) |
+         encodeRC5(address, command, key_released);
+}
+#endif  // SEND_RC5
+
+#if SEND_RC6
+/// Encode a Philips RC-6 data message.
+/// Status: Beta / Should be working.
+/// @param[in] address The address (aka. control) value for the message.
+///   Includes the field/mode/toggle bits.
+/// @param[in] command The 8-bit command value for the message.
+///   (aka. information)
+/// @param[in] mode Which protocol to use.
+///   Defined by nr. of bits in the protocol.
+/// @return A data message suitable for use in `sendRC6()`.
+constexpr uint64_t IRsend::encodeRC6(const uint32_t address,
+                                     const uint8_t command,
+                                     const uint16_t mode) {
+  return (mode == kRC6Mode0Bits) ?
+      ((uint64_t)(address & 0xFFF) << 8) | command :
+      (mode == kRC6_36Bits) ?
+      ((uint64_t)(address & 0xFFFFFFF) << 8) | command :
+      0;
+}
+#endif  // SEND_RC6
+
+#if SEND_PIONEER
+/// Calculate the raw Pioneer data code based on two NEC sub-codes
+/// Status: STABLE / Expected to work.
+/// @param[in] address A 16-bit "published" NEC value.
+/// @param[in] command A 16-bit "published" NEC value.
+/// @return A raw 64-bit Pioneer message code for use with `sendPioneer()``
+/// @note Address & Command can be take from a decode result OR from the
+///   spreadsheets located at:
+///    https://www.pioneerelectronics.com/PUSA/Support/Home-Entertainment-Custom-Install/IR+Codes/A+V+Receivers
+///   where the first part is considered the address,
+///   and the second the command.
+///  e.g.
+///  "A556+AF20" is an Address of 0xA556 & a Command of 0xAF20.
+constexpr uint64_t IRsend::encodePioneer(const uint16_t address,
+                                         const uint16_t command) {
+  return ((uint64_t)encodeNEC(address >> 8, address & 0xFF) << 32) |
+         encodeNEC(command >> 8, command & 0xFF);
+}
+#endif  // SEND_PIONEER
+
 #endif  // IRSEND_H_
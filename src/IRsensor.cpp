@@ -0,0 +1,312 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Periodic room temperature ("FollowMe"/"iFeel") reports for A/Cs.
+/// @see IRSensorReporter
+
+#include "IRsensor.h"
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#include <string.h>
+#include <algorithm>
+#include "IRac.h"
+
+/// Class constructor
+/// @param[in] max_units The max. nr. of A/C units to report to.
+/// @param[in] emitter_gap_ms Min. nr. of milli-seconds between reports sent
+///   by the same emitter.
+IRSensorReporter::IRSensorReporter(const uint16_t max_units,
+                                   const uint16_t emitter_gap_ms)
+    : _capacity(max_units), _nr_units(0), _gap(emitter_gap_ms), _sent(0),
+      _now(0), _nr_emitters(0) {
+  _units = new unit_t[_capacity];
+  if (_units == NULL) {
+    DPRINTLN("Could not allocate memory for the sensor reporter.");
+    _capacity = 0;
+  }
+}
+
+/// Class destructor
+IRSensorReporter::~IRSensorReporter(void) { delete[] _units; }
+
+/// Can we send sensor reports for a given protocol?
+/// @param[in] protocol The A/C protocol.
+/// @return true if we can, otherwise false.
+bool IRSensorReporter::isProtocolSupported(const decode_type_t protocol) {
+  switch (protocol) {
+#if SEND_ARGO
+    case decode_type_t::ARGO:
+#endif  // SEND_ARGO
+#if SEND_COOLIX
+    case decode_type_t::COOLIX:
+#endif  // SEND_COOLIX
+#if SEND_MIDEA
+    case decode_type_t::MIDEA:
+#endif  // SEND_MIDEA
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// How often does a unit using a given protocol need a sensor report?
+/// @param[in] protocol The A/C protocol.
+/// @return The max. nr. of milli-seconds between reports.
+uint32_t IRSensorReporter::defaultRefresh(const decode_type_t protocol) {
+  switch (protocol) {
+    case decode_type_t::COOLIX: return kSensorCoolixRefreshMs;
+    case decode_type_t::ARGO: return kSensorArgoRefreshMs;
+    default: return kSensorMideaRefreshMs;
+  }
+}
+
+/// How long must we wait between sensor reports for a given protocol?
+/// @param[in] protocol The A/C protocol.
+/// @return The min. nr. of milli-seconds between reports.
+uint32_t IRSensorReporter::minInterval(const decode_type_t protocol) {
+  switch (protocol) {
+    case decode_type_t::COOLIX: return kSensorCoolixMinIntervalMs;
+    default: return 0;
+  }
+}
+
+/// What is the highest sensor temperature a given protocol can report?
+/// @param[in] protocol The A/C protocol.
+/// @return The max. temperature in degrees celsius.
+uint8_t IRSensorReporter::maxTemp(const decode_type_t protocol) {
+  switch (protocol) {
+    case decode_type_t::ARGO: return kArgoMaxRoomTemp;
+    case decode_type_t::COOLIX: return kCoolixSensorTempMax;
+    default: return kMideaACMaxSensorTempC;
+  }
+}
+
+/// Add an A/C unit to report the room temperature to.
+/// @param[in] emitter A Ptr to the IRsend object that can reach the unit.
+/// @param[in] protocol The unit's A/C protocol.
+/// @param[in] refresh_ms Max. nr. of milli-seconds between reports.
+///   0 means use the protocol's default.
+/// @param[in] threshold The change in temperature (Celsius) that needs to be
+///   reported straight away.
+/// @return The unit's id, or kSensorNoUnit if it couldn't be added.
+int16_t IRSensorReporter::addUnit(IRsend *emitter,
+                                  const decode_type_t protocol,
+                                  const uint32_t refresh_ms,
+                                  const float threshold) {
+  if (emitter == NULL || !isProtocolSupported(protocol) ||
+      _nr_units >= _capacity || _nr_units >= INT16_MAX)
+    return kSensorNoUnit;
+  uint8_t index = 0;
+  while (index < _nr_emitters && _emitters[index].irsend != emitter) index++;
+  if (index == _nr_emitters) {  // A new emitter.
+    if (_nr_emitters >= kSensorMaxEmitters) return kSensorNoUnit;
+    _emitters[index].irsend = emitter;
+    _emitters[index].used = false;
+    _nr_emitters++;
+  }
+  unit_t *unit = &_units[_nr_units];
+  unit->protocol = protocol;
+  unit->emitter = index;
+  unit->has_temp = false;
+  unit->reported = false;
+  unit->threshold = threshold;
+  unit->refresh = std::max(refresh_ms ? refresh_ms : defaultRefresh(protocol),
+                           minInterval(protocol));
+  unit->last_ms = _now;
+  // Start with the protocol's default command.
+  memset(unit->base.state, 0, sizeof(unit->base.state));
+  switch (protocol) {
+#if SEND_ARGO
+    case decode_type_t::ARGO:
+    {
+      IRArgoAC ac(kGpioUnused);
+      memcpy(unit->base.state, ac.getRaw(), kArgoStateLength);
+      break;
+    }
+#endif  // SEND_ARGO
+#if SEND_COOLIX
+    case decode_type_t::COOLIX:
+    {
+      IRCoolixAC ac(kGpioUnused);
+      unit->base.raw = ac.getRaw();
+      break;
+    }
+#endif  // SEND_COOLIX
+#if SEND_MIDEA
+    case decode_type_t::MIDEA:
+    {
+      IRMideaAC ac(kGpioUnused);
+      unit->base.raw = ac.getRaw();
+      break;
+    }
+#endif  // SEND_MIDEA
+    default:
+      break;
+  }
+  return _nr_units++;
+}
+
+/// Set the command a unit's reports are based on. (Coolix & Midea)
+/// Use the unit's latest normal command, so the reports don't change any of
+/// its other settings.
+/// @param[in] unit The unit's id.
+/// @param[in] raw The command, in native form.
+/// @return true if it was set, otherwise false.
+bool IRSensorReporter::setBaseState(const int16_t unit, const uint64_t raw) {
+  if (!valid(unit) || _units[unit].protocol == decode_type_t::ARGO)
+    return false;
+  _units[unit].base.raw = raw;
+  return true;
+}
+
+/// Set the command a unit's reports are based on. (Argo)
+/// @param[in] unit The unit's id.
+/// @param[in] state The command, in native form.
+/// @param[in] nbytes The length of the command.
+/// @return true if it was set, otherwise false.
+bool IRSensorReporter::setBaseState(const int16_t unit, const uint8_t *state,
+                                    const uint16_t nbytes) {
+  if (!valid(unit) || state == NULL ||
+      _units[unit].protocol != decode_type_t::ARGO ||
+      nbytes != kArgoStateLength)
+    return false;
+  memcpy(_units[unit].base.state, state, nbytes);
+  return true;
+}
+
+/// Give a unit's latest room temperature reading.
+/// @param[in] unit The unit's id.
+/// @param[in] celsius The temperature, in Celsius.
+/// @return true if it was accepted, otherwise false.
+bool IRSensorReporter::setTemp(const int16_t unit, const float celsius) {
+  if (!valid(unit)) return false;
+  _units[unit].temp = celsius;
+  _units[unit].has_temp = true;
+  return true;
+}
+
+/// Does a unit need a report?
+/// @param[in] unit The unit's id.
+/// @param[in] now_ms The current time, in milli-seconds.
+/// @return true if it does, otherwise false.
+bool IRSensorReporter::isDue(const int16_t unit, const uint32_t now_ms) {
+  return valid(unit) && untilDue(&_units[unit], now_ms) == 0;
+}
+
+/// Get the nr. of units added.
+/// @return The nr. of units.
+uint16_t IRSensorReporter::getUnits(void) { return _nr_units; }
+
+/// Get the nr. of reports sent so far.
+/// @return The nr. of reports.
+uint32_t IRSensorReporter::getReportsSent(void) { return _sent; }
+
+/// Send the reports that are due, as the emitters allow.
+/// Each free emitter sends the report for its unit that has waited longest.
+/// @param[in] now_ms The current time, in milli-seconds. e.g. `millis()`
+/// @return The nr. of reports sent.
+uint16_t IRSensorReporter::poll(const uint32_t now_ms) {
+  _now = now_ms;
+  int32_t best[kSensorMaxEmitters];
+  for (uint8_t i = 0; i < _nr_emitters; i++) best[i] = -1;
+  for (uint16_t i = 0; i < _nr_units; i++) {
+    unit_t *unit = &_units[i];
+    const emitter_t *emitter = &_emitters[unit->emitter];
+    if (emitter->used && now_ms - emitter->last_ms < _gap) continue;
+    if (untilDue(unit, now_ms)) continue;
+    const int32_t current = best[unit->emitter];
+    if (current < 0 ||
+        now_ms - unit->last_ms > now_ms - _units[current].last_ms)
+      best[unit->emitter] = i;
+  }
+  uint16_t sent = 0;
+  for (uint8_t i = 0; i < _nr_emitters; i++) {
+    if (best[i] < 0) continue;
+    report(&_units[best[i]]);
+    sent++;
+  }
+  return sent;
+}
+
+#ifndef UNIT_TEST
+/// Send the reports that are due, as the emitters allow.
+/// @return The nr. of reports sent.
+uint16_t IRSensorReporter::poll(void) { return poll(millis()); }
+#endif  // UNIT_TEST
+
+/// Is a unit id valid?
+/// @param[in] unit The unit's id.
+/// @return true if it is, otherwise false.
+bool IRSensorReporter::valid(const int16_t unit) {
+  return unit >= 0 && unit < _nr_units;
+}
+
+/// How long until a unit needs a report?
+/// @param[in] unit A Ptr to the unit.
+/// @param[in] now_ms The current time, in milli-seconds.
+/// @return Nr. of milli-seconds until it is due. 0 if it is due now.
+uint32_t IRSensorReporter::untilDue(const unit_t *unit,
+                                    const uint32_t now_ms) {
+  if (!unit->has_temp) return UINT32_MAX;  // Nothing to report yet.
+  const uint32_t elapsed = now_ms - unit->last_ms;
+  if (!unit->reported) return 0;
+  const uint32_t min_interval = minInterval(unit->protocol);
+  if (elapsed < min_interval) return min_interval - elapsed;
+  const float change = unit->temp - unit->reported_temp;
+  if (change >= unit->threshold || -change >= unit->threshold) return 0;
+  // Send it a little before the unit would give up on us.
+  const uint32_t deadline = unit->refresh -
+                            unit->refresh / kSensorRefreshLeadDivisor;
+  return (elapsed >= deadline) ? 0 : deadline - elapsed;
+}
+
+/// Send a sensor report to a unit.
+/// @param[in, out] unit A Ptr to the unit.
+void IRSensorReporter::report(unit_t *unit) {
+  IRsend *irsend = _emitters[unit->emitter].irsend;
+  const float celsius = std::min(std::max(unit->temp, 0.0f),
+                                 (float)maxTemp(unit->protocol));
+  const uint8_t degrees = celsius + 0.5;  // Round it.
+  switch (unit->protocol) {
+#if SEND_ARGO
+    case decode_type_t::ARGO:
+    {
+      IRArgoAC ac(kGpioUnused);
+      ac.setRaw(unit->base.state);
+      ac.setiFeel(true);
+      ac.setRoomTemp(degrees);
+      irsend->sendArgo(ac.getRaw(), kArgoStateLength, kArgoDefaultRepeat);
+      break;
+    }
+#endif  // SEND_ARGO
+#if SEND_COOLIX
+    case decode_type_t::COOLIX:
+    {
+      IRCoolixAC ac(kGpioUnused);
+      ac.setRaw(unit->base.raw);
+      ac.setSensorTemp(degrees);
+      irsend->sendCOOLIX(ac.getRaw(), kCoolixBits, kCoolixDefaultRepeat);
+      break;
+    }
+#endif  // SEND_COOLIX
+#if SEND_MIDEA
+    case decode_type_t::MIDEA:
+    {
+      IRMideaAC ac(kGpioUnused);
+      ac.setRaw(unit->base.raw);
+      ac.setSensorTemp(degrees, true);  // Also makes it a FollowMe message.
+      irsend->sendMidea(ac.getRaw(), kMideaBits, kMideaMinRepeat);
+      break;
+    }
+#endif  // SEND_MIDEA
+    default:
+      return;
+  }
+  unit->reported = true;
+  unit->reported_temp = unit->temp;
+  unit->last_ms = _now;
+  _emitters[unit->emitter].last_ms = _now;
+  _emitters[unit->emitter].used = true;
+  _sent++;
+}
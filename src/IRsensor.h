@@ -0,0 +1,107 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Periodic room temperature ("FollowMe"/"iFeel") reports for A/Cs.
+/// @see IRSensorReporter
+
+#ifndef IRSENSOR_H_
+#define IRSENSOR_H_
+
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+
+// Constants
+/// Max. nr. of different emitters (IRsend objects) a reporter can use.
+const uint8_t kSensorMaxEmitters = 8;
+/// Default change in temperature (Celsius) that triggers a report.
+const float kSensorDefaultThreshold = 0.5;
+/// Default min. nr. of milli-seconds between reports on the same emitter.
+const uint16_t kSensorDefaultEmitterGapMs = 500;
+/// A report is sent once this fraction (1/n) of its refresh period remains.
+const uint8_t kSensorRefreshLeadDivisor = 8;
+/// Midea units drop out of FollowMe mode if they don't hear from the remote.
+const uint32_t kSensorMideaRefreshMs = 3 * 60 * 1000;
+/// Coolix units ignore sensor reports sent more often than once a minute.
+const uint32_t kSensorCoolixMinIntervalMs = 60 * 1000;
+/// How often a Coolix unit needs to hear the sensor temperature.
+const uint32_t kSensorCoolixRefreshMs = 5 * 60 * 1000;
+/// How often an Argo unit needs to hear the iFeel temperature.
+const uint32_t kSensorArgoRefreshMs = 3 * 60 * 1000;
+/// Returned instead of a unit id when a unit could not be added.
+const int16_t kSensorNoUnit = -1;
+
+/// Sends room temperature reports to A/C units that use the remote's sensor
+/// rather than their own. i.e. Midea "FollowMe", Coolix "Zone Follow" &
+/// Argo "iFeel".
+/// A unit only gets a report when its temperature has moved by more than its
+/// threshold, or its refresh deadline is close. Each emitter sends at most
+/// one report per gap, the most urgent first, so the airtime is bounded no
+/// matter how many units there are.
+/// @note The report is the unit's normal command message (see
+///   `setBaseState()`) with the sensor temperature added, as none of these
+///   protocols have a shorter sensor-only message.
+class IRSensorReporter {
+ public:
+  explicit IRSensorReporter(
+      const uint16_t max_units,
+      const uint16_t emitter_gap_ms = kSensorDefaultEmitterGapMs);
+  ~IRSensorReporter(void);
+  static bool isProtocolSupported(const decode_type_t protocol);
+  static uint32_t defaultRefresh(const decode_type_t protocol);
+  static uint32_t minInterval(const decode_type_t protocol);
+  static uint8_t maxTemp(const decode_type_t protocol);
+  int16_t addUnit(IRsend *emitter, const decode_type_t protocol,
+                  const uint32_t refresh_ms = 0,
+                  const float threshold = kSensorDefaultThreshold);
+  bool setBaseState(const int16_t unit, const uint64_t raw);
+  bool setBaseState(const int16_t unit, const uint8_t *state,
+                    const uint16_t nbytes);
+  bool setTemp(const int16_t unit, const float celsius);
+  bool isDue(const int16_t unit, const uint32_t now_ms);
+  uint16_t getUnits(void);
+  uint32_t getReportsSent(void);
+  uint16_t poll(const uint32_t now_ms);
+#ifndef UNIT_TEST
+  uint16_t poll(void);
+#endif  // UNIT_TEST
+
+ private:
+  /// What we know about each unit.
+  struct unit_t {
+    decode_type_t protocol;  ///< The unit's A/C protocol.
+    uint8_t emitter;  ///< Index into `_emitters`.
+    bool has_temp;  ///< Have we been given a temperature yet?
+    bool reported;  ///< Has a report ever been sent?
+    float temp;  ///< The latest temperature, in Celsius.
+    float reported_temp;  ///< The temperature last reported.
+    float threshold;  ///< Change in temperature that needs a report.
+    uint32_t refresh;  ///< Max. nr. of milli-seconds between reports.
+    uint32_t last_ms;  ///< When the last report was sent (or unit added).
+    union {
+      uint64_t raw;  ///< Base command for 64 bit or smaller protocols.
+      uint8_t state[kArgoStateLength];  ///< Base command for Argo.
+    } base;  ///< The unit's normal command, that the reports are based on.
+  };
+  /// An emitter & when it was last used.
+  struct emitter_t {
+    IRsend *irsend;  ///< The emitter.
+    uint32_t last_ms;  ///< When it last sent a report.
+    bool used;  ///< Has it sent a report yet?
+  };
+  unit_t *_units;  ///< The unit storage.
+  uint16_t _capacity;  ///< Max. nr. of units.
+  uint16_t _nr_units;  ///< Nr. of units added.
+  uint16_t _gap;  ///< Min. nr. of milli-seconds between sends on an emitter.
+  uint32_t _sent;  ///< Nr. of reports sent so far.
+  uint32_t _now;  ///< The last time we were given. (ms)
+  emitter_t _emitters[kSensorMaxEmitters];  ///< The emitters in use.
+  uint8_t _nr_emitters;  ///< Nr. of emitters in use.
+
+  bool valid(const int16_t unit);
+  uint32_t untilDue(const unit_t *unit, const uint32_t now_ms);
+  void report(unit_t *unit);
+};
+
+#endif  // IRSENSOR_H_
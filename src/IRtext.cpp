@@ -214,6 +214,10 @@ IRTEXT_CONST_STRING(kBitsStr, D_STR_BITS);  ///< "Bits"
 
 // Protocol Names
 // Needs to be in decode_type_t order.
+// Note: When COMPRESS_PROTOCOL_NAMES is enabled, a compressed copy of this
+//       (see `IRtext_protocols.h`) is used instead. Run
+//       '../tools/generate_irtext_protocols.py' after changing this list.
+#if !COMPRESS_PROTOCOL_NAMES
 IRTEXT_CONST_BLOB_DECL(kAllProtocolNamesStr) {
     D_STR_UNUSED "\x0"
     D_STR_RC5 "\x0"
@@ -329,3 +333,4 @@ IRTEXT_CONST_BLOB_DECL(kAllProtocolNamesStr) {
 };
 
 IRTEXT_CONST_BLOB_PTR(kAllProtocolNamesStr);
+#endif  // !COMPRESS_PROTOCOL_NAMES
@@ -0,0 +1,319 @@
+// Copyright 2026 IRremoteESP8266 authors
+// This header file is only to be included by 'IRutils.cpp'.
+//
+// WARNING: Do not edit this file! This file is automatically generated by
+//          '../tools/generate_irtext_protocols.py'.
+//
+// Flash used: 753 bytes, instead of 991 bytes uncompressed. (Saves 238 bytes)
+// Per lookup: 3 index reads, then at most 13 packed bytes & 4 dictionary
+//             words are read. Nothing is allocated.
+
+#ifndef IRTEXT_PROTOCOLS_H_
+#define IRTEXT_PROTOCOLS_H_
+
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "i18n.h"
+
+#ifndef PROGMEM
+#define PROGMEM  // Pretend we have the PROGMEM macro even if we really don't.
+#endif
+
+/// Nr. of protocol names in the table.
+const uint16_t kProtocolNameCount = 109;
+/// Length of the longest protocol name, excluding the null.
+const uint16_t kProtocolNameMaxLength = 20;
+/// Nr. of bits of a protocol number that select its index block.
+const uint8_t kProtocolNameBlockBits = 4;
+/// Packed bytes from this value up are dictionary words.
+const uint8_t kProtocolNameTokenBase = 0x80;
+
+/// Where each dictionary word starts in `kProtocolNameDict`, plus the end.
+const uint8_t kProtocolNameDictIndex[24] PROGMEM = {
+    0, 10, 13, 19, 26, 35, 42, 49, 54, 56, 61, 63, 65, 67, 74, 76, 78, 81, 86,
+    91, 93, 95, 97, 99,
+};
+
+/// The dictionary words, back to back.
+const char kProtocolNameDict[] PROGMEM =
+    "MITSUBISHI"  // 0x80
+    "_AC"  // 0x81
+    "DAIKIN"  // 0x82
+    "HITACHI"  // 0x83
+    "PANASONIC"  // 0x84
+    "CARRIER"  // 0x85
+    "SAMSUNG"  // 0x86
+    "SANYO"  // 0x87
+    "ON"  // 0x88
+    "HAIER"  // 0x89
+    "EC"  // 0x8A
+    "EL"  // 0x8B
+    "SH"  // 0x8C
+    "_HEAVY_"  // 0x8D
+    "TR"  // 0x8E
+    "ER"  // 0x8F
+    "EST"  // 0x90
+    "MIDEA"  // 0x91
+    "OCLIM"  // 0x92
+    "RC"  // 0x93
+    "AG"  // 0x94
+    "AR"  // 0x95
+    "CO";  // 0x96
+
+/// Where each block of names starts in `kProtocolNamePacked`.
+const uint16_t kProtocolNameBlock[7] PROGMEM = {
+    0, 52, 130, 203, 274, 345, 441,
+};
+
+/// Where each packed name (plus the end) starts, relative to its block.
+const uint8_t kProtocolNameIndex[110] PROGMEM = {
+    0, 6, 8, 10, 12, 15, 16, 19, 20, 26, 37, 39, 40, 41, 44, 47, 0, 1, 5, 14,
+    20, 22, 25, 33, 36, 40, 45, 52, 55, 59, 64, 67, 0, 7, 15, 16, 22, 28, 30,
+    32, 34, 36, 39, 42, 49, 57, 67, 69, 0, 5, 7, 12, 15, 18, 20, 24, 27, 30,
+    38, 44, 48, 53, 57, 61, 0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 41, 48, 52,
+    59, 62, 65, 0, 7, 13, 26, 30, 34, 39, 44, 47, 53, 55, 61, 65, 72, 80, 85,
+    0, 4, 10, 12, 15, 19, 24, 34, 37, 46, 50, 54, 58, 63,
+};
+
+/// The packed protocol names, in decode_type_t order.
+const char kProtocolNamePacked[] PROGMEM =
+    "UNUSED"  // D_STR_UNUSED
+    "\x93" "5"  // D_STR_RC5
+    "\x93" "6"  // D_STR_RC6
+    "N" "\x8A"  // D_STR_NEC
+    "S" "\x88" "Y"  // D_STR_SONY
+    "\x84"  // D_STR_PANASONIC
+    "JVC"  // D_STR_JVC
+    "\x86"  // D_STR_SAMSUNG
+    "WHYNT" "\x8F"  // D_STR_WHYNTER
+    "AIWA_" "\x93" "_T501"  // D_STR_AIWA_RC_T501
+    "LG"  // D_STR_LG
+    "\x87"  // D_STR_SANYO
+    "\x80"  // D_STR_MITSUBISHI
+    "DI" "\x8C"  // D_STR_DISH
+    "\x8C" "\x95" "P"  // D_STR_SHARP
+    "\x96" "OLIX"  // D_STR_COOLIX
+    "\x82"  // D_STR_DAIKIN
+    "DEN" "\x88"  // D_STR_DENON
+    "K" "\x8B" "VINATOR"  // D_STR_KELVINATOR
+    "\x8C" "\x8F" "WOOD"  // D_STR_SHERWOOD
+    "\x80" "\x81"  // D_STR_MITSUBISHI_AC
+    "\x93" "MM"  // D_STR_RCMM
+    "\x87" "_LC7461"  // D_STR_SANYO_LC7461
+    "\x93" "5X"  // D_STR_RC5X
+    "GREE"  // D_STR_GREE
+    "PR" "\x88" "TO"  // D_STR_PRONTO
+    "N" "\x8A" "_LIKE"  // D_STR_NEC_LIKE
+    "\x95" "GO"  // D_STR_ARGO
+    "\x8E" "OT" "\x8A"  // D_STR_TROTEC
+    "NIKAI"  // D_STR_NIKAI
+    "RAW"  // D_STR_RAW
+    "GLOBALCACHE"  // D_STR_GLOBALCACHE
+    "TO" "\x8C" "IBA" "\x81"  // D_STR_TOSHIBA_AC
+    "FUJITSU" "\x81"  // D_STR_FUJITSU_AC
+    "\x91"  // D_STR_MIDEA
+    "M" "\x94" "IQU" "\x90"  // D_STR_MAGIQUEST
+    "LAS" "\x8F" "T" "\x94"  // D_STR_LASERTAG
+    "\x85" "\x81"  // D_STR_CARRIER_AC
+    "\x89" "\x81"  // D_STR_HAIER_AC
+    "\x80" "2"  // D_STR_MITSUBISHI2
+    "\x83" "\x81"  // D_STR_HITACHI_AC
+    "\x83" "\x81" "1"  // D_STR_HITACHI_AC1
+    "\x83" "\x81" "2"  // D_STR_HITACHI_AC2
+    "GICABLE"  // D_STR_GICABLE
+    "\x89" "\x81" "_YRW02"  // D_STR_HAIER_AC_YRW02
+    "WHIRLPOOL" "\x81"  // D_STR_WHIRLPOOL_AC
+    "\x86" "\x81"  // D_STR_SAMSUNG_AC
+    "LU" "\x8E" "\x88"  // D_STR_LUTRON
+    "\x8B" "\x8A" "\x8E" "A" "\x81"  // D_STR_ELECTRA_AC
+    "\x84" "\x81"  // D_STR_PANASONIC_AC
+    "PI" "\x88" "E" "\x8F"  // D_STR_PIONEER
+    "LG2"  // D_STR_LG2
+    "MWM"  // D_STR_MWM
+    "\x82" "2"  // D_STR_DAIKIN2
+    "V" "\x90" "\x8B" "\x81"  // D_STR_VESTEL_AC
+    "T" "\x8A" "O"  // D_STR_TECO
+    "\x86" "36"  // D_STR_SAMSUNG36
+    "TCL112AC"  // D_STR_TCL112AC
+    "LEGOPF"  // D_STR_LEGOPF
+    "\x80" "\x8D" "88"  // D_STR_MITSUBISHI_HEAVY_88
+    "\x80" "\x8D" "152"  // D_STR_MITSUBISHI_HEAVY_152
+    "\x82" "216"  // D_STR_DAIKIN216
+    "\x8C" "\x95" "P" "\x81"  // D_STR_SHARP_AC
+    "GOODWEATH" "\x8F"  // D_STR_GOODWEATHER
+    "INAX"  // D_STR_INAX
+    "\x82" "160"  // D_STR_DAIKIN160
+    "NE" "\x92" "A"  // D_STR_NEOCLIMA
+    "\x82" "176"  // D_STR_DAIKIN176
+    "\x82" "128"  // D_STR_DAIKIN128
+    "AM" "\x96" "R"  // D_STR_AMCOR
+    "\x82" "152"  // D_STR_DAIKIN152
+    "\x80" "136"  // D_STR_MITSUBISHI136
+    "\x80" "112"  // D_STR_MITSUBISHI112
+    "\x83" "\x81" "424"  // D_STR_HITACHI_AC424
+    "S" "\x88" "Y_38K"  // D_STR_SONY_38K
+    "EPS" "\x88"  // D_STR_EPSON
+    "SYMPH" "\x88" "Y"  // D_STR_SYMPHONY
+    "\x83" "\x81" "3"  // D_STR_HITACHI_AC3
+    "\x82" "64"  // D_STR_DAIKIN64
+    "AIRW" "\x8B" "L"  // D_STR_AIRWELL
+    "D" "\x8B" "\x88" "GHI" "\x81"  // D_STR_DELONGHI_AC
+    "DO" "\x8C" "I" "\x8C" "A"  // D_STR_DOSHISHA
+    "MULTIBRACKETS"  // D_STR_MULTIBRACKETS
+    "\x85" "\x81" "40"  // D_STR_CARRIER_AC40
+    "\x85" "\x81" "64"  // D_STR_CARRIER_AC64
+    "\x83" "\x81" "344"  // D_STR_HITACHI_AC344
+    "\x96" "R" "\x88" "A" "\x81"  // D_STR_CORONA_AC
+    "\x91" "24"  // D_STR_MIDEA24
+    "ZEPEAL"  // D_STR_ZEPEAL
+    "\x87" "\x81"  // D_STR_SANYO_AC
+    "VOLTAS"  // D_STR_VOLTAS
+    "METZ"  // D_STR_METZ
+    "\x8E" "ANS" "\x96" "LD"  // D_STR_TRANSCOLD
+    "T" "\x8A" "HNIB" "\x8B" "\x81"  // D_STR_TECHNIBEL_AC
+    "MIR" "\x94" "E"  // D_STR_MIRAGE
+    "\x8B" "ITESCREENS"  // D_STR_ELITESCREENS
+    "\x84" "\x81" "32"  // D_STR_PANASONIC_AC32
+    "MIL" "\x90" "\x94" "2"  // D_STR_MILESTAG2
+    "\x8A" "\x92"  // D_STR_ECOCLIM
+    "XMP"  // D_STR_XMP
+    "\x8E" "UMA"  // D_STR_TRUMA
+    "\x89" "\x81" "176"  // D_STR_HAIER_AC176
+    "TEKNOPOINT"  // D_STR_TEKNOPOINT
+    "K" "\x8B" "\x88"  // D_STR_KELON
+    "\x8E" "OT" "\x8A" "_3550"  // D_STR_TROTEC_3550
+    "\x87" "\x81" "88"  // D_STR_SANYO_AC88
+    "BOSE"  // D_STR_BOSE
+    "\x95" "RIS"  // D_STR_ARRIS
+    "RHOSS";  // D_STR_RHOSS
+
+/// Compile-time comparison of two strings.
+/// @param[in] a A string.
+/// @param[in] b Another string.
+/// @return true if they are the same, otherwise false.
+constexpr bool protocolNameCheck(const char *a, const char *b) {
+  return *a == *b && (*a == '\0' || protocolNameCheck(a + 1, b + 1));
+}
+
+#define IRTEXT_PROTOCOL_CHECK(NAME, VALUE) \
+    static_assert(protocolNameCheck(NAME, VALUE), \
+                  #NAME " has changed. Run " \
+                  "'tools/generate_irtext_protocols.py', or set " \
+                  "COMPRESS_PROTOCOL_NAMES to false.")
+
+static_assert(kProtocolNameCount == kLastDecodeType + 1,
+              "The protocol list has changed. Run "
+              "'tools/generate_irtext_protocols.py'.");
+IRTEXT_PROTOCOL_CHECK(D_STR_UNUSED, "UNUSED");
+IRTEXT_PROTOCOL_CHECK(D_STR_RC5, "RC5");
+IRTEXT_PROTOCOL_CHECK(D_STR_RC6, "RC6");
+IRTEXT_PROTOCOL_CHECK(D_STR_NEC, "NEC");
+IRTEXT_PROTOCOL_CHECK(D_STR_SONY, "SONY");
+IRTEXT_PROTOCOL_CHECK(D_STR_PANASONIC, "PANASONIC");
+IRTEXT_PROTOCOL_CHECK(D_STR_JVC, "JVC");
+IRTEXT_PROTOCOL_CHECK(D_STR_SAMSUNG, "SAMSUNG");
+IRTEXT_PROTOCOL_CHECK(D_STR_WHYNTER, "WHYNTER");
+IRTEXT_PROTOCOL_CHECK(D_STR_AIWA_RC_T501, "AIWA_RC_T501");
+IRTEXT_PROTOCOL_CHECK(D_STR_LG, "LG");
+IRTEXT_PROTOCOL_CHECK(D_STR_SANYO, "SANYO");
+IRTEXT_PROTOCOL_CHECK(D_STR_MITSUBISHI, "MITSUBISHI");
+IRTEXT_PROTOCOL_CHECK(D_STR_DISH, "DISH");
+IRTEXT_PROTOCOL_CHECK(D_STR_SHARP, "SHARP");
+IRTEXT_PROTOCOL_CHECK(D_STR_COOLIX, "COOLIX");
+IRTEXT_PROTOCOL_CHECK(D_STR_DAIKIN, "DAIKIN");
+IRTEXT_PROTOCOL_CHECK(D_STR_DENON, "DENON");
+IRTEXT_PROTOCOL_CHECK(D_STR_KELVINATOR, "KELVINATOR");
+IRTEXT_PROTOCOL_CHECK(D_STR_SHERWOOD, "SHERWOOD");
+IRTEXT_PROTOCOL_CHECK(D_STR_MITSUBISHI_AC, "MITSUBISHI_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_RCMM, "RCMM");
+IRTEXT_PROTOCOL_CHECK(D_STR_SANYO_LC7461, "SANYO_LC7461");
+IRTEXT_PROTOCOL_CHECK(D_STR_RC5X, "RC5X");
+IRTEXT_PROTOCOL_CHECK(D_STR_GREE, "GREE");
+IRTEXT_PROTOCOL_CHECK(D_STR_PRONTO, "PRONTO");
+IRTEXT_PROTOCOL_CHECK(D_STR_NEC_LIKE, "NEC_LIKE");
+IRTEXT_PROTOCOL_CHECK(D_STR_ARGO, "ARGO");
+IRTEXT_PROTOCOL_CHECK(D_STR_TROTEC, "TROTEC");
+IRTEXT_PROTOCOL_CHECK(D_STR_NIKAI, "NIKAI");
+IRTEXT_PROTOCOL_CHECK(D_STR_RAW, "RAW");
+IRTEXT_PROTOCOL_CHECK(D_STR_GLOBALCACHE, "GLOBALCACHE");
+IRTEXT_PROTOCOL_CHECK(D_STR_TOSHIBA_AC, "TOSHIBA_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_FUJITSU_AC, "FUJITSU_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_MIDEA, "MIDEA");
+IRTEXT_PROTOCOL_CHECK(D_STR_MAGIQUEST, "MAGIQUEST");
+IRTEXT_PROTOCOL_CHECK(D_STR_LASERTAG, "LASERTAG");
+IRTEXT_PROTOCOL_CHECK(D_STR_CARRIER_AC, "CARRIER_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_HAIER_AC, "HAIER_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_MITSUBISHI2, "MITSUBISHI2");
+IRTEXT_PROTOCOL_CHECK(D_STR_HITACHI_AC, "HITACHI_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_HITACHI_AC1, "HITACHI_AC1");
+IRTEXT_PROTOCOL_CHECK(D_STR_HITACHI_AC2, "HITACHI_AC2");
+IRTEXT_PROTOCOL_CHECK(D_STR_GICABLE, "GICABLE");
+IRTEXT_PROTOCOL_CHECK(D_STR_HAIER_AC_YRW02, "HAIER_AC_YRW02");
+IRTEXT_PROTOCOL_CHECK(D_STR_WHIRLPOOL_AC, "WHIRLPOOL_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_SAMSUNG_AC, "SAMSUNG_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_LUTRON, "LUTRON");
+IRTEXT_PROTOCOL_CHECK(D_STR_ELECTRA_AC, "ELECTRA_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_PANASONIC_AC, "PANASONIC_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_PIONEER, "PIONEER");
+IRTEXT_PROTOCOL_CHECK(D_STR_LG2, "LG2");
+IRTEXT_PROTOCOL_CHECK(D_STR_MWM, "MWM");
+IRTEXT_PROTOCOL_CHECK(D_STR_DAIKIN2, "DAIKIN2");
+IRTEXT_PROTOCOL_CHECK(D_STR_VESTEL_AC, "VESTEL_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_TECO, "TECO");
+IRTEXT_PROTOCOL_CHECK(D_STR_SAMSUNG36, "SAMSUNG36");
+IRTEXT_PROTOCOL_CHECK(D_STR_TCL112AC, "TCL112AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_LEGOPF, "LEGOPF");
+IRTEXT_PROTOCOL_CHECK(D_STR_MITSUBISHI_HEAVY_88, "MITSUBISHI_HEAVY_88");
+IRTEXT_PROTOCOL_CHECK(D_STR_MITSUBISHI_HEAVY_152, "MITSUBISHI_HEAVY_152");
+IRTEXT_PROTOCOL_CHECK(D_STR_DAIKIN216, "DAIKIN216");
+IRTEXT_PROTOCOL_CHECK(D_STR_SHARP_AC, "SHARP_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_GOODWEATHER, "GOODWEATHER");
+IRTEXT_PROTOCOL_CHECK(D_STR_INAX, "INAX");
+IRTEXT_PROTOCOL_CHECK(D_STR_DAIKIN160, "DAIKIN160");
+IRTEXT_PROTOCOL_CHECK(D_STR_NEOCLIMA, "NEOCLIMA");
+IRTEXT_PROTOCOL_CHECK(D_STR_DAIKIN176, "DAIKIN176");
+IRTEXT_PROTOCOL_CHECK(D_STR_DAIKIN128, "DAIKIN128");
+IRTEXT_PROTOCOL_CHECK(D_STR_AMCOR, "AMCOR");
+IRTEXT_PROTOCOL_CHECK(D_STR_DAIKIN152, "DAIKIN152");
+IRTEXT_PROTOCOL_CHECK(D_STR_MITSUBISHI136, "MITSUBISHI136");
+IRTEXT_PROTOCOL_CHECK(D_STR_MITSUBISHI112, "MITSUBISHI112");
+IRTEXT_PROTOCOL_CHECK(D_STR_HITACHI_AC424, "HITACHI_AC424");
+IRTEXT_PROTOCOL_CHECK(D_STR_SONY_38K, "SONY_38K");
+IRTEXT_PROTOCOL_CHECK(D_STR_EPSON, "EPSON");
+IRTEXT_PROTOCOL_CHECK(D_STR_SYMPHONY, "SYMPHONY");
+IRTEXT_PROTOCOL_CHECK(D_STR_HITACHI_AC3, "HITACHI_AC3");
+IRTEXT_PROTOCOL_CHECK(D_STR_DAIKIN64, "DAIKIN64");
+IRTEXT_PROTOCOL_CHECK(D_STR_AIRWELL, "AIRWELL");
+IRTEXT_PROTOCOL_CHECK(D_STR_DELONGHI_AC, "DELONGHI_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_DOSHISHA, "DOSHISHA");
+IRTEXT_PROTOCOL_CHECK(D_STR_MULTIBRACKETS, "MULTIBRACKETS");
+IRTEXT_PROTOCOL_CHECK(D_STR_CARRIER_AC40, "CARRIER_AC40");
+IRTEXT_PROTOCOL_CHECK(D_STR_CARRIER_AC64, "CARRIER_AC64");
+IRTEXT_PROTOCOL_CHECK(D_STR_HITACHI_AC344, "HITACHI_AC344");
+IRTEXT_PROTOCOL_CHECK(D_STR_CORONA_AC, "CORONA_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_MIDEA24, "MIDEA24");
+IRTEXT_PROTOCOL_CHECK(D_STR_ZEPEAL, "ZEPEAL");
+IRTEXT_PROTOCOL_CHECK(D_STR_SANYO_AC, "SANYO_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_VOLTAS, "VOLTAS");
+IRTEXT_PROTOCOL_CHECK(D_STR_METZ, "METZ");
+IRTEXT_PROTOCOL_CHECK(D_STR_TRANSCOLD, "TRANSCOLD");
+IRTEXT_PROTOCOL_CHECK(D_STR_TECHNIBEL_AC, "TECHNIBEL_AC");
+IRTEXT_PROTOCOL_CHECK(D_STR_MIRAGE, "MIRAGE");
+IRTEXT_PROTOCOL_CHECK(D_STR_ELITESCREENS, "ELITESCREENS");
+IRTEXT_PROTOCOL_CHECK(D_STR_PANASONIC_AC32, "PANASONIC_AC32");
+IRTEXT_PROTOCOL_CHECK(D_STR_MILESTAG2, "MILESTAG2");
+IRTEXT_PROTOCOL_CHECK(D_STR_ECOCLIM, "ECOCLIM");
+IRTEXT_PROTOCOL_CHECK(D_STR_XMP, "XMP");
+IRTEXT_PROTOCOL_CHECK(D_STR_TRUMA, "TRUMA");
+IRTEXT_PROTOCOL_CHECK(D_STR_HAIER_AC176, "HAIER_AC176");
+IRTEXT_PROTOCOL_CHECK(D_STR_TEKNOPOINT, "TEKNOPOINT");
+IRTEXT_PROTOCOL_CHECK(D_STR_KELON, "KELON");
+IRTEXT_PROTOCOL_CHECK(D_STR_TROTEC_3550, "TROTEC_3550");
+IRTEXT_PROTOCOL_CHECK(D_STR_SANYO_AC88, "SANYO_AC88");
+IRTEXT_PROTOCOL_CHECK(D_STR_BOSE, "BOSE");
+IRTEXT_PROTOCOL_CHECK(D_STR_ARRIS, "ARRIS");
+IRTEXT_PROTOCOL_CHECK(D_STR_RHOSS, "RHOSS");
+
+#undef IRTEXT_PROTOCOL_CHECK
+
+#endif  // IRTEXT_PROTOCOLS_H_
@@ -0,0 +1,385 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Translate the codes of one remote into the codes for another
+///   device. e.g. A universal remote's buttons into a TV's & an A/C's codes.
+/// @see IRTranslator
+
+#include "IRtranslate.h"
+#include <string.h>
+#include <algorithm>
+#include "IRutils.h"
+
+/// Add some bytes to a FNV-1a 64-bit hash.
+/// @param[in] hash The hash so far.
+/// @param[in] data The bytes to add.
+/// @param[in] nbytes Nr. of bytes to add.
+/// @return The new hash.
+static uint64_t fnv64(uint64_t hash, const uint8_t data[],
+                      const uint16_t nbytes) {
+  for (uint16_t i = 0; i < nbytes; i++) hash = (hash ^ data[i]) * kFnvPrime64;
+  return hash;
+}
+
+/// Start the key of a message.
+/// @param[in] protocol The protocol of the message.
+/// @param[in] nbits The size of the message, in bits.
+/// @return The hash of the two.
+static uint64_t keyHeader(const decode_type_t protocol, const uint16_t nbits) {
+  const uint8_t header[4] = {
+      (uint8_t)((int16_t)protocol >> 8), (uint8_t)protocol,
+      (uint8_t)(nbits >> 8), (uint8_t)nbits};
+  return fnv64(kFnvBasis64, header, sizeof(header));
+}
+
+/// Class constructor
+/// @param[in] irsend The IRsend object to send the targets with.
+/// @param[in] max_mappings The max. nr. of source messages that can be
+///   mapped. (Up to 16384)
+/// @param[in] max_targets The max. nr. of targets that can be stored.
+/// @param[in] hold_ms Max. nr. of milli-seconds between a remote's messages
+///   for them to be treated as the same button still being held down.
+IRTranslator::IRTranslator(IRsend *irsend, const uint16_t max_mappings,
+                           const uint16_t max_targets, const uint16_t hold_ms)
+    : _irsend(irsend), _max_targets(max_targets), _nr_targets(0),
+      _max_mappings(std::min(max_mappings, (uint16_t)16384)),
+      _nr_mappings(0), _hold_ms(hold_ms), _last_key(0), _last_ms(0) {
+  _targets = new target_t[_max_targets];
+  if (_targets == NULL) {
+    DPRINTLN("Could not allocate memory for the translation targets.");
+    _max_targets = 0;
+  }
+  // Keep the hash table at most half full, so lookups stay short.
+  uint32_t slots = 2;
+  while (slots < 2UL * _max_mappings) slots <<= 1;
+  _mask = slots - 1;
+  _mappings = new mapping_t[slots];
+  if (_mappings == NULL) {
+    DPRINTLN("Could not allocate memory for the translation mappings.");
+    _max_mappings = 0;
+    _mask = 0;
+  } else {
+    for (uint32_t i = 0; i < slots; i++) _mappings[i].key = 0;
+  }
+  resetStats();
+}
+
+/// Class destructor
+IRTranslator::~IRTranslator(void) {
+  for (uint16_t i = 0; i < _nr_targets; i++) delete[] _targets[i].data;
+  delete[] _targets;
+  delete[] _mappings;
+}
+
+/// Store a new target, with an optional copy of some data.
+/// @param[in] protocol The protocol of the target.
+/// @param[in] data The data to copy. NULL if none.
+/// @param[in] nbytes Nr. of bytes of data.
+/// @return The index of the target, or kTranslateNoTarget if there was no room.
+int16_t IRTranslator::newTarget(const decode_type_t protocol,
+                                const uint8_t data[], const uint16_t nbytes) {
+  if (_nr_targets >= _max_targets || _nr_targets >= INT16_MAX)
+    return kTranslateNoTarget;
+  target_t *target = &_targets[_nr_targets];
+  target->protocol = protocol;
+  target->nbits = 0;
+  target->repeat = 0;
+  target->hz = 0;
+  target->nbytes = 0;
+  target->value = 0;
+  target->data = NULL;
+  if (data != NULL) {
+    target->data = new uint8_t[nbytes];
+    if (target->data == NULL) return kTranslateNoTarget;
+    memcpy(target->data, data, nbytes);
+    target->nbytes = nbytes;
+  }
+  return _nr_targets++;
+}
+
+/// Add a protocol message, with a simple value, as a target.
+/// @param[in] protocol The protocol to send it with.
+/// @param[in] value The value to send.
+/// @param[in] nbits Nr. of bits of the value to send.
+/// @param[in] repeat Nr. of times to repeat the message.
+/// @return The index of the target, or kTranslateNoTarget if it couldn't be
+///   added.
+int16_t IRTranslator::addTarget(const decode_type_t protocol,
+                                const uint64_t value, const uint16_t nbits,
+                                const uint16_t repeat) {
+  if (protocol <= decode_type_t::UNKNOWN || hasACState(protocol))
+    return kTranslateNoTarget;
+  const int16_t index = newTarget(protocol, NULL, 0);
+  if (index != kTranslateNoTarget) {
+    _targets[index].value = value;
+    _targets[index].nbits = nbits;
+    _targets[index].repeat = repeat;
+  }
+  return index;
+}
+
+/// Add a protocol message, with a state (e.g. An A/C's), as a target.
+/// @param[in] protocol The protocol to send it with.
+/// @param[in] state The state to send. It is copied.
+/// @param[in] nbytes Nr. of bytes in the state.
+/// @return The index of the target, or kTranslateNoTarget if it couldn't be
+///   added.
+int16_t IRTranslator::addTarget(const decode_type_t protocol,
+                                const uint8_t state[], const uint16_t nbytes) {
+  if (state == NULL || nbytes == 0 || nbytes > kStateSizeMax ||
+      !hasACState(protocol))
+    return kTranslateNoTarget;
+  return newTarget(protocol, state, nbytes);
+}
+
+/// Add a pulse train (e.g. A learned raw code) as a target.
+/// @param[in] raw An array of durations (microseconds). Marks then spaces.
+/// @param[in] len Nr. of elements in the raw[] array.
+/// @param[in] hz Its modulation frequency.
+/// @return The index of the target, or kTranslateNoTarget if it couldn't be
+///   added.
+int16_t IRTranslator::addRawTarget(const uint16_t raw[], const uint16_t len,
+                                   const uint16_t hz) {
+  if (raw == NULL) return kTranslateNoTarget;
+  uint8_t packed[kTranslateMaxRawBytes];
+  const uint16_t nbytes = packRawData(raw, len, packed, sizeof(packed));
+  if (nbytes > sizeof(packed)) return kTranslateNoTarget;
+  return addPackedTarget(packed, nbytes, hz);
+}
+
+/// Add a pulse train that has already been packed by `packRawData()` as a
+/// target.
+/// @param[in] packed The packed timings. They are copied.
+/// @param[in] nbytes Nr. of bytes in the packed[] array.
+/// @param[in] hz Its modulation frequency.
+/// @return The index of the target, or kTranslateNoTarget if it couldn't be
+///   added.
+int16_t IRTranslator::addPackedTarget(const uint8_t packed[],
+                                      const uint16_t nbytes,
+                                      const uint16_t hz) {
+  if (packed == NULL || nbytes == 0) return kTranslateNoTarget;
+  const int16_t index = newTarget(decode_type_t::UNKNOWN, packed, nbytes);
+  if (index != kTranslateNoTarget) _targets[index].hz = hz;
+  return index;
+}
+
+/// Get the nr. of targets stored.
+/// @return The nr. of targets.
+uint16_t IRTranslator::countTargets(void) const { return _nr_targets; }
+
+/// Send a target.
+/// @param[in] target The index of the target.
+/// @return true if it was sent, otherwise false.
+bool IRTranslator::sendTarget(const int16_t target) {
+  if (_irsend == NULL || target < 0 || target >= _nr_targets) return false;
+  const target_t *t = &_targets[target];
+  if (t->protocol == decode_type_t::UNKNOWN) {
+    // Pre-rendered, so there is nothing to encode. Send it as it is stored.
+    _irsend->sendRawPacked_P(t->data, t->nbytes, t->hz);
+    return true;
+  }
+  if (t->data != NULL) return _irsend->send(t->protocol, t->data, t->nbytes);
+  return _irsend->send(t->protocol, t->value, t->nbits, t->repeat);
+}
+
+/// Calculate the key of a message with a simple value.
+/// @param[in] protocol The protocol of the message.
+/// @param[in] value The value of the message.
+/// @param[in] nbits Nr. of bits in the message.
+/// @return The key. Never 0.
+/// @note `nbits` is ignored for UNKNOWN messages. It is just half the raw
+///   length, so a stray noise pulse would change it, but not their `value`.
+uint64_t IRTranslator::key(const decode_type_t protocol, const uint64_t value,
+                           const uint16_t nbits) {
+  uint8_t bytes[8];
+  for (uint8_t i = 0; i < 8; i++) bytes[i] = value >> (8 * (7 - i));
+  const uint64_t result = fnv64(
+      keyHeader(protocol, protocol == decode_type_t::UNKNOWN ? 0 : nbits),
+      bytes, 8);
+  return result ? result : 1;
+}
+
+/// Calculate the key of a message with a state. e.g. An A/C message.
+/// @param[in] protocol The protocol of the message.
+/// @param[in] state The state of the message.
+/// @param[in] nbytes Nr. of bytes in the state.
+/// @return The key. Never 0.
+uint64_t IRTranslator::key(const decode_type_t protocol, const uint8_t state[],
+                           const uint16_t nbytes) {
+  if (state == NULL) return key(protocol, (uint64_t)0, 0);
+  const uint64_t result = fnv64(keyHeader(protocol, nbytes * 8), state,
+                                nbytes);
+  return result ? result : 1;
+}
+
+/// Calculate the key of a decoded message.
+/// @param[in] results The decoded message.
+/// @return The key. 0 if there is no message.
+uint64_t IRTranslator::key(const decode_results *results) {
+  if (results == NULL) return 0;
+  if (hasACState(results->decode_type))
+    return key(results->decode_type, results->state, results->bits / 8);
+  return key(results->decode_type, results->value, results->bits);
+}
+
+/// Get the home slot of a key in the hash table.
+/// @param[in] key The key.
+/// @return The slot's index.
+uint16_t IRTranslator::slot(const uint64_t key) const {
+  return (key ^ (key >> 32)) & _mask;
+}
+
+/// Find the slot a key is in.
+/// @param[in] key The key.
+/// @return The slot's index, or -1 if it isn't in the table.
+int32_t IRTranslator::find(const uint64_t key) const {
+  if (_max_mappings == 0 || key == 0) return -1;
+  // The table is never full, so there is always an empty slot to stop at.
+  for (uint16_t i = slot(key); _mappings[i].key; i = (i + 1) & _mask)
+    if (_mappings[i].key == key) return i;
+  return -1;
+}
+
+/// Add or replace a mapping in the hash table.
+/// @param[in] key The key of the source message.
+/// @param[in] target The index of the target to send.
+/// @param[in] hold What to do when the source is held.
+/// @return true if it was added, otherwise false.
+bool IRTranslator::insert(const uint64_t key, const int16_t target,
+                          const translate_hold_t hold) {
+  if (key == 0 || target < 0 || target >= _nr_targets) return false;
+  int32_t index = find(key);
+  if (index < 0) {
+    if (_nr_mappings >= _max_mappings) return false;
+    index = slot(key);
+    while (_mappings[index].key) index = (index + 1) & _mask;
+    _mappings[index].key = key;
+    _nr_mappings++;
+  }
+  _mappings[index].target = target;
+  _mappings[index].hold = hold;
+  return true;
+}
+
+/// Map a message with a simple value to a target.
+/// @param[in] protocol The protocol of the source message.
+/// @param[in] value The value of the source message.
+/// @param[in] nbits Nr. of bits in the source message.
+/// @param[in] target The index of the target to send for it.
+/// @param[in] hold What to do when the source's button is held down.
+/// @return true if it was mapped, otherwise false. An existing mapping for
+///   the same message is replaced.
+bool IRTranslator::map(const decode_type_t protocol, const uint64_t value,
+                       const uint16_t nbits, const int16_t target,
+                       const translate_hold_t hold) {
+  return insert(key(protocol, value, nbits), target, hold);
+}
+
+/// Map a message with a state (e.g. An A/C message) to a target.
+/// @param[in] protocol The protocol of the source message.
+/// @param[in] state The state of the source message.
+/// @param[in] nbytes Nr. of bytes in the state.
+/// @param[in] target The index of the target to send for it.
+/// @param[in] hold What to do when the source's button is held down.
+/// @return true if it was mapped, otherwise false. An existing mapping for
+///   the same message is replaced.
+bool IRTranslator::map(const decode_type_t protocol, const uint8_t state[],
+                       const uint16_t nbytes, const int16_t target,
+                       const translate_hold_t hold) {
+  if (state == NULL) return false;
+  return insert(key(protocol, state, nbytes), target, hold);
+}
+
+/// Remove a mapping.
+/// @param[in] key The key of the source message. See `key()`.
+/// @return true if it was removed, false if there was no such mapping.
+bool IRTranslator::unmap(const uint64_t key) {
+  const int32_t index = find(key);
+  if (index < 0) return false;
+  // Close the gap, by moving back any later entry in the same run that would
+  // otherwise no longer be found from its home slot.
+  uint16_t hole = index;
+  for (uint16_t i = (hole + 1) & _mask; _mappings[i].key;
+       i = (i + 1) & _mask) {
+    const uint16_t home = slot(_mappings[i].key);
+    if (((i - home) & _mask) >= ((i - hole) & _mask)) {
+      _mappings[hole] = _mappings[i];
+      hole = i;
+    }
+  }
+  _mappings[hole].key = 0;
+  _nr_mappings--;
+  if (key == _last_key) _last_key = 0;
+  return true;
+}
+
+/// Get the nr. of mappings.
+/// @return The nr. of mappings.
+uint16_t IRTranslator::countMappings(void) const { return _nr_mappings; }
+
+/// Look up the target for a source message's key.
+/// @param[in] key The key of the source message. See `key()`.
+/// @return The index of its target, or kTranslateNoTarget if it isn't mapped.
+int16_t IRTranslator::lookup(const uint64_t key) const {
+  const int32_t index = find(key);
+  return index < 0 ? kTranslateNoTarget : _mappings[index].target;
+}
+
+/// Look up the target for a decoded message.
+/// @param[in] results The decoded message.
+/// @return The index of its target, or kTranslateNoTarget if it isn't mapped.
+int16_t IRTranslator::lookup(const decode_results *results) const {
+  return lookup(key(results));
+}
+
+/// Translate a decoded message. i.e. Send its target, if it has one.
+/// @param[in] results The decoded message.
+/// @param[in] now_ms The current time, in milli-seconds. e.g. `millis()`
+/// @return The index of the target that was sent, or kTranslateNoTarget if
+///   nothing was sent.
+/// @note A repeat code (e.g. NEC's) is treated as the last message heard,
+///   if that was recent enough, as the button is still held down.
+int16_t IRTranslator::translate(const decode_results *results,
+                                const uint32_t now_ms) {
+  if (results == NULL) return kTranslateNoTarget;
+  const bool recent = _last_key && now_ms - _last_ms <= _hold_ms;
+  const uint64_t k = results->repeat ? (recent ? _last_key : 0)
+                                     : key(results);
+  const int32_t index = find(k);
+  if (index < 0) {
+    _stats.unmapped++;
+    _last_key = 0;
+    return kTranslateNoTarget;
+  }
+  const bool held = recent && k == _last_key;
+  _last_key = k;
+  _last_ms = now_ms;
+  const mapping_t *mapping = &_mappings[index];
+  if (held && mapping->hold == kTranslateHoldIgnore) {
+    _stats.suppressed++;
+    return kTranslateNoTarget;
+  }
+  if (!sendTarget(mapping->target)) return kTranslateNoTarget;
+  if (held)
+    _stats.repeated++;
+  else
+    _stats.translated++;
+  return mapping->target;
+}
+
+#ifndef UNIT_TEST
+/// Translate a decoded message. i.e. Send its target, if it has one.
+/// @param[in] results The decoded message.
+/// @return The index of the target that was sent, or kTranslateNoTarget if
+///   nothing was sent.
+int16_t IRTranslator::translate(const decode_results *results) {
+  return translate(results, millis());
+}
+#endif  // UNIT_TEST
+
+/// Get the translation statistics.
+/// @return The statistics.
+translate_stats_t IRTranslator::getStats(void) const { return _stats; }
+
+/// Reset the translation statistics.
+void IRTranslator::resetStats(void) { memset(&_stats, 0, sizeof(_stats)); }
@@ -0,0 +1,144 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+/// @file
+/// @brief Translate the codes of one remote into the codes for another
+///   device. e.g. A universal remote's buttons into a TV's & an A/C's codes.
+/// @see IRTranslator
+
+#ifndef IRTRANSLATE_H_
+#define IRTRANSLATE_H_
+
+#ifndef UNIT_TEST
+#include <Arduino.h>
+#endif  // UNIT_TEST
+#define __STDC_LIMIT_MACROS
+#include <stdint.h>
+#include "IRremoteESP8266.h"
+#include "IRrecv.h"
+#include "IRsend.h"
+
+// Constants
+/// Max. nr. of milli-seconds between a remote's messages for them to be
+/// treated as the same button still being held down.
+const uint16_t kTranslateHoldMs = 250;
+/// Returned instead of a target index when one could not be found or added.
+const int16_t kTranslateNoTarget = -1;
+/// Max. nr. of bytes in a target's packed timings. (See `packRawData()`)
+const uint16_t kTranslateMaxRawBytes = 512;
+
+/// What to do when a source remote's button is held down. i.e. It repeats
+/// its message, or sends a repeat code.
+enum translate_hold_t {
+  kTranslateHoldRepeat = 0,  ///< Send the target again. e.g. Volume up.
+  kTranslateHoldIgnore,  ///< Only send the target once. e.g. A power toggle.
+};
+
+/// Translation statistics. See `IRTranslator::getStats()`.
+typedef struct {
+  uint32_t translated;  ///< New presses we sent a target for.
+  uint32_t repeated;  ///< Held buttons we sent a target again for.
+  uint32_t suppressed;  ///< Held buttons we didn't send anything for.
+  uint32_t unmapped;  ///< Messages we had no mapping for.
+} translate_stats_t;
+
+/// Translate the messages captured from one remote into messages for other
+/// devices.
+///
+/// A message is looked up in a hash table by a key made from its protocol,
+/// size, & value or state, so each lookup takes the same short time
+/// whether there are ten mappings or thousands. Nothing is allocated when
+/// translating.
+///
+/// A target is sent as either:
+/// - A pre-rendered pulse train. Stored packed (See `packRawData()`) & sent
+///   without any encoding. e.g. Learned codes, or ones from an IRCodeStore.
+/// - A protocol message. A value, or an A/C state, for `IRsend::send()`.
+///
+/// Any number of mappings can share the same target.
+///
+/// When a button is held down, most remotes either keep repeating its
+/// message, or send a repeat code (e.g. NEC). Each mapping says whether to
+/// send its target again, or to only send it once per press.
+/// @note For UNKNOWN messages, the key is their `value`. Turn on
+///   `IRrecv::setUnknownFingerprint()` so that it is stable from one press to
+///   the next.
+class IRTranslator {
+ public:
+  IRTranslator(IRsend *irsend, const uint16_t max_mappings,
+               const uint16_t max_targets,
+               const uint16_t hold_ms = kTranslateHoldMs);
+  ~IRTranslator(void);
+  // Targets.
+  int16_t addTarget(const decode_type_t protocol, const uint64_t value,
+                    const uint16_t nbits, const uint16_t repeat = kNoRepeat);
+  int16_t addTarget(const decode_type_t protocol, const uint8_t state[],
+                    const uint16_t nbytes);
+  int16_t addRawTarget(const uint16_t raw[], const uint16_t len,
+                       const uint16_t hz);
+  int16_t addPackedTarget(const uint8_t packed[], const uint16_t nbytes,
+                          const uint16_t hz);
+  uint16_t countTargets(void) const;
+  bool sendTarget(const int16_t target);
+  // Mappings.
+  bool map(const decode_type_t protocol, const uint64_t value,
+           const uint16_t nbits, const int16_t target,
+           const translate_hold_t hold = kTranslateHoldRepeat);
+  bool map(const decode_type_t protocol, const uint8_t state[],
+           const uint16_t nbytes, const int16_t target,
+           const translate_hold_t hold = kTranslateHoldRepeat);
+  bool unmap(const uint64_t key);
+  uint16_t countMappings(void) const;
+  int16_t lookup(const uint64_t key) const;
+  int16_t lookup(const decode_results *results) const;
+  static uint64_t key(const decode_type_t protocol, const uint64_t value,
+                      const uint16_t nbits);
+  static uint64_t key(const decode_type_t protocol, const uint8_t state[],
+                      const uint16_t nbytes);
+  static uint64_t key(const decode_results *results);
+  // Translating.
+  int16_t translate(const decode_results *results, const uint32_t now_ms);
+#ifndef UNIT_TEST
+  int16_t translate(const decode_results *results);
+#endif  // UNIT_TEST
+  translate_stats_t getStats(void) const;
+  void resetStats(void);
+
+ private:
+  /// Something to send.
+  struct target_t {
+    decode_type_t protocol;  ///< UNKNOWN for a pre-rendered pulse train.
+    uint16_t nbits;  ///< Nr. of bits in a value. 0 for a state or raw.
+    uint16_t repeat;  ///< Nr. of repeats to send a value with.
+    uint16_t hz;  ///< Modulation frequency of a raw target.
+    uint16_t nbytes;  ///< Nr. of bytes in `data`.
+    uint64_t value;  ///< The value to send, if it is one.
+    uint8_t *data;  ///< A state, or packed timings. (Heap allocated.)
+  };
+  /// A slot in the hash table of mappings.
+  struct mapping_t {
+    uint64_t key;  ///< The source message's key. 0 if the slot is empty.
+    int16_t target;  ///< Index of the target to send.
+    uint8_t hold;  ///< A `translate_hold_t`. What to do when it is held.
+  };
+  IRsend *_irsend;
+  uint16_t _max_targets;  ///< Max. nr. of targets.
+  uint16_t _nr_targets;  ///< Nr. of targets added.
+  target_t *_targets;
+  uint16_t _mask;  ///< Nr. of slots in the hash table, less one.
+  uint16_t _max_mappings;  ///< Max. nr. of mappings.
+  uint16_t _nr_mappings;  ///< Nr. of slots in use.
+  mapping_t *_mappings;
+  uint16_t _hold_ms;  ///< See `kTranslateHoldMs`.
+  uint64_t _last_key;  ///< Key of the last mapped message. 0 if none.
+  uint32_t _last_ms;  ///< When we last heard it.
+  translate_stats_t _stats;
+
+  int16_t newTarget(const decode_type_t protocol, const uint8_t data[],
+                    const uint16_t nbytes);
+  bool insert(const uint64_t key, const int16_t target,
+              const translate_hold_t hold);
+  uint16_t slot(const uint64_t key) const;
+  int32_t find(const uint64_t key) const;
+};
+
+#endif  // IRTRANSLATE_H_
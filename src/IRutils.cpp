@@ -16,6 +16,9 @@
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRtext.h"
+#if COMPRESS_PROTOCOL_NAMES
+#include "IRtext_protocols.h"
+#endif  // COMPRESS_PROTOCOL_NAMES
 
 // On the ESP8266 platform we need to use a set of ..._P functions
 // to handle the strings stored in the flash address space.
@@ -114,6 +117,13 @@ void serialPrintUint64(uint64_t input, uint8_t base) {
 /// @param[in] str A C-style string containing a protocol name or number.
 /// @return A decode_type_t enum. (decode_type_t::UNKNOWN if no match.)
 decode_type_t strToDecodeType(const char * const str) {
+#if COMPRESS_PROTOCOL_NAMES
+  char name[kProtocolNameMaxLength + 1];
+  for (uint16_t i = 0; i < kProtocolNameCount; i++) {
+    typeToName((decode_type_t)i, name, sizeof(name));
+    if (!strcasecmp(str, name)) return (decode_type_t)i;
+  }
+#else  // COMPRESS_PROTOCOL_NAMES
   auto *ptr = reinterpret_cast<const char*>(kAllProtocolNamesStr);
   uint16_t length = STRLEN(ptr);
   for (uint16_t i = 0; length; i++) {
@@ -121,6 +131,7 @@ decode_type_t strToDecodeType(const char * const str) {
     ptr += length + 1;
     length = STRLEN(ptr);
   }
+#endif  // COMPRESS_PROTOCOL_NAMES
   // Handle integer values of the type by converting to a string and back again.
   decode_type_t result = strToDecodeType(
       typeToString((decode_type_t)atoi(str)).c_str());
@@ -140,6 +151,11 @@ String typeToString(const decode_type_t protocol, const bool isRepeat) {
   if (protocol > kLastDecodeType || protocol == decode_type_t::UNKNOWN) {
     result = kUnknownStr;
   } else {
+#if COMPRESS_PROTOCOL_NAMES
+    char name[kProtocolNameMaxLength + 1];
+    typeToName(protocol, name, sizeof(name));
+    result = name;
+#else  // COMPRESS_PROTOCOL_NAMES
     auto *ptr = reinterpret_cast<const char*>(kAllProtocolNamesStr);
     if (protocol > kLastDecodeType || protocol == decode_type_t::UNKNOWN) {
       result = kUnknownStr;
@@ -152,6 +168,7 @@ String typeToString(const decode_type_t protocol, const bool isRepeat) {
         ptr += STRLEN(ptr) + 1;
       }
     }
+#endif  // COMPRESS_PROTOCOL_NAMES
   }
   if (isRepeat) {
     result += kSpaceLBraceStr;
@@ -161,6 +178,56 @@ String typeToString(const decode_type_t protocol, const bool isRepeat) {
   return result;
 }
 
+/// Copy the name of a protocol into a buffer, without allocating any memory.
+/// @param[in] protocol Nr. (enum) of the protocol.
+/// @param[out] buffer Where to put the null terminated name. The name is
+///   truncated if it doesn't fit.
+/// @param[in] size The size of the buffer, in bytes.
+/// @return The length of the full name, excluding the null. 0 if no match.
+uint16_t typeToName(const decode_type_t protocol, char *buffer,
+                    const uint16_t size) {
+  if (buffer == NULL || size == 0) return 0;
+  buffer[0] = '\0';
+  if (protocol > kLastDecodeType || protocol == decode_type_t::UNKNOWN)
+    return 0;
+  uint16_t length = 0;
+#if COMPRESS_PROTOCOL_NAMES
+  // The name runs from the start of this protocol's entry to the next one's.
+  const uint16_t first = pgm_read_word(
+      &kProtocolNameBlock[protocol >> kProtocolNameBlockBits]) +
+      pgm_read_byte(&kProtocolNameIndex[protocol]);
+  const uint16_t last = pgm_read_word(
+      &kProtocolNameBlock[(protocol + 1) >> kProtocolNameBlockBits]) +
+      pgm_read_byte(&kProtocolNameIndex[protocol + 1]);
+  for (uint16_t i = first; i < last; i++) {
+    const uint8_t code = pgm_read_byte(&kProtocolNamePacked[i]);
+    if (code < kProtocolNameTokenBase) {  // A literal character.
+      if (length + 1 < size) buffer[length] = code;
+      length++;
+    } else {  // A dictionary word.
+      const uint8_t word = code - kProtocolNameTokenBase;
+      const uint8_t end = pgm_read_byte(&kProtocolNameDictIndex[word + 1]);
+      for (uint8_t j = pgm_read_byte(&kProtocolNameDictIndex[word]); j < end;
+           j++) {
+        if (length + 1 < size)
+          buffer[length] = pgm_read_byte(&kProtocolNameDict[j]);
+        length++;
+      }
+    }
+  }
+#else  // COMPRESS_PROTOCOL_NAMES
+  auto *ptr = reinterpret_cast<const char*>(kAllProtocolNamesStr);
+  for (uint16_t i = 0; i < protocol && STRLEN(ptr); i++)
+    ptr += STRLEN(ptr) + 1;
+  for (char c = pgm_read_byte(ptr); c; c = pgm_read_byte(++ptr)) {
+    if (length + 1 < size) buffer[length] = c;
+    length++;
+  }
+#endif  // COMPRESS_PROTOCOL_NAMES
+  buffer[std::min(length, (uint16_t)(size - 1))] = '\0';
+  return length;
+}
+
 /// Does the given protocol use a complex state as part of the decode?
 /// @param[in] protocol The decode_type_t protocol we are enquiring about.
 /// @return True if the protocol uses a state array. False if just an integer.
@@ -223,7 +290,7 @@ bool hasACState(const decode_type_t protocol) {
 /// @return The corrected length.
 uint16_t getCorrectedRawLength(const decode_results * const results) {
   uint16_t extended_length = results->rawlen - 1;
-  for (uint16_t i = 0; i < results->rawlen - 1; i++) {
+  for (uint16_t i = 1; i < results->rawlen; i++) {
     uint32_t usecs = results->rawbuf[i] * kRawTick;
     // Add two extra entries for multiple larger than UINT16_MAX it is.
     extended_length += (usecs / (UINT16_MAX + 1)) * 2;
@@ -428,6 +495,412 @@ uint16_t* resultToRawArray(const decode_results * const decode) {
   return result;
 }
 
+/// Integer log2. i.e. The position of the highest bit set.
+/// @param[in] value The value. Must be non-zero.
+/// @return floor(log2(value)).
+static uint8_t ilog2(uint64_t value) {
+  uint8_t result = 0;
+  while (value >>= 1) result++;
+  return result;
+}
+
+/// A group of similar durations, as used by `resultToFingerprint()`.
+struct fingerprint_cluster_t {
+  uint32_t sum;  ///< Total of the durations, in uSeconds.
+  uint16_t count;  ///< Nr. of durations in it.
+  uint32_t mean;  ///< Mean duration, in uSeconds.
+};
+
+/// Find the cluster whose mean is nearest to a duration.
+/// @param[in] clusters The clusters to look in.
+/// @param[in] n Nr. of clusters.
+/// @param[in] usecs The duration, in uSeconds.
+/// @return The index of the nearest cluster.
+static uint8_t nearestCluster(const fingerprint_cluster_t clusters[],
+                              const uint8_t n, const uint32_t usecs) {
+  uint8_t best = 0;
+  uint32_t best_diff = UINT32_MAX;
+  for (uint8_t c = 0; c < n; c++) {
+    const uint32_t mean = clusters[c].mean;
+    const uint32_t diff = (mean > usecs) ? mean - usecs : usecs - mean;
+    if (diff < best_diff) {
+      best = c;
+      best_diff = diff;
+    }
+  }
+  return best;
+}
+
+/// Are two durations within `kFingerprintTolerance` of each other?
+/// @param[in] a A duration.
+/// @param[in] b Another duration.
+/// @return true if they are close enough to be in the same cluster.
+static bool fingerprintMatch(const uint32_t a, const uint32_t b) {
+  const uint32_t diff = (a > b) ? a - b : b - a;
+  return (uint64_t)diff * 100 <=
+      (uint64_t)std::min(a, b) * kFingerprintTolerance;
+}
+
+/// Calculate a 64-bit timing fingerprint of a captured message.
+/// Unlike the legacy UNKNOWN hash, this takes the actual timings into account,
+/// but is stable under small timing errors (jitter), & short noise pulses
+/// before or after the message.
+///
+/// The algorithm: Trim any noise marks (and their spaces) off each end.
+/// Group the marks, & separately the spaces, into up to
+/// `kFingerprintMaxClusters` clusters of durations within
+/// `kFingerprintTolerance` percent of each other, & keep the ones with at least
+/// `kFingerprintMinCount` durations. The most common mark is the unit. Hash
+/// (FNV-1a 64) the unit's octave, the header's shape, which clusters are longer
+/// than the unit, & then for each duration its nearest cluster, & whether it
+/// is more than `kFingerprintSpread` percent above or below it.
+/// @param[in] results A ptr to a decode_results structure with the capture.
+/// @return The fingerprint, or 0 if there is nothing to fingerprint.
+/// @note Only integer maths is used.
+/// @note There are no fixed edges for the ratios, as real ones are too densely
+///   spread for jitter to stay clear of them. The spread (~sqrt(3)) is halfway
+///   between the common 1.5x & 2x on a log scale, so both are ~15% clear of it.
+///   Durations that differ by less than that, or units either side of an
+///   octave edge, can still be confused or tipped over.
+uint64_t resultToFingerprint(const decode_results * const results) {
+  uint16_t start = 1;
+  uint16_t end = results->rawlen;
+  if (end > start && (end - start) % 2 == 0) end--;  // Drop a trailing space.
+  // Trim the noise. Entries with an odd index are marks.
+  while (end - start > 2 &&
+         results->rawbuf[start] * kRawTick < kFingerprintNoiseUs) start += 2;
+  while (end - start > 2 &&
+         results->rawbuf[end - 1] * kRawTick < kFingerprintNoiseUs) end -= 2;
+  if (end <= start) return 0;  // Nothing to fingerprint.
+
+  fingerprint_cluster_t clusters[2][kFingerprintMaxClusters];
+  uint8_t n[2] = {0, 0};
+  // Group the durations into clusters.
+  for (uint16_t i = start; i < end; i++) {
+    const uint8_t kind = (i - start) % 2;  // 0 is a mark, 1 is a space.
+    fingerprint_cluster_t *found = clusters[kind];
+    const uint32_t usecs = results->rawbuf[i] * kRawTick;
+    uint8_t c = n[kind];
+    if (n[kind]) {
+      const uint8_t nearest = nearestCluster(found, n[kind], usecs);
+      if (fingerprintMatch(found[nearest].mean, usecs) ||
+          n[kind] == kFingerprintMaxClusters) c = nearest;
+    }
+    if (c == n[kind]) {  // A new cluster.
+      found[c].sum = 0;
+      found[c].count = 0;
+      n[kind]++;
+    }
+    found[c].sum += usecs;
+    found[c].count++;
+    found[c].mean = found[c].sum / found[c].count;
+  }
+  // Merge any clusters that drifted too close together.
+  for (uint8_t kind = 0; kind < 2; kind++) {
+    fingerprint_cluster_t *found = clusters[kind];
+    for (uint8_t a = 0; a < n[kind]; a++)
+      for (uint8_t b = a + 1; b < n[kind]; b++)
+        if (fingerprintMatch(found[a].mean, found[b].mean)) {
+          found[a].sum += found[b].sum;
+          found[a].count += found[b].count;
+          found[a].mean = found[a].sum / found[a].count;
+          found[b--] = found[--n[kind]];
+        }
+  }
+  // Re-assign every duration to its nearest cluster, so the order they came
+  // in doesn't matter.
+  for (uint8_t kind = 0; kind < 2; kind++)
+    for (uint8_t c = 0; c < n[kind]; c++) {
+      clusters[kind][c].sum = 0;
+      clusters[kind][c].count = 0;
+    }
+  for (uint16_t i = start; i < end; i++) {
+    const uint8_t kind = (i - start) % 2;
+    const uint32_t usecs = results->rawbuf[i] * kRawTick;
+    fingerprint_cluster_t *cluster =
+        &clusters[kind][nearestCluster(clusters[kind], n[kind], usecs)];
+    cluster->sum += usecs;
+    cluster->count++;
+  }
+  for (uint8_t kind = 0; kind < 2; kind++)
+    for (uint8_t c = 0; c < n[kind]; c++)
+      if (clusters[kind][c].count)
+        clusters[kind][c].mean = clusters[kind][c].sum /
+            clusters[kind][c].count;
+      else  // Nothing is nearest to it any more.
+        clusters[kind][c--] = clusters[kind][--n[kind]];
+  // Sort the clusters by their mean, & keep only the populous ones. Their
+  // means are averaged over many durations, so they hardly move with jitter.
+  // If a kind has none, keep its most common cluster instead.
+  for (uint8_t kind = 0; kind < 2; kind++) {
+    fingerprint_cluster_t *found = clusters[kind];
+    for (uint8_t a = 1; a < n[kind]; a++)
+      for (uint8_t b = a; b && found[b].mean < found[b - 1].mean; b--)
+        std::swap(found[b], found[b - 1]);
+    uint8_t most = 0;
+    uint8_t kept = 0;
+    for (uint8_t c = 0; c < n[kind]; c++) {
+      if (found[c].count > found[most].count) most = c;
+      if (found[c].count >= kFingerprintMinCount) found[kept++] = found[c];
+    }
+    if (!kept && n[kind]) found[kept++] = found[most];
+    n[kind] = kept;
+  }
+  // The unit is the most common mark.
+  uint8_t unit = 0;
+  for (uint8_t c = 0; c < n[0]; c++)
+    if (clusters[0][c].count > clusters[0][unit].count) unit = c;
+  const uint32_t unit_usecs = std::max(clusters[0][unit].mean, (uint32_t)1);
+
+  uint64_t hash = kFnvBasis64;
+  // Octaves of the unit, with the edges at ~356, ~712, ~1424us etc.
+  hash = (hash ^ ilog2((uint64_t)unit_usecs * 184 / 256 + 1)) * kFnvPrime64;
+  // Is the header mark a lot longer than its space? e.g. 2:1 vs 1:1.
+  if (end - start > 1)
+    hash = (hash ^ ((uint64_t)results->rawbuf[start] * 100 >
+                    (uint64_t)results->rawbuf[start + 1] *
+                        kFingerprintHeaderRatio)) * kFnvPrime64;
+  for (uint8_t kind = 0; kind < 2; kind++) {
+    // Which clusters are clearly longer than the unit. The ratio itself is
+    // left to the symbols below, as fixed edges are easily tipped over.
+    for (uint8_t c = 0; c < n[kind]; c++)
+      hash = (hash ^ ((uint64_t)clusters[kind][c].mean * 100 >
+                      (uint64_t)unit_usecs * (100 + kFingerprintTolerance))) *
+          kFnvPrime64;
+    hash = (hash ^ 0xFF) * kFnvPrime64;  // Separate the kinds.
+  }
+  for (uint16_t i = start; i < end; i++) {
+    const uint8_t kind = (i - start) % 2;
+    const uint64_t usecs = std::max(results->rawbuf[i] * kRawTick, 1);
+    // The cluster nearest by ratio, & whether it is well above or below it.
+    uint8_t best = 0;
+    for (uint8_t c = 1; c < n[kind]; c++) {
+      const uint64_t mean = clusters[kind][c].mean;
+      const uint64_t best_mean = clusters[kind][best].mean;
+      if (std::max(usecs, mean) * std::min(usecs, best_mean) <
+          std::max(usecs, best_mean) * std::min(usecs, mean)) best = c;
+    }
+    const uint64_t mean = clusters[kind][best].mean;
+    uint8_t zone = 0;  // Within it.
+    if (usecs * 100 > mean * kFingerprintSpread)
+      zone = 1;  // Above it.
+    else if (usecs * kFingerprintSpread < mean * 100)
+      zone = 2;  // Below it.
+    hash = (hash ^ ((kind << 7) | (zone << 3) | best)) * kFnvPrime64;
+  }
+  return hash ? hash : 1;  // Never 0, as that means nothing to fingerprint.
+}
+
+/// Add a duration to a packed raw array. See `IRsend::sendRawPacked_P()`.
+/// @param[in] usecs The duration, in microseconds.
+/// @param[in, out] last The previous duration of the same kind (mark/space).
+/// @param[out] packed Where to store the bytes. NULL means don't store them.
+/// @param[in] size The size of the packed array.
+/// @param[in, out] used Nr. of bytes used so far.
+static void packRawDuration(const uint32_t usecs, uint32_t *last,
+                            uint8_t *packed, const uint16_t size,
+                            uint16_t *used) {
+  const uint32_t delta = usecs - *last;
+  // Zig-zag encode it, so small negative differences are small too.
+  uint32_t value = (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);
+  *last = usecs;
+  do {
+    uint8_t byte = value & 0x7F;
+    value >>= 7;
+    if (value) byte |= 0x80;  // More to come.
+    if (packed != NULL && *used < size) packed[*used] = byte;
+    (*used)++;
+  } while (value);
+}
+
+/// Pack a `sendRaw()` style array into the compact form used by
+/// `IRsend::sendRawPacked_P()`.
+/// @param[in] raw An array of durations (microseconds). Marks then spaces.
+/// @param[in] len Nr. of elements in the raw[] array.
+/// @param[out] packed Where to store the packed bytes. NULL to just size it.
+/// @param[in] size The size of the packed array, in bytes.
+/// @return The nr. of bytes the packed form needs. If it is more than `size`,
+///   only the first `size` bytes were stored.
+uint16_t packRawData(const uint16_t raw[], const uint16_t len,
+                     uint8_t *packed, const uint16_t size) {
+  uint32_t last[2] = {0, 0};
+  uint16_t used = 0;
+  for (uint16_t i = 0; i < len; i++)
+    packRawDuration(raw[i], &last[i & 1], packed, size, &used);
+  return used;
+}
+
+/// Pack an array of 32-bit durations into the compact form used by
+/// `IRsend::sendRawPacked_P()`.
+/// @param[in] raw An array of durations (microseconds). Marks then spaces.
+/// @param[in] len Nr. of elements in the raw[] array.
+/// @param[out] packed Where to store the packed bytes. NULL to just size it.
+/// @param[in] size The size of the packed array, in bytes.
+/// @return The nr. of bytes the packed form needs. If it is more than `size`,
+///   only the first `size` bytes were stored.
+uint16_t packRawData(const uint32_t raw[], const uint16_t len,
+                     uint8_t *packed, const uint16_t size) {
+  uint32_t last[2] = {0, 0};
+  uint16_t used = 0;
+  for (uint16_t i = 0; i < len; i++)
+    packRawDuration(raw[i], &last[i & 1], packed, size, &used);
+  return used;
+}
+
+/// Unpack a packed raw array (as made by `packRawData()`) back into a
+/// `sendRaw()` style array.
+/// @param[in] packed The packed bytes. (In RAM.)
+/// @param[in] nbytes Nr. of bytes in the packed[] array.
+/// @param[out] raw Where to store the durations. NULL to just count them.
+/// @param[in] size Nr. of elements the raw[] array can hold.
+/// @return The nr. of durations in the packed array. If it is more than
+///   `size`, only the first `size` were stored. Durations over 65535us are
+///   stored as 65535.
+uint16_t unpackRawData(const uint8_t packed[], const uint16_t nbytes,
+                       uint16_t *raw, const uint16_t size) {
+  uint32_t last[2] = {0, 0};  // The previous mark & space.
+  uint32_t value = 0;
+  uint8_t shift = 0;
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < nbytes; i++) {
+    if (shift < 32) value |= (uint32_t)(packed[i] & 0x7F) << shift;
+    shift += 7;
+    if (packed[i] & 0x80) continue;  // There is more of this value to come.
+    // Undo the zig-zag encoding & apply the difference.
+    const uint32_t usecs = last[count & 1] + ((value >> 1) ^ -(value & 1));
+    last[count & 1] = usecs;
+    if (raw != NULL && count < size)
+      raw[count] = std::min(usecs, (uint32_t)UINT16_MAX);
+    count++;
+    value = 0;
+    shift = 0;
+  }
+  return count;
+}
+
+/// Find the length of the frame starting at a given position of a raw array.
+/// @param[in] raw An array of durations. (`sendRaw()` format)
+/// @param[in] len Nr. of elements in the raw[] array.
+/// @param[in] start Where the frame starts. (A mark.)
+/// @param[in] min_gap The shortest space that ends a frame. (usecs)
+/// @return Nr. of entries in the frame, excluding the gap after it.
+static uint16_t rawFrameLength(const uint16_t raw[], const uint16_t len,
+                               const uint16_t start, const uint32_t min_gap) {
+  uint16_t i = start + 1;
+  while (i < len && raw[i] < min_gap) i += 2;
+  return std::min(i, len) - start;
+}
+
+/// Find the length of the gap at a given position of a raw array.
+/// A gap too long for 16 bits is stored as several spaces joined by 0us marks.
+/// e.g. By `resultToRawArray()`.
+/// @param[in] raw An array of durations. (`sendRaw()` format)
+/// @param[in] len Nr. of elements in the raw[] array.
+/// @param[in] start Where the gap starts. (A space.)
+/// @param[out] usecs Where to store the duration of the gap.
+/// @return Nr. of entries in the gap.
+static uint16_t rawGapLength(const uint16_t raw[], const uint16_t len,
+                             const uint16_t start, uint32_t *usecs) {
+  *usecs = 0;
+  if (start >= len) return 0;
+  uint16_t i = start;
+  *usecs = raw[i++];
+  while (i + 1 < len && raw[i] == 0) {
+    *usecs += raw[i + 1];
+    i += 2;
+  }
+  return i - start;
+}
+
+/// Are two durations the same, within a tolerance?
+/// @param[in] a A duration.
+/// @param[in] b Another duration.
+/// @param[in] tolerance Percentage they may differ by.
+/// @return true if they match, otherwise false.
+static bool rawDurationsMatch(const uint32_t a, const uint32_t b,
+                              const uint8_t tolerance) {
+  const uint32_t diff = (a > b) ? a - b : b - a;
+  return (uint64_t)diff * 100 <= (uint64_t)std::max(a, b) * tolerance;
+}
+
+/// Are two raw frames (of the same length) the same, within a tolerance?
+/// @param[in] a A Ptr to the start of a frame.
+/// @param[in] b A Ptr to the start of the other frame.
+/// @param[in] len Nr. of entries in each frame.
+/// @param[in] tolerance Percentage each duration may differ by.
+/// @return true if they match, otherwise false.
+static bool rawFramesMatch(const uint16_t *a, const uint16_t *b,
+                           const uint16_t len, const uint8_t tolerance) {
+  for (uint16_t i = 0; i < len; i++)
+    if (!rawDurationsMatch(a[i], b[i], tolerance)) return false;
+  return true;
+}
+
+/// Compact a raw message that contains the same frame several times.
+/// e.g. Sony's triple sends, or a NEC message followed by repeat codes.
+/// The copies of the frame are averaged into a single canonical frame, and
+/// are stored (after any lead-in) with the gap & the nr. of repeats.
+/// @param[in] raw An array of durations. (`sendRaw()` format)
+/// @param[in] len Nr. of elements in the raw[] array.
+/// @param[out] out Where to store the compacted array. It needs room for `len`
+///   entries, as nothing may be found to compact. It may be the same as raw[].
+/// @param[out] info A Ptr to where to store the layout of the out[] array.
+/// @param[in] tolerance Percentage the durations of each copy may differ by.
+/// @param[in] min_gap The shortest space that ends a frame. (usecs)
+/// @return Nr. of elements stored in the out[] array.
+/// @note Send the result with `IRsend::sendRawCompact()`.
+uint16_t compactRaw(const uint16_t raw[], const uint16_t len, uint16_t *out,
+                    raw_compact_t *info, const uint8_t tolerance,
+                    const uint32_t min_gap) {
+  info->lead_len = 0;
+  info->frame_len = len;
+  info->gap = 0;
+  info->repeat = 0;
+  // Try each frame in turn as the first copy of the repeated frame.
+  for (uint16_t first = 0; first < len; ) {
+    const uint16_t frame_len = rawFrameLength(raw, len, first, min_gap);
+    uint32_t first_gap;
+    const uint16_t gap_len = rawGapLength(raw, len, first + frame_len,
+                                          &first_gap);
+    uint32_t gap = first_gap;  // The gap before the next copy.
+    uint32_t gap_sum = 0;
+    uint16_t copies = 1;
+    uint16_t next = first + frame_len + gap_len;
+    // Count the copies that follow it, with the same gaps between them.
+    while (next < len &&
+           rawFrameLength(raw, len, next, min_gap) == frame_len &&
+           rawFramesMatch(raw + first, raw + next, frame_len, tolerance) &&
+           rawDurationsMatch(first_gap, gap, tolerance)) {
+      gap_sum += gap;
+      copies++;
+      next += frame_len + rawGapLength(raw, len, next + frame_len, &gap);
+    }
+    // Compact it only if the copies run to the end of the message.
+    if (copies > 1 && next >= len) {
+      info->lead_len = first;
+      info->frame_len = frame_len;
+      info->repeat = copies - 1;
+      info->gap = gap_sum / info->repeat;
+      if (out != raw)
+        for (uint16_t i = 0; i < first; i++) out[i] = raw[i];
+      // Average each duration across the copies.
+      for (uint16_t i = 0; i < frame_len; i++) {
+        uint32_t sum = 0;
+        for (uint16_t c = 0, pos = first; c < copies; c++) {
+          sum += raw[pos + i];
+          pos += frame_len + rawGapLength(raw, len, pos + frame_len, &gap);
+        }
+        out[first + i] = (sum + copies / 2) / copies;
+      }
+      return first + frame_len;
+    }
+    first += frame_len + gap_len;
+  }
+  if (out != raw)
+    for (uint16_t i = 0; i < len; i++) out[i] = raw[i];
+  return len;
+}
+
 /// Sum all the bytes of an array and return the least significant 8-bits of
 /// the result.
 /// @param[in] start A ptr to the start of the byte array to calculate over.
@@ -1210,6 +1683,21 @@ namespace irutils {
     return true;
   }
 
+  /// Is a name usable as a level of an MQTT topic, & in a message payload?
+  /// @param[in] name The name.
+  /// @param[in] max_length Max. length of the name, excluding the null.
+  /// @param[in] separators The characters the payloads use as separators.
+  /// @return true if it is, otherwise false.
+  /// @note '/', '+' & '#' are never allowed, as they have special meanings in
+  ///   MQTT topics.
+  bool validTopicName(const char *name, const uint16_t max_length,
+                      const char *separators) {
+    if (name == NULL || *name == '\0' || strlen(name) > max_length)
+      return false;
+    return strpbrk(name, "/+#") == NULL &&
+        (separators == NULL || strpbrk(name, separators) == NULL);
+  }
+
   /// Perform a low level bit manipulation sanity check for the given cpu
   /// architecture and the compiler operation. Calls to this should return
   /// 0 if everything is as expected, anything else means the library won't work
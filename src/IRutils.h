@@ -14,15 +14,31 @@
 #include "IRremoteESP8266.h"
 #include "IRrecv.h"
 
+struct raw_compact_t;  // See IRsend.h
+
 const uint8_t kNibbleSize = 4;
 const uint8_t kLowNibble = 0;
 const uint8_t kHighNibble = 4;
 const uint8_t kModeBitsSize = 3;
+// Shortest space (usecs) treated as a gap between frames by `compactRaw()`.
+const uint32_t kRawCompactMinGap = 10000;
+
+/// A function that publishes a message. e.g. Via an MQTT client.
+/// @param[in] topic The topic to publish to.
+/// @param[in] payload The message.
+/// @param[in] retain Should the broker retain the message?
+/// @param[in] arg The argument given to the publisher's `setPublisher()`.
+/// @return true if it was published, otherwise false.
+typedef bool (*IRPublish)(const char *topic, const char *payload,
+                          const bool retain, void *arg);
+
 uint64_t reverseBits(uint64_t input, uint16_t nbits);
 String uint64ToString(uint64_t input, uint8_t base = 10);
 String int64ToString(int64_t input, uint8_t base = 10);
 String typeToString(const decode_type_t protocol,
                     const bool isRepeat = false);
+uint16_t typeToName(const decode_type_t protocol, char *buffer,
+                    const uint16_t size);
 void serialPrintUint64(uint64_t input, uint8_t base = 10);
 String resultToSourceCode(const decode_results * const results);
 String resultToTimingInfo(const decode_results * const results);
@@ -31,6 +47,16 @@ String resultToHexidecimal(const decode_results * const result);
 bool hasACState(const decode_type_t protocol);
 uint16_t getCorrectedRawLength(const decode_results * const results);
 uint16_t *resultToRawArray(const decode_results * const decode);
+uint64_t resultToFingerprint(const decode_results * const results);
+uint16_t packRawData(const uint16_t raw[], const uint16_t len,
+                     uint8_t *packed, const uint16_t size);
+uint16_t packRawData(const uint32_t raw[], const uint16_t len,
+                     uint8_t *packed, const uint16_t size);
+uint16_t unpackRawData(const uint8_t packed[], const uint16_t nbytes,
+                       uint16_t *raw, const uint16_t size);
+uint16_t compactRaw(const uint16_t raw[], const uint16_t len, uint16_t *out,
+                    raw_compact_t *info, const uint8_t tolerance = kTolerance,
+                    const uint32_t min_gap = kRawCompactMinGap);
 uint8_t sumBytes(const uint8_t * const start, const uint16_t length,
                  const uint8_t init = 0);
 uint8_t xorBytes(const uint8_t * const start, const uint16_t length,
@@ -132,6 +158,8 @@ namespace irutils {
                const uint64_t data);
   uint8_t * invertBytePairs(uint8_t *ptr, const uint16_t length);
   bool checkInvertedBytePairs(const uint8_t * const ptr, const uint16_t length);
+  bool validTopicName(const char *name, const uint16_t max_length,
+                      const char *separators);
   uint8_t lowLevelSanityCheck(void);
 }  // namespace irutils
 #endif  // IRUTILS_H_
@@ -29,12 +29,18 @@ using irutils::addTempToString;
 /// @param[in] repeat The number of times the command is to be repeated.
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/1069
 void IRsend::sendAirwell(uint64_t data, uint16_t nbits, uint16_t repeat) {
-  // Header + Data
-  sendManchester(kAirwellHdrMark, kAirwellHdrMark, kAirwellHalfClockPeriod,
-                 0, 0, data, nbits, 38000, true, repeat, kDutyDefault, false);
+  enableIROut(38000, kDutyDefault);
+  for (uint16_t r = 0; r <= repeat; r++) {
+    // Header
+    queueMark(kAirwellHdrMark);
+    queueSpace(kAirwellHdrMark);
+    // Data
+    queueManchesterData(kAirwellHalfClockPeriod, data, nbits, true, false);
+  }
   // Footer
-  mark(kAirwellHdrMark + kAirwellHalfClockPeriod);
-  space(kDefaultMessageGap);  // A guess.
+  queueMark(kAirwellHdrMark + kAirwellHalfClockPeriod);
+  queueSpace(kDefaultMessageGap);  // A guess.
+  flushQueued();
 }
 #endif
 
@@ -146,11 +146,17 @@ bool IRDaikinESP::validChecksum(uint8_t state[], const uint16_t length) {
 }
 
 /// Calculate and set the checksum values for the internal state.
+/// Only the sections that have changed since the last call are summed.
 void IRDaikinESP::checksum(void) {
-  _.Sum1 = sumBytes(_.raw, kDaikinSection1Length - 1);
-  _.Sum2 = sumBytes(_.raw + kDaikinSection1Length, kDaikinSection2Length - 1);
-  _.Sum3 = sumBytes(_.raw + kDaikinSection1Length + kDaikinSection2Length,
-                    kDaikinSection3Length - 1);
+  if (_dirty & kDaikinSection1Dirty)
+    _.Sum1 = sumBytes(_.raw, kDaikinSection1Length - 1);
+  if (_dirty & kDaikinSection2Dirty)
+    _.Sum2 = sumBytes(_.raw + kDaikinSection1Length,
+                      kDaikinSection2Length - 1);
+  if (_dirty & kDaikinSection3Dirty)
+    _.Sum3 = sumBytes(_.raw + kDaikinSection1Length + kDaikinSection2Length,
+                      kDaikinSection3Length - 1);
+  _dirty = 0;
 }
 
 /// Reset the internal state to a fixed known good state.
@@ -177,11 +183,13 @@ void IRDaikinESP::stateReset(void) {
   _.raw[28] = 0x60;
   _.raw[31] = 0xC0;
   // _.raw[34] is a checksum byte, it will be set by checksum().
-  checksum();
+  _dirty = kDaikinAllSectionsDirty;
 }
 
 /// Get a PTR to the internal state/code for this protocol.
 /// @return PTR to a code for this protocol based on the current internal state.
+/// @note The checksums are only recalculated if something has changed.
+///   Use `setRaw()`, not the returned PTR, to change the state.
 uint8_t *IRDaikinESP::getRaw(void) {
   checksum();  // Ensure correct settings before sending.
   return _.raw;
@@ -198,6 +206,7 @@ void IRDaikinESP::setRaw(const uint8_t new_code[], const uint16_t length) {
   }
   for (uint8_t i = 0; i < length && i < kDaikinStateLength; i++)
     _.raw[i + offset] = new_code[i];
+  _dirty = kDaikinAllSectionsDirty;
 }
 
 /// Change the power setting to On.
@@ -209,6 +218,7 @@ void IRDaikinESP::off(void) { setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setPower(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   _.Power = on;
 }
 
@@ -221,6 +231,7 @@ bool IRDaikinESP::getPower(void) const {
 /// Set the temperature.
 /// @param[in] temp The temperature in degrees celsius.
 void IRDaikinESP::setTemp(const uint8_t temp) {
+  _dirty |= kDaikinSection3Dirty;
   uint8_t degrees = std::max(temp, kDaikinMinTemp);
   degrees = std::min(degrees, kDaikinMaxTemp);
   _.Temp = degrees;
@@ -234,6 +245,7 @@ uint8_t IRDaikinESP::getTemp(void) const { return _.Temp; }
 /// @param[in] fan The desired setting.
 /// @note 1-5 or kDaikinFanAuto or kDaikinFanQuiet
 void IRDaikinESP::setFan(const uint8_t fan) {
+  _dirty |= kDaikinSection3Dirty;
   // Set the fan speed bits, leave low 4 bits alone
   uint8_t fanset;
   if (fan == kDaikinFanQuiet || fan == kDaikinFanAuto)
@@ -262,6 +274,7 @@ uint8_t IRDaikinESP::getMode(void) const {
 /// Set the operating mode of the A/C.
 /// @param[in] mode The desired operating mode.
 void IRDaikinESP::setMode(const uint8_t mode) {
+  _dirty |= kDaikinSection3Dirty;
   switch (mode) {
     case kDaikinAuto:
     case kDaikinCool:
@@ -278,6 +291,7 @@ void IRDaikinESP::setMode(const uint8_t mode) {
 /// Set the Vertical Swing mode of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setSwingVertical(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   _.SwingV = (on ? kDaikinSwingOn : kDaikinSwingOff);
 }
 
@@ -290,6 +304,7 @@ bool IRDaikinESP::getSwingVertical(void) const {
 /// Set the Horizontal Swing mode of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setSwingHorizontal(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   _.SwingH = (on ? kDaikinSwingOn : kDaikinSwingOff);
 }
 
@@ -302,6 +317,7 @@ bool IRDaikinESP::getSwingHorizontal(void) const {
 /// Set the Quiet mode of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setQuiet(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   _.Quiet = on;
   // Powerful & Quiet mode being on are mutually exclusive.
   if (on) setPowerful(false);
@@ -316,6 +332,7 @@ bool IRDaikinESP::getQuiet(void) const {
 /// Set the Powerful (Turbo) mode of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setPowerful(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   _.Powerful = on;
   if (on) {
     // Powerful, Quiet, & Econo mode being on are mutually exclusive.
@@ -333,6 +350,7 @@ bool IRDaikinESP::getPowerful(void) const {
 /// Set the Sensor mode of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setSensor(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   _.Sensor = on;
 }
 
@@ -345,6 +363,7 @@ bool IRDaikinESP::getSensor(void) const {
 /// Set the Economy mode of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setEcono(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   _.Econo = on;
   // Powerful & Econo mode being on are mutually exclusive.
   if (on) setPowerful(false);
@@ -359,6 +378,7 @@ bool IRDaikinESP::getEcono(void) const {
 /// Set the Mould mode of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setMold(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   _.Mold = on;
 }
 
@@ -371,6 +391,7 @@ bool IRDaikinESP::getMold(void) const {
 /// Set the Comfort mode of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setComfort(const bool on) {
+  _dirty |= kDaikinSection1Dirty;
   _.Comfort = on;
 }
 
@@ -383,12 +404,14 @@ bool IRDaikinESP::getComfort(void) const {
 /// Set the enable status & time of the On Timer.
 /// @param[in] starttime The number of minutes past midnight.
 void IRDaikinESP::enableOnTimer(const uint16_t starttime) {
+  _dirty |= kDaikinSection3Dirty;
   _.OnTimer = true;
   _.OnTime = starttime;
 }
 
 /// Clear and disable the On timer.
 void IRDaikinESP::disableOnTimer(void) {
+  _dirty |= kDaikinSection3Dirty;
   _.OnTimer = false;
   _.OnTime = kDaikinUnusedTime;
 }
@@ -408,12 +431,14 @@ bool IRDaikinESP::getOnTimerEnabled(void) const {
 /// Set the enable status & time of the Off Timer.
 /// @param[in] endtime The number of minutes past midnight.
 void IRDaikinESP::enableOffTimer(const uint16_t endtime) {
+  _dirty |= kDaikinSection3Dirty;
   _.OffTimer = true;
   _.OffTime = endtime;
 }
 
 /// Clear and disable the Off timer.
 void IRDaikinESP::disableOffTimer(void) {
+  _dirty |= kDaikinSection3Dirty;
   _.OffTimer = false;
   _.OffTime = kDaikinUnusedTime;
 }
@@ -433,6 +458,7 @@ bool IRDaikinESP::getOffTimerEnabled(void) const {
 /// Set the clock on the A/C unit.
 /// @param[in] mins_since_midnight Nr. of minutes past midnight.
 void IRDaikinESP::setCurrentTime(const uint16_t mins_since_midnight) {
+  _dirty |= kDaikinSection2Dirty;
   uint16_t mins = mins_since_midnight;
   if (mins > 24 * 60) mins = 0;  // If > 23:59, set to 00:00
   _.CurrentTime = mins;
@@ -448,6 +474,7 @@ uint16_t IRDaikinESP::getCurrentTime(void) const {
 /// @param[in] day_of_week The numerical representation of the day of the week.
 /// @note 1 is SUN, 2 is MON, ..., 7 is SAT
 void IRDaikinESP::setCurrentDay(const uint8_t day_of_week) {
+  _dirty |= kDaikinSection2Dirty;
   _.CurrentDay = day_of_week;
 }
 
@@ -461,6 +488,7 @@ uint8_t IRDaikinESP::getCurrentDay(void) const {
 /// Set the enable status of the Weekly Timer.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRDaikinESP::setWeeklyTimerEnable(const bool on) {
+  _dirty |= kDaikinSection3Dirty;
   // Bit is cleared for `on`.
   _.WeeklyTimer = !on;
 }
@@ -584,6 +612,55 @@ String IRDaikinESP::toString(void) const {
   return result;
 }
 
+#if (DECODE_DAIKIN || DECODE_DAIKIN2 || DECODE_DAIKIN160 || \
+     DECODE_DAIKIN176 || DECODE_DAIKIN216)
+/// Match the data sections of a multi-section Daikin message.
+/// Each section is a header, the data bytes (LSBF), & a footer, all using the
+/// same timings. Only the last section may end the capture early.
+/// @param[in,out] results Ptr to the data to decode & where to store the
+///   section data.
+/// @param[in] offset The index of the first section's header mark.
+/// @param[in] sizes The nr. of bytes in each section.
+/// @param[in] sections The nr. of sections.
+/// @param[in] hdrmark The section header mark length. (uSeconds)
+/// @param[in] hdrspace The section header space length. (uSeconds)
+/// @param[in] bitmark The bit & footer mark length. (uSeconds)
+/// @param[in] onespace The one bit space length. (uSeconds)
+/// @param[in] zerospace The zero bit space length. (uSeconds)
+/// @param[in] gap The footer space length. (uSeconds)
+/// @param[in] tolerance The percentage error allowed.
+/// @return The nr. of bytes stored in `results->state`. 0 if it failed.
+uint16_t IRrecv::matchDaikinSections(decode_results *results, uint16_t offset,
+                                     const uint8_t sizes[],
+                                     const uint8_t sections,
+                                     const uint16_t hdrmark,
+                                     const uint32_t hdrspace,
+                                     const uint16_t bitmark,
+                                     const uint32_t onespace,
+                                     const uint32_t zerospace,
+                                     const uint32_t gap,
+                                     const uint8_t tolerance) {
+  uint16_t pos = 0;
+  for (uint8_t section = 0; section < sections; section++) {
+    const uint16_t used = matchGeneric(results->rawbuf + offset,
+                                       results->state + pos,
+                                       results->rawlen - offset,
+                                       sizes[section] * 8,
+                                       hdrmark, hdrspace,
+                                       bitmark, onespace,
+                                       bitmark, zerospace,
+                                       bitmark, gap,
+                                       section >= sections - 1,
+                                       tolerance, kDaikinMarkExcess, false);
+    if (used == 0) return 0;
+    offset += used;
+    pos += sizes[section];
+  }
+  return pos;
+}
+#endif  // (DECODE_DAIKIN || DECODE_DAIKIN2 || DECODE_DAIKIN160 ||
+        //  DECODE_DAIKIN176 || DECODE_DAIKIN216)
+
 #if DECODE_DAIKIN
 /// Decode the supplied Daikin 280-bit message. (DAIKIN)
 /// Status: STABLE / Reported as working.
@@ -624,22 +701,11 @@ bool IRrecv::decodeDaikin(decode_results *results, uint16_t offset,
   // Sections
   const uint8_t ksectionSize[kDaikinSections] = {
       kDaikinSection1Length, kDaikinSection2Length, kDaikinSection3Length};
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikinSections; section++) {
-    uint16_t used;
-    // Section Header + Section Data (7 bytes) + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikinHdrMark, kDaikinHdrSpace,
-                        kDaikinBitMark, kDaikinOneSpace,
-                        kDaikinBitMark, kDaikinZeroSpace,
-                        kDaikinBitMark, kDaikinZeroSpace + kDaikinGap,
-                        section >= kDaikinSections - 1,
-                        kDaikinTolerance, kDaikinMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
+  const uint16_t pos = matchDaikinSections(
+      results, offset, ksectionSize, kDaikinSections, kDaikinHdrMark,
+      kDaikinHdrSpace, kDaikinBitMark, kDaikinOneSpace, kDaikinZeroSpace,
+      kDaikinZeroSpace + kDaikinGap, kDaikinTolerance);
+  if (pos == 0) return false;
   // Compliance
   if (strict) {
     // Re-check we got the correct size/length due to the way we read the data.
@@ -1347,23 +1413,11 @@ bool IRrecv::decodeDaikin2(decode_results *results, uint16_t offset,
                   _tolerance + kDaikin2Tolerance)) return false;
 
   // Sections
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikin2Sections; section++) {
-    uint16_t used;
-    // Section Header + Section Data + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikin2HdrMark, kDaikin2HdrSpace,
-                        kDaikin2BitMark, kDaikin2OneSpace,
-                        kDaikin2BitMark, kDaikin2ZeroSpace,
-                        kDaikin2BitMark, kDaikin2Gap,
-                        section >= kDaikin2Sections - 1,
-                        _tolerance + kDaikin2Tolerance, kDaikinMarkExcess,
-                        false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
+  const uint16_t pos = matchDaikinSections(
+      results, offset, ksectionSize, kDaikin2Sections, kDaikin2HdrMark,
+      kDaikin2HdrSpace, kDaikin2BitMark, kDaikin2OneSpace, kDaikin2ZeroSpace,
+      kDaikin2Gap, _tolerance + kDaikin2Tolerance);
+  if (pos == 0) return false;
   // Compliance
   if (strict) {
     // Re-check we got the correct size/length due to the way we read the data.
@@ -1687,22 +1741,11 @@ bool IRrecv::decodeDaikin216(decode_results *results, uint16_t offset,
   const uint8_t ksectionSize[kDaikin216Sections] = {kDaikin216Section1Length,
                                                     kDaikin216Section2Length};
   // Sections
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikin216Sections; section++) {
-    uint16_t used;
-    // Section Header + Section Data + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikin216HdrMark, kDaikin216HdrSpace,
-                        kDaikin216BitMark, kDaikin216OneSpace,
-                        kDaikin216BitMark, kDaikin216ZeroSpace,
-                        kDaikin216BitMark, kDaikin216Gap,
-                        section >= kDaikin216Sections - 1,
-                        kDaikinTolerance, kDaikinMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
+  const uint16_t pos = matchDaikinSections(
+      results, offset, ksectionSize, kDaikin216Sections, kDaikin216HdrMark,
+      kDaikin216HdrSpace, kDaikin216BitMark, kDaikin216OneSpace,
+      kDaikin216ZeroSpace, kDaikin216Gap, kDaikinTolerance);
+  if (pos == 0) return false;
   // Compliance
   if (strict) {
     if (pos * 8 != kDaikin216Bits) return false;
@@ -2043,22 +2086,11 @@ bool IRrecv::decodeDaikin160(decode_results *results, uint16_t offset,
                                                     kDaikin160Section2Length};
 
   // Sections
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikin160Sections; section++) {
-    uint16_t used;
-    // Section Header + Section Data (7 bytes) + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikin160HdrMark, kDaikin160HdrSpace,
-                        kDaikin160BitMark, kDaikin160OneSpace,
-                        kDaikin160BitMark, kDaikin160ZeroSpace,
-                        kDaikin160BitMark, kDaikin160Gap,
-                        section >= kDaikin160Sections - 1,
-                        kDaikinTolerance, kDaikinMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
+  const uint16_t pos = matchDaikinSections(
+      results, offset, ksectionSize, kDaikin160Sections, kDaikin160HdrMark,
+      kDaikin160HdrSpace, kDaikin160BitMark, kDaikin160OneSpace,
+      kDaikin160ZeroSpace, kDaikin160Gap, kDaikinTolerance);
+  if (pos == 0) return false;
   // Compliance
   if (strict) {
     // Validate the checksum.
@@ -2436,22 +2468,11 @@ bool IRrecv::decodeDaikin176(decode_results *results, uint16_t offset,
                                                     kDaikin176Section2Length};
 
   // Sections
-  uint16_t pos = 0;
-  for (uint8_t section = 0; section < kDaikin176Sections; section++) {
-    uint16_t used;
-    // Section Header + Section Data (7 bytes) + Section Footer
-    used = matchGeneric(results->rawbuf + offset, results->state + pos,
-                        results->rawlen - offset, ksectionSize[section] * 8,
-                        kDaikin176HdrMark, kDaikin176HdrSpace,
-                        kDaikin176BitMark, kDaikin176OneSpace,
-                        kDaikin176BitMark, kDaikin176ZeroSpace,
-                        kDaikin176BitMark, kDaikin176Gap,
-                        section >= kDaikin176Sections - 1,
-                        kDaikinTolerance, kDaikinMarkExcess, false);
-    if (used == 0) return false;
-    offset += used;
-    pos += ksectionSize[section];
-  }
+  const uint16_t pos = matchDaikinSections(
+      results, offset, ksectionSize, kDaikin176Sections, kDaikin176HdrMark,
+      kDaikin176HdrSpace, kDaikin176BitMark, kDaikin176OneSpace,
+      kDaikin176ZeroSpace, kDaikin176Gap, kDaikinTolerance);
+  if (pos == 0) return false;
   // Compliance
   if (strict) {
     // Validate the checksum.
@@ -3733,3 +3754,84 @@ stdAc::state_t IRDaikin64::toCommon(const stdAc::state_t *prev) const {
   result.light = false;
   return result;
 }
+
+#if DECODE_DAIKIN_FAMILY
+/// Decode the supplied message as any of the Daikin A/C variants.
+/// The variants are told apart by how they start (a leader, a section header,
+/// or a short run of zero bits), so we only attempt the variants whose start
+/// matches. Longer variants are tried before shorter ones that start the same
+/// way, as their length checks reject a short message without decoding it.
+/// @param[in,out] results Ptr to the data to decode & where to store the result
+/// @param[in] offset The starting index to use when attempting to decode the
+///   raw data. Typically/Defaults to kStartOffset.
+/// @return True if it can decode it, false if it can't.
+bool IRrecv::decodeDaikinFamily(decode_results *results, uint16_t offset) {
+  if (results->rawlen < kHeader + offset) return false;
+  const uint16_t mark = results->rawbuf[offset];
+  const uint16_t space = results->rawbuf[offset + 1];
+  // A short run of zero bits. (Daikin & Daikin152)
+#if DECODE_DAIKIN
+  if (matchMark(mark, kDaikinBitMark, kDaikinTolerance, kDaikinMarkExcess)) {
+    DPRINTLN("Attempting Daikin decode");
+    if (decodeDaikin(results, offset)) return true;
+  }
+#endif  // DECODE_DAIKIN
+#if DECODE_DAIKIN152
+  if (matchMark(mark, kDaikin152BitMark)) {
+    DPRINTLN("Attempting Daikin152 decode");
+    if (decodeDaikin152(results, offset)) return true;
+  }
+#endif  // DECODE_DAIKIN152
+#if DECODE_DAIKIN2
+  // A leader with a very long space.
+  if (matchMark(mark, kDaikin2LeaderMark, _tolerance + kDaikin2Tolerance) &&
+      matchSpace(space, kDaikin2LeaderSpace, _tolerance + kDaikin2Tolerance)) {
+    DPRINTLN("Attempting Daikin2 decode");
+    if (decodeDaikin2(results, offset)) return true;
+  }
+#endif  // DECODE_DAIKIN2
+#if DECODE_DAIKIN216
+  // A section header.
+  if (matchMark(mark, kDaikin216HdrMark, kDaikinTolerance, kDaikinMarkExcess) &&
+      matchSpace(space, kDaikin216HdrSpace, kDaikinTolerance,
+                 kDaikinMarkExcess)) {
+    DPRINTLN("Attempting Daikin216 decode");
+    if (decodeDaikin216(results, offset)) return true;
+  }
+#endif  // DECODE_DAIKIN216
+#if DECODE_DAIKIN176
+  if (matchMark(mark, kDaikin176HdrMark, kDaikinTolerance, kDaikinMarkExcess) &&
+      matchSpace(space, kDaikin176HdrSpace, kDaikinTolerance,
+                 kDaikinMarkExcess)) {
+    DPRINTLN("Attempting Daikin176 decode");
+    if (decodeDaikin176(results, offset)) return true;
+  }
+#endif  // DECODE_DAIKIN176
+#if DECODE_DAIKIN160
+  if (matchMark(mark, kDaikin160HdrMark, kDaikinTolerance, kDaikinMarkExcess) &&
+      matchSpace(space, kDaikin160HdrSpace, kDaikinTolerance,
+                 kDaikinMarkExcess)) {
+    DPRINTLN("Attempting Daikin160 decode");
+    if (decodeDaikin160(results, offset)) return true;
+  }
+#endif  // DECODE_DAIKIN160
+  // A leader with an equally long space. (Daikin128 & Daikin64)
+#if DECODE_DAIKIN128
+  if (matchMark(mark, kDaikin128LeaderMark, kDaikinTolerance,
+                kDaikinMarkExcess) &&
+      matchSpace(space, kDaikin128LeaderSpace, kDaikinTolerance,
+                 kDaikinMarkExcess)) {
+    DPRINTLN("Attempting Daikin128 decode");
+    if (decodeDaikin128(results, offset)) return true;
+  }
+#endif  // DECODE_DAIKIN128
+#if DECODE_DAIKIN64
+  if (matchMark(mark, kDaikin64LdrMark) &&
+      matchSpace(space, kDaikin64LdrSpace)) {
+    DPRINTLN("Attempting Daikin64 decode");
+    if (decodeDaikin64(results, offset)) return true;
+  }
+#endif  // DECODE_DAIKIN64
+  return false;
+}
+#endif  // DECODE_DAIKIN_FAMILY
@@ -153,6 +153,11 @@ const uint8_t kDaikinSection3Length =
     kDaikinStateLength - kDaikinSection1Length - kDaikinSection2Length;
 const uint8_t kDaikinByteChecksum1 = 7;
 const uint8_t kDaikinByteChecksum2 = 15;
+// Bits of `IRDaikinESP::_dirty`. Which sections need their checksum redone.
+const uint8_t kDaikinSection1Dirty = 0b001;
+const uint8_t kDaikinSection2Dirty = 0b010;
+const uint8_t kDaikinSection3Dirty = 0b100;
+const uint8_t kDaikinAllSectionsDirty = 0b111;
 // const uint8_t kDaikinBitEye = 0b10000000;
 const uint16_t kDaikinUnusedTime = 0x600;
 const uint8_t kDaikinBeepQuiet = 1;
@@ -766,6 +771,7 @@ class IRDaikinESP {
 #endif
   // # of bytes per command
   DaikinESPProtocol _;
+  uint8_t _dirty;  ///< Sections changed since their checksums were last set.
   void stateReset(void);
   void checksum(void);
 };
@@ -123,13 +123,17 @@ void IRGreeAC::stateReset(void) {
   _.Light = true;  // _.remote_state[2] = 0x20;
   _.unknown1 = 5;  // _.remote_state[3] = 0x50;
   _.unknown2 = 4;  // _.remote_state[5] = 0x20;
+  _dirty = true;
 }
 
 /// Fix up the internal state so it is correct.
-/// @note Internal use only.
+/// @note Internal use only. Does nothing if the state hasn't changed since the
+///   last time.
 void IRGreeAC::fixup(void) {
+  if (!_dirty) return;
   setPower(getPower());  // Redo the power bits as they differ between models.
   checksum();  // Calculate the checksums
+  _dirty = false;
 }
 
 /// Set up hardware to be able to send a message.
@@ -145,6 +149,7 @@ void IRGreeAC::send(const uint16_t repeat) {
 
 /// Get a PTR to the internal state/code for this protocol.
 /// @return PTR to a code for this protocol based on the current internal state.
+/// @note Use `setRaw()`, not the returned PTR, to change the state.
 uint8_t* IRGreeAC::getRaw(void) {
   fixup();  // Ensure correct settings before sending.
   return _.remote_state;
@@ -154,6 +159,7 @@ uint8_t* IRGreeAC::getRaw(void) {
 /// @param[in] new_code A valid code for this protocol.
 void IRGreeAC::setRaw(const uint8_t new_code[]) {
   std::memcpy(_.remote_state, new_code, kGreeStateLength);
+  _dirty = true;
   // We can only detect the difference between models when the power is on.
   if (_.Power) {
     if (_.ModelA)
@@ -183,6 +189,7 @@ bool IRGreeAC::validChecksum(const uint8_t state[], const uint16_t length) {
 /// Set the model of the A/C to emulate.
 /// @param[in] model The enum of the appropriate model.
 void IRGreeAC::setModel(const gree_ac_remote_model_t model) {
+  _dirty = true;
   switch (model) {
     case gree_ac_remote_model_t::YAW1F:
     case gree_ac_remote_model_t::YBOFB: _model = model; break;
@@ -204,6 +211,7 @@ void IRGreeAC::off(void) { setPower(false); }
 /// @param[in] on true, the setting is on. false, the setting is off.
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/814
 void IRGreeAC::setPower(const bool on) {
+  _dirty = true;
   _.Power = on;
   // May not be needed. See #814
   _.ModelA = (on && _model == gree_ac_remote_model_t::YAW1F);
@@ -221,6 +229,7 @@ bool IRGreeAC::getPower(void) const {
 /// @param[in] on Use Fahrenheit as the units.
 ///   true is Fahrenheit, false is Celsius.
 void IRGreeAC::setUseFahrenheit(const bool on) {
+  _dirty = true;
   _.UseFahrenheit = on;
 }
 
@@ -237,6 +246,7 @@ bool IRGreeAC::getUseFahrenheit(void) const {
 /// @note The unit actually works in Celsius with a special optional
 ///   "extra degree" when sending Fahrenheit.
 void IRGreeAC::setTemp(const uint8_t temp, const bool fahrenheit) {
+  _dirty = true;
   float safecelsius = temp;
   if (fahrenheit)
     // Covert to F, and add a fudge factor to round to the expected degree.
@@ -273,6 +283,7 @@ uint8_t IRGreeAC::getTemp(void) const {
 /// Set the speed of the fan.
 /// @param[in] speed The desired setting. 0 is auto, 1-3 is the speed.
 void IRGreeAC::setFan(const uint8_t speed) {
+  _dirty = true;
   uint8_t fan = std::min(kGreeFanMax, speed);  // Bounds check
   if (_.Mode == kGreeDry) fan = 1;  // DRY mode is always locked to fan 1.
   // Set the basic fan values.
@@ -288,6 +299,7 @@ uint8_t IRGreeAC::getFan(void) const {
 /// Set the operating mode of the A/C.
 /// @param[in] new_mode The desired operating mode.
 void IRGreeAC::setMode(const uint8_t new_mode) {
+  _dirty = true;
   uint8_t mode = new_mode;
   switch (mode) {
     // AUTO is locked to 25C
@@ -312,6 +324,7 @@ uint8_t IRGreeAC::getMode(void) const {
 /// Set the Light (LED) setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRGreeAC::setLight(const bool on) {
+  _dirty = true;
   _.Light = on;
 }
 
@@ -324,6 +337,7 @@ bool IRGreeAC::getLight(void) const {
 /// Set the IFeel setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRGreeAC::setIFeel(const bool on) {
+  _dirty = true;
   _.IFeel = on;
 }
 
@@ -336,6 +350,7 @@ bool IRGreeAC::getIFeel(void) const {
 /// Set the Wifi (enabled) setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRGreeAC::setWiFi(const bool on) {
+  _dirty = true;
   _.WiFi = on;
 }
 
@@ -348,6 +363,7 @@ bool IRGreeAC::getWiFi(void) const {
 /// Set the XFan (Mould) setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRGreeAC::setXFan(const bool on) {
+  _dirty = true;
   _.Xfan = on;
 }
 
@@ -360,6 +376,7 @@ bool IRGreeAC::getXFan(void) const {
 /// Set the Sleep setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRGreeAC::setSleep(const bool on) {
+  _dirty = true;
   _.Sleep = on;
 }
 
@@ -372,6 +389,7 @@ bool IRGreeAC::getSleep(void) const {
 /// Set the Turbo setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRGreeAC::setTurbo(const bool on) {
+  _dirty = true;
   _.Turbo = on;
 }
 
@@ -385,6 +403,7 @@ bool IRGreeAC::getTurbo(void) const {
 /// @param[in] automatic Do we use the automatic setting?
 /// @param[in] position The position/mode to set the vanes to.
 void IRGreeAC::setSwingVertical(const bool automatic, const uint8_t position) {
+  _dirty = true;
   _.SwingAuto = automatic;
   uint8_t new_position = position;
   if (!automatic) {
@@ -427,6 +446,7 @@ uint8_t IRGreeAC::getSwingVerticalPosition(void) const {
 /// Set the timer enable setting of the A/C.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRGreeAC::setTimerEnabled(const bool on) {
+  _dirty = true;
   _.TimerEnabled = on;
 }
 
@@ -449,6 +469,7 @@ uint16_t IRGreeAC::getTimer(void) const {
 /// @note Stores time internally in 30 min units.
 ///  e.g. 5 mins means 0 (& Off), 95 mins is  90 mins (& On). Max is 24 hours.
 void IRGreeAC::setTimer(const uint16_t minutes) {
+  _dirty = true;
   uint16_t mins = std::min(kGreeTimerMax, minutes);  // Bounds check.
   setTimerEnabled(mins >= 30);  // Timer is enabled when >= 30 mins.
   uint8_t hours = mins / 60;
@@ -472,6 +493,7 @@ void IRGreeAC::setTimer(const uint16_t minutes) {
 ///   out of order.
 /// @see https://github.com/crankyoldgit/IRremoteESP8266/issues/1118#issuecomment-628242152
 void IRGreeAC::setDisplayTempSource(const uint8_t mode) {
+  _dirty = true;
   _.DisplayTemp = mode;
 }
 
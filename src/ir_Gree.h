@@ -210,6 +210,7 @@ class IRGreeAC {
 #endif  // UNIT_TEST
   GreeProtocol _;
   gree_ac_remote_model_t _model;
+  bool _dirty;  ///< Has the state changed since the last `fixup()`?
   void checksum(const uint16_t length = kGreeStateLength);
   void fixup(void);
   void setTimerEnabled(const bool on);
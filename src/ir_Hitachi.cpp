@@ -29,6 +29,7 @@ const uint16_t kHitachiAcBitMark = 400;
 const uint16_t kHitachiAcOneSpace = 1250;
 const uint16_t kHitachiAcZeroSpace = 500;
 const uint32_t kHitachiAcMinGap = kDefaultMessageGap;  // Just a guess.
+const uint8_t kHitachiAcExtraTolerance = 5;  // Percent. (HitachiAC & AC1)
 // Support for HitachiAc424 protocol
 const uint16_t kHitachiAc424LdrMark = 29784;   // Leader
 const uint16_t kHitachiAc424LdrSpace = 49290;  // Leader
@@ -846,7 +847,7 @@ String IRHitachiAc1::toString(void) const {
 bool IRrecv::decodeHitachiAC(decode_results *results, uint16_t offset,
                              const uint16_t nbits, const bool strict,
                              const bool MSBfirst) {
-  const uint8_t k_tolerance = _tolerance + 5;
+  const uint8_t k_tolerance = _tolerance + kHitachiAcExtraTolerance;
 
   if (strict) {
     switch (nbits) {
@@ -1578,3 +1579,75 @@ String IRHitachiAc344::toString(void) const {
   result += ')';
   return result;
 }
+
+#if DECODE_HITACHI_FAMILY
+/// Decode the supplied message as any of the Hitachi A/C variants.
+/// HitachiAc424 is the only one with a leader, & the rest are told apart by
+/// their header & their length, so we only attempt the variants & sizes that
+/// the start & the end of the message allow.
+/// @param[in,out] results Ptr to the data to decode & where to store the result
+/// @param[in] offset The starting index to use when attempting to decode the
+///   raw data. Typically/Defaults to kStartOffset.
+/// @return True if it can decode it, false if it can't.
+bool IRrecv::decodeHitachiFamily(decode_results *results, uint16_t offset) {
+  if (results->rawlen < kHeader + offset) return false;
+  const uint16_t mark = results->rawbuf[offset];
+  const uint16_t space = results->rawbuf[offset + 1];
+#if DECODE_HITACHI_AC424
+  if (matchMark(mark, kHitachiAc424LdrMark)) {
+    DPRINTLN("Attempting Hitachi AC 424 decode");
+    if (decodeHitachiAc424(results, offset, kHitachiAc424Bits)) return true;
+  }
+#endif  // DECODE_HITACHI_AC424
+#if DECODE_HITACHI_AC3
+  if (matchMark(mark, kHitachiAc3HdrMark, kUseDefTol, 0) &&
+      matchSpace(space, kHitachiAc3HdrSpace, kUseDefTol, 0)) {
+    DPRINTLN("Attempting Hitachi AC3 decode");
+    // Order these in decreasing bit size.
+    const uint16_t kSizes[] = {kHitachiAc3Bits, kHitachiAc3Bits - 4 * 8,
+                               kHitachiAc3Bits - 6 * 8,
+                               kHitachiAc3MinBits + 2 * 8, kHitachiAc3MinBits};
+    for (uint8_t i = 0; i < sizeof(kSizes) / sizeof(kSizes[0]); i++)
+      if (matchGapAt(results, offset + kHeader + 2 * kSizes[i] + 1,
+                     kHitachiAcMinGap, kUseDefTol, 0) &&
+          decodeHitachiAc3(results, offset, kSizes[i])) return true;
+  }
+#endif  // DECODE_HITACHI_AC3
+#if (DECODE_HITACHI_AC || DECODE_HITACHI_AC1 || DECODE_HITACHI_AC2 || \
+     DECODE_HITACHI_AC344)
+  const uint8_t k_tolerance = _tolerance + kHitachiAcExtraTolerance;
+#endif
+#if (DECODE_HITACHI_AC || DECODE_HITACHI_AC2 || DECODE_HITACHI_AC344)
+  if (matchMark(mark, kHitachiAcHdrMark, k_tolerance) &&
+      matchSpace(space, kHitachiAcHdrSpace, k_tolerance)) {
+#if DECODE_HITACHI_AC344
+    DPRINTLN("Attempting Hitachi AC344 decode");
+    if (matchGapAt(results, offset + kHeader + 2 * kHitachiAc344Bits + 1,
+                   kHitachiAcMinGap, k_tolerance, kMarkExcess) &&
+        decodeHitachiAC(results, offset, kHitachiAc344Bits, true, false))
+      return true;
+#endif  // DECODE_HITACHI_AC344
+#if DECODE_HITACHI_AC2
+    DPRINTLN("Attempting Hitachi AC2 decode");
+    if (matchGapAt(results, offset + kHeader + 2 * kHitachiAc2Bits + 1,
+                   kHitachiAcMinGap, k_tolerance, kMarkExcess) &&
+        decodeHitachiAC(results, offset, kHitachiAc2Bits)) return true;
+#endif  // DECODE_HITACHI_AC2
+#if DECODE_HITACHI_AC
+    DPRINTLN("Attempting Hitachi AC decode");
+    if (matchGapAt(results, offset + kHeader + 2 * kHitachiAcBits + 1,
+                   kHitachiAcMinGap, k_tolerance, kMarkExcess) &&
+        decodeHitachiAC(results, offset, kHitachiAcBits)) return true;
+#endif  // DECODE_HITACHI_AC
+  }
+#endif  // (DECODE_HITACHI_AC || DECODE_HITACHI_AC2 || DECODE_HITACHI_AC344)
+#if DECODE_HITACHI_AC1
+  if (matchMark(mark, kHitachiAc1HdrMark, k_tolerance) &&
+      matchSpace(space, kHitachiAc1HdrSpace, k_tolerance)) {
+    DPRINTLN("Attempting Hitachi AC1 decode");
+    if (decodeHitachiAC(results, offset, kHitachiAc1Bits)) return true;
+  }
+#endif  // DECODE_HITACHI_AC1
+  return false;
+}
+#endif  // DECODE_HITACHI_FAMILY
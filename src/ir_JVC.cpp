@@ -69,15 +69,6 @@ void IRsend::sendJVC(uint64_t data, uint16_t nbits, uint16_t repeat) {
   }
 }
 
-/// Calculate the raw JVC data based on address and command.
-/// Status: STABLE / Works fine.
-/// @param[in] address An 8-bit address value.
-/// @param[in] command An 8-bit command value.
-/// @return A raw JVC message code, suitable for sendJVC()..
-/// @see http://www.sbprojects.net/knowledge/ir/jvc.php
-uint16_t IRsend::encodeJVC(uint8_t address, uint8_t command) {
-  return reverseBits((command << 8) | address, 16);
-}
 #endif  // SEND_JVC
 
 #if DECODE_JVC
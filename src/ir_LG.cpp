@@ -47,7 +47,6 @@ const uint16_t kLg2HdrSpace = 9900;           ///< uSeconds.
 const uint16_t kLg2BitMark = 480;             ///< uSeconds.
 
 const uint32_t kLgAcAKB74955603DetectionMask = 0x0000080;
-const uint8_t  kLgAcChecksumSize = 4;  ///< Size in bits.
 // Signature has the checksum removed, and another bit to match both Auto & Off.
 const uint8_t  kLgAcSwingHOffsetSize = kLgAcChecksumSize + 1;
 const uint32_t kLgAcSwingHSignature  = kLgAcSwingHOff >> kLgAcSwingHOffsetSize;
@@ -122,16 +121,6 @@ void IRsend::sendLG2(uint64_t data, uint16_t nbits, uint16_t repeat) {
                 38, true, repeat - 1, 50);
 }
 
-/// Construct a raw 28-bit LG message code from the supplied address & command.
-/// Status: STABLE / Works.
-/// @param[in] address The address code.
-/// @param[in] command The command code.
-/// @return A raw 28-bit LG message code suitable for sendLG() etc.
-/// @note Sequence of bits = address + command + checksum.
-uint32_t IRsend::encodeLG(uint16_t address, uint16_t command) {
-  return ((address << 20) | (command << kLgAcChecksumSize) |
-          irutils::sumNibbles(command, 4));
-}
 #endif  // SEND_LG
 
 #if DECODE_LG
@@ -40,15 +40,16 @@ void IRsend::sendLasertag(uint64_t data, uint16_t nbits, uint16_t repeat) {
   for (uint16_t i = 0; i <= repeat; i++) {
     // Data
     for (uint64_t mask = 1ULL << (nbits - 1); mask; mask >>= 1)
-      if (data & mask) {       // 1
-        space(kLasertagTick);  // 1 is space, then mark.
-        mark(kLasertagTick);
-      } else {                // 0
-        mark(kLasertagTick);  // 0 is mark, then space.
-        space(kLasertagTick);
+      if (data & mask) {            // 1
+        queueSpace(kLasertagTick);  // 1 is space, then mark.
+        queueMark(kLasertagTick);
+      } else {                     // 0
+        queueMark(kLasertagTick);  // 0 is mark, then space.
+        queueSpace(kLasertagTick);
       }
     // Footer
-    space(kLasertagMinGap);
+    queueSpace(kLasertagMinGap);
+    flushQueued();
   }
 }
 #endif  // SEND_LASERTAG
@@ -48,21 +48,22 @@ void IRsend::sendMWM(const uint8_t data[], const uint16_t nbytes,
       uint8_t byte = data[i];
 
       // Start bit
-      mark(kMWMTick);
+      queueMark(kMWMTick);
 
       // LSB first, space=1
       for (uint8_t mask = 0x1; mask; mask <<= 1) {
         if (byte & mask) {  // 1
-          space(kMWMTick);
+          queueSpace(kMWMTick);
         } else {  // 0
-          mark(kMWMTick);
+          queueMark(kMWMTick);
         }
       }
       // Stop bit
-      space(kMWMTick);
+      queueSpace(kMWMTick);
     }
     // Footer
-    space(kMWMMinGap);
+    queueSpace(kMWMMinGap);
+    flushQueued();
   }
 }
 #endif  // SEND_MWM
@@ -339,6 +339,7 @@ void IRMitsubishiAC::send(const uint16_t repeat) {
 
 /// Get a PTR to the internal state/code for this protocol.
 /// @return PTR to a code for this protocol based on the current internal state.
+/// @note Use `setRaw()`, not the returned PTR, to change the state.
 uint8_t *IRMitsubishiAC::getRaw(void) {
   checksum();
   return _.raw;
@@ -348,11 +349,15 @@ uint8_t *IRMitsubishiAC::getRaw(void) {
 /// @param[in] data A valid code for this protocol.
 void IRMitsubishiAC::setRaw(const uint8_t *data) {
   std::memcpy(_.raw, data, kMitsubishiACStateLength);
+  _dirty = true;
 }
 
 /// Calculate and set the checksum values for the internal state.
+/// Does nothing if the state hasn't changed since the last time.
 void IRMitsubishiAC::checksum(void) {
+  if (!_dirty) return;
   _.Sum = calculateChecksum(_.raw);
+  _dirty = false;
 }
 
 /// Verify the checksum is valid for a given state.
@@ -378,6 +383,7 @@ void IRMitsubishiAC::off(void) { setPower(false); }
 /// Change the power setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRMitsubishiAC::setPower(bool on) {
+  _dirty = true;
   _.Power = on;
 }
 
@@ -391,6 +397,7 @@ bool IRMitsubishiAC::getPower(void) const {
 /// @param[in] degrees The temperature in degrees celsius.
 /// @note The temperature resolution is 0.5 of a degree.
 void IRMitsubishiAC::setTemp(const float degrees) {
+  _dirty = true;
   // Make sure we have desired temp in the correct range.
   float celsius = std::max(degrees, kMitsubishiAcMinTemp);
   celsius = std::min(celsius, kMitsubishiAcMaxTemp);
@@ -411,6 +418,7 @@ float IRMitsubishiAC::getTemp(void) const {
 /// Set the speed of the fan.
 /// @param[in] speed The desired setting. 0 is auto, 1-5 is speed, 6 is silent.
 void IRMitsubishiAC::setFan(const uint8_t speed) {
+  _dirty = true;
   uint8_t fan = speed;
   // Bounds check
   if (fan > kMitsubishiAcFanSilent)
@@ -439,6 +447,7 @@ uint8_t IRMitsubishiAC::getMode(void) const {
 /// Set the operating mode of the A/C.
 /// @param[in] mode The desired operating mode.
 void IRMitsubishiAC::setMode(const uint8_t mode) {
+  _dirty = true;
   // If we get an unexpected mode, default to AUTO.
   switch (mode) {
     case kMitsubishiAcAuto: _.raw[8] = 0b00110000; break;
@@ -458,6 +467,7 @@ void IRMitsubishiAC::setMode(const uint8_t mode) {
 /// @note On some models, this represents the Right vertical vane.
 /// @param[in] position The position/mode to set the vane to.
 void IRMitsubishiAC::setVane(const uint8_t position) {
+  _dirty = true;
   uint8_t pos = std::min(position, kMitsubishiAcVaneAutoMove);  // bounds check
   _.VaneBit = 1;
   _.Vane = pos;
@@ -466,6 +476,7 @@ void IRMitsubishiAC::setVane(const uint8_t position) {
 /// Set the requested wide-vane (Horizontal Swing) operation mode of the a/c.
 /// @param[in] position The position/mode to set the wide vane to.
 void IRMitsubishiAC::setWideVane(const uint8_t position) {
+  _dirty = true;
   _.WideVane = std::min(position, kMitsubishiAcWideVaneAuto);
 }
 
@@ -485,6 +496,7 @@ uint8_t IRMitsubishiAC::getWideVane(void) const {
 /// Set the requested Left Vane (Vertical Swing) operation mode of the a/c unit.
 /// @param[in] position The position/mode to set the vane to.
 void IRMitsubishiAC::setVaneLeft(const uint8_t position) {
+  _dirty = true;
   _.VaneLeft = std::min(position, kMitsubishiAcVaneAutoMove);  // bounds check
 }
 
@@ -501,6 +513,7 @@ uint8_t IRMitsubishiAC::getClock(void) const { return _.Clock; }
 /// @param[in] clock Nr. of 10 minute increments past midnight.
 /// @note 1 = 1/6 hour (10 minutes). e.g. 6am = 36.
 void IRMitsubishiAC::setClock(const uint8_t clock) {
+  _dirty = true;
   _.Clock = clock;
 }
 
@@ -513,6 +526,7 @@ uint8_t IRMitsubishiAC::getStartClock(void) const { return _.StartClock; }
 /// @param[in] clock Nr. of 10 minute increments past midnight.
 /// @note 1 = 1/6 hour (10 minutes). e.g. 8pm = 120.
 void IRMitsubishiAC::setStartClock(const uint8_t clock) {
+  _dirty = true;
   _.StartClock = clock;
 }
 
@@ -525,6 +539,7 @@ uint8_t IRMitsubishiAC::getStopClock(void) const { return _.StopClock; }
 /// @param[in] clock Nr. of 10 minute increments past midnight.
 /// @note 1 = 1/6 hour (10 minutes). e.g. 10pm = 132.
 void IRMitsubishiAC::setStopClock(const uint8_t clock) {
+  _dirty = true;
   _.StopClock = clock;
 }
 
@@ -543,6 +558,7 @@ uint8_t IRMitsubishiAC::getTimer(void) const {
 ///   kMitsubishiAcStartTimer, kMitsubishiAcStopTimer,
 ///   kMitsubishiAcStartStopTimer
 void IRMitsubishiAC::setTimer(const uint8_t timer) {
+  _dirty = true;
   _.Timer = timer;
 }
 
@@ -709,6 +725,7 @@ stdAc::state_t IRMitsubishiAC::toCommon(void) const {
 /// Change the Weekly Timer Enabled setting.
 /// @param[in] on true, the setting is on. false, the setting is off.
 void IRMitsubishiAC::setWeeklyTimerEnabled(const bool on) {
+  _dirty = true;
   _.WeeklyTimer = on;
 }
 
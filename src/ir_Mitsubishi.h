@@ -312,6 +312,7 @@ class IRMitsubishiAC {
   /// @endcond
 #endif  // UNIT_TEST
   Mitsubishi144Protocol _;
+  bool _dirty;  ///< Has the state changed since the last `checksum()`?
   void checksum(void);
   static uint8_t calculateChecksum(const uint8_t* data);
 };
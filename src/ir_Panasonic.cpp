@@ -91,23 +91,6 @@ void IRsend::sendPanasonic(const uint16_t address, const uint32_t data,
   sendPanasonic64(((uint64_t)address << 32) | (uint64_t)data, nbits, repeat);
 }
 
-/// Calculate the raw Panasonic data based on device, subdevice, & function.
-/// Status: STABLE / Should be working.
-/// @param[in] manufacturer A 16-bit manufacturer code. e.g. 0x4004 is Panasonic
-/// @param[in] device An 8-bit code.
-/// @param[in] subdevice An 8-bit code.
-/// @param[in] function An 8-bit code.
-/// @return A value suitable for use with `sendPanasonic64()`.
-/// @note Panasonic 48-bit protocol is a modified version of Kaseikyo.
-/// @see http://www.remotecentral.com/cgi-bin/mboard/rc-pronto/thread.cgi?2615
-uint64_t IRsend::encodePanasonic(const uint16_t manufacturer,
-                                 const uint8_t device,
-                                 const uint8_t subdevice,
-                                 const uint8_t function) {
-  uint8_t checksum = device ^ subdevice ^ function;
-  return (((uint64_t)manufacturer << 32) | ((uint64_t)device << 24) |
-          ((uint64_t)subdevice << 16) | ((uint64_t)function << 8) | checksum);
-}
 #endif  // (SEND_PANASONIC || SEND_DENON)
 
 // Used by Denon as well.
@@ -62,22 +62,6 @@ void IRsend::sendPioneer(const uint64_t data, const uint16_t nbits,
   }
 }
 
-/// Calculate the raw Pioneer data code based on two NEC sub-codes
-/// Status: STABLE / Expected to work.
-/// @param[in] address A 16-bit "published" NEC value.
-/// @param[in] command A 16-bit "published" NEC value.
-/// @return A raw 64-bit Pioneer message code for use with `sendPioneer()``
-/// @note Address & Command can be take from a decode result OR from the
-///   spreadsheets located at:
-///    https://www.pioneerelectronics.com/PUSA/Support/Home-Entertainment-Custom-Install/IR+Codes/A+V+Receivers
-///   where the first part is considered the address,
-///   and the second the command.
-///  e.g.
-///  "A556+AF20" is an Address of 0xA556 & a Command of 0xAF20.
-uint64_t IRsend::encodePioneer(const uint16_t address, const uint16_t command) {
-  return (((uint64_t)encodeNEC(address >> 8, address & 0xFF)) << 32) |
-         encodeNEC(command >> 8, command & 0xFF);
-}
 #endif  // SEND_PIONEER
 
 #if DECODE_PIONEER
@@ -81,58 +81,35 @@ void IRsend::sendRC5(const uint64_t data, uint16_t nbits,
     if (skipSpace)
       skipSpace = false;  // First time through, we assume the leading space().
     else
-      space(kRc5T1);
-    mark(kRc5T1);
+      queueSpace(kRc5T1);
+    queueMark(kRc5T1);
     // Field/Second start bit.
     if (field_bit) {  // Send a 1. Normal for RC-5.
-      space(kRc5T1);
-      mark(kRc5T1);
+      queueSpace(kRc5T1);
+      queueMark(kRc5T1);
     } else {  // Send a 0. Special case for RC-5X. Means 7th command bit is 1.
-      mark(kRc5T1);
-      space(kRc5T1);
+      queueMark(kRc5T1);
+      queueSpace(kRc5T1);
     }
 
     // Data
     for (uint64_t mask = 1ULL << (nbits - 1); mask; mask >>= 1)
-      if (data & mask) {  // 1
-        space(kRc5T1);    // 1 is space, then mark.
-        mark(kRc5T1);
-      } else {         // 0
-        mark(kRc5T1);  // 0 is mark, then space.
-        space(kRc5T1);
+      if (data & mask) {     // 1
+        queueSpace(kRc5T1);  // 1 is space, then mark.
+        queueMark(kRc5T1);
+      } else {              // 0
+        queueMark(kRc5T1);  // 0 is mark, then space.
+        queueSpace(kRc5T1);
       }
     // Footer
-    space(std::max(kRc5MinGap, kRc5MinCommandLength - usecTimer.elapsed()));
+    // Include any trailing space we haven't sent yet.
+    const uint32_t queued = flushQueuedMark();
+    const uint32_t elapsed = usecTimer.elapsed() + queued;
+    queueSpace(std::max(kRc5MinGap, kRc5MinCommandLength - elapsed));
+    flushQueued();
   }
 }
 
-/// Encode a Philips RC-5 data message.
-/// Status: Beta / Should be working.
-/// @param[in] address The 5-bit address value for the message.
-/// @param[in] command The 6-bit command value for the message.
-/// @param[in] key_released Indicate if the remote key has been released.
-/// @return A message suitable for use in sendRC5().
-uint16_t IRsend::encodeRC5(const uint8_t address, const uint8_t command,
-                           const bool key_released) {
-  return (key_released << (kRC5Bits - 1)) | ((address & 0x1f) << 6) |
-         (command & 0x3F);
-}
-
-/// Encode a Philips RC-5X data message.
-/// Status: Beta / Should be working.
-/// @param[in] address The 5-bit address value for the message.
-/// @param[in] command The 7-bit command value for the message.
-/// @param[in] key_released Indicate if the remote key has been released.
-/// @return A message suitable for use in sendRC5().
-uint16_t IRsend::encodeRC5X(const uint8_t address, const uint8_t command,
-                            const bool key_released) {
-  // The 2nd start/field bit (MSB of the return value) is the value of the 7th
-  // command bit.
-  bool s2 = (command >> 6) & 1;
-  return ((uint16_t)s2 << (kRC5XBits - 1)) |
-         encodeRC5(address, command, key_released);
-}
-
 /// Flip the toggle bit of a Philips RC-5/RC-5X data message.
 /// Used to indicate a change of remote button's state.
 /// Status: STABLE.
@@ -159,27 +136,6 @@ uint64_t IRsend::toggleRC6(const uint64_t data, const uint16_t nbits) {
   return data ^ kRc6ToggleMask;
 }
 
-/// Encode a Philips RC-6 data message.
-/// Status: Beta / Should be working.
-/// @param[in] address The address (aka. control) value for the message.
-///   Includes the field/mode/toggle bits.
-/// @param[in] command The 8-bit command value for the message.
-///   (aka. information)
-/// @param[in] mode Which protocol to use.
-///   Defined by nr. of bits in the protocol.
-/// @return A data message suitable for use in `sendRC6()`.
-uint64_t IRsend::encodeRC6(const uint32_t address, const uint8_t command,
-                           const uint16_t mode) {
-  switch (mode) {
-    case kRC6Mode0Bits:
-      return ((address & 0xFFF) << 8) | (command & 0xFF);
-    case kRC6_36Bits:
-      return ((uint64_t)(address & 0xFFFFFFF) << 8) | (command & 0xFF);
-    default:
-      return 0;
-  }
-}
-
 /// Send a Philips RC-6 packet.
 /// Status: Stable.
 /// @note Caller needs to take care of flipping the toggle bit (The 4th Most
@@ -195,11 +151,11 @@ void IRsend::sendRC6(const uint64_t data, const uint16_t nbits,
   enableIROut(36, 33);
   for (uint16_t r = 0; r <= repeat; r++) {
     // Header
-    mark(kRc6HdrMark);
-    space(kRc6HdrSpace);
+    queueMark(kRc6HdrMark);
+    queueSpace(kRc6HdrSpace);
     // Start bit.
-    mark(kRc6Tick);  // mark, then space == 0x1.
-    space(kRc6Tick);
+    queueMark(kRc6Tick);  // mark, then space == 0x1.
+    queueSpace(kRc6Tick);
     // Data
     uint16_t bitTime;
     for (uint64_t i = 1, mask = 1ULL << (nbits - 1); mask; i++, mask >>= 1) {
@@ -208,15 +164,16 @@ void IRsend::sendRC6(const uint64_t data, const uint16_t nbits,
       else
         bitTime = kRc6Tick;  // Normal bit
       if (data & mask) {     // 1
-        mark(bitTime);
-        space(bitTime);
+        queueMark(bitTime);
+        queueSpace(bitTime);
       } else {  // 0
-        space(bitTime);
-        mark(bitTime);
+        queueSpace(bitTime);
+        queueMark(bitTime);
       }
     }
     // Footer
-    space(kRc6RptLength);
+    queueSpace(kRc6RptLength);
+    flushQueued();
   }
 }
 #endif  // SEND_RC6
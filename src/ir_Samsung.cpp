@@ -87,18 +87,6 @@ void IRsend::sendSAMSUNG(const uint64_t data, const uint16_t nbits,
               nbits, 38, true, repeat, 33);
 }
 
-/// Construct a raw Samsung message from the supplied customer(address) &
-/// command.
-/// Status: STABLE / Should be working.
-/// @param[in] customer The customer code. (aka. Address)
-/// @param[in] command The command code.
-/// @return A raw 32-bit Samsung message suitable for `sendSAMSUNG()`.
-uint32_t IRsend::encodeSAMSUNG(const uint8_t customer, const uint8_t command) {
-  uint8_t revcustomer = reverseBits(customer, sizeof(customer) * 8);
-  uint8_t revcommand = reverseBits(command, sizeof(command) * 8);
-  return ((revcommand ^ 0xFF) | (revcommand << 8) | (revcustomer << 16) |
-          (revcustomer << 24));
-}
 #endif
 
 #if DECODE_SAMSUNG
@@ -83,38 +83,6 @@ void IRsend::sendSharpRaw(const uint64_t data, const uint16_t nbits,
   }
 }
 
-/// Encode a (raw) Sharp message from it's components.
-/// Status: STABLE / Works okay.
-/// @param[in] address The value of the address to be sent.
-/// @param[in] command The value of the address to be sent. (8 bits)
-/// @param[in] expansion The value of the expansion bit to use.
-///   (0 or 1, typically 1)
-/// @param[in] check The value of the check bit to use. (0 or 1, typically 0)
-/// @param[in] MSBfirst Flag indicating MSB first or LSB first order.
-/// @return A uint32_t containing the raw Sharp message for `sendSharpRaw()`.
-/// @note Assumes the standard Sharp bit sizes.
-///   Historically sendSharp() sends address & command in
-///   MSB first order. This is actually incorrect. It should be sent in LSB
-///   order. The behaviour of sendSharp() hasn't been changed to maintain
-///   backward compatibility.
-uint32_t IRsend::encodeSharp(const uint16_t address, const uint16_t command,
-                             const uint16_t expansion, const uint16_t check,
-                             const bool MSBfirst) {
-  // Mask any unexpected bits.
-  uint16_t tempaddress = GETBITS16(address, 0, kSharpAddressBits);
-  uint16_t tempcommand = GETBITS16(command, 0, kSharpCommandBits);
-  uint16_t tempexpansion = GETBITS16(expansion, 0, 1);
-  uint16_t tempcheck = GETBITS16(check, 0, 1);
-
-  if (!MSBfirst) {  // Correct bit order if needed.
-    tempaddress = reverseBits(tempaddress, kSharpAddressBits);
-    tempcommand = reverseBits(tempcommand, kSharpCommandBits);
-  }
-  // Concatenate all the bits.
-  return (tempaddress << (kSharpCommandBits + 2)) | (tempcommand << 2) |
-         (tempexpansion << 1) | tempcheck;
-}
-
 /// Send a Sharp message
 /// Status:  DEPRECATED / Previously working fine.
 /// @deprecated Only use this if you are using legacy from the original
@@ -78,33 +78,6 @@ void IRsend::_sendSony(const uint64_t data, const uint16_t nbits,
               kSonyMinGap, kSonyRptLength, data, nbits, freq, true, repeat, 33);
 }
 
-/// Convert Sony/SIRC command, address, & extended bits into sendSony format.
-/// Status: STABLE / Should be working.
-/// @param[in] nbits Sony protocol bit size.
-/// @param[in] command Sony command bits.
-/// @param[in] address Sony address bits.
-/// @param[in] extended Sony extended bits.
-/// @return A `sendSony()` etc compatible data message.
-uint32_t IRsend::encodeSony(const uint16_t nbits, const uint16_t command,
-                            const uint16_t address, const uint16_t extended) {
-  uint32_t result = 0;
-  switch (nbits) {
-    case 12:  // 5 address bits.
-      result = address & 0x1F;
-      break;
-    case 15:  // 8 address bits.
-      result = address & 0xFF;
-      break;
-    case 20:  // 5 address bits, 8 extended bits.
-      result = address & 0x1F;
-      result |= (extended & 0xFF) << 5;
-      break;
-    default:
-      return 0;  // This is not an expected Sony bit size/protocol.
-  }
-  result = (result << 7) | (command & 0x7F);  // All sizes have 7 command bits.
-  return reverseBits(result, nbits);  // sendSony uses reverse ordered bits.
-}
 #endif  // SEND_SONY
 
 #if DECODE_SONY
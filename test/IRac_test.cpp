@@ -2251,6 +2251,139 @@ TEST(TestIRac, handleToggles) {
   ASSERT_NE(stdAc::swingv_t::kOff, result.swingv);  // i.e A toggle.
 }
 
+TEST(TestIRac, diffStates) {
+  stdAc::state_t a, b;
+  IRac::initState(&a);
+  b = a;
+  EXPECT_EQ(0, IRac::diffStates(a, b));
+  b.clock = 1234;  // Unlike cmpStates(), the clock is compared.
+  EXPECT_EQ(kAcFieldClock, IRac::diffStates(a, b));
+  b.power = !a.power;
+  b.swingh = stdAc::swingh_t::kAuto;
+  EXPECT_EQ(kAcFieldClock | kAcFieldPower | kAcFieldSwingh,
+            IRac::diffStates(a, b));
+  EXPECT_EQ(IRac::diffStates(a, b), IRac::diffStates(b, a));
+}
+
+TEST(TestIRac, getCapabilities) {
+  stdAc::capabilities_t caps;
+  // Not an A/C protocol.
+  EXPECT_FALSE(IRac::getCapabilities(decode_type_t::NEC, kAcAnyModel, &caps));
+  // Every protocol IRac supports should have an entry.
+  for (int i = 0; i <= kLastDecodeType; i++) {
+    const decode_type_t protocol = (decode_type_t)i;
+    EXPECT_EQ(IRac::isProtocolSupported(protocol),
+              IRac::getCapabilities(protocol, kAcAnyModel, &caps))
+        << "Protocol: " << typeToString(protocol);
+  }
+
+  ASSERT_TRUE(IRac::getCapabilities(decode_type_t::AIRWELL, kAcAnyModel,
+                                    &caps));
+  EXPECT_EQ(decode_type_t::AIRWELL, caps.protocol);
+  EXPECT_EQ(kAcFieldProtocol | kAcFieldPower | kAcFieldMode |
+            kAcFieldDegrees | kAcFieldCelsius | kAcFieldFanspeed, caps.fields);
+  EXPECT_EQ(kAirwellMinTemp, caps.minTemp);
+  EXPECT_EQ(kAirwellMaxTemp, caps.maxTemp);
+
+  // Protocols that use the model report it, and keep the model asked for.
+  ASSERT_TRUE(IRac::getCapabilities(decode_type_t::FUJITSU_AC,
+                                    fujitsu_ac_remote_model_t::ARREB1E,
+                                    &caps));
+  EXPECT_TRUE(caps.fields & kAcFieldModel);
+  EXPECT_EQ(fujitsu_ac_remote_model_t::ARREB1E, caps.model);
+  ASSERT_TRUE(IRac::getCapabilities(decode_type_t::DAIKIN128, kAcAnyModel,
+                                    &caps));
+  EXPECT_FALSE(caps.fields & kAcFieldModel);
+  EXPECT_TRUE(caps.fields & kAcFieldClock);
+  EXPECT_FALSE(caps.fields & kAcFieldSwingh);
+  EXPECT_EQ(kDaikin128MinTemp, caps.minTemp);
+  EXPECT_EQ(kDaikin128MaxTemp, caps.maxTemp);
+}
+
+TEST(TestIRac, applyUpdate) {
+  IRac irac(kGpioUnused);
+  IRac::initState(&irac.next);
+  irac.next.protocol = decode_type_t::AIRWELL;
+  irac.next.power = true;
+  const stdAc::state_t before = irac.next;
+  stdAc::update_t update;
+  update.values = irac.next;
+
+  // Nothing asked for, nothing changes.
+  update.fields = 0;
+  EXPECT_EQ(0, irac.applyUpdate(update));
+  // Asking for the current values changes nothing.
+  update.fields = kAcFieldAll;
+  EXPECT_EQ(0, irac.applyUpdate(update));
+  // Airwell has no turbo or swing settings, so they are ignored.
+  update.values.turbo = true;
+  update.values.swingv = stdAc::swingv_t::kHigh;
+  update.fields = kAcFieldTurbo | kAcFieldSwingv;
+  EXPECT_EQ(0, irac.applyUpdate(update));
+  EXPECT_FALSE(IRac::cmpStates(before, irac.next));
+  // Only the fields in the mask are applied.
+  update.values.degrees = 21;
+  update.values.power = false;
+  update.fields = kAcFieldDegrees | kAcFieldTurbo;
+  EXPECT_EQ(kAcFieldDegrees, irac.applyUpdate(update));
+  EXPECT_EQ(21, irac.next.degrees);
+  EXPECT_TRUE(irac.next.power);
+  EXPECT_FALSE(irac.next.turbo);
+  // Temperatures are limited to what the protocol can do.
+  update.values.degrees = 99;
+  update.fields = kAcFieldDegrees;
+  EXPECT_EQ(kAcFieldDegrees, irac.applyUpdate(update));
+  EXPECT_EQ(kAirwellMaxTemp, irac.next.degrees);
+  // So asking for even more is a no-op.
+  update.values.degrees = 100;
+  EXPECT_EQ(0, irac.applyUpdate(update));
+  // Also in Fahrenheit.
+  update.values.celsius = false;
+  update.values.degrees = 0;
+  update.fields = kAcFieldDegrees | kAcFieldCelsius;
+  EXPECT_EQ(kAcFieldDegrees | kAcFieldCelsius, irac.applyUpdate(update));
+  EXPECT_FALSE(irac.next.celsius);
+  EXPECT_NEAR(celsiusToFahrenheit(kAirwellMinTemp), irac.next.degrees, 0.01);
+
+  // Changing the protocol uses the new protocol's capabilities.
+  update.values.protocol = decode_type_t::COOLIX;
+  update.values.turbo = true;
+  update.fields = kAcFieldProtocol | kAcFieldTurbo;
+  EXPECT_EQ(kAcFieldProtocol | kAcFieldTurbo, irac.applyUpdate(update));
+  EXPECT_EQ(decode_type_t::COOLIX, irac.next.protocol);
+  EXPECT_TRUE(irac.next.turbo);
+  // An unsupported protocol is rejected outright.
+  update.values.protocol = decode_type_t::NEC;
+  update.fields = kAcFieldProtocol | kAcFieldPower;
+  EXPECT_EQ(0, irac.applyUpdate(update));
+  EXPECT_EQ(decode_type_t::COOLIX, irac.next.protocol);
+}
+
+TEST(TestIRac, sendUpdate) {
+  IRac irac(kGpioUnused);
+  IRac::initState(&irac.next);
+  irac.next.protocol = decode_type_t::AIRWELL;
+  irac.next.power = true;
+  irac.next.degrees = 20;
+  irac.markAsSent();
+
+  stdAc::update_t update;
+  update.values = irac.next;
+  // An unsupported setting shouldn't result in a message.
+  update.values.quiet = true;
+  update.fields = kAcFieldQuiet;
+  EXPECT_FALSE(irac.sendUpdate(update));
+  EXPECT_FALSE(irac.hasStateChanged());
+  // A supported one should, and be remembered as sent.
+  update.values.degrees = 25;
+  update.fields = kAcFieldDegrees;
+  EXPECT_TRUE(irac.sendUpdate(update));
+  EXPECT_FALSE(irac.hasStateChanged());
+  EXPECT_EQ(25, irac.getStatePrev().degrees);
+  // Sending it again does nothing.
+  EXPECT_FALSE(irac.sendUpdate(update));
+}
+
 TEST(TestIRac, strToBool) {
   EXPECT_TRUE(IRac::strToBool("ON"));
   EXPECT_TRUE(IRac::strToBool("1"));
@@ -0,0 +1,204 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "IRcapture.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRCaptureDriver classes.
+
+// A NEC message (0x00FF00FF) as captured, without the trailing gap.
+const uint16_t kNecCapture[67] = {
+    9000, 4500, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560,
+    560, 560, 560, 560, 560, 1690, 560, 1690, 560, 1690, 560, 1690, 560, 1690,
+    560, 1690, 560, 1690, 560, 1690, 560, 560, 560, 560, 560, 560, 560, 560,
+    560, 560, 560, 560, 560, 560, 560, 560, 560, 1690, 560, 1690, 560, 1690,
+    560, 1690, 560, 1690, 560, 1690, 560, 1690, 560, 1690, 560};
+// A NEC repeat message, as captured.
+const uint16_t kNecRepeatCapture[3] = {9000, 2250, 560};
+
+TEST(TestIRCapture, NoDriverByDefaultWhenTesting) {
+  IRrecv irrecv(1);
+  EXPECT_EQ(NULL, irrecv.getCaptureDriver());
+}
+
+TEST(TestIRCapture, MockDriverDeliversAFrame) {
+  IRMockCaptureDriver mock;
+  IRrecv irrecv(1);
+  decode_results results;
+
+  irrecv.setCaptureDriver(&mock);
+  EXPECT_EQ(&mock, irrecv.getCaptureDriver());
+  mock.addFrame(kNecCapture, 67);
+  // Not started, so nothing should be delivered.
+  EXPECT_FALSE(irrecv.decode(&results));
+  EXPECT_EQ(1, mock.framesPending());
+
+  irrecv.enableIRIn();
+  EXPECT_TRUE(mock.isRunning());
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(0, mock.framesPending());
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(kNECBits, results.bits);
+  EXPECT_EQ(0x00FF00FF, results.value);
+  EXPECT_EQ(68, results.rawlen);
+  EXPECT_FALSE(results.overflow);
+  // Delivered in blocks of kCaptureBlockSize.
+  EXPECT_EQ(2, mock.getBlocksDelivered());
+
+  // Nothing left to decode.
+  irrecv.resume();
+  EXPECT_FALSE(irrecv.decode(&results));
+  irrecv.disableIRIn();
+  EXPECT_FALSE(mock.isRunning());
+}
+
+TEST(TestIRCapture, SmallBlocks) {
+  IRMockCaptureDriver mock(8);
+  IRrecv irrecv(1);
+  decode_results results;
+
+  irrecv.setCaptureDriver(&mock);
+  irrecv.enableIRIn();
+  mock.addFrame(kNecCapture, 67);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x00FF00FF, results.value);
+  EXPECT_EQ(9, mock.getBlocksDelivered());  // ceil(67 / 8)
+}
+
+TEST(TestIRCapture, WaitsForResume) {
+  IRMockCaptureDriver mock;
+  IRrecv irrecv(1);
+  decode_results results;
+
+  irrecv.setCaptureDriver(&mock);
+  irrecv.enableIRIn();
+  mock.addFrame(kNecCapture, 67);
+  mock.addFrame(kNecRepeatCapture, 3);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(1, mock.framesPending());
+  // The first message hasn't been released yet, so the second must wait.
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(1, mock.framesPending());
+  irrecv.resume();
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(0, mock.framesPending());
+  EXPECT_TRUE(results.repeat);
+  EXPECT_EQ(4, results.rawlen);
+}
+
+TEST(TestIRCapture, SaveBufferResumesAutomatically) {
+  IRMockCaptureDriver mock;
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  decode_results results;
+
+  irrecv.setCaptureDriver(&mock);
+  irrecv.enableIRIn();
+  mock.addFrame(kNecCapture, 67);
+  mock.addFrame(kNecCapture, 67);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0, mock.framesPending());
+  EXPECT_FALSE(irrecv.decode(&results));
+}
+
+TEST(TestIRCapture, Overflow) {
+  IRMockCaptureDriver mock(7);
+  IRrecv irrecv(1, 20);
+  decode_results results;
+
+  irrecv.setCaptureDriver(&mock);
+  irrecv.enableIRIn();
+  mock.addFrame(kNecCapture, 67);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_TRUE(results.overflow);
+  EXPECT_EQ(20, results.rawlen);
+}
+
+TEST(TestIRCapture, LoadString) {
+  IRMockCaptureDriver mock;
+  IRrecv irrecv(1);
+  decode_results results;
+
+  std::stringstream text;
+  text << "# Two messages. The 2nd is a NEC repeat code." << std::endl;
+  for (uint16_t i = 0; i < 67; i++) {
+    text << kNecCapture[i];
+    // Mix up the separators & line endings.
+    if (i % 10 == 9)
+      text << "  # A comment.\n";
+    else if (i % 2)
+      text << ", ";
+    else
+      text << " ";
+  }
+  text << std::endl << std::endl << std::endl << "9000, 2250, 560";
+  EXPECT_EQ(2, mock.loadString(text.str()));
+  EXPECT_EQ(2, mock.framesPending());
+  irrecv.setCaptureDriver(&mock);
+  irrecv.enableIRIn();
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x00FF00FF, results.value);
+  EXPECT_FALSE(results.repeat);
+  irrecv.resume();
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_TRUE(results.repeat);
+}
+
+TEST(TestIRCapture, LoadFile) {
+  IRMockCaptureDriver mock;
+  IRrecv irrecv(1);
+  decode_results results;
+  const std::string filename = "IRcapture_test.tmp";
+
+  EXPECT_FALSE(mock.loadFile("this_file_does_not_exist.txt"));
+  std::ofstream file(filename.c_str());
+  for (uint16_t i = 0; i < 67; i++) file << kNecCapture[i] << ", ";
+  file << std::endl;
+  file.close();
+  EXPECT_TRUE(mock.loadFile(filename));
+  std::remove(filename.c_str());
+  EXPECT_EQ(1, mock.framesPending());
+
+  irrecv.setCaptureDriver(&mock);
+  irrecv.enableIRIn();
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x00FF00FF, results.value);
+}
+
+TEST(TestIRCapture, SentMessageRoundTrip) {
+  IRsendTest irsend(0);
+  IRMockCaptureDriver mock;
+  IRrecv irrecv(1);
+  decode_results results;
+
+  irsend.begin();
+  irsend.reset();
+  irsend.sendSony(0x240, kSony12Bits, 0);
+  uint16_t frame[OUTPUT_BUF];
+  for (uint16_t i = 0; i <= irsend.last; i++)
+    frame[i] = std::min(irsend.output[i], (uint32_t)UINT16_MAX);
+  mock.addFrame(frame, irsend.last + 1);
+  irrecv.setCaptureDriver(&mock);
+  irrecv.enableIRIn();
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(SONY, results.decode_type);
+  EXPECT_EQ(kSony12Bits, results.bits);
+  EXPECT_EQ(0x240, results.value);
+}
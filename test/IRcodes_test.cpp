@@ -0,0 +1,317 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include "IRcodes.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRCodeStore class.
+
+// A local stand-in for an MQTT broker. Every node hears every message
+// (including its own), & new subscribers get the retained messages.
+class FakeCodeBroker {
+ public:
+  FakeCodeBroker(void) : now(0), drop_next(0) {}
+  void join(IRCodeStore *node) {
+    nodes.push_back(node);
+    node->setPublisher(publish, this);
+    for (std::map<std::string, std::string>::iterator it = retained.begin();
+         it != retained.end(); it++)
+      node->handleMessage(it->first.c_str(), it->second.c_str(), now);
+  }
+  static bool publish(const char *topic, const char *payload,
+                      const bool retain, void *arg) {
+    FakeCodeBroker *broker = static_cast<FakeCodeBroker *>(arg);
+    std::string kind = topic;
+    kind = kind.substr(kind.find('/') + 1);
+    kind = kind.substr(0, kind.find('/'));
+    broker->published[kind]++;
+    if (broker->drop_next) {  // Lost in transit.
+      broker->drop_next--;
+      return true;
+    }
+    if (retain) broker->retained[topic] = payload;
+    for (uint16_t i = 0; i < broker->nodes.size(); i++)
+      broker->nodes[i]->handleMessage(topic, payload, broker->now);
+    return true;
+  }
+  void pollAll(const uint32_t now_ms) {
+    now = now_ms;
+    for (uint16_t i = 0; i < nodes.size(); i++) nodes[i]->poll(now);
+  }
+  // Run the fleet in 100ms steps until they all agree, or we give up.
+  bool converge(const uint32_t max_ms = 60000) {
+    for (const uint32_t end = now + max_ms; now < end;) {
+      pollAll(now + 100);
+      bool done = true;
+      for (uint16_t i = 1; i < nodes.size() && done; i++)
+        done = nodes[i]->getDigest() == nodes[0]->getDigest() &&
+            !nodes[i]->getPending();
+      if (done) return true;
+    }
+    return false;
+  }
+  std::vector<IRCodeStore *> nodes;
+  std::map<std::string, std::string> retained;
+  std::map<std::string, uint32_t> published;  ///< Messages, by kind.
+  uint32_t now;  ///< The time, as far as the nodes are concerned.
+  uint16_t drop_next;  ///< Nr. of messages to lose.
+};
+
+const uint16_t kNecPower[71] = {
+    9000, 4500, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560,
+    560, 560, 560, 560, 560, 1690, 560, 1690, 560, 1690, 560, 1690, 560, 1690,
+    560, 1690, 560, 1690, 560, 1690, 560, 560, 560, 560, 560, 1690, 560, 560,
+    560, 560, 560, 560, 560, 560, 560, 560, 560, 1690, 560, 1690, 560, 560,
+    560, 1690, 560, 1690, 560, 1690, 560, 1690, 560, 1690, 560, 40000, 9000,
+    2250, 560};
+const uint16_t kShort[5] = {2400, 600, 1200, 600, 600};
+
+TEST(TestIRCodeStore, AddAndFind) {
+  IRCodeStore store("node", "codes", 3);
+  EXPECT_EQ(0, store.count());
+  const uint64_t power = store.add("power", kNecPower, 71, 38000);
+  ASSERT_NE(kCodeNoId, power);
+  EXPECT_EQ(1, store.count());
+  // Adding the same code again (even by another name) doesn't duplicate it.
+  EXPECT_EQ(power, store.add("again", kNecPower, 71, 38000));
+  EXPECT_EQ(1, store.count());
+  // The frequency is part of the code.
+  const uint64_t power40 = store.add("power", kNecPower, 71, 40000);
+  EXPECT_NE(power, power40);
+  const uint64_t sony = store.add("sony", kShort, 5, 40000);
+  EXPECT_EQ(3, store.count());
+  // Full.
+  EXPECT_EQ(kCodeNoId, store.add("full", kShort, 4, 40000));
+  // Name too long.
+  EXPECT_EQ(kCodeNoId, store.add("0123456789012345678901234567890123",
+                                 kShort, 3, 38000));
+  // Kept in id order.
+  EXPECT_LT(store.getId(0), store.getId(1));
+  EXPECT_LT(store.getId(1), store.getId(2));
+  EXPECT_EQ(kCodeNoId, store.getId(3));
+  const int16_t index = store.find(sony);
+  ASSERT_GE(index, 0);
+  EXPECT_STREQ("sony", store.getName(index));
+  EXPECT_EQ(40000, store.getHz(index));
+  EXPECT_EQ(index, store.findName("sony"));
+  EXPECT_EQ(-1, store.findName("nope"));
+  EXPECT_EQ(-1, store.find(12345));
+  // The timings come back the same.
+  uint16_t raw[71];
+  const int16_t power_index = store.find(power);
+  EXPECT_EQ(71, store.getRaw(power_index, NULL, 0));
+  EXPECT_EQ(71, store.getRaw(power_index, raw, 71));
+  for (uint16_t i = 0; i < 71; i++) EXPECT_EQ(kNecPower[i], raw[i]);
+  // Remove one.
+  EXPECT_TRUE(store.remove(power40));
+  EXPECT_FALSE(store.remove(power40));
+  EXPECT_EQ(2, store.count());
+  EXPECT_EQ(-1, store.find(power40));
+  EXPECT_GE(store.find(power), 0);
+  EXPECT_GE(store.find(sony), 0);
+}
+
+TEST(TestIRCodeStore, Ids) {
+  uint8_t packed[kCodeMaxBytes];
+  const uint16_t nbytes = packRawData(kNecPower, 71, packed, kCodeMaxBytes);
+  const uint64_t id = IRCodeStore::hash(packed, nbytes, 38000);
+  EXPECT_EQ(id, IRCodeStore::hash(packed, nbytes, 38000));
+  EXPECT_NE(id, IRCodeStore::hash(packed, nbytes, 38001));
+  packed[nbytes - 1]++;
+  EXPECT_NE(id, IRCodeStore::hash(packed, nbytes, 38000));
+  EXPECT_EQ("0000000000000001", IRCodeStore::idToString(1));
+  EXPECT_EQ("0123456789ABCDEF", IRCodeStore::idToString(0x0123456789ABCDEF));
+  EXPECT_EQ(0x0123456789ABCDEF,
+            IRCodeStore::idFromString("0123456789abcdef"));
+  EXPECT_EQ(0xABC, IRCodeStore::idFromString("ABC"));
+  EXPECT_EQ(kCodeNoId, IRCodeStore::idFromString("0123456789abcdef0"));
+  EXPECT_EQ(kCodeNoId, IRCodeStore::idFromString("12g"));
+  EXPECT_EQ(kCodeNoId, IRCodeStore::idFromString(""));
+  EXPECT_EQ(kCodeNoId, IRCodeStore::idFromString(NULL));
+}
+
+TEST(TestIRCodeStore, ManifestAndMissing) {
+  IRCodeStore a("a", "codes", 4);
+  IRCodeStore b("b", "codes", 4);
+  EXPECT_EQ("0:0000000000000000:", a.getManifest());
+  const uint64_t power = a.add("power", kNecPower, 71, 38000);
+  const uint64_t sony = a.add("sony", kShort, 5, 40000);
+  // The same codes, added in another order, have the same digest.
+  b.add("sony", kShort, 5, 40000);
+  EXPECT_NE(a.getDigest(), b.getDigest());
+  b.add("power", kNecPower, 71, 38000);
+  EXPECT_EQ(a.getDigest(), b.getDigest());
+  EXPECT_EQ(a.getManifest(), b.getManifest());
+  EXPECT_EQ("2:" + IRCodeStore::idToString(power + sony) + ':' +
+            IRCodeStore::idToString(std::min(power, sony)) + ',' +
+            IRCodeStore::idToString(std::max(power, sony)),
+            a.getManifest());
+  EXPECT_EQ(0, b.getMissing(a.getManifest().c_str(), NULL, 0));
+  // What is the other one missing?
+  b.remove(power);
+  const uint64_t other = b.add("other", kShort, 4, 38000);
+  uint64_t ids[2] = {0, 0};
+  EXPECT_EQ(1, b.getMissing(a.getManifest().c_str(), ids, 2));
+  EXPECT_EQ(power, ids[0]);
+  EXPECT_EQ(1, a.getMissing(b.getManifest().c_str(), ids, 2));
+  EXPECT_EQ(other, ids[0]);
+  // Only room for some of them.
+  IRCodeStore empty("c", "codes", 4);
+  ids[1] = 0;
+  EXPECT_EQ(2, empty.getMissing(a.getManifest().c_str(), ids, 1));
+  EXPECT_EQ(0, ids[1]);
+  // Junk.
+  EXPECT_EQ(0, empty.getMissing("", ids, 2));
+  EXPECT_EQ(0, empty.getMissing("2:", ids, 2));
+  EXPECT_EQ(0, empty.getMissing("x:0:1", ids, 2));
+  EXPECT_EQ(0, empty.getMissing(NULL, ids, 2));
+}
+
+TEST(TestIRCodeStore, ExportAndImport) {
+  IRCodeStore a("a", "codes", 4);
+  IRCodeStore b("b", "codes", 4);
+  const uint64_t id = a.add("tv power", kShort, 5, 40000);
+  const String text = a.exportCode(id);
+  EXPECT_EQ(IRCodeStore::idToString(id) + ",40000,C025B009DF1200AF09,"
+            "tv power", text);
+  EXPECT_EQ("", a.exportCode(id + 1));
+  EXPECT_EQ(id, b.importCode(text.c_str()));
+  EXPECT_EQ(1, b.count());
+  EXPECT_STREQ("tv power", b.getName(0));
+  EXPECT_EQ(a.getDigest(), b.getDigest());
+  EXPECT_EQ(1, b.getStats().codes_added);
+  // Importing it again changes nothing.
+  EXPECT_EQ(id, b.importCode(text.c_str()));
+  EXPECT_EQ(1, b.count());
+  EXPECT_EQ(1, b.getStats().codes_added);
+  // Tampered with, or corrupted.
+  IRCodeStore c("c", "codes", 4);
+  String bad = text;
+  const size_t timings = bad.find(',', bad.find(',') + 1) + 1;
+  bad[timings] = (bad[timings] == '0') ? '1' : '0';
+  EXPECT_EQ(kCodeNoId, c.importCode(bad.c_str()));
+  EXPECT_EQ(1, c.getStats().codes_rejected);
+  EXPECT_EQ(0, c.count());
+  EXPECT_EQ(kCodeNoId, c.importCode(""));
+  EXPECT_EQ(kCodeNoId, c.importCode(NULL));
+  EXPECT_EQ(kCodeNoId, c.importCode("1,38000,e02,x"));
+  EXPECT_EQ(kCodeNoId, c.importCode("1,38000,e025"));
+  EXPECT_EQ(kCodeNoId, c.importCode("1,,e025,x"));
+  EXPECT_EQ(1, c.getStats().codes_rejected);  // Only the bad hash counts.
+}
+
+TEST(TestIRCodeStore, Send) {
+  IRsendTest irsend(0);
+  IRsendTest expected(0);
+  irsend.begin();
+  expected.begin();
+  IRCodeStore store("node", "codes", 2);
+  const uint64_t id = store.add("power", kNecPower, 71, 38);
+  EXPECT_TRUE(store.send(&irsend, id));
+  expected.sendRaw(kNecPower, 71, 38);
+  EXPECT_EQ(expected.outputStr(), irsend.outputStr());
+  EXPECT_FALSE(store.send(&irsend, id + 1));
+  EXPECT_FALSE(store.send(NULL, id));
+}
+
+// A hundred nodes. One learns some codes, & they spread to all the others
+// for about one message per code.
+TEST(TestIRCodeStore, FleetConverges) {
+  FakeCodeBroker broker;
+  std::vector<IRCodeStore *> nodes;
+  for (uint16_t i = 0; i < 100; i++) {
+    nodes.push_back(new IRCodeStore(("node" + std::to_string(i)).c_str(),
+                                    "codes", 8));
+    broker.join(nodes[i]);
+  }
+  EXPECT_TRUE(broker.converge());
+  EXPECT_EQ(100, broker.published["manifest"]);
+  EXPECT_EQ(0, broker.published["want"]);
+  EXPECT_EQ(0, broker.published["code"]);
+
+  broker.published.clear();
+  nodes[42]->add("power", kNecPower, 71, 38000);
+  nodes[42]->add("input", kShort, 5, 38000);
+  nodes[42]->add("mute", kShort, 3, 38000);
+  EXPECT_TRUE(broker.converge());
+  for (uint16_t i = 0; i < 100; i++) {
+    EXPECT_EQ(3, nodes[i]->count());
+    EXPECT_EQ(nodes[42]->getDigest(), nodes[i]->getDigest());
+  }
+  // Each code was only sent once, & only a few nodes had to ask for them.
+  EXPECT_EQ(3, broker.published["code"]);
+  EXPECT_GE(3, broker.published["want"]);
+  EXPECT_EQ(100, broker.published["manifest"]);
+  uint32_t suppressed = 0;
+  for (uint16_t i = 0; i < 100; i++)
+    suppressed += nodes[i]->getStats().wants_suppressed;
+  EXPECT_LT(250, suppressed);
+
+  // Two nodes learn different codes at the same time.
+  broker.published.clear();
+  const uint64_t a = nodes[1]->add("a", kShort, 4, 36000);
+  const uint64_t b = nodes[2]->add("b", kShort, 4, 56000);
+  EXPECT_TRUE(broker.converge());
+  for (uint16_t i = 0; i < 100; i++) {
+    EXPECT_EQ(5, nodes[i]->count());
+    EXPECT_GE(nodes[i]->find(a), 0);
+    EXPECT_GE(nodes[i]->find(b), 0);
+  }
+  EXPECT_EQ(2, broker.published["code"]);
+
+  // A new node picks everything up from the retained manifests.
+  broker.published.clear();
+  IRCodeStore late("late", "codes", 8);
+  broker.join(&late);
+  EXPECT_EQ(5, late.getPending());
+  EXPECT_TRUE(broker.converge());
+  EXPECT_EQ(5, late.count());
+  EXPECT_EQ(5, broker.published["code"]);
+  EXPECT_EQ(1, broker.published["want"]);
+  for (uint16_t i = 0; i < 100; i++) delete nodes[i];
+}
+
+// Lost messages are recovered from.
+TEST(TestIRCodeStore, LostMessages) {
+  FakeCodeBroker broker;
+  IRCodeStore a("a", "codes", 4);
+  IRCodeStore b("b", "codes", 4);
+  broker.join(&a);
+  broker.join(&b);
+  EXPECT_TRUE(broker.converge());
+  a.add("power", kNecPower, 71, 38000);
+  broker.pollAll(broker.now + kCodeSyncJitterMs);  // a's new manifest.
+  EXPECT_EQ(1, b.getPending());
+  // b's request goes missing.
+  broker.drop_next = 1;
+  broker.pollAll(broker.now + kCodeSyncJitterMs);
+  EXPECT_EQ(1, broker.published["want"]);
+  EXPECT_EQ(0, broker.published["code"]);
+  EXPECT_EQ(0, b.count());
+  // So it asks again later, & gets it.
+  EXPECT_TRUE(broker.converge());
+  EXPECT_EQ(2, broker.published["want"]);
+  EXPECT_EQ(1, broker.published["code"]);
+  EXPECT_EQ(1, b.count());
+
+  // A manifest going missing is fixed by the periodic re-publishing.
+  IRCodeStore c("c", "codes", 4, 32, 60000);
+  IRCodeStore d("d", "codes", 4, 32, 60000);
+  FakeCodeBroker broker2;
+  broker2.join(&c);
+  broker2.join(&d);
+  broker2.pollAll(0);
+  c.add("power", kNecPower, 71, 38000);
+  broker2.drop_next = 1;
+  broker2.pollAll(kCodeSyncJitterMs);
+  EXPECT_EQ(0, d.getPending());
+  EXPECT_FALSE(broker2.converge(50000));
+  EXPECT_TRUE(broker2.converge(20000));
+  EXPECT_EQ(1, d.count());
+}
@@ -0,0 +1,198 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include <algorithm>
+#include <vector>
+#include "IRdemod.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRutils.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRDemodulator & IRDemodCaptureDriver classes.
+
+// A NEC message (0x00FF00FF), without the trailing gap.
+const uint16_t kNecMessage[67] = {
+    9000, 4500, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560, 560,
+    560, 560, 560, 560, 560, 1690, 560, 1690, 560, 1690, 560, 1690, 560, 1690,
+    560, 1690, 560, 1690, 560, 1690, 560, 560, 560, 560, 560, 560, 560, 560,
+    560, 560, 560, 560, 560, 560, 560, 560, 560, 1690, 560, 1690, 560, 1690,
+    560, 1690, 560, 1690, 560, 1690, 560, 1690, 560, 1690, 560};
+
+// Modulate some marks & spaces onto a carrier, as 1-bit samples.
+// `skip` drops every n'th carrier pulse (0 = none), to simulate noise.
+static std::vector<bool> modulate(const uint16_t *usecs, const uint16_t len,
+                                  const uint32_t hz, const uint8_t duty,
+                                  const uint32_t sample_hz,
+                                  const uint32_t skip = 0) {
+  const uint32_t kLeadUs = 1000;
+  const uint32_t kTailUs = 20000;
+  uint64_t total_us = kLeadUs + kTailUs;
+  for (uint16_t i = 0; i < len; i++) total_us += usecs[i];
+  std::vector<bool> samples(total_us * sample_hz / 1000000, false);
+  uint64_t start_us = kLeadUs;
+  uint32_t pulse = 0;
+  for (uint16_t i = 0; i < len; start_us += usecs[i++]) {
+    if (i & 1) continue;  // A space.
+    const uint32_t cycles = ((uint64_t)usecs[i] * hz + 500000) / 1000000;
+    for (uint32_t c = 0; c < cycles; c++) {
+      if (skip && ++pulse % skip == 0 && c && c < cycles - 1) continue;
+      // Work in picoseconds, so the carrier's period isn't rounded.
+      const uint64_t on_ps = start_us * 1000000 + c * 1000000000000 / hz;
+      const uint64_t off_ps = on_ps + duty * 10000000000 / hz;
+      for (uint64_t s = (on_ps * sample_hz + 999999999999) / 1000000000000;
+           s * 1000000000000 < off_ps * sample_hz && s < samples.size(); s++)
+        samples[s] = true;
+    }
+  }
+  return samples;
+}
+
+// Pack samples 32 to a word. The first sample in the lowest bit.
+static std::vector<uint32_t> pack(const std::vector<bool> &samples,
+                                  const uint32_t from, const uint32_t to) {
+  std::vector<uint32_t> words((to - from + 31) / 32, 0);
+  for (uint32_t i = from; i < to; i++)
+    if (samples[i]) words[(i - from) / 32] |= 1UL << ((i - from) % 32);
+  return words;
+}
+
+// The times of each edge in the samples.
+static std::vector<uint32_t> edges(const std::vector<bool> &samples) {
+  std::vector<uint32_t> times;
+  bool level = false;
+  for (uint32_t i = 0; i < samples.size(); i++)
+    if (samples[i] != level) {
+      level = samples[i];
+      times.push_back(i);
+    }
+  return times;
+}
+
+static void feed(IRDemodulator *demod, const std::vector<bool> &samples,
+                 const uint32_t from, const uint32_t to) {
+  const std::vector<uint32_t> words = pack(samples, from, to);
+  demod->feedSamples(words.data(), to - from);
+}
+
+static void expectNecDurations(IRDemodulator *demod, const uint16_t slack) {
+  ASSERT_TRUE(demod->isComplete());
+  ASSERT_EQ(67, demod->getLength());
+  for (uint16_t i = 0; i < 67; i++)
+    EXPECT_NEAR(kNecMessage[i], demod->getDurations()[i], slack) << i;
+}
+
+TEST(TestIRDemodulator, CarrierAndDuty) {
+  IRDemodulator demod(1000000);
+  const std::vector<bool> samples = modulate(kNecMessage, 67, 38000, 33,
+                                             1000000);
+  EXPECT_FALSE(demod.isComplete());
+  feed(&demod, samples, 0, samples.size());
+  // The trailing 20ms of darkness ends the message.
+  expectNecDurations(&demod, 27);  // Within a carrier cycle.
+  EXPECT_FALSE(demod.hasOverflowed());
+  carrier_info_t carrier = demod.getCarrier();
+  EXPECT_NEAR(38000, carrier.hz, 38);
+  EXPECT_NEAR(33, carrier.duty, 2);
+  EXPECT_LT(500, carrier.cycles);
+
+  // Another carrier, at a faster sample rate.
+  IRDemodulator fast(8000000);
+  const std::vector<bool> more = modulate(kNecMessage, 67, 56000, 50,
+                                          8000000);
+  feed(&fast, more, 0, more.size());
+  expectNecDurations(&fast, 18);
+  carrier = fast.getCarrier();
+  EXPECT_NEAR(56000, carrier.hz, 56);
+  EXPECT_NEAR(50, carrier.duty, 1);
+}
+
+TEST(TestIRDemodulator, Edges) {
+  // A 455kHz carrier, timed by a 24MHz logic analyser.
+  IRDemodulator demod(24000000);
+  const std::vector<uint32_t> times = edges(
+      modulate(kNecMessage, 67, 455000, 25, 24000000));
+  demod.feedEdges(times.data(), times.size());
+  EXPECT_FALSE(demod.isComplete());  // No edge or sample after the last one.
+  demod.finish();
+  expectNecDurations(&demod, 3);
+  const carrier_info_t carrier = demod.getCarrier();
+  EXPECT_NEAR(455000, carrier.hz, 455 * 2);
+  EXPECT_NEAR(25, carrier.duty, 3);
+}
+
+// However the samples are split up, the result is the same.
+TEST(TestIRDemodulator, Chunks) {
+  const std::vector<bool> samples = modulate(kNecMessage, 67, 38000, 33,
+                                             1000000);
+  IRDemodulator whole(1000000);
+  feed(&whole, samples, 0, samples.size());
+  const uint32_t kChunks[4] = {1, 31, 33, 1000};
+  for (uint8_t c = 0; c < 4; c++) {
+    IRDemodulator demod(1000000);
+    for (uint32_t from = 0; from < samples.size(); from += kChunks[c])
+      feed(&demod, samples, from,
+           std::min(from + kChunks[c], (uint32_t)samples.size()));
+    ASSERT_TRUE(demod.isComplete());
+    ASSERT_EQ(whole.getLength(), demod.getLength());
+    for (uint16_t i = 0; i < whole.getLength(); i++)
+      EXPECT_EQ(whole.getDurations()[i], demod.getDurations()[i]);
+    EXPECT_EQ(whole.getCarrier().hz, demod.getCarrier().hz);
+    EXPECT_EQ(samples.size(), demod.getTime());
+  }
+}
+
+// A few missing carrier pulses don't split a mark, or upset the frequency.
+TEST(TestIRDemodulator, MissingPulses) {
+  IRDemodulator demod(1000000);
+  const std::vector<bool> samples = modulate(kNecMessage, 67, 38000, 33,
+                                             1000000, 7);
+  feed(&demod, samples, 0, samples.size());
+  expectNecDurations(&demod, 27);
+  EXPECT_NEAR(38000, demod.getCarrier().hz, 38000 / 200);  // Within 0.5%.
+  EXPECT_NEAR(33, demod.getCarrier().duty, 2);
+}
+
+TEST(TestIRDemodulator, Overflow) {
+  IRDemodulator demod(1000000, 10);
+  const std::vector<bool> samples = modulate(kNecMessage, 67, 38000, 33,
+                                             1000000);
+  feed(&demod, samples, 0, samples.size());
+  EXPECT_TRUE(demod.isComplete());
+  EXPECT_TRUE(demod.hasOverflowed());
+  EXPECT_EQ(10, demod.getLength());
+}
+
+TEST(TestIRDemodCaptureDriver, Decode) {
+  IRDemodulator demod(1000000);
+  IRDemodCaptureDriver driver(&demod);
+  IRrecv irrecv(1);
+  decode_results results;
+  irrecv.setCaptureDriver(&driver);
+  irrecv.enableIRIn();
+  EXPECT_EQ(&demod, driver.getDemodulator());
+  const std::vector<bool> samples = modulate(kNecMessage, 67, 38000, 33,
+                                             1000000);
+  // Two messages, back to back.
+  std::vector<bool> both = samples;
+  both.insert(both.end(), samples.begin(), samples.end());
+  // The first message, but not enough darkness after it to end it.
+  feed(&demod, both, 0, samples.size() - 10000);
+  EXPECT_FALSE(irrecv.decode(&results));
+  // Now it's ended, & the second message's first mark has started.
+  const uint32_t split = samples.size() + 1000 + 4500;
+  feed(&demod, both, samples.size() - 10000, split);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x00FF00FF, results.value);
+  EXPECT_FALSE(results.overflow);
+  EXPECT_FALSE(demod.isComplete());
+  irrecv.resume();
+  // The rest of the second message.
+  feed(&demod, both, split + 1, both.size());
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x00FF00FF, results.value);
+  EXPECT_EQ(0, demod.getDropped());
+  irrecv.disableIRIn();
+}
@@ -0,0 +1,338 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include "IRevents.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+#include "IRrecv.h"
+#include "IRremoteESP8266.h"
+#include "IRutils.h"
+#include "gtest/gtest.h"
+
+// Tests for the IREventServer class.
+
+// A client that takes up to `room` bytes per write, & up to `budget` bytes
+// in total, & remembers them.
+class FakeSink : public IREventSink {
+ public:
+  explicit FakeSink(const int32_t room = 1024)
+      : room(room), budget(INT32_MAX), closed(false) {}
+  int32_t write(const uint8_t *data, const uint16_t length) {
+    if (closed) return -1;
+    const int32_t n = std::min(std::min((int32_t)length, room), budget);
+    received.append(reinterpret_cast<const char *>(data), n);
+    budget -= n;
+    return n;
+  }
+  int32_t room;
+  int32_t budget;
+  bool closed;
+  std::string received;
+};
+
+// Make a decode_results for a simple message. As IRrecv would.
+static decode_results message(const decode_type_t protocol,
+                              const uint64_t value, const uint16_t nbits) {
+  decode_results results;
+  results.decode_type = protocol;
+  results.value = value;
+  results.bits = nbits;
+  results.repeat = false;
+  return results;
+}
+
+TEST(TestIREventServer, SerialiseLine) {
+  uint8_t buffer[kEventMaxLength];
+  decode_results results = message(NEC, 0x20DF10EF, 32);
+  uint16_t length = IREventServer::serialise(&results, 42, kEventLine,
+                                             buffer, sizeof(buffer));
+  EXPECT_EQ("42,NEC,32,0x20DF10EF,0\n",
+            std::string(reinterpret_cast<char *>(buffer), length));
+
+  results.repeat = true;
+  results.value = 0;
+  length = IREventServer::serialise(&results, 1, kEventLine,
+                                    buffer, sizeof(buffer));
+  EXPECT_EQ("1,NEC,32,0x0,1\n",
+            std::string(reinterpret_cast<char *>(buffer), length));
+
+  // A/C states are written byte by byte.
+  results = message(DAIKIN, 0, 24);
+  results.state[0] = 0x11;
+  results.state[1] = 0x0A;
+  results.state[2] = 0xFF;
+  length = IREventServer::serialise(&results, 7, kEventLine,
+                                    buffer, sizeof(buffer));
+  EXPECT_EQ("7,DAIKIN,24,0x110AFF,0\n",
+            std::string(reinterpret_cast<char *>(buffer), length));
+
+  // Doesn't fit.
+  EXPECT_EQ(0, IREventServer::serialise(&results, 7, kEventLine, buffer, 10));
+  EXPECT_EQ(0, IREventServer::serialise(NULL, 7, kEventLine, buffer,
+                                        sizeof(buffer)));
+}
+
+TEST(TestIREventServer, SerialiseBinary) {
+  uint8_t buffer[kEventMaxLength];
+  decode_results results = message(NEC, 0x20DF10EF, 32);
+  results.repeat = true;
+  uint16_t length = IREventServer::serialise(&results, 0x01020304,
+                                             kEventBinary, buffer,
+                                             sizeof(buffer));
+  const uint8_t expected[] = {
+      kEventBinaryMagic, 17, 0x01, 0x02, 0x03, 0x04,
+      (uint8_t)(NEC >> 8), (uint8_t)NEC, 0x00, 32, kEventBinaryRepeat,
+      0x00, 0x00, 0x00, 0x00, 0x20, 0xDF, 0x10, 0xEF};
+  ASSERT_EQ(sizeof(expected), length);
+  EXPECT_EQ(0, memcmp(expected, buffer, length));
+
+  results = message(DAIKIN, 0, 16);
+  results.state[0] = 0x11;
+  results.state[1] = 0xDA;
+  length = IREventServer::serialise(&results, 1, kEventBinary, buffer,
+                                    sizeof(buffer));
+  ASSERT_EQ(kEventBinaryHeaderLength + 2, length);
+  EXPECT_EQ(length - 2, buffer[1]);
+  EXPECT_EQ(kEventBinaryState, buffer[10]);
+  EXPECT_EQ(0x11, buffer[11]);
+  EXPECT_EQ(0xDA, buffer[12]);
+
+  // UNKNOWN (-1) is sent as 0xFFFF.
+  results = message(UNKNOWN, 0x1234, 0);
+  length = IREventServer::serialise(&results, 1, kEventBinary, buffer,
+                                    sizeof(buffer));
+  ASSERT_EQ(kEventBinaryHeaderLength + 8, length);
+  EXPECT_EQ(0xFF, buffer[6]);
+  EXPECT_EQ(0xFF, buffer[7]);
+}
+
+TEST(TestIREventServer, Clients) {
+  IREventServer server(2);
+  FakeSink a, b, c;
+  EXPECT_EQ(0, server.countClients());
+  EXPECT_EQ(0, server.addClient(&a));
+  EXPECT_EQ(1, server.addClient(&b));
+  EXPECT_EQ(-1, server.addClient(&c));  // Full.
+  EXPECT_EQ(-1, server.addClient(&a));  // Already added.
+  EXPECT_EQ(-1, server.addClient(NULL));
+  EXPECT_EQ(2, server.countClients());
+  EXPECT_TRUE(server.hasClient(&a));
+  EXPECT_FALSE(server.hasClient(&c));
+
+  EXPECT_TRUE(server.removeClient(&a));
+  EXPECT_FALSE(server.removeClient(&a));
+  EXPECT_EQ(1, server.countClients());
+  EXPECT_EQ(0, server.addClient(&c));  // Re-uses the free slot.
+}
+
+TEST(TestIREventServer, Broadcast) {
+  IREventServer server(4);
+  FakeSink a, b, c(5);
+  server.addClient(&a);
+  server.addClient(&b);
+  server.addClient(&c);
+  decode_results results = message(NEC, 0x20DF10EF, 32);
+  EXPECT_EQ(1, server.publish(&results));
+  results.value = 0x20DF40BF;
+  EXPECT_EQ(2, server.publish(&results));
+  const std::string expected = "1,NEC,32,0x20DF10EF,0\n"
+                               "2,NEC,32,0x20DF40BF,0\n";
+  EXPECT_EQ(expected, a.received);
+  EXPECT_EQ(expected, b.received);
+  // A client that only takes a few bytes at a time still gets everything,
+  // in order.
+  EXPECT_EQ(expected, c.received);
+  EXPECT_EQ(0, server.getQueued(&c));
+
+  c.room = 0;  // It would block.
+  results.value = 0x20DFC03F;
+  server.publish(&results);
+  EXPECT_EQ(1, server.getQueued(&c));
+  EXPECT_EQ(0, server.getQueued(&a));
+  EXPECT_EQ(0, server.poll());
+  c.room = 3;
+  EXPECT_EQ(22, server.poll());
+  EXPECT_EQ(expected + "3,NEC,32,0x20DFC03F,0\n", c.received);
+  EXPECT_EQ(3, server.getClientStats(&c).sent);
+  EXPECT_EQ(66, server.getClientStats(&c).bytes);
+  EXPECT_EQ(0, server.getClientStats(&c).dropped);
+
+  // No clients.
+  IREventServer empty(2);
+  EXPECT_EQ(1, empty.publish(&results));
+  EXPECT_EQ(0, empty.publish(NULL));
+}
+
+// Publish `count` events, with values 1 to `count`.
+static void publishSome(IREventServer *server, const uint8_t count) {
+  for (uint8_t i = 1; i <= count; i++) {
+    decode_results results = message(NEC, i, 32);
+    server->publish(&results);
+  }
+}
+
+TEST(TestIREventServer, DropOldest) {
+  IREventServer server(2, 3);
+  FakeSink fast, slow(0);
+  server.addClient(&fast);
+  server.addClient(&slow, kEventDropOldest);
+  publishSome(&server, 5);
+  EXPECT_EQ(3, server.getQueued(&slow));
+  EXPECT_EQ(2, server.getClientStats(&slow).dropped);
+  EXPECT_EQ(5, server.getClientStats(&fast).sent);
+  EXPECT_EQ(0, server.getClientStats(&fast).dropped);
+  slow.room = 1024;
+  server.poll();
+  EXPECT_EQ("3,NEC,32,0x3,0\n4,NEC,32,0x4,0\n5,NEC,32,0x5,0\n", slow.received);
+}
+
+TEST(TestIREventServer, DropOldestKeepsPartialEvent) {
+  IREventServer server(1, 2);
+  FakeSink slow;
+  slow.budget = 4;
+  server.addClient(&slow);
+  decode_results results = message(NEC, 1, 32);
+  server.publish(&results);  // Only "1,NE" is sent.
+  publishSome(&server, 3);  // Events 2, 3 & 4.
+  // The partly sent event is kept, so the stream isn't corrupted.
+  slow.budget = INT32_MAX;
+  server.poll();
+  EXPECT_EQ("1,NEC,32,0x1,0\n4,NEC,32,0x3,0\n", slow.received);
+  EXPECT_EQ(2, server.getClientStats(&slow).dropped);
+}
+
+TEST(TestIREventServer, DropNewest) {
+  IREventServer server(1, 3);
+  FakeSink slow(0);
+  server.addClient(&slow, kEventDropNewest);
+  publishSome(&server, 5);
+  EXPECT_EQ(3, server.getQueued(&slow));
+  EXPECT_EQ(2, server.getClientStats(&slow).dropped);
+  slow.room = 1024;
+  server.poll();
+  EXPECT_EQ("1,NEC,32,0x1,0\n2,NEC,32,0x2,0\n3,NEC,32,0x3,0\n", slow.received);
+}
+
+TEST(TestIREventServer, Coalesce) {
+  IREventServer server(1, 3);
+  FakeSink slow(0);
+  server.addClient(&slow, kEventCoalesce);
+  publishSome(&server, 5);
+  // Queue was full at the 4th, so it only has the 4th & 5th.
+  EXPECT_EQ(2, server.getQueued(&slow));
+  EXPECT_EQ(3, server.getClientStats(&slow).dropped);
+  slow.room = 1024;
+  server.poll();
+  EXPECT_EQ("4,NEC,32,0x4,0\n5,NEC,32,0x5,0\n", slow.received);
+}
+
+TEST(TestIREventServer, PoolIsShared) {
+  // Every client with a full queue of different events, & more keep coming.
+  IREventServer server(3, 2);
+  FakeSink a(0), b(0), c(0);
+  server.addClient(&a, kEventDropOldest);
+  server.addClient(&b, kEventDropNewest);
+  server.addClient(&c, kEventCoalesce);
+  publishSome(&server, 20);
+  a.room = b.room = c.room = 1024;
+  server.poll();
+  EXPECT_EQ("19,NEC,32,0x13,0\n20,NEC,32,0x14,0\n", a.received);
+  EXPECT_EQ("1,NEC,32,0x1,0\n2,NEC,32,0x2,0\n", b.received);
+  EXPECT_EQ("19,NEC,32,0x13,0\n20,NEC,32,0x14,0\n", c.received);
+  EXPECT_EQ(18, server.getClientStats(&b).dropped);
+  // Nothing leaked. It all works again.
+  publishSome(&server, 2);
+  EXPECT_EQ(4, server.getClientStats(&b).sent);
+  EXPECT_EQ(0, server.getQueued(&a));
+}
+
+TEST(TestIREventServer, ClosedClient) {
+  IREventServer server(2);
+  FakeSink a, b;
+  server.addClient(&a);
+  server.addClient(&b);
+  b.closed = true;
+  publishSome(&server, 1);
+  EXPECT_TRUE(server.hasClient(&a));
+  EXPECT_FALSE(server.hasClient(&b));
+  EXPECT_EQ(1, server.countClients());
+  EXPECT_EQ("1,NEC,32,0x1,0\n", a.received);
+}
+
+TEST(TestIREventServer, BinaryFormat) {
+  IREventServer server(1, kEventQueueDepth, kEventBinary);
+  FakeSink a;
+  server.addClient(&a);
+  publishSome(&server, 2);
+  ASSERT_EQ(2 * (kEventBinaryHeaderLength + 8), a.received.size());
+  EXPECT_EQ(kEventBinaryMagic, (uint8_t)a.received[0]);
+  EXPECT_EQ(kEventBinaryMagic,
+            (uint8_t)a.received[kEventBinaryHeaderLength + 8]);
+}
+
+// Read whatever has arrived on a socket.
+static std::string readAll(const int fd) {
+  std::string text;
+  char buffer[256];
+  ssize_t n;
+  while ((n = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+    text.append(buffer, n);
+  return text;
+}
+
+TEST(TestIREventFdSink, TcpClients) {
+  const int listener = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_LE(0, listener);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  ASSERT_EQ(0, bind(listener, (struct sockaddr *)&addr, sizeof(addr)));
+  ASSERT_EQ(0, listen(listener, 4));
+  socklen_t addr_len = sizeof(addr);
+  ASSERT_EQ(0, getsockname(listener, (struct sockaddr *)&addr, &addr_len));
+
+  const uint8_t kClients = 3;
+  int remote[kClients];
+  int local[kClients];
+  IREventFdSink *sinks[kClients];
+  IREventServer server(kClients);
+  for (uint8_t i = 0; i < kClients; i++) {
+    remote[i] = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_EQ(0, connect(remote[i], (struct sockaddr *)&addr, sizeof(addr)));
+    local[i] = accept(listener, NULL, NULL);
+    ASSERT_LE(0, local[i]);
+    fcntl(local[i], F_SETFL, fcntl(local[i], F_GETFL) | O_NONBLOCK);
+    sinks[i] = new IREventFdSink(local[i]);
+    EXPECT_EQ(local[i], sinks[i]->getFd());
+    EXPECT_EQ(i, server.addClient(sinks[i]));
+  }
+  publishSome(&server, 2);
+  for (uint8_t i = 0; i < kClients; i++)
+    EXPECT_EQ("1,NEC,32,0x1,0\n2,NEC,32,0x2,0\n", readAll(remote[i]));
+
+  // A client hangs up. It is noticed & removed, & the others are unaffected.
+  close(remote[1]);
+  usleep(10000);
+  publishSome(&server, 3);
+  server.poll();
+  EXPECT_FALSE(server.hasClient(sinks[1]));
+  EXPECT_TRUE(server.hasClient(sinks[0]));
+  EXPECT_TRUE(server.hasClient(sinks[2]));
+  EXPECT_EQ("3,NEC,32,0x1,0\n4,NEC,32,0x2,0\n5,NEC,32,0x3,0\n",
+            readAll(remote[0]));
+
+  for (uint8_t i = 0; i < kClients; i++) {
+    server.removeClient(sinks[i]);
+    delete sinks[i];
+    close(local[i]);
+    if (i != 1) close(remote[i]);
+  }
+  close(listener);
+  IREventFdSink closed(-1);
+  EXPECT_EQ(-1, closed.write(NULL, 0));
+}
@@ -0,0 +1,324 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include "IRfleet.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRFleet class.
+
+// A local stand-in for an MQTT broker. Every node hears every message
+// (including its own), & new subscribers get the retained messages.
+class FakeBroker {
+ public:
+  FakeBroker(void) : published(0), now(0) {}
+  void join(IRFleet *node) {
+    nodes.push_back(node);
+    node->setPublisher(publish, this);
+    for (std::map<std::string, std::string>::iterator it = retained.begin();
+         it != retained.end(); it++)
+      node->handleMessage(it->first.c_str(), it->second.c_str(), now);
+  }
+  // The node just stops. e.g. It lost power.
+  void drop(IRFleet *node) {
+    for (uint16_t i = 0; i < nodes.size(); i++)
+      if (nodes[i] == node) nodes.erase(nodes.begin() + i);
+  }
+  static bool publish(const char *topic, const char *payload,
+                      const bool retain, void *arg) {
+    FakeBroker *broker = static_cast<FakeBroker *>(arg);
+    broker->published++;
+    if (retain) {
+      if (*payload)
+        broker->retained[topic] = payload;
+      else
+        broker->retained.erase(topic);
+    }
+    for (uint16_t i = 0; i < broker->nodes.size(); i++)
+      broker->nodes[i]->handleMessage(topic, payload, broker->now);
+    return true;
+  }
+  void pollAll(const uint32_t now_ms) {
+    now = now_ms;
+    for (uint16_t i = 0; i < nodes.size(); i++) nodes[i]->poll(now);
+  }
+  std::vector<IRFleet *> nodes;
+  std::map<std::string, std::string> retained;
+  uint32_t published;
+  uint32_t now;  ///< The time, as far as the nodes are concerned.
+};
+
+// Records the ownership changes reported to a node.
+struct OwnershipLog {
+  std::string log;
+  static void callback(const int16_t unit, const bool owned, void *arg) {
+    static_cast<OwnershipLog *>(arg)->log += (owned ? "+" : "-") +
+                                             std::to_string(unit);
+  }
+};
+
+const char *kUnitNames[6] = {"lounge", "kitchen", "bed1", "bed2", "office",
+                             "garage"};
+
+// How many of the nodes think they own a unit?
+static uint16_t owners(FakeBroker *broker, const char *unit) {
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < broker->nodes.size(); i++) {
+    IRFleet *node = broker->nodes[i];
+    count += node->isOwner(node->findUnit(unit));
+  }
+  return count;
+}
+
+TEST(TestIRFleet, Weight) {
+  EXPECT_EQ(IRFleet::weight("lounge", "node1"),
+            IRFleet::weight("lounge", "node1"));
+  EXPECT_NE(IRFleet::weight("lounge", "node1"),
+            IRFleet::weight("lounge", "node2"));
+  EXPECT_NE(IRFleet::weight("ab", "c"), IRFleet::weight("a", "bc"));
+  // Spread the units fairly evenly over a couple of nodes.
+  uint16_t wins = 0;
+  for (uint16_t i = 0; i < 1000; i++) {
+    const std::string unit = "unit" + std::to_string(i);
+    wins += IRFleet::weight(unit.c_str(), "node1") >
+            IRFleet::weight(unit.c_str(), "node2");
+  }
+  EXPECT_LT(400, wins);
+  EXPECT_GT(600, wins);
+}
+
+TEST(TestIRFleet, Units) {
+  IRFleet fleet("node1", "ir/fleet", 4);
+  EXPECT_EQ(0, fleet.getUnits());
+  EXPECT_EQ(0, fleet.addUnit("lounge", 2));
+  EXPECT_EQ(1, fleet.addUnit("kitchen"));
+  EXPECT_EQ(kFleetNoUnit, fleet.addUnit("lounge"));  // Already added.
+  EXPECT_EQ(kFleetNoUnit, fleet.addUnit("a/b"));
+  EXPECT_EQ(kFleetNoUnit, fleet.addUnit("a,b"));
+  EXPECT_EQ(kFleetNoUnit, fleet.addUnit(""));
+  EXPECT_EQ(kFleetNoUnit, fleet.addUnit(NULL));
+  EXPECT_EQ(kFleetNoUnit,
+            fleet.addUnit("a_really_long_unit_name_that_is_too_long"));
+  EXPECT_EQ(2, fleet.getUnits());
+  EXPECT_EQ(1, fleet.findUnit("kitchen"));
+  EXPECT_EQ(kFleetNoUnit, fleet.findUnit("garage"));
+  EXPECT_STREQ("lounge", fleet.getUnitName(0));
+  EXPECT_EQ(NULL, fleet.getUnitName(2));
+  EXPECT_EQ(2, fleet.getEmitter(0));
+  EXPECT_EQ(0, fleet.getEmitter(1));
+  EXPECT_EQ("ir/fleet/+", fleet.getSubscription());
+  for (uint8_t i = 2; i < kFleetMaxUnits; i++)
+    EXPECT_EQ(i, fleet.addUnit(("unit" + std::to_string(i)).c_str()));
+  EXPECT_EQ(kFleetNoUnit, fleet.addUnit("one_too_many"));
+}
+
+TEST(TestIRFleet, SingleNode) {
+  FakeBroker broker;
+  IRFleet fleet("node1", "ir/fleet", 4);
+  OwnershipLog changes;
+  fleet.setOwnershipCallback(OwnershipLog::callback, &changes);
+  fleet.addUnit("lounge");
+  fleet.addUnit("kitchen");
+  broker.join(&fleet);
+
+  broker.now = 1000;
+  EXPECT_TRUE(fleet.poll(broker.now));  // Advertises straight away.
+  EXPECT_EQ("lounge,kitchen", broker.retained["ir/fleet/node1"]);
+  // Nothing is claimed until it has had a chance to hear from the others.
+  EXPECT_FALSE(fleet.isOwner(0));
+  EXPECT_EQ("", fleet.getOwner(0));
+  broker.now += kFleetSettleMs - 1;
+  EXPECT_FALSE(fleet.poll(broker.now));
+  EXPECT_EQ("", changes.log);
+  fleet.poll(++broker.now);
+  EXPECT_TRUE(fleet.isOwner(0));
+  EXPECT_TRUE(fleet.isOwner(1));
+  EXPECT_FALSE(fleet.isOwner(2));
+  EXPECT_EQ("node1", fleet.getOwner(1));
+  EXPECT_EQ("+0+1", changes.log);
+  EXPECT_EQ(0, fleet.getLivePeers());
+
+  // Heartbeats.
+  broker.now = 1000 + kFleetHeartbeatMs - 1;
+  EXPECT_FALSE(fleet.poll(broker.now));
+  EXPECT_TRUE(fleet.poll(++broker.now));
+
+  // Leaving.
+  EXPECT_TRUE(fleet.leave());
+  EXPECT_EQ("+0+1-0-1", changes.log);
+  EXPECT_FALSE(fleet.isOwner(0));
+  EXPECT_EQ(0, broker.retained.count("ir/fleet/node1"));
+}
+
+TEST(TestIRFleet, EachUnitHasOneOwner) {
+  FakeBroker broker;
+  IRFleet node1("node1", "ir/fleet", 4);
+  IRFleet node2("node2", "ir/fleet", 4);
+  IRFleet node3("node3", "ir/fleet", 4);
+  for (uint8_t i = 0; i < 6; i++) {
+    node1.addUnit(kUnitNames[i]);
+    node2.addUnit(kUnitNames[i]);
+  }
+  node3.addUnit("garage");  // Only node3 can reach the bedrooms & office.
+  node3.addUnit("bed1");
+  node3.addUnit("bed2");
+  node3.addUnit("office");
+  broker.join(&node1);
+  broker.join(&node2);
+  broker.join(&node3);
+  broker.pollAll(0);
+  broker.pollAll(kFleetSettleMs);
+  EXPECT_EQ(2, node1.getLivePeers());
+  EXPECT_EQ(2, node3.getLivePeers());
+
+  for (uint8_t i = 0; i < 6; i++) {
+    const char *unit = kUnitNames[i];
+    EXPECT_EQ(1, owners(&broker, unit)) << unit;
+    // Everyone agrees on who it is.
+    const String owner = node1.getOwner(node1.findUnit(unit));
+    EXPECT_EQ(owner, node2.getOwner(node2.findUnit(unit))) << unit;
+    // The highest weight of the nodes that can reach it.
+    const char *best = IRFleet::weight(unit, "node1") >
+        IRFleet::weight(unit, "node2") ? "node1" : "node2";
+    if (node3.findUnit(unit) != kFleetNoUnit &&
+        IRFleet::weight(unit, "node3") > IRFleet::weight(unit, best))
+      best = "node3";
+    EXPECT_EQ(best, owner) << unit;
+  }
+  // node3 never owns what it can't reach.
+  EXPECT_FALSE(node3.isOwner(node3.findUnit("lounge")));
+}
+
+TEST(TestIRFleet, Failover) {
+  FakeBroker broker;
+  IRFleet node1("node1", "ir/fleet", 4);
+  IRFleet node2("node2", "ir/fleet", 4);
+  OwnershipLog changes1;
+  node1.setOwnershipCallback(OwnershipLog::callback, &changes1);
+  for (uint8_t i = 0; i < 6; i++) {
+    node1.addUnit(kUnitNames[i]);
+    node2.addUnit(kUnitNames[i]);
+  }
+  broker.join(&node1);
+  broker.join(&node2);
+  broker.pollAll(0);
+  broker.pollAll(kFleetSettleMs);
+  uint8_t owned_by_2 = 0;
+  for (uint8_t i = 0; i < 6; i++) owned_by_2 += node2.isOwner(i);
+  ASSERT_LT(0, owned_by_2);  // Otherwise this test proves nothing.
+  ASSERT_GT(6, owned_by_2);
+
+  // node2 dies. Nothing changes until it misses enough heartbeats.
+  broker.drop(&node2);
+  const uint32_t last_heard = 0;  // Its only advertisement so far.
+  broker.pollAll(last_heard + kFleetTimeoutMs - 1);
+  for (uint8_t i = 0; i < 6; i++)
+    EXPECT_EQ(!node2.isOwner(i), node1.isOwner(i));
+  broker.pollAll(last_heard + kFleetTimeoutMs);
+  EXPECT_EQ(0, node1.getLivePeers());
+  for (uint8_t i = 0; i < 6; i++) EXPECT_TRUE(node1.isOwner(i));
+
+  // It comes back, & gets its units back (only those).
+  changes1.log = "";
+  const uint32_t back = last_heard + kFleetTimeoutMs + 1000;
+  broker.now = back;
+  broker.join(&node2);  // It hears node1's retained advertisement.
+  node2.poll(back);
+  node1.poll(back);
+  EXPECT_EQ(1, node1.getLivePeers());
+  // node2 must settle first, but node1 gives them up straight away.
+  uint8_t given_up = 0;
+  for (uint8_t i = 0; i < 6; i++) given_up += !node1.isOwner(i);
+  EXPECT_EQ(owned_by_2, given_up);
+  EXPECT_EQ(owned_by_2, std::count(changes1.log.begin(), changes1.log.end(),
+                                   '-'));
+  broker.pollAll(back + kFleetSettleMs);
+  for (uint8_t i = 0; i < 6; i++)
+    EXPECT_EQ(1, owners(&broker, kUnitNames[i])) << kUnitNames[i];
+
+  // A graceful exit hands over at once.
+  node2.leave();
+  broker.drop(&node2);
+  for (uint8_t i = 0; i < 6; i++) EXPECT_TRUE(node1.isOwner(i));
+}
+
+TEST(TestIRFleet, AddingANodeOnlyMovesUnitsToIt) {
+  FakeBroker broker;
+  IRFleet node1("node1", "ir/fleet", 4);
+  IRFleet node2("node2", "ir/fleet", 4);
+  IRFleet node3("node3", "ir/fleet", 4);
+  for (uint8_t i = 0; i < 6; i++) {
+    node1.addUnit(kUnitNames[i]);
+    node2.addUnit(kUnitNames[i]);
+    node3.addUnit(kUnitNames[i]);
+  }
+  broker.join(&node1);
+  broker.join(&node2);
+  broker.pollAll(0);
+  broker.pollAll(kFleetSettleMs);
+  bool before1[6];
+  bool before2[6];
+  for (uint8_t i = 0; i < 6; i++) {
+    before1[i] = node1.isOwner(i);
+    before2[i] = node2.isOwner(i);
+  }
+  broker.join(&node3);
+  broker.pollAll(kFleetSettleMs + 1000);
+  broker.pollAll(2 * kFleetSettleMs + 1000);
+  for (uint8_t i = 0; i < 6; i++) {
+    EXPECT_EQ(1, owners(&broker, kUnitNames[i])) << kUnitNames[i];
+    if (node1.isOwner(i)) {
+      EXPECT_TRUE(before1[i]);
+    }
+    if (node2.isOwner(i)) {
+      EXPECT_TRUE(before2[i]);
+    }
+  }
+}
+
+TEST(TestIRFleet, Messages) {
+  IRFleet fleet("node1", "ir/fleet", 1);
+  fleet.addUnit("lounge");
+  fleet.addUnit("kitchen");
+  fleet.poll(0);
+  fleet.poll(kFleetSettleMs);
+  ASSERT_TRUE(fleet.isOwner(0));
+
+  // Not ours.
+  EXPECT_FALSE(fleet.handleMessage("ir/other/node2", "lounge", 6000));
+  EXPECT_FALSE(fleet.handleMessage("ir/fleetx/node2", "lounge", 6000));
+  EXPECT_FALSE(fleet.handleMessage("ir/fleet", "lounge", 6000));
+  EXPECT_FALSE(fleet.handleMessage("ir/fleet/a/b", "lounge", 6000));
+  EXPECT_FALSE(fleet.handleMessage(NULL, "lounge", 6000));
+  EXPECT_FALSE(fleet.handleMessage("ir/fleet/node2", NULL, 6000));
+  EXPECT_EQ(0, fleet.getLivePeers());
+  // Our own.
+  EXPECT_TRUE(fleet.handleMessage("ir/fleet/node1", "lounge", 6000));
+  EXPECT_EQ(0, fleet.getLivePeers());
+
+  // Pick a peer name that beats us for the lounge.
+  std::string peer;
+  for (uint16_t i = 0; peer.empty(); i++) {
+    const std::string name = "peer" + std::to_string(i);
+    if (IRFleet::weight("lounge", name.c_str()) >
+        IRFleet::weight("lounge", "node1"))
+      peer = name;
+  }
+  const std::string topic = "ir/fleet/" + peer;
+  // Units we don't know of are ignored.
+  EXPECT_TRUE(fleet.handleMessage(topic.c_str(), "garage,,office", 6000));
+  EXPECT_EQ(1, fleet.getLivePeers());
+  EXPECT_TRUE(fleet.isOwner(0));
+  EXPECT_TRUE(fleet.handleMessage(topic.c_str(), "garage,lounge", 6000));
+  EXPECT_FALSE(fleet.isOwner(0));
+  EXPECT_EQ(peer, fleet.getOwner(0));
+  // No room for another peer while that one is alive.
+  EXPECT_TRUE(fleet.handleMessage("ir/fleet/peerX", "kitchen", 6000));
+  EXPECT_EQ(1, fleet.getLivePeers());
+  // It left.
+  EXPECT_TRUE(fleet.handleMessage(topic.c_str(), "", 6000));
+  EXPECT_EQ(0, fleet.getLivePeers());
+  EXPECT_TRUE(fleet.isOwner(0));
+}
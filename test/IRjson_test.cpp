@@ -0,0 +1,251 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include <math.h>
+#include <stdlib.h>
+#include <chrono>  // NOLINT(build/c++11)
+#include <new>
+#include <string>
+#include "IRac.h"
+#include "IRjson.h"
+#include "IRremoteESP8266.h"
+#include "gtest/gtest.h"
+
+// Tests for the irjson namespace.
+
+// Count every allocation in this test binary, so we can prove the codec
+// doesn't make any.
+static uint32_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *ptr = malloc(size ? size : 1);
+  if (ptr == NULL) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+// A busy state, with every field set to something other than its default.
+static stdAc::state_t busyState(void) {
+  stdAc::state_t state;
+  IRac::initState(&state, decode_type_t::DAIKIN2, 3, true,
+                  stdAc::opmode_t::kFan, 21.5, false,
+                  stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kHighest,
+                  stdAc::swingh_t::kLeftMax, true, true, true, true, true,
+                  true, true, 120, -1);
+  return state;
+}
+
+static std::string toJson(const stdAc::state_t &state,
+                          const bool ha_mode = false) {
+  char buffer[irjson::kStateJsonMaxLength];
+  const uint16_t length = irjson::stateToJson(state, buffer, sizeof(buffer),
+                                              ha_mode);
+  EXPECT_EQ(length, strlen(buffer));
+  return buffer;
+}
+
+// The text is exactly what IRMQTTServer has always published.
+TEST(TestIRJson, StateToJsonShape) {
+  stdAc::state_t state;
+  IRac::initState(&state);
+  EXPECT_EQ(
+      "{\"protocol\":\"UNKNOWN\",\"model\":-1,\"power\":\"Off\","
+      "\"mode\":\"Off\",\"use_celsius\":\"On\",\"temp\":25,"
+      "\"fanspeed\":\"Auto\",\"swingv\":\"Off\",\"swingh\":\"Off\","
+      "\"quiet\":\"Off\",\"turbo\":\"Off\",\"econo\":\"Off\",\"light\":\"Off\","
+      "\"filter\":\"Off\",\"clean\":\"Off\",\"beep\":\"Off\",\"sleep\":-1}",
+      toJson(state));
+  EXPECT_EQ(
+      "{\"protocol\":\"DAIKIN2\",\"model\":3,\"power\":\"On\","
+      "\"mode\":\"Fan\",\"use_celsius\":\"Off\",\"temp\":21.5,"
+      "\"fanspeed\":\"Medium\",\"swingv\":\"Highest\",\"swingh\":\"LeftMax\","
+      "\"quiet\":\"On\",\"turbo\":\"On\",\"econo\":\"On\",\"light\":\"On\","
+      "\"filter\":\"On\",\"clean\":\"On\",\"beep\":\"On\",\"sleep\":120}",
+      toJson(busyState()));
+}
+
+TEST(TestIRJson, StateToJsonHomeAssistant) {
+  stdAc::state_t state = busyState();
+  EXPECT_NE(std::string::npos,
+            toJson(state, true).find("\"power\":\"On\",\"mode\":\"fan-only\""));
+  // Power off means mode off, & vice-versa.
+  state.power = false;
+  EXPECT_NE(std::string::npos,
+            toJson(state, true).find("\"power\":\"Off\",\"mode\":\"Off\""));
+  state.power = true;
+  state.mode = stdAc::opmode_t::kOff;
+  EXPECT_NE(std::string::npos,
+            toJson(state, true).find("\"power\":\"Off\",\"mode\":\"Off\""));
+  // But not outside of Home Assistant mode.
+  EXPECT_NE(std::string::npos,
+            toJson(state).find("\"power\":\"On\",\"mode\":\"Off\""));
+}
+
+TEST(TestIRJson, StateToJsonNumbers) {
+  stdAc::state_t state = busyState();
+  const float kTemps[6] = {0, -5, 18.25, 77.125, 16.0001, -0.5};
+  const char *kTexts[6] = {"0", "-5", "18.25", "77.125", "16", "-0.5"};
+  for (uint8_t i = 0; i < 6; i++) {
+    state.degrees = kTemps[i];
+    EXPECT_NE(std::string::npos,
+              toJson(state).find(std::string("\"temp\":") + kTexts[i] + ","))
+        << kTexts[i];
+  }
+  state.degrees = NAN;
+  EXPECT_NE(std::string::npos, toJson(state).find("\"temp\":null,"));
+  state.model = -32768;
+  EXPECT_NE(std::string::npos, toJson(state).find("\"model\":-32768,"));
+}
+
+// Too small a buffer gets as much as fits, & the length it needed.
+TEST(TestIRJson, StateToJsonTruncates) {
+  const std::string full = toJson(busyState());
+  char buffer[20];
+  memset(buffer, 'x', sizeof(buffer));
+  EXPECT_EQ(full.length(),
+            irjson::stateToJson(busyState(), buffer, sizeof(buffer)));
+  EXPECT_EQ(full.substr(0, sizeof(buffer) - 1), buffer);
+  EXPECT_EQ(full.length(), irjson::stateToJson(busyState(), NULL, 0));
+}
+
+TEST(TestIRJson, RoundTrip) {
+  stdAc::state_t states[4];
+  IRac::initState(&states[0]);
+  states[1] = busyState();
+  states[2] = busyState();
+  states[2].protocol = decode_type_t::MITSUBISHI_HEAVY_152;
+  states[2].mode = stdAc::opmode_t::kDry;
+  states[2].degrees = 77.5;
+  states[2].swingh = stdAc::swingh_t::kWide;
+  states[2].power = false;
+  states[3] = states[0];
+  states[3].protocol = decode_type_t::COOLIX;
+  states[3].mode = stdAc::opmode_t::kHeat;
+  states[3].fanspeed = stdAc::fanspeed_t::kMin;
+  states[3].swingv = stdAc::swingv_t::kLowest;
+  for (uint8_t i = 0; i < 4; i++) {
+    stdAc::state_t result;
+    IRac::initState(&result);
+    result.clock = 1234;
+    ASSERT_TRUE(irjson::jsonToState(toJson(states[i]).c_str(), &result));
+    EXPECT_FALSE(IRac::cmpStates(states[i], result)) << toJson(result);
+    EXPECT_EQ(1234, result.clock);  // Not part of the JSON.
+  }
+}
+
+// Only the fields given change, & values of the wrong type are ignored.
+TEST(TestIRJson, JsonToStatePartial) {
+  const stdAc::state_t busy = busyState();
+  stdAc::state_t state = busy;
+  EXPECT_TRUE(irjson::jsonToState("{}", &state));
+  EXPECT_FALSE(IRac::cmpStates(busy, state));
+  EXPECT_TRUE(irjson::jsonToState(
+      " {\"temp\" : 19 , \"mode\":\"COOLING\",\n\"quiet\":false,"
+      "\"turbo\":\"no\",\"sleep\":7.5,\"model\":\"bogus\"} ", &state));
+  EXPECT_EQ(19, state.degrees);
+  EXPECT_EQ(stdAc::opmode_t::kCool, state.mode);
+  EXPECT_FALSE(state.quiet);
+  EXPECT_FALSE(state.turbo);
+  EXPECT_EQ(120, state.sleep);  // Not an integer, so ignored.
+  EXPECT_EQ(-1, state.model);  // An unknown model name.
+  EXPECT_EQ(decode_type_t::DAIKIN2, state.protocol);
+
+  // Numbers for the protocol & model. Unknown keys & odd values are skipped.
+  EXPECT_TRUE(irjson::jsonToState(
+      "{\"protocol\":15,\"model\":2,\"extra\":{\"a\":[1,{\"b\":null}],"
+      "\"c\":\"}\"},\"fanspeed\":5,\"econo\":null,\"swingv\":[],"
+      "\"beep\":true,\"light\":\"Off\"}", &state));
+  EXPECT_EQ(decode_type_t::COOLIX, state.protocol);
+  EXPECT_EQ(2, state.model);
+  EXPECT_EQ(stdAc::fanspeed_t::kMedium, state.fanspeed);
+  EXPECT_TRUE(state.econo);
+  EXPECT_EQ(stdAc::swingv_t::kHighest, state.swingv);
+  EXPECT_TRUE(state.beep);
+  EXPECT_FALSE(state.light);
+
+  // Protocol names, & escapes in strings.
+  EXPECT_TRUE(irjson::jsonToState(
+      "{\"protocol\":\"mitsubishi_ac\",\"swingh\":\"\\u0057ide\","
+      "\"swingv\":\"\\u0041uto\",\"mode\":\"H\\u0065at\","
+      "\"fanspeed\":\"\\/\"}", &state));
+  EXPECT_EQ(decode_type_t::MITSUBISHI_AC, state.protocol);
+  // \u escapes aren't decoded, so these aren't recognised.
+  EXPECT_EQ(stdAc::swingh_t::kOff, state.swingh);
+  EXPECT_EQ(stdAc::swingv_t::kOff, state.swingv);
+  EXPECT_EQ(stdAc::opmode_t::kAuto, state.mode);
+  EXPECT_EQ(stdAc::fanspeed_t::kAuto, state.fanspeed);
+
+  // Over-long values are unrecognised.
+  state.power = true;
+  EXPECT_TRUE(irjson::jsonToState(
+      "{\"power\":\"onnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnnn\"}",
+      &state));
+  EXPECT_FALSE(state.power);
+
+  // UTF-8 text in a string is fine.
+  state.degrees = 0;
+  EXPECT_TRUE(irjson::jsonToState(
+      "{\"room\":\"Caf\xC3\xA9 \xE2\x84\x83\",\"temp\":21}", &state));
+  EXPECT_EQ(21, state.degrees);
+}
+
+// Malformed text doesn't change anything.
+TEST(TestIRJson, JsonToStateMalformed) {
+  const stdAc::state_t busy = busyState();
+  const char *kBad[] = {
+      "", " ", "[]", "\"temp\"", "{", "{\"temp\":19", "{\"temp\":19,}",
+      "{\"temp\" 19}", "{temp:19}", "{\"temp\":19}}", "{\"temp\":19} x",
+      "{\"temp\":-}", "{\"temp\":1e}", "{\"temp\":1.2.3}", "{\"temp\":tru}",
+      "{\"mode\":\"Cool}", "{\"mode\":\"\\q\"}", "{\"mode\":\"\\u12\"}",
+      "{\"x\":[1,2}", "{\"x\":[[[[[[[[[[1]]]]]]]]]]}", "{\"temp\":19,\"a\"}",
+      "{\"mode\":\"Co\nol\"}", "{\"temp\":12345678901234567890123456789}",
+      // Bytes above 0x7F. e.g. UTF-8 where JSON doesn't allow it.
+      "{\"temp\":\xC2\xB2}", "{\"temp\":1\xC2\xB2}",
+      "{\"mode\":\"\\u\xC2\xB2\xC2\xB2\"}"};
+  for (const char *bad : kBad) {
+    stdAc::state_t state = busy;
+    EXPECT_FALSE(irjson::jsonToState(bad, &state)) << bad;
+    EXPECT_FALSE(IRac::cmpStates(busy, state)) << bad;
+  }
+  stdAc::state_t state = busy;
+  EXPECT_FALSE(irjson::jsonToState(NULL, &state));
+  EXPECT_FALSE(irjson::jsonToState("{}", NULL));
+  // Only look at the given length.
+  EXPECT_FALSE(irjson::jsonToState("{\"temp\":19}", &state, 10));
+  EXPECT_TRUE(irjson::jsonToState("{\"temp\":19}garbage", &state, 11));
+  EXPECT_EQ(19, state.degrees);
+}
+
+TEST(TestIRJson, Benchmark) {
+  const stdAc::state_t busy = busyState();
+  const uint32_t kRuns = 20000;
+  char buffer[irjson::kStateJsonMaxLength];
+  uint64_t bytes = 0;
+  uint32_t before = allocations;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < kRuns; i++)
+    bytes += irjson::stateToJson(busy, buffer, sizeof(buffer), i & 1);
+  const double write_secs = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  const uint32_t write_allocs = allocations - before;
+
+  irjson::stateToJson(busy, buffer, sizeof(buffer));
+  stdAc::state_t state;
+  before = allocations;
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < kRuns; i++) irjson::jsonToState(buffer, &state);
+  const double read_secs = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  const uint32_t read_allocs = allocations - before;
+
+  EXPECT_EQ(0, write_allocs);
+  EXPECT_EQ(0, read_allocs);
+  EXPECT_FALSE(IRac::cmpStates(busy, state));
+  const double write_rate = bytes / write_secs;
+  const double read_rate = strlen(buffer) * kRuns / read_secs;
+  ::testing::Test::RecordProperty("write_bytes_per_sec", write_rate);
+  ::testing::Test::RecordProperty("read_bytes_per_sec", read_rate);
+}
@@ -0,0 +1,196 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include <string>
+#include "IRac.h"
+#include "IRmetrics.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRscheduler.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "gtest/gtest.h"
+
+// Tests for the irmetrics registry.
+
+TEST(TestIRMetrics, CountersAndGauges) {
+  irmetrics::reset();
+  EXPECT_EQ(0, irmetrics::getCounter(irmetrics::kRecvMessages));
+  irmetrics::add(irmetrics::kRecvMessages);
+  irmetrics::add(irmetrics::kRecvMessages, 41);
+  EXPECT_EQ(42, irmetrics::getCounter(irmetrics::kRecvMessages));
+  IR_METRIC_INC(kRecvMessages);
+  EXPECT_EQ(43, irmetrics::getCounter(irmetrics::kRecvMessages));
+  irmetrics::set(irmetrics::kRecvLastLength, -5);
+  EXPECT_EQ(-5, irmetrics::getGauge(irmetrics::kRecvLastLength));
+  IR_METRIC_SET(kRecvLastLength, 100);
+  EXPECT_EQ(100, irmetrics::getGauge(irmetrics::kRecvLastLength));
+  // Out of range ids are ignored.
+  irmetrics::add(irmetrics::kCounters);
+  irmetrics::set(irmetrics::kGauges, 1);
+  EXPECT_EQ(0, irmetrics::getCounter(irmetrics::kCounters));
+  EXPECT_EQ(0, irmetrics::getGauge(irmetrics::kGauges));
+  irmetrics::reset();
+  EXPECT_EQ(0, irmetrics::getCounter(irmetrics::kRecvMessages));
+  EXPECT_EQ(0, irmetrics::getGauge(irmetrics::kRecvLastLength));
+}
+
+TEST(TestIRMetrics, Histograms) {
+  irmetrics::reset();
+  EXPECT_EQ(0, irmetrics::getBucketBound(irmetrics::kSchedulerLateMs, 0));
+  EXPECT_EQ(UINT32_MAX, irmetrics::getBucketBound(
+      irmetrics::kSchedulerLateMs, irmetrics::kHistogramBuckets));
+  irmetrics::observe(irmetrics::kSchedulerLateMs, 0);
+  irmetrics::observe(irmetrics::kSchedulerLateMs, 1);
+  irmetrics::observe(irmetrics::kSchedulerLateMs, 3);
+  irmetrics::observe(irmetrics::kSchedulerLateMs, 1000);
+  irmetrics::observe(irmetrics::kSchedulerLateMs, 5000);
+  const irmetrics::histogram_value_t h = irmetrics::getHistogram(
+      irmetrics::kSchedulerLateMs);
+  EXPECT_EQ(5, h.count);
+  EXPECT_EQ(6004, h.sum);
+  EXPECT_EQ(1, h.buckets[0]);  // <= 0
+  EXPECT_EQ(1, h.buckets[1]);  // <= 1
+  EXPECT_EQ(1, h.buckets[2]);  // <= 5
+  EXPECT_EQ(1, h.buckets[7]);  // <= 1000
+  EXPECT_EQ(1, h.buckets[8]);  // +Inf
+}
+
+TEST(TestIRMetrics, Exporters) {
+  irmetrics::reset();
+  // The user's metrics can only be added once per run, so do it all here.
+  const int16_t sent = irmetrics::addCounter("mqtt_sent_total");
+  ASSERT_EQ(irmetrics::kUserCounter, sent);
+  const int16_t rssi = irmetrics::addGauge("wifi_rssi");
+  ASSERT_EQ(irmetrics::kUserGauge, rssi);
+  for (uint8_t i = 1; i < irmetrics::kMaxUserMetrics; i++)
+    EXPECT_NE(irmetrics::kNoMetric, irmetrics::addCounter("spare_total"));
+  EXPECT_EQ(irmetrics::kNoMetric, irmetrics::addCounter("one_too_many"));
+  EXPECT_EQ(irmetrics::kNoMetric, irmetrics::addGauge(NULL));
+
+  irmetrics::add(irmetrics::kRecvMessages, 3);
+  irmetrics::add(sent, 7);
+  irmetrics::set(rssi, -67);
+  irmetrics::observe(irmetrics::kAcAirtimeMs, 150);
+
+  const std::string text = irmetrics::toPrometheus();
+  EXPECT_NE(std::string::npos, text.find(
+      "# TYPE ir_recv_messages_total counter\n"
+      "ir_recv_messages_total 3\n"));
+  EXPECT_NE(std::string::npos, text.find(
+      "# TYPE mqtt_sent_total counter\nmqtt_sent_total 7\n"));
+  EXPECT_NE(std::string::npos, text.find(
+      "# TYPE wifi_rssi gauge\nwifi_rssi -67\n"));
+  EXPECT_NE(std::string::npos, text.find(
+      "# TYPE ir_ac_airtime_msecs histogram\n"
+      "ir_ac_airtime_msecs_bucket{le=\"25\"} 0\n"
+      "ir_ac_airtime_msecs_bucket{le=\"50\"} 0\n"
+      "ir_ac_airtime_msecs_bucket{le=\"100\"} 0\n"
+      "ir_ac_airtime_msecs_bucket{le=\"200\"} 1\n"
+      "ir_ac_airtime_msecs_bucket{le=\"300\"} 1\n"
+      "ir_ac_airtime_msecs_bucket{le=\"500\"} 1\n"
+      "ir_ac_airtime_msecs_bucket{le=\"1000\"} 1\n"
+      "ir_ac_airtime_msecs_bucket{le=\"2000\"} 1\n"
+      "ir_ac_airtime_msecs_bucket{le=\"+Inf\"} 1\n"
+      "ir_ac_airtime_msecs_sum 150\n"
+      "ir_ac_airtime_msecs_count 1\n"));
+
+  const std::string json = irmetrics::toJson();
+  EXPECT_EQ('{', json.front());
+  EXPECT_EQ('}', json.back());
+  EXPECT_EQ(0, json.find("{\"ir_recv_messages_total\":3,"));
+  EXPECT_NE(std::string::npos, json.find("\"mqtt_sent_total\":7,"));
+  EXPECT_NE(std::string::npos, json.find("\"wifi_rssi\":-67,"));
+  EXPECT_NE(std::string::npos, json.find(
+      "\"ir_ac_airtime_msecs\":{\"le\":[25,50,100,200,300,500,1000,2000],"
+      "\"buckets\":[0,0,0,1,0,0,0,0,0],\"sum\":150,\"count\":1}}"));
+}
+
+TEST(TestIRMetrics, Receiving) {
+  IRsendTest irsend(kGpioUnused);
+  IRrecv irrecv(kGpioUnused);
+  irsend.begin();
+  irmetrics::reset();
+
+  irsend.reset();
+  irsend.sendNEC(0x00FF00FF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(1, irmetrics::getCounter(irmetrics::kRecvMessages));
+  EXPECT_EQ(0, irmetrics::getCounter(irmetrics::kRecvUnknown));
+  EXPECT_EQ(irsend.capture.rawlen,
+            irmetrics::getGauge(irmetrics::kRecvLastLength));
+
+  // Something no protocol matches.
+  const uint16_t junk[11] = {100, 200, 300, 400, 500, 600, 700, 800, 900,
+                             1000, 1100};
+  irsend.reset();
+  irsend.sendRaw(junk, 11, 38);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(UNKNOWN, irsend.capture.decode_type);
+  EXPECT_EQ(1, irmetrics::getCounter(irmetrics::kRecvUnknown));
+
+  // Too short to even be UNKNOWN.
+  irsend.reset();
+  irsend.sendRaw(junk, 3, 38);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(1, irmetrics::getCounter(irmetrics::kRecvMissed));
+  EXPECT_EQ(3, irmetrics::getCounter(irmetrics::kRecvMessages));
+
+  // The noise filter.
+  const uint16_t noisy[5] = {8000, 4000, 20, 30, 600};
+  irsend.reset();
+  irsend.sendRaw(noisy, 5, 38);
+  irsend.makeDecodeResult();
+  irrecv.decode(&irsend.capture, NULL, 0, 100);
+  EXPECT_EQ(2, irmetrics::getCounter(irmetrics::kRecvNoisePulses));
+}
+
+TEST(TestIRMetrics, Sending) {
+  IRsendLowLevelTest irsend(kGpioUnused);
+  irsend.begin();
+  irmetrics::reset();
+  irsend.enableIROut(38000);
+  irsend.mark(500);
+  irsend.space(1500);
+  irsend.space(0);
+  EXPECT_EQ(1, irmetrics::getCounter(irmetrics::kSendMessages));
+  EXPECT_EQ(2000, irmetrics::getCounter(irmetrics::kSendAirtimeUs));
+
+  // A/C messages.
+  IRac ac(kGpioUnused);
+  stdAc::state_t state;
+  IRac::initState(&state);
+  state.protocol = decode_type_t::COOLIX;
+  EXPECT_TRUE(ac.sendAc(state, NULL));
+  state.protocol = decode_type_t::NEC;
+  EXPECT_FALSE(ac.sendAc(state, NULL));
+  EXPECT_EQ(1, irmetrics::getCounter(irmetrics::kAcSends));
+  EXPECT_EQ(1, irmetrics::getCounter(irmetrics::kAcUnsupported));
+  const irmetrics::histogram_value_t h = irmetrics::getHistogram(
+      irmetrics::kAcAirtimeMs);
+  EXPECT_EQ(1, h.count);  // The unit tests' IRsend doesn't count airtime.
+}
+
+static void nothing(void *) {}
+
+TEST(TestIRMetrics, Scheduler) {
+  IRScheduler scheduler(4, 10);
+  irmetrics::reset();
+  scheduler.poll(0);
+  scheduler.scheduleCall(100, 0, nothing, NULL);
+  scheduler.scheduleCall(200, 0, nothing, NULL);
+  EXPECT_EQ(2, irmetrics::getGauge(irmetrics::kSchedulerPending));
+  EXPECT_EQ(1, scheduler.poll(100));  // On time.
+  EXPECT_EQ(1, scheduler.poll(255));  // 55ms late.
+  EXPECT_EQ(2, irmetrics::getCounter(irmetrics::kSchedulerRuns));
+  EXPECT_EQ(0, irmetrics::getGauge(irmetrics::kSchedulerPending));
+  const irmetrics::histogram_value_t h = irmetrics::getHistogram(
+      irmetrics::kSchedulerLateMs);
+  EXPECT_EQ(2, h.count);
+  EXPECT_EQ(55, h.sum);
+  EXPECT_EQ(1, h.buckets[0]);  // <= 0
+  EXPECT_EQ(1, h.buckets[5]);  // <= 100
+}
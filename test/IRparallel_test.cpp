@@ -0,0 +1,268 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include "IRparallel.h"
+#include <chrono>  // NOLINT(build/c++11)
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "ir_Daikin.h"
+#include "ir_Gree.h"
+#include "ir_Kelvinator.h"
+#include "ir_Mitsubishi.h"
+#include "ir_Rhoss.h"
+#include "ir_Toshiba.h"
+#include "gtest/gtest.h"
+
+// Tests for parallel decoding, & the IRThreadDecodeRunner class.
+
+// Record which parts of a job were run.
+static void markPart(void *arg, const uint8_t part) {
+  static_cast<uint8_t *>(arg)[part]++;
+}
+
+TEST(TestIRThreadDecodeRunner, RunsEveryPart) {
+  IRThreadDecodeRunner runner(4);
+  EXPECT_EQ(4, runner.parts());
+  uint8_t counts[kDecodeMaxParts] = {0};
+  for (uint8_t i = 0; i < 100; i++) runner.run(markPart, counts, 4);
+  for (uint8_t part = 0; part < 4; part++) EXPECT_EQ(100, counts[part]);
+  // Fewer parts than threads.
+  memset(counts, 0, sizeof(counts));
+  runner.run(markPart, counts, 2);
+  EXPECT_EQ(1, counts[0]);
+  EXPECT_EQ(1, counts[1]);
+  EXPECT_EQ(0, counts[2]);
+  // More parts than threads.
+  memset(counts, 0, sizeof(counts));
+  runner.run(markPart, counts, 6);
+  EXPECT_EQ(1, counts[3]);
+  EXPECT_EQ(0, counts[4]);
+  // Limits.
+  EXPECT_EQ(1, IRThreadDecodeRunner(0).parts());
+  EXPECT_EQ(kDecodeMaxParts, IRThreadDecodeRunner(100).parts());
+}
+
+// Send an A/C's default state.
+template <class AC>
+static void sendAc(IRsendTest *irsend, const decode_type_t protocol,
+                   const uint16_t nbytes) {
+  AC ac(0);
+  ac.begin();
+  irsend->send(protocol, ac.getRaw(), nbytes);
+}
+
+// Send the i'th of our test messages. Returns false when there are no more.
+static bool sendMessage(IRsendTest *irsend, const uint8_t i) {
+  irsend->reset();
+  switch (i) {
+    case 0: return irsend->send(NEC, 0x20DF10EF, 32);
+    case 1: return irsend->send(SONY, 0xA90, 12);
+    case 2: return irsend->send(RC5, 0x175, 13);
+    case 3: return irsend->send(RC6, 0x1234, 20);
+    case 4: return irsend->send(SAMSUNG, 0xE0E040BF, 32);
+    case 5: return irsend->send(LG, 0x8800347, 28);
+    case 6: return irsend->send(PANASONIC, 0x40040190ED7C, 48);
+    case 7: return irsend->send(JVC, 0xC2B8, 16);
+    case 8: return irsend->send(SHARP, 0x454A, 15);
+    case 9: return irsend->send(DENON, 0x2A4C028D6CE3, 48);
+    case 10: return irsend->send(ARRIS, 0x1000085E, 32);
+    case 11: return irsend->send(EPSON, 0xC1AA09F6, 32);
+    case 12: sendAc<IRDaikinESP>(irsend, DAIKIN, kDaikinStateLength);
+      return true;
+    case 13: sendAc<IRGreeAC>(irsend, GREE, kGreeStateLength);
+      return true;
+    case 14: sendAc<IRKelvinatorAC>(irsend, KELVINATOR,
+                                    kKelvinatorStateLength);
+      return true;
+    case 15: sendAc<IRMitsubishiAC>(irsend, MITSUBISHI_AC,
+                                    kMitsubishiACStateLength);
+      return true;
+    case 16: sendAc<IRToshibaAC>(irsend, TOSHIBA_AC, kToshibaACStateLength);
+      return true;
+    case 17: sendAc<IRRhossAc>(irsend, RHOSS, kRhossStateLength);
+      return true;
+    case 18:  // Something no decoder knows. i.e. UNKNOWN.
+      for (uint16_t j = 0; j < 40; j++) {
+        irsend->mark(300 + (j % 7) * 150);
+        irsend->space(500 + (j % 5) * 230);
+      }
+      return true;
+    default: return false;
+  }
+}
+
+static void expectSameResult(const decode_results &expected,
+                             const decode_results &actual) {
+  EXPECT_EQ(expected.decode_type, actual.decode_type);
+  EXPECT_EQ(expected.bits, actual.bits);
+  if (hasACState(expected.decode_type)) {
+    EXPECT_EQ(0, memcmp(expected.state, actual.state, expected.bits / 8));
+  } else {
+    EXPECT_EQ(expected.value, actual.value);
+    EXPECT_EQ(expected.address, actual.address);
+    EXPECT_EQ(expected.command, actual.command);
+  }
+}
+
+TEST(TestParallelDecode, SameAsSerial) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  for (uint8_t parts = 2; parts <= kDecodeMaxParts; parts++) {
+    IRThreadDecodeRunner runner(parts);
+    for (uint8_t i = 0; sendMessage(&irsend, i); i++) {
+      SCOPED_TRACE(i);
+      irsend.makeDecodeResult();
+      irrecv.setDecodeRunner(NULL);
+      ASSERT_TRUE(irrecv.decode(&irsend.capture));
+      const decode_results serial = irsend.capture;
+      irrecv.setDecodeRunner(&runner);
+      ASSERT_EQ(&runner, irrecv.getDecodeRunner());
+      irsend.makeDecodeResult();
+      ASSERT_TRUE(irrecv.decode(&irsend.capture));
+      expectSameResult(serial, irsend.capture);
+      if (i == 18) {
+        EXPECT_EQ(UNKNOWN, irsend.capture.decode_type);
+      }
+    }
+  }
+  irrecv.setDecodeRunner(NULL);
+}
+
+TEST(TestParallelDecode, SkippedPulses) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  IRThreadDecodeRunner runner(3);
+  irsend.begin();
+  // Some noise before a NEC message.
+  irsend.reset();
+  irsend.mark(100);
+  irsend.space(100);
+  irsend.sendNEC(0x20DF10EF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture, NULL, 1));
+  const decode_results serial = irsend.capture;
+  ASSERT_EQ(NEC, serial.decode_type);
+  irrecv.setDecodeRunner(&runner);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture, NULL, 1));
+  expectSameResult(serial, irsend.capture);
+}
+
+// Runs the parts one after another on the calling thread, timing each one.
+// i.e. How long a decode would take with an idle core for each part, not
+// counting the hand-offs.
+class IRTimedDecodeRunner : public IRDecodeRunner {
+ public:
+  explicit IRTimedDecodeRunner(const uint8_t parts, const bool reverse)
+      : saved(0), _parts(parts), _reverse(reverse) {}
+  uint8_t parts(void) const { return _parts; }
+  void run(void (*job)(void *arg, const uint8_t part), void *arg,
+           const uint8_t count) {
+    double total = 0;
+    double longest = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      job(arg, _reverse ? count - 1 - i : i);
+      const double taken = std::chrono::duration<double, std::micro>(
+          std::chrono::steady_clock::now() - start).count();
+      total += taken;
+      longest = std::max(longest, taken);
+    }
+    saved += total - longest;
+  }
+  double saved;  ///< uSecs that running the parts at once would have saved.
+
+ private:
+  uint8_t _parts;
+  bool _reverse;
+};
+
+TEST(TestParallelDecode, PartsStopEarly) {
+  // Run in order, the later parts see the earlier parts' matches & stop.
+  // In reverse, they don't. Either way the result is the same as serial.
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  for (uint8_t reverse = 0; reverse <= 1; reverse++) {
+    IRTimedDecodeRunner runner(3, reverse);
+    for (uint8_t i = 0; sendMessage(&irsend, i); i++) {
+      SCOPED_TRACE(i);
+      irsend.makeDecodeResult();
+      irrecv.setDecodeRunner(NULL);
+      ASSERT_TRUE(irrecv.decode(&irsend.capture));
+      const decode_results serial = irsend.capture;
+      irrecv.setDecodeRunner(&runner);
+      irsend.makeDecodeResult();
+      ASSERT_TRUE(irrecv.decode(&irsend.capture));
+      expectSameResult(serial, irsend.capture);
+    }
+  }
+  irrecv.setDecodeRunner(NULL);
+}
+
+// Average time (in uSecs) to decode the current capture. The best of a few
+// batches, as other work on the machine only ever slows a batch down.
+// If a `timed` runner is in use, the time its parts could have overlapped is
+// taken off.
+static double timeDecodes(IRrecv *irrecv, IRsendTest *irsend,
+                          const uint16_t runs,
+                          IRTimedDecodeRunner *timed = NULL) {
+  irsend->makeDecodeResult();
+  double best = 0;
+  for (uint8_t batch = 0; batch < 5; batch++) {
+    if (timed != NULL) timed->saved = 0;
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (uint16_t i = 0; i < runs; i++) irrecv->decode(&irsend->capture);
+    double taken = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count();
+    if (timed != NULL) taken -= timed->saved;
+    if (batch == 0 || taken < best) best = taken;
+  }
+  return best / runs;
+}
+
+// Record a time (in uSecs) as a whole nr. of nano-seconds.
+static void recordTime(const std::string &key, const double usecs) {
+  ::testing::Test::RecordProperty(key, static_cast<int>(usecs * 1000));
+}
+
+TEST(TestParallelDecode, Benchmark) {
+  // Times are recorded as properties of the test (in nSecs). e.g. See them
+  // with --gtest_output=xml
+  // "threads" is the real time with IRThreadDecodeRunner, hand-offs & all.
+  // It can only beat serial with idle cores to run the parts on. "critical"
+  // is the time when each part has an idle core, less the hand-offs.
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  const uint16_t kRuns = 200;
+  const uint8_t kMessages[] = {18, 17, 0};  // UNKNOWN, Rhoss (late), NEC.
+  const char *kNames[] = {"UNKNOWN", "RHOSS", "NEC"};
+  for (uint8_t m = 0; m < sizeof(kMessages); m++) {
+    const std::string name = kNames[m];
+    sendMessage(&irsend, kMessages[m]);
+    irrecv.setDecodeRunner(NULL);
+    const double serial = timeDecodes(&irrecv, &irsend, kRuns);
+    recordTime(name + "_serial", serial);
+    for (uint8_t parts = 2; parts <= 4; parts += 2) {
+      const std::string prefix = name + "_" + std::to_string(parts);
+      IRThreadDecodeRunner threads(parts);
+      irrecv.setDecodeRunner(&threads);
+      recordTime(prefix + "_threads", timeDecodes(&irrecv, &irsend, kRuns));
+      IRTimedDecodeRunner timed(parts, true);
+      irrecv.setDecodeRunner(&timed);
+      recordTime(prefix + "_critical",
+                 timeDecodes(&irrecv, &irsend, kRuns, &timed));
+    }
+    irrecv.setDecodeRunner(NULL);
+  }
+}
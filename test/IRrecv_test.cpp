@@ -1,10 +1,15 @@
 // Copyright 2017 David Conran
 
 #include "IRrecv_test.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
 #include "IRrecv.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
 #include "IRsend_test.h"
+#include "IRutils.h"
 #include "gtest/gtest.h"
 
 // Tests for the IRrecv object.
@@ -2019,3 +2024,194 @@ TEST(TestMatchManchesterData, SimulateLongFooter) {
   EXPECT_EQ("f38000d50m1000s2000m1000s1000m2000s5000",
             irsend.outputStr());
 }
+
+// Deterministically add up to +/- `percent` of jitter to each duration.
+static void addJitter(decode_results *results, const uint8_t percent,
+                      uint32_t seed) {
+  for (uint16_t i = 1; i < results->rawlen; i++) {
+    seed = seed * 1103515245UL + 12345;
+    const int32_t change = (int32_t)((seed >> 16) % (2 * percent + 1)) -
+        percent;
+    results->rawbuf[i] = std::min(results->rawbuf[i] * (100 + change) / 100,
+                                  (int32_t)UINT16_MAX);
+  }
+}
+
+TEST(TestFingerprint, Jitter) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendNEC(0x4BB640BF);
+  irsend.makeDecodeResult();
+  const uint64_t clean = resultToFingerprint(&irsend.capture);
+  EXPECT_NE(0, clean);
+  for (uint32_t seed = 1; seed <= 20; seed++) {
+    irsend.reset();
+    irsend.sendNEC(0x4BB640BF);
+    irsend.makeDecodeResult();
+    addJitter(&irsend.capture, 10, seed);
+    EXPECT_EQ(clean, resultToFingerprint(&irsend.capture)) << seed;
+  }
+  // A different code, with the same timings, is different.
+  irsend.reset();
+  irsend.sendNEC(0x4BB640BE);
+  irsend.makeDecodeResult();
+  EXPECT_NE(clean, resultToFingerprint(&irsend.capture));
+}
+
+TEST(TestFingerprint, NoiseTrimming) {
+  IRsendTest irsend(0);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendSony(0x240, kSony12Bits, 0);
+  irsend.makeDecodeResult();
+  const uint64_t clean = resultToFingerprint(&irsend.capture);
+
+  // Noise before the message.
+  irsend.reset();
+  irsend.mark(60);
+  irsend.space(3000);
+  irsend.mark(40);
+  irsend.space(500);
+  irsend.sendSony(0x240, kSony12Bits, 0);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(clean, resultToFingerprint(&irsend.capture));
+
+  // & after it.
+  irsend.mark(80);
+  irsend.space(1000);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(clean, resultToFingerprint(&irsend.capture));
+
+  // A real mark isn't noise.
+  irsend.mark(600);
+  irsend.space(1000);
+  irsend.makeDecodeResult();
+  EXPECT_NE(clean, resultToFingerprint(&irsend.capture));
+
+  // Nothing to fingerprint.
+  irsend.capture.rawlen = 1;
+  EXPECT_EQ(0, resultToFingerprint(&irsend.capture));
+}
+
+// Codes the legacy hash can't tell apart, as they only differ in timing.
+TEST(TestFingerprint, AbsoluteTimings) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendNEC(0xE0E040BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  const uint64_t nec_legacy = irsend.capture.value;
+  const uint64_t nec = resultToFingerprint(&irsend.capture);
+  // The same again, but with the header of a Samsung message.
+  irsend.reset();
+  irsend.sendSAMSUNG(0xE0E040BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  EXPECT_EQ(nec_legacy, irsend.capture.value);
+  EXPECT_NE(nec, resultToFingerprint(&irsend.capture));
+  // Everything twice as long.
+  irsend.reset();
+  irsend.sendNEC(0xE0E040BF);
+  irsend.makeDecodeResult();
+  for (uint16_t i = 1; i < irsend.capture.rawlen; i++)
+    irsend.capture.rawbuf[i] *= 2;
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  EXPECT_EQ(nec_legacy, irsend.capture.value);
+  EXPECT_NE(nec, resultToFingerprint(&irsend.capture));
+}
+
+TEST(TestFingerprint, DecodeHash) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  irsend.reset();
+  irsend.sendNEC(0x4BB640BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  const uint64_t legacy = irsend.capture.value;
+  EXPECT_EQ(0, irsend.capture.command);
+  EXPECT_GE(UINT32_MAX, legacy);
+
+  irrecv.setUnknownFingerprint(true);
+  irsend.reset();
+  irsend.sendNEC(0x4BB640BF);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  EXPECT_EQ(UNKNOWN, irsend.capture.decode_type);
+  EXPECT_EQ(resultToFingerprint(&irsend.capture), irsend.capture.value);
+  EXPECT_EQ(legacy, irsend.capture.command);
+
+  irrecv.setUnknownFingerprint(false);
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  EXPECT_EQ(legacy, irsend.capture.value);
+  EXPECT_EQ(0, irsend.capture.command);
+}
+
+// Measure collisions, & stability under jitter, over all the simple protocols
+// we can send.
+TEST(TestFingerprint, CollisionRate) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+  irrecv.setUnknownFingerprint(true);
+  const uint64_t kValues[] = {0x0, 0x1, 0x2, 0x80, 0x1234, 0xE0E040BF,
+                              0x4BB640BF, 0x5A5A5A5A5A5A5A5A};
+  const uint8_t kJitter[2] = {5, 10};  // Percentages.
+  std::set<std::vector<uint16_t> > seen;
+  std::map<uint64_t, uint16_t> legacy;
+  std::map<uint64_t, uint16_t> fingerprint;
+  uint16_t codes = 0;
+  uint16_t legacy_collisions = 0;
+  uint16_t collisions = 0;
+  uint16_t legacy_stable[2] = {0, 0};
+  uint16_t stable[2] = {0, 0};
+  for (int16_t i = 1; i <= kLastDecodeType; i++) {
+    const decode_type_t protocol = (decode_type_t)i;
+    if (hasACState(protocol)) continue;
+    const uint16_t nbits = IRsend::defaultBits(protocol);
+    for (uint8_t v = 0; v < sizeof(kValues) / sizeof(kValues[0]); v++) {
+      const uint64_t value = (nbits < 64) ? kValues[v] & ((1ULL << nbits) - 1)
+                                          : kValues[v];
+      irsend.reset();
+      if (!irsend.send(protocol, value, nbits, 0)) continue;
+      irsend.makeDecodeResult();
+      if (irsend.capture.overflow) continue;
+      const std::vector<uint16_t> timings(
+          irsend.capture.rawbuf + 1,
+          irsend.capture.rawbuf + irsend.capture.rawlen);
+      if (!seen.insert(timings).second) continue;  // Already seen.
+      if (!irrecv.decodeHash(&irsend.capture)) continue;  // Too short.
+      codes++;
+      const uint64_t clean = irsend.capture.value;
+      const uint64_t clean_legacy = irsend.capture.command;
+      if (legacy[clean_legacy]++) legacy_collisions++;
+      if (fingerprint[clean]++) collisions++;
+      for (uint8_t j = 0; j < 2; j++) {
+        std::copy(timings.begin(), timings.end(), irsend.capture.rawbuf + 1);
+        addJitter(&irsend.capture, kJitter[j], i * 256 + v);
+        ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+        if (irsend.capture.value == clean) stable[j]++;
+        if (irsend.capture.command == clean_legacy) legacy_stable[j]++;
+      }
+    }
+  }
+  RecordProperty("codes", codes);
+  RecordProperty("legacy_collisions", legacy_collisions);
+  RecordProperty("fingerprint_collisions", collisions);
+  RecordProperty("legacy_stable_5pc", legacy_stable[0]);
+  RecordProperty("fingerprint_stable_5pc", stable[0]);
+  RecordProperty("legacy_stable_10pc", legacy_stable[1]);
+  RecordProperty("fingerprint_stable_10pc", stable[1]);
+  EXPECT_LT(400, codes);
+  // The only ones left are codes whose timings differ by less than the
+  // spread, or whose units are either side of an octave edge.
+  // i.e. XMP, RCMM, Multibrackets, & Kelon vs. Panasonic.
+  EXPECT_GE(6, collisions);
+  EXPECT_LT(5 * collisions, legacy_collisions);
+  // It must be at least as stable as the legacy hash.
+  for (uint8_t j = 0; j < 2; j++) EXPECT_LE(legacy_stable[j], stable[j]);
+  EXPECT_LE(codes * 95 / 100, stable[1]);
+}
@@ -0,0 +1,212 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include <algorithm>
+#include <vector>
+#include "IRac.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRscheduler.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRScheduler class.
+
+// Record the order the callbacks were called in.
+static std::vector<intptr_t> called;
+
+static void record(void *arg) { called.push_back((intptr_t)arg); }
+
+TEST(TestIRScheduler, Basics) {
+  IRScheduler scheduler(4);
+  EXPECT_EQ(4, scheduler.getCapacity());
+  EXPECT_EQ(0, scheduler.getPending());
+  EXPECT_EQ(kSchedulerNoJob, scheduler.scheduleCall(0, 0, NULL, NULL));
+  EXPECT_EQ(kSchedulerNoJob,
+            scheduler.scheduleSend(0, 0, NULL, NEC, 0x1234, 32));
+  const uint32_t job = scheduler.scheduleCall(100, 0, record, NULL);
+  EXPECT_NE(kSchedulerNoJob, job);
+  EXPECT_TRUE(scheduler.isScheduled(job));
+  EXPECT_EQ(1, scheduler.getPending());
+  EXPECT_TRUE(scheduler.cancel(job));
+  EXPECT_FALSE(scheduler.isScheduled(job));
+  EXPECT_FALSE(scheduler.cancel(job));
+  EXPECT_EQ(0, scheduler.getPending());
+  // Fill it up.
+  for (uint8_t i = 0; i < 4; i++)
+    EXPECT_NE(kSchedulerNoJob, scheduler.scheduleCall(i, 0, record, NULL));
+  EXPECT_EQ(kSchedulerNoJob, scheduler.scheduleCall(0, 0, record, NULL));
+  // A stale job id shouldn't cancel the job now using its slot.
+  EXPECT_FALSE(scheduler.cancel(job));
+  EXPECT_EQ(4, scheduler.getPending());
+}
+
+TEST(TestIRScheduler, OneShotsRunInOrder) {
+  IRScheduler scheduler(10, 10);
+  called.clear();
+  scheduler.poll(1000);  // Start the clock.
+  scheduler.scheduleCall(300, 0, record, reinterpret_cast<void *>(3));
+  scheduler.scheduleCall(100, 0, record, reinterpret_cast<void *>(1));
+  scheduler.scheduleCall(5000, 0, record, reinterpret_cast<void *>(4));
+  scheduler.scheduleCall(200, 0, record, reinterpret_cast<void *>(2));
+  EXPECT_EQ(0, scheduler.poll(1099));
+  EXPECT_EQ(1, scheduler.poll(1100));
+  ASSERT_EQ(1, called.size());
+  EXPECT_EQ(1, called[0]);
+  // Catch up on a long gap in one go.
+  EXPECT_EQ(3, scheduler.poll(10000));
+  ASSERT_EQ(4, called.size());
+  EXPECT_EQ(2, called[1]);
+  EXPECT_EQ(3, called[2]);
+  EXPECT_EQ(4, called[3]);
+  EXPECT_EQ(0, scheduler.getPending());
+  EXPECT_EQ(0, scheduler.poll(20000));
+}
+
+TEST(TestIRScheduler, Periodic) {
+  IRScheduler scheduler(2, 10);
+  called.clear();
+  scheduler.poll(0);
+  const uint32_t job = scheduler.scheduleCall(50, 1000, record, NULL);
+  uint16_t runs = 0;
+  for (uint32_t now = 0; now <= 10050; now += 10) runs += scheduler.poll(now);
+  EXPECT_EQ(11, runs);  // At 50, 1050, ... 10050
+  EXPECT_TRUE(scheduler.isScheduled(job));
+  EXPECT_EQ(1, scheduler.getPending());
+  EXPECT_TRUE(scheduler.cancel(job));
+  EXPECT_EQ(0, scheduler.poll(20000));
+}
+
+TEST(TestIRScheduler, FarFutureJobs) {
+  IRScheduler scheduler(3, 1);
+  called.clear();
+  scheduler.poll(0);
+  // Further away than the wheel can hold in one go.
+  const uint32_t far = kSchedulerMaxTicks + 12345;
+  scheduler.scheduleCall(far, 0, record, reinterpret_cast<void *>(2));
+  scheduler.scheduleCall(70000, 0, record, reinterpret_cast<void *>(1));
+  EXPECT_EQ(0, scheduler.poll(69999));
+  EXPECT_EQ(1, scheduler.poll(70000));
+  EXPECT_EQ(0, scheduler.poll(far - 1));
+  EXPECT_EQ(1, scheduler.poll(far));
+  ASSERT_EQ(2, called.size());
+  EXPECT_EQ(1, called[0]);
+  EXPECT_EQ(2, called[1]);
+}
+
+// When each job in the Stress test ran.
+static uint32_t stress_now;
+static uint32_t stress_ran_at[500];
+
+static void recordTime(void *arg) {
+  stress_ran_at[(intptr_t)arg] = stress_now;
+}
+
+TEST(TestIRScheduler, Stress) {
+  IRScheduler scheduler(500, 1);
+  uint32_t due[500];
+  uint32_t seed = 12345;
+  scheduler.poll(0);
+  for (intptr_t i = 0; i < 500; i++) {
+    seed = seed * 1103515245 + 12345;  // A simple PRNG.
+    due[i] = (seed >> 8) % 300000;  // Spread them across every level.
+    stress_ran_at[i] = UINT32_MAX;
+    ASSERT_NE(kSchedulerNoJob, scheduler.scheduleCall(
+        due[i], 0, recordTime, reinterpret_cast<void *>(i)));
+  }
+  uint32_t ran = 0;
+  for (stress_now = 1; stress_now <= 300000; stress_now++)
+    ran += scheduler.poll(stress_now);
+  EXPECT_EQ(500, ran);
+  for (uint16_t i = 0; i < 500; i++)  // A 0 delay runs on the next tick.
+    EXPECT_EQ(std::max(due[i], (uint32_t)1), stress_ran_at[i]) << i;
+}
+
+TEST(TestIRScheduler, ClockWrapsAround) {
+  IRScheduler scheduler(2, 10);
+  called.clear();
+  scheduler.poll(UINT32_MAX - 5);
+  scheduler.scheduleCall(100, 0, record, NULL);
+  EXPECT_EQ(0, scheduler.poll(80));
+  EXPECT_EQ(1, scheduler.poll(95));
+}
+
+// A job that cancels another job, and itself.
+struct Canceller {
+  IRScheduler *scheduler;
+  uint32_t victim;
+  uint32_t self;
+  uint16_t runs;
+};
+
+static void cancelJobs(void *arg) {
+  Canceller *c = static_cast<Canceller *>(arg);
+  c->runs++;
+  c->scheduler->cancel(c->victim);
+  c->scheduler->cancel(c->self);
+}
+
+TEST(TestIRScheduler, JobsCanCancelJobs) {
+  IRScheduler scheduler(4, 10);
+  called.clear();
+  scheduler.poll(0);
+  Canceller c;
+  c.scheduler = &scheduler;
+  c.runs = 0;
+  c.self = scheduler.scheduleCall(100, 100, cancelJobs, &c);
+  // Due in the same tick, but after the canceller.
+  c.victim = scheduler.scheduleCall(100, 0, record, NULL);
+  EXPECT_EQ(2, scheduler.getPending());
+  EXPECT_EQ(1, scheduler.poll(100));
+  EXPECT_EQ(1, c.runs);
+  EXPECT_TRUE(called.empty());
+  EXPECT_EQ(0, scheduler.getPending());
+  EXPECT_EQ(0, scheduler.poll(1000));
+}
+
+TEST(TestIRScheduler, SendsMessages) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  IRScheduler scheduler(4, 10);
+  const uint8_t state[kKelvinatorStateLength] = {
+      0x19, 0x0B, 0x80, 0x50, 0x00, 0x00, 0x00, 0xE0,
+      0x19, 0x0B, 0x80, 0x70, 0x00, 0x00, 0x10, 0xF0};
+  irsend.begin();
+  scheduler.poll(0);
+  scheduler.scheduleSend(100, 0, &irsend, NEC, 0x00FF00FF, kNECBits);
+  scheduler.scheduleSendState(200, 0, &irsend, KELVINATOR, state,
+                              kKelvinatorStateLength);
+
+  irsend.reset();
+  EXPECT_EQ(1, scheduler.poll(100));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0x00FF00FF, irsend.capture.value);
+
+  irsend.reset();
+  EXPECT_EQ(1, scheduler.poll(200));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(KELVINATOR, irsend.capture.decode_type);
+  EXPECT_STATE_EQ(state, irsend.capture.state, kKelvinatorBits);
+}
+
+TEST(TestIRScheduler, UpdatesAnAc) {
+  IRac ac(kGpioUnused);
+  IRScheduler scheduler(2, 10);
+  IRac::initState(&ac.next);
+  ac.next.protocol = decode_type_t::COOLIX;
+  ac.next.power = true;
+  ac.markAsSent();
+  stdAc::update_t off;
+  off.fields = kAcFieldPower;
+  off.values.power = false;
+  scheduler.poll(0);
+  scheduler.scheduleAc(1000, 0, &ac, &off);
+  EXPECT_TRUE(ac.getStatePrev().power);
+  EXPECT_EQ(1, scheduler.poll(1000));
+  EXPECT_FALSE(ac.getStatePrev().power);
+  EXPECT_FALSE(ac.hasStateChanged());
+}
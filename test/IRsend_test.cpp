@@ -1,7 +1,11 @@
 // Copyright 2017,2019 David Conran
 
+#include <chrono>  // NOLINT(build/c++11)
+#include <string>
 #include "IRsend_test.h"
 #include "IRrecv_test.h"
+#include "IRmetrics.h"
+#include "IRrecv.h"
 #include "IRsend.h"
 #include "IRutils.h"
 #include "gtest/gtest.h"
@@ -232,6 +236,178 @@ TEST(TestSendRaw, NoTrailingGap) {
   EXPECT_EQ(kNECBits, irsend.capture.bits);
 }
 
+#ifndef PROGMEM
+#define PROGMEM  // Pretend we have the PROGMEM macro even if we really don't.
+#endif
+
+// NEC C3E0E0E8 as measured in #204
+const uint16_t kFlashRawData[67] PROGMEM = {
+    8950, 4500, 550, 1650, 600, 1650, 550, 550,  600, 500,  600, 550,
+    550,  550,  600, 1650, 550, 1650, 600, 1650, 600, 1650, 550, 1700,
+    550,  550,  600, 550,  550, 550,  600, 500,  600, 550,  550, 1650,
+    600,  1650, 600, 1650, 550, 550,  600, 500,  600, 500,  600, 550,
+    550,  550,  600, 1650, 550, 1650, 600, 1650, 600, 500,  650, 1600,
+    600,  500,  600, 550,  550, 550,  600};
+
+// Sending from flash should be identical to sending from RAM.
+TEST(TestSendRaw, FromFlash) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  uint16_t ram[67];
+  memcpy(ram, kFlashRawData, sizeof(ram));
+  irsend.sendRaw(ram, 67, 38);
+  const std::string expected = irsend.outputStr();
+  irsend.sendRaw_P(kFlashRawData, 67, 38);
+  EXPECT_EQ(expected, irsend.outputStr());
+
+  // Packed.
+  const uint16_t nbytes = packRawData(kFlashRawData, 67, NULL, 0);
+  EXPECT_EQ(82, nbytes);  // vs. 134 bytes unpacked.
+  uint8_t packed[82];
+  EXPECT_EQ(nbytes, packRawData(kFlashRawData, 67, packed, sizeof(packed)));
+  irsend.sendRawPacked_P(packed, nbytes, 38);
+  EXPECT_EQ(expected, irsend.outputStr());
+  // Truncated input just sends the durations that are complete.
+  irsend.sendRawPacked_P(packed, 3, 38);
+  EXPECT_EQ("f38000d50m8950", irsend.outputStr());
+  irsend.sendRawPacked_P(packed, 2, 38);
+  EXPECT_EQ("", irsend.outputStr());
+  irsend.sendRawPacked_P(packed, 0, 38);
+  EXPECT_EQ("", irsend.outputStr());
+}
+
+// Packed raw data can hold durations that don't fit in 16 bits.
+TEST(TestSendRaw, PackedLongDurations) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  const uint32_t raw[7] = {100000, 65535, 1, 4000000000, 65536, 0, 70000};
+  uint8_t packed[32];
+  const uint16_t nbytes = packRawData(raw, 7, packed, sizeof(packed));
+  ASSERT_GE(sizeof(packed), nbytes);
+  irsend.sendRawPacked_P(packed, nbytes, 38000);
+  EXPECT_EQ(
+      "f38000d50"
+      "m100000s65535m1s4000000000m135536",  // The 0 space is merged away.
+      irsend.outputStr());
+  // A decrease in a duration is stored just as well as an increase.
+  const uint32_t down[4] = {9000, 4500, 560, 560};
+  EXPECT_EQ(3 + 2 + 3 + 2, packRawData(down, 4, NULL, 0));
+  // Too small a buffer.
+  EXPECT_EQ(nbytes, packRawData(raw, 7, packed, 3));
+}
+
+// Packed raw data unpacks back to what it was packed from.
+TEST(TestSendRaw, UnpackRawData) {
+  const uint16_t raw[7] = {9000, 4500, 560, 1690, 560, 560, 560};
+  uint8_t packed[32];
+  const uint16_t nbytes = packRawData(raw, 7, packed, sizeof(packed));
+  uint16_t unpacked[7] = {0};
+  EXPECT_EQ(7, unpackRawData(packed, nbytes, NULL, 0));
+  EXPECT_EQ(7, unpackRawData(packed, nbytes, unpacked, 7));
+  for (uint16_t i = 0; i < 7; i++) EXPECT_EQ(raw[i], unpacked[i]);
+  // Too small a buffer, & durations too big for 16 bits.
+  const uint32_t big[3] = {100000, 1, 70000};
+  EXPECT_EQ(3, unpackRawData(packed, packRawData(big, 3, packed, 32),
+                             unpacked, 2));
+  EXPECT_EQ(65535, unpacked[0]);
+  EXPECT_EQ(1, unpacked[1]);
+  EXPECT_EQ(1690, unpacked[3]);  // Untouched.
+}
+
+// Compact a raw capture with the same frame in it several times.
+TEST(TestSendRaw, CompactRepeats) {
+  // Two short frames with a little jitter, & the same gap between them.
+  const uint16_t raw[11] = {1000, 500, 1000, 20000,
+                            1020, 490, 980,  20100,
+                            1000, 510, 1000};
+  uint16_t out[11];
+  raw_compact_t info;
+  EXPECT_EQ(3, compactRaw(raw, 11, out, &info));
+  EXPECT_EQ(0, info.lead_len);
+  EXPECT_EQ(3, info.frame_len);
+  EXPECT_EQ(20050, info.gap);
+  EXPECT_EQ(2, info.repeat);
+  EXPECT_EQ(1007, out[0]);
+  EXPECT_EQ(500, out[1]);
+  EXPECT_EQ(993, out[2]);
+  IRsendTest irsend(4);
+  irsend.begin();
+  irsend.sendRawCompact(out, &info, 38);
+  EXPECT_EQ(
+      "f38000d50"
+      "m1007s500m993s20050m1007s500m993s20050m1007s500m993",
+      irsend.outputStr());
+
+  // Frames that differ by more than the tolerance are left alone.
+  const uint16_t differ[7] = {1000, 500, 1000, 20000, 1000, 500, 1500};
+  EXPECT_EQ(7, compactRaw(differ, 7, out, &info));
+  EXPECT_EQ(0, info.lead_len);
+  EXPECT_EQ(7, info.frame_len);
+  EXPECT_EQ(0, info.repeat);
+  EXPECT_EQ(0, memcmp(differ, out, sizeof(differ)));
+  // As is a single frame.
+  EXPECT_EQ(3, compactRaw(differ, 3, out, &info));
+  EXPECT_EQ(0, info.repeat);
+  // Different gaps between the frames.
+  uint16_t gaps[7] = {1000, 500, 1000, 20000, 1000, 500, 1000};
+  EXPECT_EQ(3, compactRaw(gaps, 7, gaps, &info));  // In place.
+  EXPECT_EQ(1, info.repeat);
+  const uint16_t gaps2[11] = {1000, 500, 1000, 20000, 1000, 500, 1000, 40000,
+                              1000, 500, 1000};
+  // Only the last two frames can be compacted.
+  EXPECT_EQ(7, compactRaw(gaps2, 11, out, &info));
+  EXPECT_EQ(4, info.lead_len);
+  EXPECT_EQ(3, info.frame_len);
+  EXPECT_EQ(40000, info.gap);
+  EXPECT_EQ(1, info.repeat);
+}
+
+// Compacted real captures should still decode to the same message.
+TEST(TestSendRaw, CompactCaptures) {
+  IRsendTest irsend(4);
+  IRrecv irrecv(4);
+  irsend.begin();
+  raw_compact_t info;
+
+  // Sony sends the same frame three times.
+  irsend.reset();
+  irsend.sendSony(0x240, kSony12Bits, 2);
+  irsend.makeDecodeResult();
+  uint16_t len = getCorrectedRawLength(&irsend.capture);
+  uint16_t *raw = resultToRawArray(&irsend.capture);
+  EXPECT_EQ(kSony12Bits * 2 + 1, compactRaw(raw, len, raw, &info));
+  EXPECT_EQ(0, info.lead_len);
+  EXPECT_EQ(kSony12Bits * 2 + 1, info.frame_len);
+  EXPECT_EQ(2, info.repeat);
+  irsend.reset();
+  irsend.sendRawCompact(raw, &info, 40);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SONY, irsend.capture.decode_type);
+  EXPECT_EQ(kSony12Bits, irsend.capture.bits);
+  EXPECT_EQ(0x240, irsend.capture.value);
+  delete[] raw;
+
+  // NEC sends a full frame, then short repeat codes.
+  irsend.reset();
+  irsend.sendNEC(0x00FF00FF, kNECBits, 3);
+  irsend.makeDecodeResult();
+  len = getCorrectedRawLength(&irsend.capture);
+  raw = resultToRawArray(&irsend.capture);
+  EXPECT_EQ(kNECBits * 2 + 4 + 3, compactRaw(raw, len, raw, &info));
+  EXPECT_EQ(kNECBits * 2 + 4, info.lead_len);  // The frame & its gap.
+  EXPECT_EQ(3, info.frame_len);
+  EXPECT_EQ(2, info.repeat);
+  EXPECT_LT(UINT16_MAX, info.gap);  // It was split up by resultToRawArray().
+  irsend.reset();
+  irsend.sendRawCompact(raw, &info, 38);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(NEC, irsend.capture.decode_type);
+  EXPECT_EQ(0x00FF00FF, irsend.capture.value);
+  delete[] raw;
+}
+
 TEST(TestLowLevelSend, MarkFrequencyModulationAt38kHz) {
   IRsendLowLevelTest irsend(0);
 
@@ -379,6 +555,74 @@ TEST(TestLowLevelSend, SpaceNoModulation) {
   EXPECT_EQ("[Off]1000usecs", irsend.low_level_sequence);
 }
 
+// Output policies for the software carrier.
+
+TEST(TestLowLevelSend, MarkWithAnOutputPolicy) {
+  IRsendLowLevelTest irsend(0);
+  irsend.begin();
+  irsend.enableIROut(38000, 50);
+  irsend.reset();
+  const uint16_t pulses = irsend.mark(1000);
+  EXPECT_EQ(48, pulses);  // 1000us at 21us per cycle. (kPeriodOffset)
+
+  // The same loop, but the policy switches the LED, not ledOn() & ledOff().
+  IRoutputMock mock;
+  irsend.reset();
+  EXPECT_EQ(pulses, irsend.markWith(&mock, 1000));
+  EXPECT_EQ(pulses, mock.ons);
+  EXPECT_EQ(pulses, mock.offs);
+  EXPECT_FALSE(mock.lit);
+  // Only the delays remain.
+  EXPECT_EQ(std::string::npos, irsend.low_level_sequence.find("[On]"));
+  EXPECT_EQ(std::string::npos, irsend.low_level_sequence.find("[Off]"));
+
+  // A fixed pin does nothing when testing, but it must still compile & time.
+  IRoutputFixedPin<4> fixed;
+  IRoutputFixedPin<4, true> inverted;
+  EXPECT_EQ(pulses, irsend.markWith(&fixed, 1000));
+  EXPECT_EQ(pulses, irsend.markWith(&inverted, 1000));
+
+  // No modulation.
+  IRsendLowLevelTest flat(0, false, false);
+  flat.begin();
+  flat.enableIROut(38000, 50);
+  IRoutputMock flat_mock;
+  EXPECT_EQ(1, flat.markWith(&flat_mock, 1000));
+  EXPECT_EQ(1, flat_mock.ons);
+  EXPECT_EQ(1, flat_mock.offs);
+}
+
+// Time passes instantly, & the LED is switched by the real (virtual when
+// testing) ledOn() & ledOff(). i.e. Only the loop's own overhead is timed.
+class IRsendCarrierLoopTest : public IRsend {
+ public:
+  explicit IRsendCarrierLoopTest(uint16_t pin) : IRsend(pin) {}
+  void _delayMicroseconds(uint32_t usec) { _IRtimer_unittest_now += usec; }
+};
+
+TEST(TestLowLevelSend, CarrierLoopOverheadPerCycle) {
+  IRsendCarrierLoopTest irsend(0);
+  irsend.begin();
+  irsend.enableIROut(38000, 50);
+  const uint16_t kRuns = 200;
+  uint32_t cycles = 0;
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (uint16_t i = 0; i < kRuns; i++) cycles += irsend.mark(UINT16_MAX);
+  const double led_ns = std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - start).count() / cycles;
+
+  IRoutputMock mock;
+  start = std::chrono::steady_clock::now();
+  for (uint16_t i = 0; i < kRuns; i++) irsend.markWith(&mock, UINT16_MAX);
+  const double mock_ns = std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - start).count() / mock.ons;
+
+  EXPECT_EQ(cycles, mock.ons);
+  ::testing::Test::RecordProperty("led_ns_per_cycle", led_ns);
+  ::testing::Test::RecordProperty("policy_ns_per_cycle", mock_ns);
+}
+
 // Test expected to work/produce a message for simple irsend:send()
 TEST(TestSend, GenericSimpleSendMethod) {
   IRsendTest irsend(0);
@@ -863,3 +1107,387 @@ TEST(TestSendManchester, SendOverLargeData) {
       "m300",
       irsend.outputStr());
 }
+
+// Carrier sense (listen-before-talk) tests.
+
+// A capture driver that lets a test say when someone else is sending.
+class FakeChannel : public IRCaptureDriver {
+ public:
+  void start(const bool) {}
+  void stop(void) {}
+  // Someone starts sending. i.e. The receiver sees the start of a message.
+  void busy(void) {
+    const uint16_t header[2] = {9000, 4500};
+    deliver(header, 2, false);
+  }
+  // Their message ends & gets decoded.
+  void quiet(IRrecv *irrecv) {
+    const uint16_t footer[1] = {560};
+    deliver(footer, 1, true);
+    irrecv->resume();
+  }
+};
+
+// An IRsendTest where time passes while we wait for the channel, & the
+// channel changes state at given msecs into the wait.
+class IRsendCarrierTest : public IRsendTest {
+ public:
+  explicit IRsendCarrierTest(uint16_t pin) : IRsendTest(pin), waited(0),
+      channel(NULL), irrecv(NULL), busy_at(-1), quiet_at(-1),
+      busy_again_at(-1), quiet_again_at(-1) {}
+  void _delayMicroseconds(uint32_t usec) {
+    IRtimer::add(usec);
+    waited++;
+    if (waited == busy_at || waited == busy_again_at) channel->busy();
+    if (waited == quiet_at || waited == quiet_again_at)
+      channel->quiet(irrecv);
+  }
+  int32_t waited;
+  FakeChannel *channel;
+  IRrecv *irrecv;
+  int32_t busy_at;
+  int32_t quiet_at;
+  int32_t busy_again_at;
+  int32_t quiet_again_at;
+};
+
+TEST(TestCarrierSense, IsReceiving) {
+  FakeChannel channel;
+  IRrecv irrecv(1);
+  irrecv.setCaptureDriver(&channel);
+  irrecv.enableIRIn();
+  EXPECT_EQ(kTimeoutMs, irrecv.getTimeout());
+  EXPECT_FALSE(irrecv.isReceiving());
+  channel.busy();
+  EXPECT_TRUE(irrecv.isReceiving());
+  channel.quiet(&irrecv);
+  EXPECT_FALSE(irrecv.isReceiving());
+  irrecv.setCaptureDriver(NULL);
+}
+
+TEST(TestCarrierSense, SendsStraightAwayOnAQuietChannel) {
+  FakeChannel channel;
+  IRrecv irrecv(1);
+  irrecv.setCaptureDriver(&channel);
+  irrecv.enableIRIn();
+  IRsendCarrierTest irsend(0);
+  irsend.begin();
+
+  irsend.setCarrierSense(&irrecv);
+  irsend.sendNEC(0x00FF00FF);
+  EXPECT_EQ(
+      "f38000d33"
+      "m8960s4480m560s560m560s560m560s560m560s560m560s560m560s560m560s560"
+      "m560s560m560s1680m560s1680m560s1680m560s1680m560s1680m560s1680"
+      "m560s1680m560s1680m560s560m560s560m560s560m560s560m560s560m560s560"
+      "m560s560m560s560m560s1680m560s1680m560s1680m560s1680m560s1680"
+      "m560s1680m560s1680m560s1680m560s40320",
+      irsend.outputStr());
+  carrier_sense_stats_t stats = irsend.getCarrierSenseStats();
+  EXPECT_EQ(1, stats.checks);
+  EXPECT_EQ(0, stats.deferrals);
+  EXPECT_EQ(0, stats.forced);
+  EXPECT_EQ(0, irsend.waited);
+
+  // Not checked again until the receiver stops hearing our own message.
+  // (IRsendTest's mark() & space() don't note when we last sent, so only
+  //  the check itself counts here.)
+  irsend.enableIROut(38000);
+  EXPECT_EQ(2, irsend.getCarrierSenseStats().checks);
+  irsend.enableIROut(38000);
+  EXPECT_EQ(2, irsend.getCarrierSenseStats().checks);
+  IRtimer::add(MS_TO_USEC(kTimeoutMs));
+  irsend.enableIROut(38000);
+  EXPECT_EQ(3, irsend.getCarrierSenseStats().checks);
+
+  // The real mark() & space() note it.
+  IRsendLowLevelTest lowlevel(0);
+  lowlevel.begin();
+  lowlevel.setCarrierSense(&irrecv);
+  lowlevel.enableIROut(38000);
+  EXPECT_EQ(1, lowlevel.getCarrierSenseStats().checks);
+  lowlevel.mark(20000);
+  lowlevel.space(20000);
+  lowlevel.enableIROut(38000);
+  EXPECT_EQ(1, lowlevel.getCarrierSenseStats().checks);
+  lowlevel.space(MS_TO_USEC(kTimeoutMs));
+  lowlevel.enableIROut(38000);
+  EXPECT_EQ(1, lowlevel.getCarrierSenseStats().checks);
+  _IRtimer_unittest_now += MS_TO_USEC(kTimeoutMs);
+  lowlevel.enableIROut(38000);
+  EXPECT_EQ(2, lowlevel.getCarrierSenseStats().checks);
+
+  // Disabled.
+  irsend.setCarrierSense(NULL);
+  irsend.resetCarrierSenseStats();
+  channel.busy();
+  irsend.sendNEC(0x00FF00FF);
+  EXPECT_EQ(0, irsend.getCarrierSenseStats().checks);
+  EXPECT_EQ(0, irsend.waited);
+  irrecv.setCaptureDriver(NULL);
+}
+
+TEST(TestCarrierSense, DefersUntilTheChannelIsQuiet) {
+  FakeChannel channel;
+  IRrecv irrecv(1);
+  irrecv.setCaptureDriver(&channel);
+  irrecv.enableIRIn();
+  IRsendCarrierTest irsend(0);
+  irsend.begin();
+  irsend.channel = &channel;
+  irsend.irrecv = &irrecv;
+  irmetrics::reset();
+
+  irsend.setCarrierSense(&irrecv);
+  channel.busy();
+  irsend.quiet_at = 30;
+  irsend.reset();
+  irsend.sendNEC(0x00FF00FF);
+  EXPECT_FALSE(irrecv.isReceiving());
+  // The guard time, plus a backoff from the first window.
+  EXPECT_LE(30 + kCarrierSenseGuardMs, irsend.waited);
+  EXPECT_GT(30 + kCarrierSenseGuardMs + kCarrierSenseSlotMs + 1,
+            irsend.waited);
+  EXPECT_EQ("f38000d33m8960s4480", irsend.outputStr().substr(0, 19));
+  carrier_sense_stats_t stats = irsend.getCarrierSenseStats();
+  EXPECT_EQ(1, stats.checks);
+  EXPECT_EQ(1, stats.deferrals);
+  EXPECT_EQ(0, stats.backoffs);
+  EXPECT_EQ(0, stats.forced);
+  EXPECT_EQ(irsend.waited, stats.deferred_ms);
+  EXPECT_EQ(1, irmetrics::getCounter(irmetrics::kSendDeferrals));
+  EXPECT_EQ(0, irmetrics::getCounter(irmetrics::kSendForced));
+
+  // Someone sends again before the guard time is up, so we back off more.
+  IRtimer::add(MS_TO_USEC(kTimeoutMs));
+  irsend.resetCarrierSenseStats();
+  irsend.waited = 0;
+  channel.busy();
+  irsend.quiet_at = 10;
+  irsend.busy_again_at = 40;
+  irsend.quiet_again_at = 60;
+  irsend.sendNEC(0x00FF00FF);
+  EXPECT_LE(60 + kCarrierSenseGuardMs, irsend.waited);
+  EXPECT_GT(60 + kCarrierSenseGuardMs + 2 * kCarrierSenseSlotMs + 1,
+            irsend.waited);
+  stats = irsend.getCarrierSenseStats();
+  EXPECT_EQ(1, stats.deferrals);
+  EXPECT_EQ(1, stats.backoffs);
+  EXPECT_EQ(0, stats.forced);
+  irrecv.setCaptureDriver(NULL);
+}
+
+TEST(TestCarrierSense, LongerGuardForACs) {
+  FakeChannel channel;
+  IRrecv irrecv(1);
+  irrecv.setCaptureDriver(&channel);
+  irrecv.enableIRIn();
+  IRsendCarrierTest irsend(0);
+  irsend.begin();
+  irsend.channel = &channel;
+  irsend.irrecv = &irrecv;
+
+  EXPECT_EQ(kCarrierSenseGuardMs, IRsend::carrierSenseGuard(NEC));
+  EXPECT_EQ(kCarrierSenseAcGuardMs, IRsend::carrierSenseGuard(DAIKIN));
+  EXPECT_EQ(kCarrierSenseGuardMs, IRsend::carrierSenseGuard(COOLIX));
+
+  irsend.setCarrierSense(&irrecv);
+  channel.busy();
+  irsend.quiet_at = 10;
+  const uint8_t state[kDaikinStateLength] = {
+      0x11, 0xDA, 0x27, 0x00, 0xC5, 0x00, 0x00, 0xD7, 0x11, 0xDA, 0x27, 0x00,
+      0x42, 0x49, 0x05, 0xA2, 0x11, 0xDA, 0x27, 0x00, 0x00, 0x49, 0x1E, 0x00,
+      0xB0, 0x00, 0x00, 0x06, 0x60, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x4F};
+  EXPECT_TRUE(irsend.send(DAIKIN, state, kDaikinStateLength));
+  EXPECT_LE(10 + kCarrierSenseAcGuardMs, irsend.waited);
+  EXPECT_GT(10 + kCarrierSenseAcGuardMs + kCarrierSenseSlotMs + 1,
+            irsend.waited);
+
+  // A fixed guard time overrides the protocol's.
+  IRtimer::add(MS_TO_USEC(kTimeoutMs));
+  irsend.setCarrierSense(&irrecv, 20);
+  irsend.waited = 0;
+  channel.busy();
+  EXPECT_TRUE(irsend.send(DAIKIN, state, kDaikinStateLength));
+  EXPECT_LE(10 + 20, irsend.waited);
+  EXPECT_GT(10 + 20 + kCarrierSenseSlotMs + 1, irsend.waited);
+  irrecv.setCaptureDriver(NULL);
+}
+
+TEST(TestCarrierSense, GivesUpWaiting) {
+  FakeChannel channel;
+  IRrecv irrecv(1);
+  irrecv.setCaptureDriver(&channel);
+  irrecv.enableIRIn();
+  IRsendCarrierTest irsend(0);
+  irsend.begin();
+  irmetrics::reset();
+
+  irsend.setCarrierSense(&irrecv, kCarrierSenseGuardMs, 100);
+  channel.busy();  // & it never ends.
+  irsend.sendNEC(0x00FF00FF);
+  EXPECT_EQ(100, irsend.waited);
+  EXPECT_EQ("f38000d33m8960s4480", irsend.outputStr().substr(0, 19));
+  const carrier_sense_stats_t stats = irsend.getCarrierSenseStats();
+  EXPECT_EQ(1, stats.deferrals);
+  EXPECT_EQ(1, stats.forced);
+  EXPECT_EQ(100, stats.deferred_ms);
+  EXPECT_EQ(1, irmetrics::getCounter(irmetrics::kSendForced));
+  irrecv.setCaptureDriver(NULL);
+}
+
+// Counts the calls to mark() & space(), & notes if two in a row were of the
+// same level. i.e. A mark or space that should have been merged.
+class IRsendCountingTest : public IRsendTest {
+ public:
+  uint16_t marks;
+  uint16_t spaces;
+  bool repeated_level;
+
+  explicit IRsendCountingTest(uint16_t x) : IRsendTest(x) { resetCounts(); }
+
+  void resetCounts(void) {
+    reset();
+    marks = 0;
+    spaces = 0;
+    repeated_level = false;
+    _was_mark = false;
+    _started = false;
+  }
+
+  uint16_t mark(uint16_t usec) {
+    marks++;
+    if (_started && _was_mark) repeated_level = true;
+    _started = true;
+    _was_mark = true;
+    return IRsendTest::mark(usec);
+  }
+
+  void space(uint32_t time) {
+    spaces++;
+    if (_started && !_was_mark) repeated_level = true;
+    _started = true;
+    _was_mark = false;
+    IRsendTest::space(time);
+  }
+
+ private:
+  bool _was_mark;
+  bool _started;
+};
+
+// Every mark & space in the output took exactly one call to send.
+static void expectCoalesced(const IRsendCountingTest &irsend) {
+  EXPECT_FALSE(irsend.repeated_level);
+  EXPECT_EQ(irsend.last + 1, irsend.marks + irsend.spaces);
+}
+
+TEST(TestCoalescing, Queue) {
+  IRsendCountingTest irsend(0);
+  irsend.begin();
+  irsend.enableIROut(38000);
+  irsend.resetCounts();
+  irsend.queueMark(100);
+  irsend.queueMark(200);
+  irsend.queueSpace(0);  // Ignored.
+  irsend.queueMark(0);
+  irsend.queueMark(300);
+  EXPECT_EQ(0, irsend.marks);  // Nothing is sent until the level changes.
+  irsend.queueSpace(400);
+  EXPECT_EQ(1, irsend.marks);
+  EXPECT_EQ(0, irsend.spaces);
+  irsend.queueSpace(500);
+  EXPECT_EQ(900, irsend.flushQueuedMark());  // Only flushes a mark.
+  EXPECT_EQ(0, irsend.spaces);
+  irsend.flushQueued();
+  irsend.flushQueued();  // Nothing left to send.
+  EXPECT_EQ(1, irsend.spaces);
+  expectCoalesced(irsend);
+  EXPECT_EQ("f38000d50m600s900", irsend.outputStr());
+
+  // Marks longer than mark() can handle are split up.
+  irsend.resetCounts();
+  irsend.queueMark(UINT16_MAX);
+  irsend.queueMark(10);
+  irsend.flushQueued();
+  EXPECT_EQ(2, irsend.marks);
+  EXPECT_EQ("f38000d50m65545", irsend.outputStr());
+}
+
+TEST(TestCoalescing, GenericEncoders) {
+  IRsendCountingTest irsend(0);
+  irsend.begin();
+
+  // No footer mark, so the last data space & the gap are merged.
+  irsend.resetCounts();
+  irsend.sendGeneric(1000, 500, 100, 300, 100, 100, 0, 1000, 0b101, 3,
+                     38000, true, 0, 50);
+  expectCoalesced(irsend);
+  EXPECT_EQ("f38000d50m1000s500m100s300m100s100m100s1300", irsend.outputStr());
+
+  // Ditto for a message with a minimum length.
+  irsend.resetCounts();
+  irsend.sendGeneric(1000, 500, 100, 300, 100, 100, 0, 0, 6000, 0b101, 3,
+                     38000, true, 0, 50);
+  expectCoalesced(irsend);
+  EXPECT_EQ("f38000d50m1000s500m100s300m100s100m100s3800", irsend.outputStr());
+
+  // Zero length marks in the data merge the spaces either side of them.
+  irsend.resetCounts();
+  irsend.sendGeneric(1000, 500, 0, 300, 100, 100, 100, 200, 0b10, 2,
+                     38000, true, 0, 50);
+  expectCoalesced(irsend);
+  EXPECT_EQ("f38000d50m1000s800m100s100m100s200", irsend.outputStr());
+
+  // Manchester encoding.
+  irsend.resetCounts();
+  irsend.sendManchesterData(100, 0b0110, 4);
+  EXPECT_FALSE(irsend.repeated_level);
+  EXPECT_EQ(6, irsend.marks + irsend.spaces);  // Rather than one per half bit.
+  EXPECT_EQ("f38000d50m0s100m200s100m100s200m100", irsend.outputStr());
+
+  irsend.resetCounts();
+  irsend.sendManchester(300, 200, 100, 400, 1000, 0b1001, 4);
+  expectCoalesced(irsend);
+  EXPECT_EQ("f38000d50m300s200m100s200m100s100m200s100m400s1000",
+            irsend.outputStr());
+
+  // A raw message with some zero lengths in it.
+  irsend.resetCounts();
+  const uint16_t raw[8] = {100, 200, 0, 300, 400, 0, 500, 600};
+  irsend.sendRaw(raw, 8, 38);
+  expectCoalesced(irsend);
+  EXPECT_EQ("f38000d50m100s500m900s600", irsend.outputStr());
+}
+
+TEST(TestCoalescing, Protocols) {
+  IRsendCountingTest irsend(0);
+  irsend.begin();
+
+  irsend.resetCounts();
+  irsend.sendRC5(0x175, kRC5Bits);
+  expectCoalesced(irsend);
+  // One call per level change, rather than one per half bit.
+  EXPECT_GT(2 * (kRC5Bits + 1), irsend.marks + irsend.spaces);
+
+  irsend.resetCounts();
+  irsend.sendRC6(0x175, kRC6Mode0Bits);
+  expectCoalesced(irsend);
+
+  irsend.resetCounts();
+  irsend.sendAirwell(0x2B0D0181B, kAirwellBits, 1);
+  expectCoalesced(irsend);
+
+  irsend.resetCounts();
+  irsend.sendBose(0xCD32);
+  expectCoalesced(irsend);
+
+  irsend.resetCounts();
+  irsend.sendLasertag(0x01);
+  expectCoalesced(irsend);
+
+  irsend.resetCounts();
+  const uint8_t mwm[3] = {0x96, 0x19, 0x10};
+  irsend.sendMWM(mwm, 3, 0);
+  expectCoalesced(irsend);
+}
@@ -0,0 +1,162 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include "IRac.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRsensor.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRSensorReporter class.
+
+TEST(TestIRSensorReporter, Supported) {
+  EXPECT_TRUE(IRSensorReporter::isProtocolSupported(decode_type_t::MIDEA));
+  EXPECT_TRUE(IRSensorReporter::isProtocolSupported(decode_type_t::COOLIX));
+  EXPECT_TRUE(IRSensorReporter::isProtocolSupported(decode_type_t::ARGO));
+  // Gree only has an iFeel flag, not a way to send the temperature.
+  EXPECT_FALSE(IRSensorReporter::isProtocolSupported(decode_type_t::GREE));
+  EXPECT_FALSE(IRSensorReporter::isProtocolSupported(decode_type_t::NEC));
+
+  IRsendTest irsend(0);
+  IRSensorReporter reporter(2);
+  EXPECT_EQ(kSensorNoUnit, reporter.addUnit(NULL, decode_type_t::MIDEA));
+  EXPECT_EQ(kSensorNoUnit, reporter.addUnit(&irsend, decode_type_t::GREE));
+  EXPECT_EQ(0, reporter.addUnit(&irsend, decode_type_t::MIDEA));
+  EXPECT_EQ(1, reporter.addUnit(&irsend, decode_type_t::COOLIX));
+  EXPECT_EQ(kSensorNoUnit, reporter.addUnit(&irsend, decode_type_t::ARGO));
+  EXPECT_EQ(2, reporter.getUnits());
+  EXPECT_FALSE(reporter.setTemp(2, 20));
+  // Base states must be the right kind for the protocol.
+  const uint8_t state[kArgoStateLength] = {0};
+  EXPECT_FALSE(reporter.setBaseState(0, state, kArgoStateLength));
+  EXPECT_TRUE(reporter.setBaseState(0, 0xA18263FFFF6EULL));
+}
+
+TEST(TestIRSensorReporter, MideaFollowMe) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  IRSensorReporter reporter(1);
+  irsend.begin();
+  reporter.poll(0);
+  const int16_t unit = reporter.addUnit(&irsend, decode_type_t::MIDEA);
+  // No temperature yet, so nothing to send.
+  EXPECT_FALSE(reporter.isDue(unit, 0));
+  EXPECT_EQ(0, reporter.poll(0));
+
+  reporter.setTemp(unit, 22.6);
+  EXPECT_TRUE(reporter.isDue(unit, 0));
+  irsend.reset();
+  EXPECT_EQ(1, reporter.poll(0));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::MIDEA, irsend.capture.decode_type);
+  IRMideaAC ac(0);
+  ac.setRaw(irsend.capture.value);
+  EXPECT_EQ(kMideaACTypeFollow, ac.getType());
+  EXPECT_TRUE(ac.getEnableSensorTemp());
+  EXPECT_EQ(23, ac.getSensorTemp(true));
+  EXPECT_EQ(1, reporter.getReportsSent());
+
+  // Small changes aren't worth a report.
+  reporter.setTemp(unit, 22.9);
+  EXPECT_EQ(0, reporter.poll(1000));
+  // Big ones are.
+  reporter.setTemp(unit, 23.2);
+  EXPECT_EQ(1, reporter.poll(2000));
+  // Nothing changes, but the refresh deadline approaches.
+  const uint32_t deadline = 2000 + kSensorMideaRefreshMs -
+      kSensorMideaRefreshMs / kSensorRefreshLeadDivisor;
+  EXPECT_EQ(0, reporter.poll(deadline - 1));
+  EXPECT_EQ(1, reporter.poll(deadline));
+  EXPECT_EQ(3, reporter.getReportsSent());
+}
+
+TEST(TestIRSensorReporter, CoolixMinInterval) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  IRSensorReporter reporter(1);
+  irsend.begin();
+  reporter.poll(0);
+  const int16_t unit = reporter.addUnit(&irsend, decode_type_t::COOLIX, 1000);
+  reporter.setTemp(unit, 19);
+  irsend.reset();
+  EXPECT_EQ(1, reporter.poll(0));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::COOLIX, irsend.capture.decode_type);
+  IRCoolixAC ac(0);
+  ac.setRaw(irsend.capture.value);
+  EXPECT_EQ(19, ac.getSensorTemp());
+  EXPECT_TRUE(ac.getZoneFollow());
+  // Even a big change has to wait for the unit to listen again.
+  reporter.setTemp(unit, 25);
+  EXPECT_FALSE(reporter.isDue(unit, kSensorCoolixMinIntervalMs - 1));
+  EXPECT_EQ(0, reporter.poll(kSensorCoolixMinIntervalMs - 1));
+  EXPECT_EQ(1, reporter.poll(kSensorCoolixMinIntervalMs));
+}
+
+TEST(TestIRSensorReporter, MaxTemp) {
+  EXPECT_EQ(kArgoMaxRoomTemp,
+            IRSensorReporter::maxTemp(decode_type_t::ARGO));
+  EXPECT_EQ(kCoolixSensorTempMax,
+            IRSensorReporter::maxTemp(decode_type_t::COOLIX));
+  EXPECT_EQ(kMideaACMaxSensorTempC,
+            IRSensorReporter::maxTemp(decode_type_t::MIDEA));
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  IRSensorReporter reporter(1);
+  irsend.begin();
+  const int16_t unit = reporter.addUnit(&irsend, decode_type_t::COOLIX);
+  // Too hot to fit in a byte. It mustn't wrap around to 20C.
+  reporter.setTemp(unit, 276);
+  irsend.reset();
+  EXPECT_EQ(1, reporter.poll(0));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  IRCoolixAC ac(0);
+  ac.setRaw(irsend.capture.value);
+  EXPECT_EQ(kCoolixSensorTempMax, ac.getSensorTemp());
+}
+
+TEST(TestIRSensorReporter, ArgoIFeel) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  IRSensorReporter reporter(1);
+  irsend.begin();
+  const int16_t unit = reporter.addUnit(&irsend, decode_type_t::ARGO);
+  IRArgoAC base(0);
+  base.setTemp(26);
+  EXPECT_TRUE(reporter.setBaseState(unit, base.getRaw(), kArgoStateLength));
+  reporter.setTemp(unit, 28);
+  irsend.reset();
+  EXPECT_EQ(1, reporter.poll(0));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::ARGO, irsend.capture.decode_type);
+  IRArgoAC ac(0);
+  ac.setRaw(irsend.capture.state);
+  EXPECT_TRUE(ac.getiFeel());
+  EXPECT_EQ(28, ac.getRoomTemp());
+  EXPECT_EQ(26, ac.getTemp());  // The unit's other settings are kept.
+}
+
+TEST(TestIRSensorReporter, SpreadAcrossEmitters) {
+  IRsendTest east(0), west(1);
+  IRSensorReporter reporter(6, 500);
+  reporter.poll(0);
+  int16_t units[6];
+  for (uint8_t i = 0; i < 6; i++) {
+    units[i] = reporter.addUnit(i % 2 ? &west : &east, decode_type_t::MIDEA);
+    reporter.setTemp(units[i], 20 + i);
+  }
+  // One report per emitter per gap.
+  EXPECT_EQ(2, reporter.poll(0));
+  EXPECT_EQ(0, reporter.poll(499));
+  EXPECT_EQ(2, reporter.poll(500));
+  EXPECT_EQ(2, reporter.poll(1000));
+  EXPECT_EQ(0, reporter.poll(1500));  // Everyone is up to date.
+  EXPECT_EQ(6, reporter.getReportsSent());
+  for (uint8_t i = 0; i < 6; i++) EXPECT_FALSE(reporter.isDue(units[i], 1500));
+}
@@ -0,0 +1,251 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+#include "IRtranslate.h"
+#include "IRrecv.h"
+#include "IRrecv_test.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "gtest/gtest.h"
+
+// Tests for the IRTranslator class.
+
+// Make a decode_results for a simple message. As IRrecv would.
+static decode_results message(const decode_type_t protocol,
+                              const uint64_t value, const uint16_t nbits) {
+  decode_results results;
+  results.decode_type = protocol;
+  results.value = value;
+  results.bits = nbits;
+  results.repeat = false;
+  return results;
+}
+
+// Decode what was sent, & check it is what we expected.
+static void expectSent(IRrecv *irrecv, IRsendTest *irsend,
+                       const decode_type_t protocol, const uint64_t value,
+                       const uint16_t nbits) {
+  irsend->makeDecodeResult();
+  ASSERT_TRUE(irrecv->decode(&irsend->capture));
+  EXPECT_EQ(protocol, irsend->capture.decode_type);
+  EXPECT_EQ(nbits, irsend->capture.bits);
+  EXPECT_EQ(value, irsend->capture.value);
+  irsend->reset();
+}
+
+TEST(TestIRTranslator, Targets) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  IRTranslator translator(&irsend, 8, 4);
+  EXPECT_EQ(0, translator.countTargets());
+  // A simple value.
+  const int16_t sony = translator.addTarget(decode_type_t::SONY, 0xA90,
+                                            kSony12Bits, 2);
+  EXPECT_EQ(0, sony);
+  // An A/C's state.
+  const uint8_t state[kKelvinatorStateLength] = {
+      0x19, 0x0B, 0x80, 0x50, 0x00, 0x00, 0x00, 0xE0,
+      0x19, 0x0B, 0x80, 0x70, 0x00, 0x00, 0x10, 0xF0};
+  const int16_t kelvinator = translator.addTarget(decode_type_t::KELVINATOR,
+                                                  state, sizeof(state));
+  EXPECT_EQ(1, kelvinator);
+  // A pre-rendered pulse train.
+  const uint16_t raw[3] = {1000, 2000, 3000};
+  const int16_t pulses = translator.addRawTarget(raw, 3, 36000);
+  EXPECT_EQ(2, pulses);
+  // Mismatched kinds of targets, & protocols we can't send, are rejected.
+  EXPECT_EQ(kTranslateNoTarget, translator.addTarget(
+      decode_type_t::KELVINATOR, 0x1, 8));
+  EXPECT_EQ(kTranslateNoTarget, translator.addTarget(
+      decode_type_t::SONY, state, sizeof(state)));
+  EXPECT_EQ(kTranslateNoTarget, translator.addTarget(
+      decode_type_t::UNKNOWN, 0x1, 8));
+  EXPECT_EQ(kTranslateNoTarget, translator.addRawTarget(NULL, 3, 38000));
+  EXPECT_EQ(3, translator.countTargets());
+
+  ASSERT_TRUE(translator.sendTarget(sony));
+  expectSent(&irrecv, &irsend, decode_type_t::SONY, 0xA90, kSony12Bits);
+  ASSERT_TRUE(translator.sendTarget(kelvinator));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(decode_type_t::KELVINATOR, irsend.capture.decode_type);
+  EXPECT_STATE_EQ(state, irsend.capture.state, kKelvinatorBits);
+  irsend.reset();
+  ASSERT_TRUE(translator.sendTarget(pulses));
+  EXPECT_EQ("f36000d50m1000s2000m3000", irsend.outputStr());
+  EXPECT_FALSE(translator.sendTarget(3));
+  EXPECT_FALSE(translator.sendTarget(kTranslateNoTarget));
+
+  // Full.
+  EXPECT_EQ(3, translator.addTarget(decode_type_t::NEC, 0x1, 32));
+  EXPECT_EQ(kTranslateNoTarget, translator.addTarget(decode_type_t::NEC, 0x2,
+                                                     32));
+}
+
+TEST(TestIRTranslator, Keys) {
+  const uint64_t nec = IRTranslator::key(decode_type_t::NEC, 0x1, 32);
+  EXPECT_NE(0, nec);
+  EXPECT_EQ(nec, IRTranslator::key(decode_type_t::NEC, 0x1, 32));
+  // Every part of the message matters.
+  EXPECT_NE(nec, IRTranslator::key(decode_type_t::NEC, 0x2, 32));
+  EXPECT_NE(nec, IRTranslator::key(decode_type_t::NEC, 0x1, 16));
+  EXPECT_NE(nec, IRTranslator::key(decode_type_t::SONY, 0x1, 32));
+  decode_results results = message(decode_type_t::NEC, 0x1, 32);
+  EXPECT_EQ(nec, IRTranslator::key(&results));
+  EXPECT_EQ(0, IRTranslator::key(NULL));
+
+  // States use all of their bytes.
+  uint8_t state[kKelvinatorStateLength] = {0};
+  const uint64_t kelvinator = IRTranslator::key(decode_type_t::KELVINATOR,
+                                                state, sizeof(state));
+  results.decode_type = decode_type_t::KELVINATOR;
+  results.bits = kKelvinatorBits;
+  memcpy(results.state, state, sizeof(state));
+  EXPECT_EQ(kelvinator, IRTranslator::key(&results));
+  results.state[kKelvinatorStateLength - 1] = 1;
+  EXPECT_NE(kelvinator, IRTranslator::key(&results));
+}
+
+TEST(TestIRTranslator, Translate) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  IRTranslator translator(&irsend, 8, 4);
+  const int16_t volume = translator.addTarget(decode_type_t::SONY, 0x490,
+                                              kSony12Bits);
+  const int16_t power = translator.addTarget(decode_type_t::SONY, 0xA90,
+                                             kSony12Bits);
+  EXPECT_TRUE(translator.map(decode_type_t::NEC, 0x20DF40BF, kNECBits,
+                             volume));
+  EXPECT_TRUE(translator.map(decode_type_t::NEC, 0x20DF10EF, kNECBits, power,
+                             kTranslateHoldIgnore));
+  EXPECT_EQ(2, translator.countMappings());
+  // Targets must exist.
+  EXPECT_FALSE(translator.map(decode_type_t::NEC, 0x1, kNECBits, 2));
+
+  decode_results results = message(decode_type_t::NEC, 0x20DF40BF, kNECBits);
+  EXPECT_EQ(volume, translator.lookup(&results));
+  EXPECT_EQ(volume, translator.translate(&results, 1000));
+  expectSent(&irrecv, &irsend, decode_type_t::SONY, 0x490, kSony12Bits);
+
+  // The button is held, & the remote sends NEC repeat codes.
+  decode_results repeat = message(decode_type_t::NEC, kRepeat, 0);
+  repeat.repeat = true;
+  EXPECT_EQ(volume, translator.translate(&repeat, 1110));
+  expectSent(&irrecv, &irsend, decode_type_t::SONY, 0x490, kSony12Bits);
+  EXPECT_EQ(volume, translator.translate(&repeat, 1220));
+  irsend.reset();
+  // It was let go a while ago. A stray repeat code is for nothing.
+  EXPECT_EQ(kTranslateNoTarget, translator.translate(&repeat, 5000));
+  EXPECT_EQ("", irsend.outputStr());
+
+  // A toggle is only sent once, however long it is held.
+  results = message(decode_type_t::NEC, 0x20DF10EF, kNECBits);
+  EXPECT_EQ(power, translator.translate(&results, 6000));
+  expectSent(&irrecv, &irsend, decode_type_t::SONY, 0xA90, kSony12Bits);
+  EXPECT_EQ(kTranslateNoTarget, translator.translate(&repeat, 6110));
+  // Some remotes repeat the whole message instead.
+  EXPECT_EQ(kTranslateNoTarget, translator.translate(&results, 6220));
+  EXPECT_EQ(kTranslateNoTarget, translator.translate(&results, 6330));
+  EXPECT_EQ("", irsend.outputStr());
+  // Pressed again.
+  EXPECT_EQ(power, translator.translate(&results, 7000));
+  expectSent(&irrecv, &irsend, decode_type_t::SONY, 0xA90, kSony12Bits);
+
+  // Not mapped.
+  results = message(decode_type_t::NEC, 0x1, kNECBits);
+  EXPECT_EQ(kTranslateNoTarget, translator.translate(&results, 8000));
+  EXPECT_EQ(kTranslateNoTarget, translator.translate(&repeat, 8100));
+  EXPECT_EQ(kTranslateNoTarget, translator.translate(NULL, 8200));
+  EXPECT_EQ("", irsend.outputStr());
+
+  const translate_stats_t stats = translator.getStats();
+  EXPECT_EQ(3, stats.translated);
+  EXPECT_EQ(2, stats.repeated);
+  EXPECT_EQ(3, stats.suppressed);
+  EXPECT_EQ(3, stats.unmapped);
+  translator.resetStats();
+  EXPECT_EQ(0, translator.getStats().translated);
+}
+
+// Learned codes from a remote we don't have a decoder for.
+TEST(TestIRTranslator, UnknownSource) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(0);
+  irsend.begin();
+  irrecv.setUnknownFingerprint(true);
+  IRTranslator translator(&irsend, 8, 4);
+  const int16_t target = translator.addTarget(decode_type_t::NEC, 0x20DF10EF,
+                                              kNECBits);
+  const uint16_t raw[9] = {3000, 1000, 500, 1500, 500, 500, 500, 1500, 500};
+  irsend.sendRaw(raw, 9, 38);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  EXPECT_TRUE(translator.map(irsend.capture.decode_type, irsend.capture.value,
+                             irsend.capture.bits, target));
+
+  // A slightly different capture of the same button.
+  const uint16_t again[9] = {3050, 980, 520, 1470, 490, 510, 530, 1520, 480};
+  irsend.reset();
+  irsend.sendRaw(again, 9, 38);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  decode_results results = irsend.capture;
+  const uint16_t again_bits = results.bits;
+  irsend.reset();
+  EXPECT_EQ(target, translator.translate(&results, 0));
+  expectSent(&irrecv, &irsend, decode_type_t::NEC, 0x20DF10EF, kNECBits);
+
+  // The same button again, with a short noise pulse after it.
+  const uint16_t noisy[11] = {3000, 1000, 500, 1500, 500, 500, 500, 1500, 500,
+                              20000, 40};
+  irsend.reset();
+  irsend.sendRaw(noisy, 11, 38);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHash(&irsend.capture));
+  results = irsend.capture;
+  EXPECT_NE(results.bits, again_bits);  // The raw length has changed.
+  irsend.reset();
+  EXPECT_EQ(target, translator.translate(&results, 1000));
+  expectSent(&irrecv, &irsend, decode_type_t::NEC, 0x20DF10EF, kNECBits);
+}
+
+// Lots of mappings, added & removed in any order, are all still found.
+TEST(TestIRTranslator, ManyMappings) {
+  const uint16_t kMappings = 4000;
+  IRsendTest irsend(0);
+  IRTranslator translator(&irsend, kMappings, 16);
+  for (uint8_t i = 0; i < 16; i++)
+    translator.addTarget(decode_type_t::NEC, i, kNECBits);
+  for (uint16_t i = 0; i < kMappings; i++)
+    ASSERT_TRUE(translator.map(decode_type_t::NEC, i * 7919 + 1, kNECBits,
+                               i % 16));
+  EXPECT_EQ(kMappings, translator.countMappings());
+  // Full.
+  EXPECT_FALSE(translator.map(decode_type_t::NEC, 0xFFFFFFFF, kNECBits, 0));
+  // Mapping the same message again replaces its target.
+  EXPECT_TRUE(translator.map(decode_type_t::NEC, 1, kNECBits, 15));
+  EXPECT_EQ(15, translator.lookup(IRTranslator::key(decode_type_t::NEC, 1,
+                                                    kNECBits)));
+  EXPECT_TRUE(translator.map(decode_type_t::NEC, 1, kNECBits, 0));
+  EXPECT_EQ(kMappings, translator.countMappings());
+
+  // Remove every third one.
+  for (uint16_t i = 0; i < kMappings; i += 3)
+    EXPECT_TRUE(translator.unmap(IRTranslator::key(decode_type_t::NEC,
+                                                   i * 7919 + 1, kNECBits)));
+  EXPECT_FALSE(translator.unmap(IRTranslator::key(decode_type_t::NEC, 1,
+                                                  kNECBits)));
+  EXPECT_EQ(kMappings - (kMappings + 2) / 3, translator.countMappings());
+  for (uint16_t i = 0; i < kMappings; i++)
+    EXPECT_EQ(i % 3 ? i % 16 : kTranslateNoTarget,
+              translator.lookup(IRTranslator::key(decode_type_t::NEC,
+                                                  i * 7919 + 1, kNECBits)))
+        << i;
+  // There is room again.
+  EXPECT_TRUE(translator.map(decode_type_t::NEC, 0xFFFFFFFF, kNECBits, 1));
+  EXPECT_EQ(1, translator.lookup(IRTranslator::key(decode_type_t::NEC,
+                                                   0xFFFFFFFF, kNECBits)));
+}
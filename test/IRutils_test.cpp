@@ -6,6 +6,7 @@
 #include "IRrecv_test.h"
 #include "IRsend.h"
 #include "IRsend_test.h"
+#include "IRtext.h"
 #include "gtest/gtest.h"
 
 // Tests reverseBits().
@@ -122,6 +123,9 @@ TEST(TestGetCorrectedRawLength, WithLargeValues) {
   EXPECT_EQ(7 + 2 * 2, getCorrectedRawLength(&irsend.capture));
   irsend.capture.rawbuf[4] = UINT16_MAX;
   EXPECT_EQ(7 + 2 * 2, getCorrectedRawLength(&irsend.capture));
+  // The last entry counts too.
+  irsend.capture.rawbuf[7] = 60000;
+  EXPECT_EQ(7 + 2 * 3, getCorrectedRawLength(&irsend.capture));
 }
 
 TEST(TestResultToSourceCode, SimpleTests) {
@@ -504,6 +508,47 @@ TEST(TestUtils, TypeStringConversionRangeTests) {
   }
 }
 
+TEST(TestUtils, TypeToName) {
+  char name[32];
+  // Every name, including those either side of an index block boundary.
+  EXPECT_EQ(strlen(D_STR_UNUSED), typeToName(decode_type_t::UNUSED, name,
+                                             sizeof(name)));
+  EXPECT_STREQ(D_STR_UNUSED, name);
+  typeToName(decode_type_t::COOLIX, name, sizeof(name));
+  EXPECT_STREQ(D_STR_COOLIX, name);
+  typeToName(decode_type_t::DAIKIN, name, sizeof(name));
+  EXPECT_STREQ(D_STR_DAIKIN, name);
+  typeToName(decode_type_t::MITSUBISHI_HEAVY_152, name, sizeof(name));
+  EXPECT_STREQ(D_STR_MITSUBISHI_HEAVY_152, name);
+  typeToName(decode_type_t::HITACHI_AC424, name, sizeof(name));
+  EXPECT_STREQ(D_STR_HITACHI_AC424, name);
+  typeToName(kLastDecodeType, name, sizeof(name));
+  EXPECT_STREQ(D_STR_RHOSS, name);
+  for (int i = 0; i <= kLastDecodeType; i++) {
+    const uint16_t length = typeToName((decode_type_t)i, name, sizeof(name));
+    EXPECT_EQ(strlen(name), length);
+    EXPECT_EQ(typeToString((decode_type_t)i), name);
+  }
+  // Truncation.
+  char small[7];
+  EXPECT_EQ(strlen(D_STR_MITSUBISHI_AC),
+            typeToName(decode_type_t::MITSUBISHI_AC, small, sizeof(small)));
+  EXPECT_STREQ("MITSUB", small);
+  EXPECT_EQ(strlen(D_STR_NEC), typeToName(decode_type_t::NEC, small, 1));
+  EXPECT_STREQ("", small);
+  EXPECT_EQ(0, typeToName(decode_type_t::NEC, small, 0));
+  EXPECT_EQ(0, typeToName(decode_type_t::NEC, NULL, 10));
+  // Unknown protocols.
+  EXPECT_EQ(0, typeToName(decode_type_t::UNKNOWN, name, sizeof(name)));
+  EXPECT_STREQ("", name);
+  EXPECT_EQ(0, typeToName((decode_type_t)(kLastDecodeType + 1), name,
+                          sizeof(name)));
+  // Look ups are case insensitive.
+  EXPECT_EQ(decode_type_t::MITSUBISHI_HEAVY_88,
+            strToDecodeType("mitsubishi_heavy_88"));
+  EXPECT_EQ(decode_type_t::UNUSED, strToDecodeType("Unused"));
+}
+
 TEST(TestUtils, MinsToString) {
   EXPECT_EQ("00:00", irutils::minsToString(0));
   EXPECT_EQ("00:01", irutils::minsToString(1));
@@ -777,6 +822,22 @@ TEST(TestUtils, InvertedBytePairs) {
   EXPECT_STATE_EQ(correct, wrong, 6 * 8);
 }
 
+TEST(TestUtils, validTopicName) {
+  EXPECT_TRUE(irutils::validTopicName("kitchen", 31, ","));
+  EXPECT_TRUE(irutils::validTopicName("node:1", 31, ","));
+  EXPECT_FALSE(irutils::validTopicName("node:1", 31, ",:"));
+  EXPECT_FALSE(irutils::validTopicName("a,b", 31, ","));
+  // MQTT's special characters are never allowed.
+  EXPECT_FALSE(irutils::validTopicName("a/b", 31, NULL));
+  EXPECT_FALSE(irutils::validTopicName("a+", 31, NULL));
+  EXPECT_FALSE(irutils::validTopicName("#", 31, NULL));
+  // Too short or long.
+  EXPECT_FALSE(irutils::validTopicName(NULL, 31, NULL));
+  EXPECT_FALSE(irutils::validTopicName("", 31, NULL));
+  EXPECT_TRUE(irutils::validTopicName("abcd", 4, NULL));
+  EXPECT_FALSE(irutils::validTopicName("abcde", 4, NULL));
+}
+
 TEST(TestUtils, lowLevelSanityCheck) {
   ASSERT_EQ(0, irutils::lowLevelSanityCheck());
 }
@@ -1,4 +1,5 @@
 // Copyright 2017-2019 David Conran
+#include <cstring>
 #include "ir_Daikin.h"
 #include "IRac.h"
 #include "IRrecv.h"
@@ -3879,3 +3880,91 @@ TEST(TestDaikin176Class, UnitId) {
   ASSERT_EQ(0, ac.getId());
   EXPECT_STATE_EQ(unita, ac.getRaw(), kDaikin176Bits);
 }
+
+// Only the sections that changed have their checksums redone.
+TEST(TestDaikinClass, DirtySections) {
+  IRDaikinESP ac(kGpioUnused);
+  ac.begin();
+  uint8_t before[kDaikinStateLength];
+  std::memcpy(before, ac.getRaw(), kDaikinStateLength);
+  EXPECT_TRUE(IRDaikinESP::validChecksum(before));
+  // Nothing changed, so nothing changes.
+  EXPECT_STATE_EQ(before, ac.getRaw(), kDaikinBits);
+
+  ac.setCurrentTime(123);  // Section #2 only.
+  const uint8_t *after = ac.getRaw();
+  EXPECT_TRUE(IRDaikinESP::validChecksum(ac.getRaw()));
+  EXPECT_EQ(before[kDaikinByteChecksum1], after[kDaikinByteChecksum1]);
+  EXPECT_NE(before[kDaikinByteChecksum2], after[kDaikinByteChecksum2]);
+  EXPECT_EQ(before[kDaikinStateLength - 1], after[kDaikinStateLength - 1]);
+
+  ac.setComfort(true);  // Section #1 only.
+  ac.setTemp(27);  // Section #3 only.
+  EXPECT_TRUE(IRDaikinESP::validChecksum(ac.getRaw()));
+  EXPECT_NE(before[kDaikinByteChecksum1], after[kDaikinByteChecksum1]);
+  EXPECT_NE(before[kDaikinStateLength - 1], after[kDaikinStateLength - 1]);
+
+  // Raw states are always checksummed in full.
+  before[kDaikinByteChecksum1]++;
+  before[kDaikinByteChecksum2]++;
+  before[kDaikinStateLength - 1]++;
+  ac.setRaw(before);
+  EXPECT_TRUE(IRDaikinESP::validChecksum(ac.getRaw()));
+}
+
+// Send an A/C's default state.
+template <class AC>
+static void sendDefaultState(IRsendTest *irsend, const decode_type_t protocol,
+                             const uint16_t nbytes) {
+  AC ac(kGpioUnused);
+  ac.begin();
+  irsend->reset();
+  irsend->send(protocol, ac.getRaw(), nbytes);
+  irsend->makeDecodeResult();
+}
+
+TEST(TestDecodeDaikinFamily, EveryVariant) {
+  IRsendTest irsend(kGpioUnused);
+  IRrecv irrecv(kGpioUnused);
+  irsend.begin();
+
+  sendDefaultState<IRDaikinESP>(&irsend, DAIKIN, kDaikinStateLength);
+  ASSERT_TRUE(irrecv.decodeDaikinFamily(&irsend.capture));
+  EXPECT_EQ(DAIKIN, irsend.capture.decode_type);
+  sendDefaultState<IRDaikin2>(&irsend, DAIKIN2, kDaikin2StateLength);
+  ASSERT_TRUE(irrecv.decodeDaikinFamily(&irsend.capture));
+  EXPECT_EQ(DAIKIN2, irsend.capture.decode_type);
+  sendDefaultState<IRDaikin216>(&irsend, DAIKIN216, kDaikin216StateLength);
+  ASSERT_TRUE(irrecv.decodeDaikinFamily(&irsend.capture));
+  EXPECT_EQ(DAIKIN216, irsend.capture.decode_type);
+  sendDefaultState<IRDaikin160>(&irsend, DAIKIN160, kDaikin160StateLength);
+  ASSERT_TRUE(irrecv.decodeDaikinFamily(&irsend.capture));
+  EXPECT_EQ(DAIKIN160, irsend.capture.decode_type);
+  sendDefaultState<IRDaikin176>(&irsend, DAIKIN176, kDaikin176StateLength);
+  ASSERT_TRUE(irrecv.decodeDaikinFamily(&irsend.capture));
+  EXPECT_EQ(DAIKIN176, irsend.capture.decode_type);
+  sendDefaultState<IRDaikin128>(&irsend, DAIKIN128, kDaikin128StateLength);
+  ASSERT_TRUE(irrecv.decodeDaikinFamily(&irsend.capture));
+  EXPECT_EQ(DAIKIN128, irsend.capture.decode_type);
+  sendDefaultState<IRDaikin152>(&irsend, DAIKIN152, kDaikin152StateLength);
+  ASSERT_TRUE(irrecv.decodeDaikinFamily(&irsend.capture));
+  EXPECT_EQ(DAIKIN152, irsend.capture.decode_type);
+
+  IRDaikin64 ac(kGpioUnused);
+  ac.begin();
+  irsend.reset();
+  irsend.sendDaikin64(ac.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeDaikinFamily(&irsend.capture));
+  EXPECT_EQ(DAIKIN64, irsend.capture.decode_type);
+  EXPECT_EQ(ac.getRaw(), irsend.capture.value);
+
+  // Not a Daikin.
+  irsend.reset();
+  irsend.sendNEC(0x20DF10EF);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decodeDaikinFamily(&irsend.capture));
+  // Too short to hold anything.
+  irsend.capture.rawlen = kStartOffset + 1;
+  EXPECT_FALSE(irrecv.decodeDaikinFamily(&irsend.capture));
+}
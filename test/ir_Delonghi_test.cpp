@@ -57,7 +57,7 @@ TEST(TestDecodeDelonghiAc, RealExample) {
       592};
 
   irsend.reset();
-  irsend.sendRaw(rawData, 263, 38000);
+  irsend.sendRaw(rawData, 131, 38000);
   irsend.makeDecodeResult();
   ASSERT_TRUE(irrecv.decode(&irsend.capture));
   EXPECT_EQ(DELONGHI_AC, irsend.capture.decode_type);
@@ -47,7 +47,7 @@ TEST(TestDecodeDoshisha, RealExample) {
 
   irsend.begin();
   irsend.reset();
-  irsend.sendRaw(rawData_2, 175, 38);
+  irsend.sendRaw(rawData_2, 83, 38);
   irsend.makeDecodeResult();
 
   ASSERT_TRUE(irrecv.decode(&irsend.capture));
@@ -69,7 +69,7 @@ TEST(TestDecodeDoshisha, RealExample) {
       446};  // DOSHISHA 800B3048A0
   irsend.begin();
   irsend.reset();
-  irsend.sendRaw(rawData_4, 175, 38);
+  irsend.sendRaw(rawData_4, 83, 38);
   irsend.makeDecodeResult();
 
   ASSERT_TRUE(irrecv.decode(&irsend.capture));
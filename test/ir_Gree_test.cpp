@@ -1,5 +1,6 @@
 // Copyright 2017 David Conran
 
+#include <cstring>
 #include "ir_Gree.h"
 #include "IRac.h"
 #include "IRrecv.h"
@@ -761,3 +762,26 @@ TEST(TestGreeClass, DisplayTempSource) {
   ac.setRaw(state);
   EXPECT_EQ(2, ac.getDisplayTempSource());
 }
+
+// The derived bits & checksum are only redone when something changes.
+TEST(TestGreeClass, DirtyState) {
+  IRGreeAC ac(kGpioUnused, gree_ac_remote_model_t::YAW1F);
+  ac.begin();
+  ac.on();
+  uint8_t before[kGreeStateLength];
+  std::memcpy(before, ac.getRaw(), kGreeStateLength);
+  EXPECT_TRUE(IRGreeAC::validChecksum(before));
+  EXPECT_STATE_EQ(before, ac.getRaw(), kGreeBits);
+
+  // Changing the model changes the power bits, even though the power didn't.
+  ac.setModel(gree_ac_remote_model_t::YBOFB);
+  EXPECT_TRUE(IRGreeAC::validChecksum(ac.getRaw()));
+  EXPECT_NE(before[2], ac.getRaw()[2]);
+  ac.setModel(gree_ac_remote_model_t::YAW1F);
+  EXPECT_STATE_EQ(before, ac.getRaw(), kGreeBits);
+
+  // A raw state with a bad checksum is fixed.
+  before[kGreeStateLength - 1] ^= 0xF0;
+  ac.setRaw(before);
+  EXPECT_TRUE(IRGreeAC::validChecksum(ac.getRaw()));
+}
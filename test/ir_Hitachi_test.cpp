@@ -1984,3 +1984,64 @@ TEST(TestIRHitachiAc344Class, SwingV) {
   ac.setSwingV(false);
   EXPECT_FALSE(ac.getSwingV());
 }
+
+TEST(TestDecodeHitachiFamily, EveryVariant) {
+  IRsendTest irsend(kGpioUnused);
+  IRrecv irrecv(kGpioUnused);
+  irsend.begin();
+
+  IRHitachiAc ac(kGpioUnused);
+  ac.begin();
+  irsend.reset();
+  irsend.sendHitachiAC(ac.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHitachiFamily(&irsend.capture));
+  EXPECT_EQ(HITACHI_AC, irsend.capture.decode_type);
+  EXPECT_EQ(kHitachiAcBits, irsend.capture.bits);
+
+  IRHitachiAc1 ac1(kGpioUnused);
+  ac1.begin();
+  irsend.reset();
+  irsend.sendHitachiAC1(ac1.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHitachiFamily(&irsend.capture));
+  EXPECT_EQ(HITACHI_AC1, irsend.capture.decode_type);
+
+  IRHitachiAc424 ac424(kGpioUnused);
+  ac424.begin();
+  irsend.reset();
+  irsend.sendHitachiAc424(ac424.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHitachiFamily(&irsend.capture));
+  EXPECT_EQ(HITACHI_AC424, irsend.capture.decode_type);
+
+  IRHitachiAc344 ac344(kGpioUnused);
+  ac344.begin();
+  irsend.reset();
+  irsend.sendHitachiAc344(ac344.getRaw());
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decodeHitachiFamily(&irsend.capture));
+  EXPECT_EQ(HITACHI_AC344, irsend.capture.decode_type);
+
+  // Each size of HitachiAc3 message.
+  const uint8_t ac3[kHitachiAc3StateLength - 4] = {
+      0x01, 0x10, 0x00, 0x40, 0xBF, 0xFF, 0x00, 0xE6, 0x19, 0x89, 0x76, 0x01,
+      0xFE, 0x3F, 0xC0, 0x2F, 0xD0, 0x18, 0xE7, 0x00, 0xFF, 0xA0, 0x5F};
+  const uint16_t kSizes[] = {kHitachiAc3StateLength - 4,
+                             kHitachiAc3MinStateLength + 2,
+                             kHitachiAc3MinStateLength};
+  for (uint8_t i = 0; i < sizeof(kSizes) / sizeof(kSizes[0]); i++) {
+    irsend.reset();
+    irsend.sendHitachiAc3(ac3, kSizes[i]);
+    irsend.makeDecodeResult();
+    ASSERT_TRUE(irrecv.decodeHitachiFamily(&irsend.capture));
+    EXPECT_EQ(HITACHI_AC3, irsend.capture.decode_type);
+    EXPECT_EQ(kSizes[i] * 8, irsend.capture.bits);
+  }
+
+  // Not a Hitachi.
+  irsend.reset();
+  irsend.sendNEC(0x20DF10EF);
+  irsend.makeDecodeResult();
+  EXPECT_FALSE(irrecv.decodeHitachiFamily(&irsend.capture));
+}
@@ -86,6 +86,9 @@ TEST(TestSendJVC, SendUnusualSize) {
       irsend.outputStr());
 }
 
+// Compile-time checks of encodeJVC().
+static_assert(IRsend::encodeJVC(0x43, 0x1D) == 0xC2B8, "encodeJVC(0x43, 0x1D)");
+
 // Tests for encodeJVC().
 
 TEST(TestEncodeJVC, NormalEncoding) {
@@ -108,6 +108,12 @@ TEST(TestSendLG, SendUnusualSize) {
       irsend.outputStr());
 }
 
+// Compile-time checks of encodeLG().
+static_assert(IRsend::encodeLG(0xB4B, 0x4AE5) == 0xB4B4AE51,
+              "encodeLG(0xB4B, 0x4AE5)");
+static_assert(IRsend::encodeLG(0xFFFF, 0xFFFF) == 0xFFFFFFFC,
+              "encodeLG(0xFFFF, 0xFFFF)");
+
 // Tests for encodeLG().
 
 TEST(TestEncodeLG, NormalEncoding) {
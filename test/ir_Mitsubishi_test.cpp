@@ -2,6 +2,7 @@
 // Copyright 2019 kuchel77
 // Copyright 2018 denxhun
 
+#include <cstring>
 #include "ir_Mitsubishi.h"
 #include "IRac.h"
 #include "IRrecv_test.h"
@@ -1706,3 +1707,23 @@ TEST(TestMitsubishiACClass, WeeklyTimerEnabled) {
   ac.setRaw(weekly_off);
   EXPECT_FALSE(ac.getWeeklyTimerEnabled());
 }
+
+// The checksum is only redone when something changes.
+TEST(TestMitsubishiACClass, DirtyState) {
+  IRMitsubishiAC ac(kGpioUnused);
+  ac.begin();
+  uint8_t state[kMitsubishiACStateLength];
+  std::memcpy(state, ac.getRaw(), kMitsubishiACStateLength);
+  EXPECT_TRUE(IRMitsubishiAC::validChecksum(state));
+  EXPECT_STATE_EQ(state, ac.getRaw(), kMitsubishiACBits);
+
+  ac.setTemp(27);
+  EXPECT_TRUE(IRMitsubishiAC::validChecksum(ac.getRaw()));
+  EXPECT_NE(state[kMitsubishiACStateLength - 1],
+            ac.getRaw()[kMitsubishiACStateLength - 1]);
+
+  // A raw state with a bad checksum is fixed.
+  state[kMitsubishiACStateLength - 1]++;
+  ac.setRaw(state);
+  EXPECT_TRUE(IRMitsubishiAC::validChecksum(ac.getRaw()));
+}
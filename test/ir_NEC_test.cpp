@@ -87,6 +87,10 @@ TEST(TestSendNEC, SendWithRepeats) {
       irsend.outputStr());
 }
 
+// Compile-time checks of encodeNEC().
+static_assert(IRsend::encodeNEC(1, 2) == 0x807F40BF, "Normal NEC");
+static_assert(IRsend::encodeNEC(0x159, 0x16) == 0x9A806897, "Extended NEC");
+
 // Tests for encodeNEC().
 
 TEST(TestEncodeNEC, NormalNECEncoding) {
@@ -10,6 +10,10 @@
 #include "IRutils.h"
 #include "gtest/gtest.h"
 
+// Compile-time checks of encodePanasonic().
+static_assert(IRsend::encodePanasonic(0x4004, 0x01, 0x90, 0xED) ==
+              0x40040190ED7C, "encodePanasonic(0x4004, 0x01, 0x90, 0xED)");
+
 // Tests for encodePanasonic().
 
 TEST(TestEncodePanasonic, General) {
@@ -49,6 +49,10 @@ TEST(TestSendPioneer, SendDataOnly) {
 
 TEST(TestIRUtils, TypeToString) { EXPECT_EQ("PIONEER", typeToString(PIONEER)); }
 
+// Compile-time checks of encodePioneer().
+static_assert(IRsend::encodePioneer(0xA556, 0xAF20) == 0xA55A6A95F50A04FB,
+              "encodePioneer(0xA556, 0xAF20)");
+
 // Tests for encodePioneer().
 
 TEST(TestEncodePioneer, SimpleEncoding) {
@@ -10,6 +10,12 @@
 // RR  RR  CC    C            5555  RR  RR  CC    C            5555  XX  XX
 // RR   RR  CCCCC          555555   RR   RR  CCCCC          555555  XX    XX
 
+// Compile-time checks of encodeRC5(), encodeRC5X() & encodeRC6().
+static_assert(IRsend::encodeRC5(0x1F, 0x3F, true) == 0xFFF, "RC-5");
+static_assert(IRsend::encodeRC5X(0x1F, 0x7F) == 0x17FF, "RC-5X");
+static_assert(IRsend::encodeRC6(0x123, 0x45) == 0x12345, "RC-6 Mode 0");
+static_assert(IRsend::encodeRC6(0x123, 0x45, 13) == 0, "Unknown RC-6 mode");
+
 // Tests for encodeRC5().
 TEST(TestEncodeRC5, NormalEncoding) {
   IRsendTest irsend(4);
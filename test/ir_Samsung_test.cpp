@@ -86,6 +86,10 @@ TEST(TestSendSamsung, SendWithRepeats) {
       irsend.outputStr());
 }
 
+// Compile-time checks of encodeSAMSUNG().
+static_assert(IRsend::encodeSAMSUNG(0x07, 0x99) == 0xE0E09966,
+              "encodeSAMSUNG(0x07, 0x99)");
+
 // Tests for encodeSAMSUNG().
 
 TEST(TestEncodeSamsung, NormalEncoding) {
@@ -8,6 +8,10 @@
 #include "IRsend_test.h"
 #include "gtest/gtest.h"
 
+// Compile-time checks of encodeSharp().
+static_assert(IRsend::encodeSharp(0x11, 0x4A) == 0x454A, "LSB first");
+static_assert(IRsend::encodeSharp(1, 1, 0, 1, true) == 0x405, "MSB first");
+
 // Tests for encodeSharp().
 
 TEST(TestEncodeSharp, NormalEncoding) {
@@ -114,6 +114,12 @@ TEST(TestSendSony, SendWithDiffRepeats) {
       irsend.outputStr());
 }
 
+// Compile-time checks of encodeSony().
+static_assert(IRsend::encodeSony(kSony12Bits, 21, 1) == 0xA90, "12 bits");
+static_assert(IRsend::encodeSony(kSony15Bits, 21, 0xAA) == 0x5455, "15 bits");
+static_assert(IRsend::encodeSony(kSony20Bits, 1, 1, 1) == 0x81080, "20 bits");
+static_assert(IRsend::encodeSony(13, 1, 1) == 0, "Not a Sony size");
+
 // Tests for encodeSony().
 
 TEST(TestEncodeSony, NormalSonyEncoding) {
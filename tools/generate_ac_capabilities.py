@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Generate src/IRac_capabilities.h by scraping the IRac::sendAc() dispatcher.
+
+Every `case` of the vendor switch in `IRac::sendAc()` hands a subset of the
+`stdAc::state_t` fields to the vendor helper. Those are the only fields that
+can affect the message sent, so they are what the protocol "supports".
+The temperature range is taken from the `k*MinTemp`/`k*MaxTemp` constants in
+the header that declares the vendor class used by the `case`.
+
+Usage: ./generate_ac_capabilities.py [-s ../src]
+"""
+import argparse
+import pathlib
+import re
+import sys
+
+# The fields of a stdAc::state_t, in kAcField* bit order.
+FIELDS = ["protocol", "model", "power", "mode", "degrees", "celsius",
+          "fanspeed", "swingv", "swingh", "quiet", "turbo", "econo", "light",
+          "filter", "clean", "beep", "sleep", "clock"]
+
+SENDAC_RE = re.compile(
+    r"bool IRac::sendAc\(const stdAc::state_t desired.*?"
+    r"switch \(send\.protocol\) \{(.*?)\n    default:", re.DOTALL)
+GUARD_RE = re.compile(r"^#if (.+)$")
+CASE_RE = re.compile(r"^\s{4}case (\w+):")
+CLASS_RE = re.compile(r"^\s+(IR\w+) ac\(")
+FIELD_RE = re.compile(r"\bsend\.(\w+)")
+CLASS_DECL_RE = r"^class {}\b"
+TEMP_RE = re.compile(
+    r"^const\s+\w+\s+(k(\w*?)(?:(Min|Max)Temp|Temp(Min|Max))C?)\s*=",
+    re.MULTILINE)
+
+
+def parse_cases(source):
+  """Split the sendAc() vendor switch into (guard, protocols, body) tuples."""
+  match = SENDAC_RE.search(source)
+  if not match:
+    sys.exit("Can't find the vendor switch in IRac::sendAc(). Aborting!")
+  cases = []
+  guard = None
+  current = None
+  for line in match.group(1).splitlines():
+    guard_match = GUARD_RE.match(line)
+    if guard_match:
+      guard = guard_match.group(1)
+      continue
+    case_match = CASE_RE.match(line)
+    if case_match:
+      if current is None or current[2]:
+        current = (guard, [], [])
+        cases.append(current)
+      current[1].append(case_match.group(1))
+    elif current is not None:
+      current[2].append(line)
+  return [(g, p, "\n".join(b)) for g, p, b in cases]
+
+
+def body_fields(body):
+  """Work out which state_t fields a case body uses."""
+  used = {"protocol"}
+  for field in FIELD_RE.findall(body):
+    if field in FIELDS:
+      used.add(field)
+  if re.search(r"\bdegC\b", body):  # degC is derived from degrees & celsius.
+    used.update(["degrees", "celsius"])
+  return [f for f in FIELDS if f in used]
+
+
+def read_headers(src_dir):
+  """Read all the vendor headers."""
+  headers = {}
+  for header in sorted(src_dir.glob("ir_*.h")):
+    headers[header] = header.read_text()
+  return headers
+
+
+def temp_range(headers, class_name):
+  """Find the Celsius temperature range constants for a vendor class."""
+  for text in headers.values():
+    if not re.search(CLASS_DECL_RE.format(class_name), text, re.MULTILINE):
+      continue
+    limits = {}
+    for constant, prefix, kind1, kind2 in TEMP_RE.findall(text):
+      limits.setdefault(prefix, {})[kind1 or kind2] = constant
+    # Pick the constants whose prefix best matches the class name.
+    # e.g. IRDaikin128 -> kDaikin128MinTemp rather than kDaikinMinTemp.
+    name = class_name[2:].lower()
+    best = None
+    for prefix, pair in limits.items():
+      if "Min" not in pair or "Max" not in pair:
+        continue
+      if prefix.lower() in name and (best is None or len(prefix) > len(best)):
+        best = prefix
+    if best is None and limits:
+      complete = [p for p in limits if len(limits[p]) == 2]
+      if complete:
+        best = min(complete, key=len)
+    if best is not None:
+      return (limits[best]["Min"], limits[best]["Max"])
+  return ("0", "0")
+
+
+def wrap(names):
+  """OR a list of constants together, wrapped to fit in 80 columns."""
+  lines = ["    "]
+  for name in names:
+    item = name if lines[-1].strip() == "" else " | " + name
+    if len(lines[-1]) + len(item) + 2 > 80:
+      lines[-1] += " |"
+      lines.append("    " + name)
+    else:
+      lines[-1] += item
+  return "\n".join(lines)
+
+
+def generate(src_dir):
+  """Produce the contents of the generated header."""
+  source = (src_dir / "IRac.cpp").read_text()
+  headers = read_headers(src_dir)
+  out = ["// Copyright 2026 IRremoteESP8266 authors",
+         "// This header file is only to be included by 'IRac.cpp'.",
+         "//",
+         "// WARNING: Do not edit this file! This file is automatically "
+         "generated by",
+         "//          '../tools/generate_ac_capabilities.py'.",
+         "",
+         "#ifndef IRAC_CAPABILITIES_H_",
+         "#define IRAC_CAPABILITIES_H_",
+         "",
+         '#include "IRac.h"',
+         "",
+         "/// The fields & temperature ranges each A/C protocol honours.",
+         "/// A model of kAcAnyModel applies to every model of the protocol.",
+         "const stdAc::capabilities_t kAcCapabilities[] = {"]
+  for guard, protocols, body in parse_cases(source):
+    fields = body_fields(body)
+    class_match = [CLASS_RE.match(l) for l in body.splitlines()]
+    class_names = [m.group(1) for m in class_match if m]
+    if not class_names:
+      sys.exit("Can't find the A/C class used by the {} case of "
+               "IRac::sendAc(). Has its layout changed? Aborting!".format(
+                   "/".join(protocols)))
+    low, high = temp_range(headers, class_names[0])
+    mask = wrap(["kAcField" + f.capitalize() for f in fields])
+    if guard:
+      out.append("#if " + guard)
+    for protocol in protocols:
+      out.append("  {{decode_type_t::{}, kAcAnyModel,".format(protocol))
+      out.append(mask + ",")
+      out.append("    {}, {}}},".format(low, high))
+    if guard:
+      out.append("#endif  // " + guard)
+  out += ["  {decode_type_t::UNKNOWN, kAcAnyModel, 0, 0, 0}  // End marker.",
+          "};",
+          "",
+          "#endif  // IRAC_CAPABILITIES_H_",
+          ""]
+  return "\n".join(out)
+
+
+def main():
+  """Parse the arguments & write the header."""
+  parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+  parser.add_argument("-s", "--src", default="../src", type=pathlib.Path,
+                      help="The directory containing IRac.cpp.")
+  args = parser.parse_args()
+  output = args.src / "IRac_capabilities.h"
+  output.write_text(generate(args.src))
+  print("Wrote", output)
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+"""Generate src/IRtext_protocols.h, a compressed copy of the protocol names.
+
+The protocol names (`D_STR_*` in decode_type_t order, as listed in the
+`kAllProtocolNamesStr` blob in IRtext.cpp) share a lot of text, e.g.
+"MITSUBISHI", "DAIKIN" & "_AC". A small static dictionary of the most
+profitable substrings is built, and each name is stored as a sequence of
+bytes where values below 0x80 are literal characters & values from 0x80 up
+are dictionary words. Two small index tables (a 16-bit start for each block
+of 16 names, then an 8-bit offset within the block for each name) make
+finding a name O(1).
+
+The values are taken from the locale's `D_STR_*` definitions (defaults.h
+unless another locale is given), and the generated header contains
+compile-time checks that they haven't changed since.
+
+Usage: ./generate_irtext_protocols.py [-s ../src] [-l en-AU]
+"""
+import argparse
+import pathlib
+import re
+import sys
+
+TOKEN_BASE = 0x80  # Byte values from here up are dictionary words.
+MAX_TOKENS = 256 - TOKEN_BASE
+INDEX_ENTRY_SIZE = 1  # sizeof(uint8_t)
+BLOCK_BITS = 4  # Names are indexed in blocks of 2^BLOCK_BITS.
+
+BLOB_RE = re.compile(
+    r"IRTEXT_CONST_BLOB_DECL\(kAllProtocolNamesStr\) \{(.*?)\n\};", re.DOTALL)
+NAME_RE = re.compile(r"^\s+(D_STR_\w+) \"\\x0\"", re.MULTILINE)
+DEFINE_RE = re.compile(r"^\s*#define\s+(D_STR_\w+)\s+(.+?)\s*$", re.MULTILINE)
+TOKEN_RE = re.compile(r'"([^"\\]*)"|(\w+)')
+
+
+def parse_order(src_dir):
+  """Get the D_STR_* macro names in decode_type_t order."""
+  match = BLOB_RE.search((src_dir / "IRtext.cpp").read_text())
+  if not match:
+    sys.exit("Can't find kAllProtocolNamesStr in IRtext.cpp. Aborting!")
+  return NAME_RE.findall(match.group(1))
+
+
+def parse_defines(src_dir, locale):
+  """Collect the D_STR_* definitions, the locale's taking precedence."""
+  defines = {}
+  for name, value in DEFINE_RE.findall(
+      (src_dir / "locale" / "defaults.h").read_text()):
+    defines.setdefault(name, value)
+  if locale:
+    for name, value in DEFINE_RE.findall(
+        (src_dir / "locale" / (locale + ".h")).read_text()):
+      defines[name] = value
+  return defines
+
+
+def resolve(defines, name, depth=0):
+  """Expand a macro into the string it produces."""
+  if depth > 10 or name not in defines:
+    sys.exit("Can't resolve '{}'. Aborting!".format(name))
+  result = ""
+  for literal, macro in TOKEN_RE.findall(defines[name]):
+    result += resolve(defines, macro, depth + 1) if macro else literal
+  return result
+
+
+def count(runs, word):
+  """Count the non-overlapping occurrences of a word in the literal runs."""
+  return sum(run.count(word) for run in runs)
+
+
+def literal_runs(names):
+  """The runs of literal characters, i.e. text not yet in a dictionary word."""
+  return [part for name in names for part in name if isinstance(part, str)]
+
+
+def build_dictionary(values):
+  """Greedily pick the substrings that save the most bytes.
+
+  Each name is a list of parts: literal strings & dictionary word numbers.
+  """
+  names = [[value] for value in values]
+  words = []
+  while len(words) < MAX_TOKENS:
+    runs = literal_runs(names)
+    candidates = set()
+    for run in runs:
+      for start in range(len(run)):
+        for end in range(start + 2, len(run) + 1):
+          candidates.add(run[start:end])
+    best = None
+    best_gain = 0
+    for word in sorted(candidates):
+      uses = count(runs, word)
+      # Each use saves len - 1 bytes, but the word costs its length & index.
+      gain = uses * (len(word) - 1) - len(word) - INDEX_ENTRY_SIZE
+      if gain > best_gain:
+        best, best_gain = word, gain
+    if best is None:
+      break
+    token = len(words)
+    words.append(best)
+    for name in names:
+      parts = []
+      for part in name:
+        if not isinstance(part, str):
+          parts.append(part)
+          continue
+        pieces = part.split(best)
+        for i, piece in enumerate(pieces):
+          if i:
+            parts.append(token)
+          if piece:
+            parts.append(piece)
+      name[:] = parts
+  return words, names
+
+
+def c_string(parts):
+  """Encode a name's parts as (concatenated) C string literals."""
+  out = []
+  for part in parts:
+    if isinstance(part, str):
+      out.append('"{}"'.format(part))
+    else:
+      out.append('"\\x{:02X}"'.format(TOKEN_BASE + part))
+  return " ".join(out) if out else '""'
+
+
+def packed_size(parts):
+  """Nr. of bytes a name takes up once packed."""
+  return sum(len(p) if isinstance(p, str) else 1 for p in parts)
+
+
+def wrap(items, indent="    "):
+  """Comma separate a list, wrapped to fit in 80 columns."""
+  lines = [indent]
+  for item in items:
+    if len(lines[-1]) + len(item) + 2 > 80:
+      lines.append(indent)
+    lines[-1] += item + ", "
+  return [line.rstrip() for line in lines]
+
+
+def generate(src_dir, locale):
+  """Produce the contents of the generated header."""
+  order = parse_order(src_dir)
+  defines = parse_defines(src_dir, locale)
+  values = [resolve(defines, name) for name in order]
+  for value in values:
+    if not value or any(ord(c) >= TOKEN_BASE for c in value):
+      sys.exit("Protocol names must be non-empty & 7-bit ASCII. Aborting!")
+  words, names = build_dictionary(values)
+
+  name_offsets = [0]
+  for parts in names:
+    name_offsets.append(name_offsets[-1] + packed_size(parts))
+  block_starts = name_offsets[::1 << BLOCK_BITS]
+  block_offsets = [offset - block_starts[i >> BLOCK_BITS]
+                   for i, offset in enumerate(name_offsets)]
+  word_offsets = [0]
+  for word in words:
+    word_offsets.append(word_offsets[-1] + len(word))
+  if max(block_offsets) > 255 or word_offsets[-1] > 255:
+    sys.exit("The tables are too big for 8-bit offsets. Aborting!")
+  # What the original blob costs: each name, its null, & the final null.
+  original = sum(len(v) + 1 for v in values) + 1
+  compressed = (word_offsets[-1] + 1 + name_offsets[-1] + 1 +
+                INDEX_ENTRY_SIZE * (len(word_offsets) + len(name_offsets)) +
+                2 * len(block_starts))
+  longest = max(len(v) for v in values)
+  most_bytes = max(packed_size(p) for p in names)
+  most_words = max(sum(not isinstance(p, str) for p in n) for n in names)
+
+  out = ["// Copyright 2026 IRremoteESP8266 authors",
+         "// This header file is only to be included by 'IRutils.cpp'.",
+         "//",
+         "// WARNING: Do not edit this file! This file is automatically "
+         "generated by",
+         "//          '../tools/generate_irtext_protocols.py'.",
+         "//",
+         "// Flash used: {} bytes, instead of {} bytes uncompressed. "
+         "(Saves {} bytes)".format(compressed, original,
+                                   original - compressed),
+         "// Per lookup: 3 index reads, then at most {} packed bytes & {} "
+         "dictionary".format(most_bytes, most_words),
+         "//             words are read. Nothing is allocated.",
+         "",
+         "#ifndef IRTEXT_PROTOCOLS_H_",
+         "#define IRTEXT_PROTOCOLS_H_",
+         "",
+         "#include <stdint.h>",
+         '#include "IRremoteESP8266.h"',
+         '#include "i18n.h"',
+         "",
+         "#ifndef PROGMEM",
+         "#define PROGMEM  // Pretend we have the PROGMEM macro even if we "
+         "really don't.",
+         "#endif",
+         "",
+         "/// Nr. of protocol names in the table.",
+         "const uint16_t kProtocolNameCount = {};".format(len(values)),
+         "/// Length of the longest protocol name, excluding the null.",
+         "const uint16_t kProtocolNameMaxLength = {};".format(longest),
+         "/// Nr. of bits of a protocol number that select its index block.",
+         "const uint8_t kProtocolNameBlockBits = {};".format(BLOCK_BITS),
+         "/// Packed bytes from this value up are dictionary words.",
+         "const uint8_t kProtocolNameTokenBase = 0x{:02X};".format(TOKEN_BASE),
+         "",
+         "/// Where each dictionary word starts in `kProtocolNameDict`, plus "
+         "the end.",
+         "const uint8_t kProtocolNameDictIndex[{}] PROGMEM = {{".format(
+             len(word_offsets))]
+  out += wrap([str(o) for o in word_offsets])
+  out += ["};",
+          "",
+          "/// The dictionary words, back to back.",
+          "const char kProtocolNameDict[] PROGMEM ="]
+  for number, word in enumerate(words):
+    out.append('    "{}"  // 0x{:02X}'.format(word, TOKEN_BASE + number))
+  out[-1] = out[-1].replace('"  //', '";  //', 1)
+  out += ["",
+          "/// Where each block of names starts in `kProtocolNamePacked`.",
+          "const uint16_t kProtocolNameBlock[{}] PROGMEM = {{".format(
+              len(block_starts))]
+  out += wrap([str(o) for o in block_starts])
+  out += ["};",
+          "",
+          "/// Where each packed name (plus the end) starts, relative to its "
+          "block.",
+          "const uint8_t kProtocolNameIndex[{}] PROGMEM = {{".format(
+              len(block_offsets))]
+  out += wrap([str(o) for o in block_offsets])
+  out += ["};",
+          "",
+          "/// The packed protocol names, in decode_type_t order.",
+          "const char kProtocolNamePacked[] PROGMEM ="]
+  for name, parts in zip(order, names):
+    out.append("    {}  // {}".format(c_string(parts), name))
+  out[-1] = out[-1].replace("  //", ";  //", 1)
+  out += ["",
+          "/// Compile-time comparison of two strings.",
+          "/// @param[in] a A string.",
+          "/// @param[in] b Another string.",
+          "/// @return true if they are the same, otherwise false.",
+          "constexpr bool protocolNameCheck(const char *a, const char *b) {",
+          "  return *a == *b && (*a == '\\0' || "
+          "protocolNameCheck(a + 1, b + 1));",
+          "}",
+          "",
+          "#define IRTEXT_PROTOCOL_CHECK(NAME, VALUE) \\",
+          "    static_assert(protocolNameCheck(NAME, VALUE), \\",
+          "                  #NAME \" has changed. Run \" \\",
+          "                  \"'tools/generate_irtext_protocols.py', or set \""
+          " \\",
+          "                  \"COMPRESS_PROTOCOL_NAMES to false.\")",
+          "",
+          "static_assert(kProtocolNameCount == kLastDecodeType + 1,",
+          "              \"The protocol list has changed. Run \"",
+          "              \"'tools/generate_irtext_protocols.py'.\");"]
+  for name, value in zip(order, values):
+    out.append('IRTEXT_PROTOCOL_CHECK({}, "{}");'.format(name, value))
+  out += ["",
+          "#undef IRTEXT_PROTOCOL_CHECK",
+          "",
+          "#endif  // IRTEXT_PROTOCOLS_H_",
+          ""]
+  for line in out:
+    if len(line) > 80:
+      sys.exit("Line too long: '{}'. Aborting!".format(line))
+  print("Protocol names: {} bytes, was {} bytes.".format(compressed, original))
+  return "\n".join(out)
+
+
+def main():
+  """Parse the arguments & write the header."""
+  parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+  parser.add_argument("-s", "--src", default="../src", type=pathlib.Path,
+                      help="The directory containing IRtext.cpp.")
+  parser.add_argument("-l", "--locale", default=None,
+                      help="The locale to use. e.g. en-AU (Default: none)")
+  args = parser.parse_args()
+  output = args.src / "IRtext_protocols.h"
+  output.write_text(generate(args.src, args.locale))
+  print("Wrote", output)
+
+
+if __name__ == "__main__":
+  main()
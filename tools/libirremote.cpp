@@ -0,0 +1,179 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+// C API to the library's decoders & encoders, for host programs.
+// See libirremote.h
+
+#include "libirremote.h"
+#include <string.h>
+#include <algorithm>
+#include <mutex>  // NOLINT(build/c++11)
+#include <new>
+#include <string>
+#include "IRac.h"
+#include "IRrecv.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+
+static_assert(kStateSizeMax <= IR_STATE_MAX,
+              "IR_STATE_MAX is too small for this build's A/C states.");
+
+// The simulated clock the encoders advance (`IRtimer::add()`) is shared by
+// every IRsend, so only one context may encode at a time.
+static std::mutex encode_mutex;
+// IRrecv's constructor & destructor set up the (single, global) capture
+// state. Decoding from our own buffer never touches it.
+static std::mutex lifecycle_mutex;
+
+struct ir_context {
+  // We always supply our own buffer, so IRrecv's is only a token one.
+  ir_context(void) : irrecv(0, kRawBuf), irsend(0), rawbuf(NULL) {}
+  ~ir_context(void) { delete[] rawbuf; }
+  IRrecv irrecv;
+  IRsendTest irsend;
+  uint16_t max_timings;
+  uint16_t *rawbuf;  // Capture buffer. `rawbuf[0]` is the (unused) gap.
+  decode_results results;  // The last message decoded.
+  bool decoded;  // Does `results` hold a decoded message?
+};
+
+uint32_t ir_api_version(void) { return IR_API_VERSION; }
+
+ir_context_t *ir_context_create(uint16_t max_timings) {
+  if (max_timings == 0 || max_timings > UINT16_MAX - 2) return NULL;
+  std::lock_guard<std::mutex> lock(lifecycle_mutex);
+  ir_context_t *ctx = new (std::nothrow) ir_context_t;
+  if (ctx == NULL) return NULL;
+  ctx->max_timings = max_timings;
+  ctx->rawbuf = new (std::nothrow) uint16_t[max_timings + 2];
+  ctx->decoded = false;
+  if (ctx->rawbuf == NULL) {
+    delete ctx;
+    return NULL;
+  }
+  ctx->irsend.begin();
+  return ctx;
+}
+
+void ir_context_destroy(ir_context_t *ctx) {
+  std::lock_guard<std::mutex> lock(lifecycle_mutex);
+  delete ctx;
+}
+
+int ir_set_tolerance(ir_context_t *ctx, uint8_t percent) {
+  if (ctx == NULL || percent > 100) return IR_ERROR_ARGS;
+  ctx->irrecv.setTolerance(percent);
+  return 0;
+}
+
+int ir_decode(ir_context_t *ctx, const uint32_t *timings, uint16_t count,
+              ir_result_t *result) {
+  if (ctx == NULL || result == NULL || (timings == NULL && count))
+    return IR_ERROR_ARGS;
+  if (count > ctx->max_timings) return IR_ERROR_SPACE;
+  ctx->decoded = false;
+  memset(result, 0, sizeof(*result));
+  result->protocol = UNKNOWN;
+  // Convert to capture ticks, as the receiver would have recorded them.
+  ctx->rawbuf[0] = 0;
+  for (uint16_t i = 0; i < count; i++)
+    ctx->rawbuf[i + 1] = std::min(timings[i] / kRawTick,
+                                  (uint32_t)UINT16_MAX);
+  ctx->rawbuf[count + 1] = 0;
+  decode_results *results = &ctx->results;
+  results->rawbuf = ctx->rawbuf;
+  results->rawlen = count + 1;
+  results->overflow = false;
+  if (!ctx->irrecv.decode(results)) return 0;
+  ctx->decoded = true;
+  result->protocol = results->decode_type;
+  const std::string name = typeToString(results->decode_type);
+  strncpy(result->protocol_name, name.c_str(), IR_NAME_MAX - 1);
+  result->bits = results->bits;
+  result->address = results->address;
+  result->command = results->command;
+  result->repeat = results->repeat;
+  if (hasACState(results->decode_type)) {
+    result->has_state = 1;
+    result->state_length = std::min((uint16_t)(results->bits / 8),
+                                    kStateSizeMax);
+    memcpy(result->state, results->state, result->state_length);
+  } else {
+    result->value = results->value;
+  }
+  return 1;
+}
+
+int ir_decode_ac(ir_context_t *ctx, ir_ac_state_t *ac) {
+  if (ctx == NULL || ac == NULL) return IR_ERROR_ARGS;
+  if (!ctx->decoded) return 0;
+  stdAc::state_t state;
+  if (!IRAcUtils::decodeToState(&ctx->results, &state)) return 0;
+  ac->protocol = state.protocol;
+  ac->model = state.model;
+  ac->power = state.power;
+  ac->mode = (int8_t)state.mode;
+  ac->degrees = state.degrees;
+  ac->celsius = state.celsius;
+  ac->fanspeed = (int8_t)state.fanspeed;
+  ac->swingv = (int8_t)state.swingv;
+  ac->swingh = (int8_t)state.swingh;
+  ac->quiet = state.quiet;
+  ac->turbo = state.turbo;
+  ac->econo = state.econo;
+  ac->light = state.light;
+  ac->filter = state.filter;
+  ac->clean = state.clean;
+  ac->beep = state.beep;
+  ac->sleep = state.sleep;
+  ac->clock = state.clock;
+  return 1;
+}
+
+// Copy what the context's IRsend just "sent" out as timings.
+static int32_t copyOutput(IRsendTest *irsend, uint32_t *timings,
+                          const uint16_t max_timings, uint32_t *hz) {
+  const uint16_t count = (irsend->last == 0 && irsend->output[0] == 0) ?
+      0 : irsend->last + 1;
+  if (count > max_timings) return IR_ERROR_SPACE;
+  for (uint16_t i = 0; i < count; i++) timings[i] = irsend->output[i];
+  if (hz != NULL) *hz = irsend->freq[0];
+  return count;
+}
+
+int32_t ir_encode(ir_context_t *ctx, int16_t protocol, uint64_t value,
+                  uint16_t bits, uint16_t repeat, uint32_t *timings,
+                  uint16_t max_timings, uint32_t *hz) {
+  if (ctx == NULL || timings == NULL) return IR_ERROR_ARGS;
+  std::lock_guard<std::mutex> lock(encode_mutex);
+  ctx->irsend.reset();
+  if (!ctx->irsend.send((decode_type_t)protocol, value, bits, repeat))
+    return IR_ERROR_PROTOCOL;
+  return copyOutput(&ctx->irsend, timings, max_timings, hz);
+}
+
+int32_t ir_encode_state(ir_context_t *ctx, int16_t protocol,
+                        const uint8_t *state, uint16_t nbytes,
+                        uint32_t *timings, uint16_t max_timings,
+                        uint32_t *hz) {
+  if (ctx == NULL || state == NULL || timings == NULL) return IR_ERROR_ARGS;
+  std::lock_guard<std::mutex> lock(encode_mutex);
+  ctx->irsend.reset();
+  if (!ctx->irsend.send((decode_type_t)protocol, state, nbytes))
+    return IR_ERROR_PROTOCOL;
+  return copyOutput(&ctx->irsend, timings, max_timings, hz);
+}
+
+int16_t ir_protocol_from_name(const char *name) {
+  if (name == NULL) return UNKNOWN;
+  return strToDecodeType(name);
+}
+
+int ir_protocol_name(int16_t protocol, char *name, uint16_t size) {
+  if (name == NULL || size == 0) return IR_ERROR_ARGS;
+  const std::string text = typeToString((decode_type_t)protocol);
+  if (text.length() >= size) return IR_ERROR_SPACE;
+  strncpy(name, text.c_str(), size);
+  return text.length();
+}
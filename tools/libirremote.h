@@ -0,0 +1,123 @@
+/* Copyright 2026 IRremoteESP8266 authors */
+
+/* A C API to the library's decoders & encoders, for use on a host (not an
+ * ESP8266/ESP32) by programs that need to process many IR messages in-process.
+ * e.g. Log processing & analytics services, or bindings for other languages.
+ *
+ * Build `libirremote.so` or `libirremote.a` with `make` in this directory.
+ *
+ * All state lives in an `ir_context_t`. Functions taking a context are
+ * reentrant, & different contexts can be used by different threads at the
+ * same time. (Checked by `make run_tsan`.) A single context must not be used
+ * by two threads at once.
+ *
+ * Timings are in micro-seconds, alternating mark (LED on) & space (LED off),
+ * starting with a mark. i.e. The same as `IRsend::sendRaw()`.
+ */
+
+#ifndef TOOLS_LIBIRREMOTE_H_
+#define TOOLS_LIBIRREMOTE_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever the API or the layout of a struct below changes. */
+#define IR_API_VERSION 1
+
+/* Max. nr. of bytes in an A/C state. */
+#define IR_STATE_MAX 64
+/* Max. nr. of characters in a protocol's name, including the '\0'. */
+#define IR_NAME_MAX 32
+
+/* Return codes. Non-negative values mean success. */
+#define IR_ERROR_ARGS -1  /* A bad argument. e.g. A NULL pointer. */
+#define IR_ERROR_SPACE -2  /* The output buffer is too small. */
+#define IR_ERROR_PROTOCOL -3  /* The protocol can't do that. */
+
+/* A decoder/encoder context. Opaque. */
+typedef struct ir_context ir_context_t;
+
+/* A decoded message. */
+typedef struct {
+  int16_t protocol;  /* A `decode_type_t`. -1 is UNKNOWN. */
+  char protocol_name[IR_NAME_MAX];
+  uint16_t bits;  /* Nr. of bits of data. */
+  uint64_t value;  /* The value, if it isn't a state. */
+  uint32_t address;  /* Decoded device address, if the protocol has one. */
+  uint32_t command;  /* Decoded command, if the protocol has one. */
+  uint8_t repeat;  /* Non-zero if it was a repeat message. */
+  uint8_t has_state;  /* Non-zero if `state` holds the data, not `value`. */
+  uint16_t state_length;  /* Nr. of bytes in `state`. */
+  uint8_t state[IR_STATE_MAX];
+} ir_result_t;
+
+/* A protocol independent A/C state. Mirrors `stdAc::state_t`. */
+typedef struct {
+  int16_t protocol;  /* A `decode_type_t`. */
+  int16_t model;
+  uint8_t power;
+  int8_t mode;  /* A `stdAc::opmode_t`. */
+  float degrees;
+  uint8_t celsius;
+  int8_t fanspeed;  /* A `stdAc::fanspeed_t`. */
+  int8_t swingv;  /* A `stdAc::swingv_t`. */
+  int8_t swingh;  /* A `stdAc::swingh_t`. */
+  uint8_t quiet;
+  uint8_t turbo;
+  uint8_t econo;
+  uint8_t light;
+  uint8_t filter;
+  uint8_t clean;
+  uint8_t beep;
+  int16_t sleep;  /* Nr. of mins of sleep mode, or -1 for off. */
+  int16_t clock;  /* Nr. of mins past midnight, or -1 for not set. */
+} ir_ac_state_t;
+
+/* The value of IR_API_VERSION the library was built with. */
+uint32_t ir_api_version(void);
+
+/* Create a context that can decode messages of up to `max_timings` timings.
+ * Returns NULL if there isn't enough memory. */
+ir_context_t *ir_context_create(uint16_t max_timings);
+/* Free a context. NULL is ignored. */
+void ir_context_destroy(ir_context_t *ctx);
+/* Set the percentage of error allowed when matching timings. (Default: 25) */
+int ir_set_tolerance(ir_context_t *ctx, uint8_t percent);
+
+/* Decode a message.
+ * Returns 1 if it was decoded into `result`, 0 if it wasn't recognised, or a
+ * negative IR_ERROR_* value. */
+int ir_decode(ir_context_t *ctx, const uint32_t *timings, uint16_t count,
+              ir_result_t *result);
+/* Convert the last message decoded by `ctx` into a common A/C state.
+ * Returns 1 on success, 0 if it wasn't an A/C message we understand, or a
+ * negative IR_ERROR_* value. */
+int ir_decode_ac(ir_context_t *ctx, ir_ac_state_t *ac);
+
+/* Encode a simple (value based) message into timings.
+ * `hz` (optional) is set to the modulation frequency.
+ * Returns the nr. of timings, or a negative IR_ERROR_* value. */
+int32_t ir_encode(ir_context_t *ctx, int16_t protocol, uint64_t value,
+                  uint16_t bits, uint16_t repeat, uint32_t *timings,
+                  uint16_t max_timings, uint32_t *hz);
+/* Encode an A/C state message into timings.
+ * Returns the nr. of timings, or a negative IR_ERROR_* value. */
+int32_t ir_encode_state(ir_context_t *ctx, int16_t protocol,
+                        const uint8_t *state, uint16_t nbytes,
+                        uint32_t *timings, uint16_t max_timings,
+                        uint32_t *hz);
+
+/* Look up a protocol by name. e.g. "NEC". Returns -1 (UNKNOWN) if not found.*/
+int16_t ir_protocol_from_name(const char *name);
+/* Get a protocol's name. Returns the length of the name, or a negative
+ * IR_ERROR_* value. */
+int ir_protocol_name(int16_t protocol, char *name, uint16_t size);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif  /* TOOLS_LIBIRREMOTE_H_ */
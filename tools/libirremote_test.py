@@ -0,0 +1,200 @@
+#!/usr/bin/python3
+"""Unit tests for the libirremote C API. (Built by `make lib`)"""
+import ctypes
+import os
+import threading
+import unittest
+
+STATE_MAX = 64
+NAME_MAX = 32
+ERROR_ARGS = -1
+ERROR_SPACE = -2
+ERROR_PROTOCOL = -3
+
+
+class Result(ctypes.Structure):
+  """Mirror of ir_result_t."""
+  _fields_ = [("protocol", ctypes.c_int16),
+              ("protocol_name", ctypes.c_char * NAME_MAX),
+              ("bits", ctypes.c_uint16),
+              ("value", ctypes.c_uint64),
+              ("address", ctypes.c_uint32),
+              ("command", ctypes.c_uint32),
+              ("repeat", ctypes.c_uint8),
+              ("has_state", ctypes.c_uint8),
+              ("state_length", ctypes.c_uint16),
+              ("state", ctypes.c_uint8 * STATE_MAX)]
+
+
+class AcState(ctypes.Structure):
+  """Mirror of ir_ac_state_t."""
+  _fields_ = [("protocol", ctypes.c_int16),
+              ("model", ctypes.c_int16),
+              ("power", ctypes.c_uint8),
+              ("mode", ctypes.c_int8),
+              ("degrees", ctypes.c_float),
+              ("celsius", ctypes.c_uint8),
+              ("fanspeed", ctypes.c_int8),
+              ("swingv", ctypes.c_int8),
+              ("swingh", ctypes.c_int8),
+              ("quiet", ctypes.c_uint8),
+              ("turbo", ctypes.c_uint8),
+              ("econo", ctypes.c_uint8),
+              ("light", ctypes.c_uint8),
+              ("filter", ctypes.c_uint8),
+              ("clean", ctypes.c_uint8),
+              ("beep", ctypes.c_uint8),
+              ("sleep", ctypes.c_int16),
+              ("clock", ctypes.c_int16)]
+
+
+def load():
+  """Load the library, & declare the functions' signatures."""
+  lib = ctypes.CDLL(os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                 "libirremote.so"))
+  lib.ir_context_create.restype = ctypes.c_void_p
+  lib.ir_context_create.argtypes = [ctypes.c_uint16]
+  lib.ir_context_destroy.argtypes = [ctypes.c_void_p]
+  lib.ir_set_tolerance.argtypes = [ctypes.c_void_p, ctypes.c_uint8]
+  lib.ir_decode.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint32),
+                            ctypes.c_uint16, ctypes.POINTER(Result)]
+  lib.ir_decode_ac.argtypes = [ctypes.c_void_p, ctypes.POINTER(AcState)]
+  lib.ir_encode.restype = ctypes.c_int32
+  lib.ir_encode.argtypes = [ctypes.c_void_p, ctypes.c_int16, ctypes.c_uint64,
+                            ctypes.c_uint16, ctypes.c_uint16,
+                            ctypes.POINTER(ctypes.c_uint32), ctypes.c_uint16,
+                            ctypes.POINTER(ctypes.c_uint32)]
+  lib.ir_encode_state.restype = ctypes.c_int32
+  lib.ir_encode_state.argtypes = [ctypes.c_void_p, ctypes.c_int16,
+                                  ctypes.POINTER(ctypes.c_uint8),
+                                  ctypes.c_uint16,
+                                  ctypes.POINTER(ctypes.c_uint32),
+                                  ctypes.c_uint16,
+                                  ctypes.POINTER(ctypes.c_uint32)]
+  lib.ir_protocol_from_name.restype = ctypes.c_int16
+  lib.ir_protocol_from_name.argtypes = [ctypes.c_char_p]
+  lib.ir_protocol_name.argtypes = [ctypes.c_int16, ctypes.c_char_p,
+                                   ctypes.c_uint16]
+  return lib
+
+
+class TestLibIRremote(unittest.TestCase):
+  """Unit tests for the libirremote C API."""
+
+  @classmethod
+  def setUpClass(cls):
+    cls.lib = load()
+    cls.nec = cls.lib.ir_protocol_from_name(b"NEC")
+    cls.gree = cls.lib.ir_protocol_from_name(b"GREE")
+
+  def setUp(self):
+    self.ctx = self.lib.ir_context_create(1000)
+    self.assertTrue(self.ctx)
+
+  def tearDown(self):
+    self.lib.ir_context_destroy(self.ctx)
+
+  def encode(self, protocol, value, bits, ctx=None):
+    """Encode a simple message. Returns its timings & frequency."""
+    timings = (ctypes.c_uint32 * 1000)()
+    hz = ctypes.c_uint32()
+    count = self.lib.ir_encode(ctx or self.ctx, protocol, value, bits, 0,
+                               timings, 1000, ctypes.byref(hz))
+    self.assertGreater(count, 0)
+    return timings, count, hz.value
+
+  def test_version(self):
+    """Tests for ir_api_version()."""
+    self.assertEqual(self.lib.ir_api_version(), 1)
+
+  def test_protocol_names(self):
+    """Tests for ir_protocol_from_name() & ir_protocol_name()."""
+    self.assertGreater(self.nec, 0)
+    self.assertEqual(self.lib.ir_protocol_from_name(b"NOT_A_PROTOCOL"), -1)
+    name = ctypes.create_string_buffer(NAME_MAX)
+    self.assertEqual(self.lib.ir_protocol_name(self.gree, name, NAME_MAX), 4)
+    self.assertEqual(name.value, b"GREE")
+    self.assertEqual(self.lib.ir_protocol_name(self.gree, name, 4),
+                     ERROR_SPACE)
+
+  def test_encode_and_decode(self):
+    """Tests for ir_encode() & ir_decode() of a simple message."""
+    timings, count, hz = self.encode(self.nec, 0x20DF10EF, 32)
+    self.assertEqual(count, 68)  # 32 bits, header & footer.
+    self.assertEqual(timings[0], 8960)  # NEC's header mark.
+    self.assertEqual(hz, 38000)
+    result = Result()
+    self.assertEqual(self.lib.ir_decode(self.ctx, timings, count,
+                                        ctypes.byref(result)), 1)
+    self.assertEqual(result.protocol, self.nec)
+    self.assertEqual(result.protocol_name, b"NEC")
+    self.assertEqual(result.bits, 32)
+    self.assertEqual(result.value, 0x20DF10EF)
+    self.assertEqual(result.has_state, 0)
+    # Not an A/C.
+    self.assertEqual(self.lib.ir_decode_ac(self.ctx, ctypes.byref(AcState())),
+                     0)
+
+  def test_errors(self):
+    """Tests for bad arguments."""
+    timings = (ctypes.c_uint32 * 2000)()
+    result = Result()
+    self.assertEqual(self.lib.ir_decode(self.ctx, timings, 2000,
+                                        ctypes.byref(result)), ERROR_SPACE)
+    self.assertEqual(self.lib.ir_decode(None, timings, 10,
+                                        ctypes.byref(result)), ERROR_ARGS)
+    self.assertEqual(self.lib.ir_encode(self.ctx, self.nec, 0x20DF10EF, 32, 0,
+                                        timings, 10, None), ERROR_SPACE)
+    daikin = self.lib.ir_protocol_from_name(b"DAIKIN")
+    self.assertEqual(self.lib.ir_encode(self.ctx, daikin, 1, 64, 0,
+                                        timings, 1000, None), ERROR_PROTOCOL)
+    self.assertEqual(self.lib.ir_set_tolerance(self.ctx, 101), ERROR_ARGS)
+    self.assertFalse(self.lib.ir_context_create(0))
+    self.lib.ir_context_destroy(None)  # Harmless.
+
+  def test_ac_state(self):
+    """Tests for A/C states, & the common A/C state."""
+    state = (ctypes.c_uint8 * 8)(0x59, 0x07, 0x20, 0x50,
+                                 0x01, 0x20, 0x00, 0xC0)
+    timings = (ctypes.c_uint32 * 1000)()
+    count = self.lib.ir_encode_state(self.ctx, self.gree, state, 8,
+                                     timings, 1000, None)
+    self.assertGreater(count, 0)
+    result = Result()
+    self.assertEqual(self.lib.ir_decode(self.ctx, timings, count,
+                                        ctypes.byref(result)), 1)
+    self.assertEqual(result.protocol, self.gree)
+    self.assertEqual(result.has_state, 1)
+    self.assertEqual(result.state_length, 8)
+    self.assertEqual(list(result.state[:8]), list(state))
+    ac_state = AcState()
+    self.assertEqual(self.lib.ir_decode_ac(self.ctx, ctypes.byref(ac_state)),
+                     1)
+    self.assertEqual(ac_state.protocol, self.gree)
+    self.assertEqual(ac_state.power, 1)
+
+  def test_threads(self):
+    """Decode in many threads at once, each with its own context."""
+    timings, count, _ = self.encode(self.nec, 0x20DF10EF, 32)
+    failures = []
+
+    def work():
+      ctx = self.lib.ir_context_create(1000)
+      result = Result()
+      for _ in range(200):
+        if (self.lib.ir_decode(ctx, timings, count, ctypes.byref(result)) != 1
+            or result.value != 0x20DF10EF):
+          failures.append(result.value)
+        self.encode(self.nec, 0x20DF40BF, 32, ctx)
+      self.lib.ir_context_destroy(ctx)
+
+    threads = [threading.Thread(target=work) for _ in range(4)]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+    self.assertEqual(failures, [])
+
+
+if __name__ == '__main__':
+  unittest.main(verbosity=2)
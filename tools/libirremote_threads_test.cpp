@@ -0,0 +1,55 @@
+// Copyright 2026 IRremoteESP8266 authors
+
+// Decode & encode in many threads at once, each with its own context, as
+// promised by libirremote.h. Build & run it under ThreadSanitizer with
+// `make run_tsan`, so any data race is reported & fails it.
+
+#include <stdio.h>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+#include "libirremote.h"
+
+const uint16_t kThreads = 4;
+const uint16_t kLoops = 200;
+const uint16_t kMaxTimings = 1000;
+const int16_t kNec = 3;  // decode_type_t::NEC
+const uint64_t kValue = 0x20DF10EF;
+
+// Returns the nr. of failures.
+static uint32_t work(void) {
+  uint32_t failures = 0;
+  ir_context_t *ctx = ir_context_create(kMaxTimings);
+  if (ctx == NULL) return 1;
+  uint32_t timings[kMaxTimings];
+  const int32_t count = ir_encode(ctx, kNec, kValue, 32, 0, timings,
+                                  kMaxTimings, NULL);
+  if (count <= 0) failures++;
+  // Too short for anything, even the UNKNOWN hash. i.e. A failed decode.
+  const uint32_t junk[3] = {500, 500, 500};
+  ir_result_t result;
+  for (uint16_t i = 0; i < kLoops && count > 0; i++) {
+    if (ir_decode(ctx, timings, count, &result) != 1 || result.value != kValue)
+      failures++;
+    if (ir_decode(ctx, junk, 3, &result) != 0) failures++;
+  }
+  ir_context_destroy(ctx);
+  return failures;
+}
+
+int main(void) {
+  std::vector<std::thread> threads;
+  uint32_t failures[kThreads] = {0};
+  for (uint16_t i = 0; i < kThreads; i++)
+    threads.push_back(std::thread([&failures, i]() { failures[i] = work(); }));
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < kThreads; i++) {
+    threads[i].join();
+    total += failures[i];
+  }
+  if (total) {
+    printf("FAIL: %u decode(s)/encode(s) went wrong.\n", total);
+    return 1;
+  }
+  printf("PASS: %u threads x %u decodes.\n", kThreads, kLoops * 2);
+  return 0;
+}